@@ -0,0 +1,581 @@
+#include "algo.h"
+
+#ifdef OS_WINDOWS
+#	define HARBOL_LIB
+#endif
+
+
+enum { HARBOL_INSERTION_SORT_CUTOFF = 16 };
+
+#define ELEM(table, i)    (&(table)[(i) * datasize])
+
+static inline NO_NULL void _harbol_swap_elems(uint8_t *a, uint8_t *b, size_t datasize) {
+	if( a==b ) {
+		return;
+	}
+	uint8_t tmp[64];
+	while( datasize > 0 ) {
+		size_t const amount = (datasize < sizeof tmp)? datasize : sizeof tmp;
+		memcpy(tmp, a, amount);
+		memcpy(a, b, amount);
+		memcpy(b, tmp, amount);
+		a += amount; b += amount; datasize -= amount;
+	}
+}
+
+static NO_NULL void _harbol_insertion_sort(uint8_t *const table, size_t const lo, size_t const hi, size_t const datasize, HarbolCmpFunc *const cmp) {
+	for( size_t i=lo + 1; i <= hi; i++ ) {
+		for( size_t j=i; j > lo && (*cmp)(ELEM(table, j - 1), ELEM(table, j)) > 0; j-- ) {
+			_harbol_swap_elems(ELEM(table, j - 1), ELEM(table, j), datasize);
+		}
+	}
+}
+
+static NO_NULL void _harbol_sift_down(uint8_t *const table, size_t root, size_t const len, size_t const datasize, HarbolCmpFunc *const cmp) {
+	for(;;) {
+		size_t child = (root << 1) + 1;
+		if( child >= len ) {
+			break;
+		} else if( child + 1 < len && (*cmp)(ELEM(table, child), ELEM(table, child + 1)) < 0 ) {
+			child++;
+		}
+		if( (*cmp)(ELEM(table, root), ELEM(table, child)) >= 0 ) {
+			break;
+		}
+		_harbol_swap_elems(ELEM(table, root), ELEM(table, child), datasize);
+		root = child;
+	}
+}
+
+static NO_NULL void _harbol_heap_sort(uint8_t *const table, size_t const len, size_t const datasize, HarbolCmpFunc *const cmp) {
+	for( size_t i=len >> 1; i-- > 0; ) {
+		_harbol_sift_down(table, i, len, datasize, cmp);
+	}
+	for( size_t end=len - 1; end > 0; end-- ) {
+		_harbol_swap_elems(ELEM(table, 0), ELEM(table, end), datasize);
+		_harbol_sift_down(table, 0, end, datasize, cmp);
+	}
+}
+
+/// quicksort over [lo, hi], falling back to heapsort past 'depth' bad splits.
+static NO_NULL void _harbol_introsort(uint8_t *const table, size_t lo, size_t hi, size_t depth, size_t const datasize, HarbolCmpFunc *const cmp) {
+	while( hi > lo ) {
+		size_t const len = hi - lo + 1;
+		if( len <= HARBOL_INSERTION_SORT_CUTOFF ) {
+			_harbol_insertion_sort(table, lo, hi, datasize, cmp);
+			return;
+		} else if( depth==0 ) {
+			_harbol_heap_sort(ELEM(table, lo), len, datasize, cmp);
+			return;
+		}
+		depth--;
+		
+		/// median of three ends up as the pivot at 'lo', largest of three guards 'hi'.
+		size_t const mid = lo + (len >> 1);
+		if( (*cmp)(ELEM(table, mid), ELEM(table, lo)) < 0 ) {
+			_harbol_swap_elems(ELEM(table, mid), ELEM(table, lo), datasize);
+		}
+		if( (*cmp)(ELEM(table, hi), ELEM(table, lo)) < 0 ) {
+			_harbol_swap_elems(ELEM(table, hi), ELEM(table, lo), datasize);
+		}
+		if( (*cmp)(ELEM(table, hi), ELEM(table, mid)) < 0 ) {
+			_harbol_swap_elems(ELEM(table, hi), ELEM(table, mid), datasize);
+		}
+		_harbol_swap_elems(ELEM(table, lo), ELEM(table, mid), datasize);
+		
+		/// stopping on equal keys keeps runs of duplicates balanced.
+		size_t i = lo, j = hi + 1;
+		for(;;) {
+			while( (*cmp)(ELEM(table, ++i), ELEM(table, lo)) < 0 ) {
+				if( i==hi ) {
+					break;
+				}
+			}
+			while( (*cmp)(ELEM(table, lo), ELEM(table, --j)) < 0 ) {
+				if( j==lo ) {
+					break;
+				}
+			}
+			if( i >= j ) {
+				break;
+			}
+			_harbol_swap_elems(ELEM(table, i), ELEM(table, j), datasize);
+		}
+		_harbol_swap_elems(ELEM(table, lo), ELEM(table, j), datasize);
+		
+		/// recurse into the smaller side to bound the stack.
+		if( j - lo < hi - j ) {
+			if( j > lo ) {
+				_harbol_introsort(table, lo, j - 1, depth, datasize, cmp);
+			}
+			lo = j + 1;
+		} else {
+			if( j < hi ) {
+				_harbol_introsort(table, j + 1, hi, depth, datasize, cmp);
+			}
+			if( j==lo ) {
+				return;
+			}
+			hi = j - 1;
+		}
+	}
+}
+
+HARBOL_EXPORT void harbol_array_sort(struct HarbolArray *const vec, size_t const datasize, HarbolCmpFunc *const cmp) {
+	if( vec->table==NULL || vec->len < 2 || datasize==0 ) {
+		return;
+	}
+	_harbol_introsort(vec->table, 0, vec->len - 1, int_log2(vec->len) << 1, datasize, cmp);
+}
+
+
+static inline NO_NULL uint64_t _harbol_radix_key(uint8_t const *const elem, size_t const key_size, bool const is_signed) {
+	switch( key_size ) {
+		case sizeof(uint8_t): {
+			uint8_t k; memcpy(&k, elem, sizeof k);
+			return is_signed? (k ^ 0x80u) : k;
+		}
+		case sizeof(uint16_t): {
+			uint16_t k; memcpy(&k, elem, sizeof k);
+			return is_signed? (k ^ 0x8000u) : k;
+		}
+		case sizeof(uint32_t): {
+			uint32_t k; memcpy(&k, elem, sizeof k);
+			return is_signed? (k ^ 0x80000000u) : k;
+		}
+		default: {
+			uint64_t k; memcpy(&k, elem, sizeof k);
+			return is_signed? (k ^ 0x8000000000000000ull) : k;
+		}
+	}
+}
+
+HARBOL_EXPORT bool harbol_array_radix_sort(struct HarbolArray *const vec, size_t const datasize, size_t const key_offset, size_t const key_size, bool const is_signed) {
+	if( key_size != 1 && key_size != 2 && key_size != 4 && key_size != 8 ) {
+		return false;
+	} else if( key_offset > datasize || key_size > datasize - key_offset ) {
+		return false;
+	} else if( vec->table==NULL || vec->len < 2 ) {
+		return true;
+	}
+	
+	uint8_t *const tmp = malloc(vec->len * datasize);
+	if( tmp==NULL ) {
+		return false;
+	}
+	
+	uint8_t *src = vec->table, *dst = tmp;
+	for( size_t pass=0; pass < key_size; pass++ ) {
+		size_t counts[256] = {0};
+		size_t const shift = pass << 3;
+		for( size_t i=0; i < vec->len; i++ ) {
+			counts[(_harbol_radix_key(&ELEM(src, i)[key_offset], key_size, is_signed) >> shift) & 0xFF]++;
+		}
+		
+		/// every key shares this digit, the pass wouldn't move anything.
+		bool skip = false;
+		for( size_t d=0; d < 256; d++ ) {
+			if( counts[d]==vec->len ) {
+				skip = true;
+				break;
+			} else if( counts[d] > 0 ) {
+				break;
+			}
+		}
+		if( skip ) {
+			continue;
+		}
+		
+		size_t offs = 0;
+		for( size_t d=0; d < 256; d++ ) {
+			size_t const c = counts[d];
+			counts[d] = offs;
+			offs += c;
+		}
+		for( size_t i=0; i < vec->len; i++ ) {
+			size_t const d = (_harbol_radix_key(&ELEM(src, i)[key_offset], key_size, is_signed) >> shift) & 0xFF;
+			memcpy(ELEM(dst, counts[d]++), ELEM(src, i), datasize);
+		}
+		uint8_t *const t = src; src = dst; dst = t;
+	}
+	if( src != vec->table ) {
+		memcpy(vec->table, src, vec->len * datasize);
+	}
+	free(tmp);
+	return true;
+}
+
+
+HARBOL_EXPORT size_t harbol_array_lower_bound(struct HarbolArray const *const vec, void const *const key, size_t const datasize, HarbolCmpFunc *const cmp) {
+	size_t lo = 0, hi = (vec->table==NULL)? 0 : vec->len;
+	while( lo < hi ) {
+		size_t const mid = lo + ((hi - lo) >> 1);
+		if( (*cmp)(ELEM(vec->table, mid), key) < 0 ) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	return lo;
+}
+
+HARBOL_EXPORT size_t harbol_array_upper_bound(struct HarbolArray const *const vec, void const *const key, size_t const datasize, HarbolCmpFunc *const cmp) {
+	size_t lo = 0, hi = (vec->table==NULL)? 0 : vec->len;
+	while( lo < hi ) {
+		size_t const mid = lo + ((hi - lo) >> 1);
+		if( (*cmp)(key, ELEM(vec->table, mid)) >= 0 ) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	return lo;
+}
+
+HARBOL_EXPORT size_t harbol_array_bsearch(struct HarbolArray const *const vec, void const *const key, size_t const datasize, HarbolCmpFunc *const cmp) {
+	size_t const index = harbol_array_lower_bound(vec, key, datasize, cmp);
+	return( index < vec->len && (*cmp)(ELEM(vec->table, index), key)==0 )? index : SIZE_MAX;
+}
+
+
+/// fixed-width scanners, 32 bytes at a time where the compiler has vector extensions.
+#if defined(COMPILER_GCC) || defined(COMPILER_CLANG)
+#	define HARBOL_ALGO_SCANNERS(bits, T) \
+	typedef T _harbol_vec##bits SIMD_VEC(32); \
+	enum { _harbol_lanes##bits = 32 / sizeof(T) }; \
+	static size_t _harbol_find##bits(uint8_t const *const table, size_t i, size_t const len, T const needle) { \
+		_harbol_vec##bits const splat = (( _harbol_vec##bits ){0}) + needle; \
+		for( ; i + _harbol_lanes##bits <= len; i += _harbol_lanes##bits ) { \
+			_harbol_vec##bits v; memcpy(&v, &table[i * sizeof(T)], sizeof v); \
+			__typeof__(v==splat) const m = (v==splat); \
+			uint64_t words[4]; memcpy(words, &m, sizeof words); \
+			if( (words[0] | words[1] | words[2] | words[3])==0 ) { \
+				continue; \
+			} \
+			for( size_t k=0; k < _harbol_lanes##bits; k++ ) { \
+				if( m[k] ) { \
+					return i + k; \
+				} \
+			} \
+		} \
+		for( ; i < len; i++ ) { \
+			T x; memcpy(&x, &table[i * sizeof(T)], sizeof x); \
+			if( x==needle ) { \
+				return i; \
+			} \
+		} \
+		return SIZE_MAX; \
+	} \
+	static size_t _harbol_count##bits(uint8_t const *const table, size_t const len, T const needle) { \
+		_harbol_vec##bits const splat = (( _harbol_vec##bits ){0}) + needle; \
+		__typeof__(splat==splat) acc = (splat != splat); \
+		size_t count = 0, i = 0, blocks = 0; \
+		for( ; i + _harbol_lanes##bits <= len; i += _harbol_lanes##bits ) { \
+			_harbol_vec##bits v; memcpy(&v, &table[i * sizeof(T)], sizeof v); \
+			acc -= (v==splat); \
+			/** flush before the narrowest lanes can overflow. */ \
+			if( ++blocks==64 ) { \
+				for( size_t k=0; k < _harbol_lanes##bits; k++ ) { \
+					count += ( size_t )(acc[k]); \
+				} \
+				acc -= acc; \
+				blocks = 0; \
+			} \
+		} \
+		for( size_t k=0; k < _harbol_lanes##bits; k++ ) { \
+			count += ( size_t )(acc[k]); \
+		} \
+		for( ; i < len; i++ ) { \
+			T x; memcpy(&x, &table[i * sizeof(T)], sizeof x); \
+			count += x==needle; \
+		} \
+		return count; \
+	}
+#else
+#	define HARBOL_ALGO_SCANNERS(bits, T) \
+	static size_t _harbol_find##bits(uint8_t const *const table, size_t i, size_t const len, T const needle) { \
+		for( ; i < len; i++ ) { \
+			T x; memcpy(&x, &table[i * sizeof(T)], sizeof x); \
+			if( x==needle ) { \
+				return i; \
+			} \
+		} \
+		return SIZE_MAX; \
+	} \
+	static size_t _harbol_count##bits(uint8_t const *const table, size_t const len, T const needle) { \
+		size_t count = 0; \
+		for( size_t i=0; i < len; i++ ) { \
+			T x; memcpy(&x, &table[i * sizeof(T)], sizeof x); \
+			count += x==needle; \
+		} \
+		return count; \
+	}
+#endif
+
+HARBOL_ALGO_SCANNERS(8, uint8_t)
+HARBOL_ALGO_SCANNERS(16, uint16_t)
+HARBOL_ALGO_SCANNERS(32, uint32_t)
+HARBOL_ALGO_SCANNERS(64, uint64_t)
+
+HARBOL_EXPORT size_t harbol_array_find(struct HarbolArray const *const vec, void const *const val, size_t const datasize, size_t const starting_index) {
+	if( vec->table==NULL || starting_index >= vec->len ) {
+		return SIZE_MAX;
+	}
+	switch( datasize ) {
+		case sizeof(uint8_t):  { uint8_t  n; memcpy(&n, val, sizeof n); return _harbol_find8(vec->table, starting_index, vec->len, n); }
+		case sizeof(uint16_t): { uint16_t n; memcpy(&n, val, sizeof n); return _harbol_find16(vec->table, starting_index, vec->len, n); }
+		case sizeof(uint32_t): { uint32_t n; memcpy(&n, val, sizeof n); return _harbol_find32(vec->table, starting_index, vec->len, n); }
+		case sizeof(uint64_t): { uint64_t n; memcpy(&n, val, sizeof n); return _harbol_find64(vec->table, starting_index, vec->len, n); }
+		default:
+			return harbol_array_index_of(vec, val, datasize, starting_index);
+	}
+}
+
+HARBOL_EXPORT size_t harbol_array_count(struct HarbolArray const *const vec, void const *const val, size_t const datasize) {
+	if( vec->table==NULL ) {
+		return 0;
+	}
+	switch( datasize ) {
+		case sizeof(uint8_t):  { uint8_t  n; memcpy(&n, val, sizeof n); return _harbol_count8(vec->table, vec->len, n); }
+		case sizeof(uint16_t): { uint16_t n; memcpy(&n, val, sizeof n); return _harbol_count16(vec->table, vec->len, n); }
+		case sizeof(uint32_t): { uint32_t n; memcpy(&n, val, sizeof n); return _harbol_count32(vec->table, vec->len, n); }
+		case sizeof(uint64_t): { uint64_t n; memcpy(&n, val, sizeof n); return _harbol_count64(vec->table, vec->len, n); }
+		default:
+			return harbol_array_item_count(vec, val, datasize);
+	}
+}
+
+
+HARBOL_EXPORT size_t harbol_array_count_if(struct HarbolArray const *const vec, size_t const datasize, HarbolPredFunc *const pred, void *const userdata) {
+	size_t count = 0;
+	for( size_t i=0; vec->table != NULL && i < vec->len; i++ ) {
+		count += (*pred)(ELEM(vec->table, i), userdata);
+	}
+	return count;
+}
+
+HARBOL_EXPORT size_t harbol_array_find_if(struct HarbolArray const *const vec, size_t const datasize, HarbolPredFunc *const pred, void *const userdata) {
+	for( size_t i=0; vec->table != NULL && i < vec->len; i++ ) {
+		if( (*pred)(ELEM(vec->table, i), userdata) ) {
+			return i;
+		}
+	}
+	return SIZE_MAX;
+}
+
+HARBOL_EXPORT size_t harbol_array_stable_partition(struct HarbolArray *const vec, size_t const datasize, HarbolPredFunc *const pred, void *const userdata) {
+	if( vec->table==NULL || vec->len==0 ) {
+		return 0;
+	}
+	
+	uint8_t *const rejects = malloc(vec->len * datasize);
+	if( rejects==NULL ) {
+		return SIZE_MAX;
+	}
+	size_t kept = 0, rejected = 0;
+	for( size_t i=0; i < vec->len; i++ ) {
+		uint8_t *const elem = ELEM(vec->table, i);
+		if( (*pred)(elem, userdata) ) {
+			if( kept != i ) {
+				memcpy(ELEM(vec->table, kept), elem, datasize);
+			}
+			kept++;
+		} else {
+			memcpy(ELEM(rejects, rejected++), elem, datasize);
+		}
+	}
+	memcpy(ELEM(vec->table, kept), rejects, rejected * datasize);
+	free(rejects);
+	return kept;
+}
+
+HARBOL_EXPORT size_t harbol_array_dedupe(struct HarbolArray *const vec, size_t const datasize, HarbolCmpFunc *const cmp) {
+	if( vec->table==NULL || vec->len < 2 ) {
+		return vec->len;
+	}
+	
+	size_t out = 1;
+	for( size_t i=1; i < vec->len; i++ ) {
+		uint8_t const *const elem = ELEM(vec->table, i);
+		uint8_t const *const last = ELEM(vec->table, out - 1);
+		bool const same = (cmp != NULL)? (*cmp)(last, elem)==0 : !memcmp(last, elem, datasize);
+		if( !same ) {
+			if( out != i ) {
+				memcpy(ELEM(vec->table, out), elem, datasize);
+			}
+			out++;
+		}
+	}
+	memset(ELEM(vec->table, out), 0, (vec->len - out) * datasize);
+	vec->len = out;
+	return out;
+}
+
+
+/// parallel helpers.
+struct HarbolAlgoTask {
+	uint8_t       *table, *dst;
+	void const    *val;
+	HarbolCmpFunc *cmp;
+	size_t         lo, mid, hi, datasize, result;
+};
+
+static size_t _harbol_algo_split(struct HarbolArray const *const vec, struct HarbolThreadPool *const pool) {
+	if( pool==NULL || vec->table==NULL || vec->len < HARBOL_ALGO_PAR_THRESHOLD || harbol_threadpool_size(pool) < 2 ) {
+		return 1;
+	}
+	return harbol_threadpool_size(pool);
+}
+
+static NEVER_NULL(1) struct HarbolAlgoTask *_harbol_algo_tasks(struct HarbolArray const *const vec, size_t const chunks, size_t const datasize, void const *const val, HarbolCmpFunc *const cmp) {
+	struct HarbolAlgoTask *const tasks = calloc(chunks, sizeof *tasks);
+	if( tasks==NULL ) {
+		return NULL;
+	}
+	size_t const step = vec->len / chunks;
+	for( size_t i=0; i < chunks; i++ ) {
+		tasks[i] = ( struct HarbolAlgoTask ){
+			.table    = vec->table,
+			.val      = val,
+			.cmp      = cmp,
+			.lo       = i * step,
+			.hi       = (i + 1==chunks)? vec->len : (i + 1) * step,
+			.datasize = datasize,
+		};
+	}
+	return tasks;
+}
+
+static void _harbol_algo_count_task(void *const arg) {
+	struct HarbolAlgoTask *const task = arg;
+	size_t const datasize = task->datasize;
+	struct HarbolArray const view = harbol_array_make_from_array(ELEM(task->table, task->lo), task->hi - task->lo, task->hi - task->lo);
+	task->result = harbol_array_count(&view, task->val, datasize);
+}
+
+static void _harbol_algo_find_task(void *const arg) {
+	struct HarbolAlgoTask *const task = arg;
+	size_t const datasize = task->datasize;
+	struct HarbolArray const view = harbol_array_make_from_array(ELEM(task->table, task->lo), task->hi - task->lo, task->hi - task->lo);
+	size_t const index = harbol_array_find(&view, task->val, datasize, 0);
+	task->result = (index==SIZE_MAX)? SIZE_MAX : index + task->lo;
+}
+
+static void _harbol_algo_sort_task(void *const arg) {
+	struct HarbolAlgoTask *const task = arg;
+	size_t const datasize = task->datasize;
+	struct HarbolArray view = harbol_array_make_from_array(ELEM(task->table, task->lo), task->hi - task->lo, task->hi - task->lo);
+	harbol_array_sort(&view, datasize, task->cmp);
+}
+
+/// stable merge of [lo, mid) and [mid, hi) from 'table' into 'dst'.
+static void _harbol_algo_merge_task(void *const arg) {
+	struct HarbolAlgoTask *const task = arg;
+	size_t const datasize = task->datasize;
+	size_t a = task->lo, b = task->mid, out = task->lo;
+	while( a < task->mid && b < task->hi ) {
+		if( (*task->cmp)(ELEM(task->table, b), ELEM(task->table, a)) < 0 ) {
+			memcpy(ELEM(task->dst, out++), ELEM(task->table, b++), datasize);
+		} else {
+			memcpy(ELEM(task->dst, out++), ELEM(task->table, a++), datasize);
+		}
+	}
+	memcpy(ELEM(task->dst, out), ELEM(task->table, a), (task->mid - a) * datasize);
+	out += task->mid - a;
+	memcpy(ELEM(task->dst, out), ELEM(task->table, b), (task->hi - b) * datasize);
+}
+
+static NO_NULL void _harbol_algo_run(struct HarbolThreadPool *const pool, HarbolTaskFunc *const func, struct HarbolAlgoTask *const tasks, size_t const count) {
+	for( size_t i=0; i < count; i++ ) {
+		if( !harbol_threadpool_submit(pool, func, &tasks[i]) ) {
+			(*func)(&tasks[i]);
+		}
+	}
+	harbol_threadpool_wait(pool);
+}
+
+HARBOL_EXPORT bool harbol_array_par_sort(struct HarbolArray *const vec, size_t const datasize, HarbolCmpFunc *const cmp, struct HarbolThreadPool *const pool) {
+	size_t chunks = _harbol_algo_split(vec, pool);
+	if( chunks < 2 ) {
+		harbol_array_sort(vec, datasize, cmp);
+		return true;
+	}
+	
+	uint8_t *const tmp = malloc(vec->len * datasize);
+	struct HarbolAlgoTask *const tasks = _harbol_algo_tasks(vec, chunks, datasize, NULL, cmp);
+	if( tmp==NULL || tasks==NULL ) {
+		free(tmp); free(tasks);
+		return false;
+	}
+	_harbol_algo_run(pool, _harbol_algo_sort_task, tasks, chunks);
+	
+	/// pairwise merge rounds, each round's merges run side by side.
+	uint8_t *src = vec->table, *dst = tmp;
+	while( chunks > 1 ) {
+		size_t const pairs = chunks >> 1;
+		for( size_t i=0; i < pairs; i++ ) {
+			struct HarbolAlgoTask const left = tasks[i << 1], right = tasks[(i << 1) + 1];
+			tasks[i] = ( struct HarbolAlgoTask ){
+				.table    = src,
+				.dst      = dst,
+				.cmp      = cmp,
+				.lo       = left.lo,
+				.mid      = right.lo,
+				.hi       = right.hi,
+				.datasize = datasize,
+			};
+		}
+		/// an odd run out is carried over by a degenerate merge.
+		if( chunks & 1 ) {
+			struct HarbolAlgoTask const last = tasks[chunks - 1];
+			tasks[pairs] = ( struct HarbolAlgoTask ){
+				.table    = src,
+				.dst      = dst,
+				.cmp      = cmp,
+				.lo       = last.lo,
+				.mid      = last.hi,
+				.hi       = last.hi,
+				.datasize = datasize,
+			};
+		}
+		chunks = pairs + (chunks & 1);
+		_harbol_algo_run(pool, _harbol_algo_merge_task, tasks, chunks);
+		uint8_t *const t = src; src = dst; dst = t;
+	}
+	if( src != vec->table ) {
+		memcpy(vec->table, src, vec->len * datasize);
+	}
+	free(tasks);
+	free(tmp);
+	return true;
+}
+
+HARBOL_EXPORT size_t harbol_array_par_count(struct HarbolArray const *const vec, void const *const val, size_t const datasize, struct HarbolThreadPool *const pool) {
+	size_t const chunks = _harbol_algo_split(vec, pool);
+	struct HarbolAlgoTask *const tasks = (chunks < 2)? NULL : _harbol_algo_tasks(vec, chunks, datasize, val, NULL);
+	if( tasks==NULL ) {
+		return harbol_array_count(vec, val, datasize);
+	}
+	_harbol_algo_run(pool, _harbol_algo_count_task, tasks, chunks);
+	size_t count = 0;
+	for( size_t i=0; i < chunks; i++ ) {
+		count += tasks[i].result;
+	}
+	free(tasks);
+	return count;
+}
+
+HARBOL_EXPORT size_t harbol_array_par_index_of(struct HarbolArray const *const vec, void const *const val, size_t const datasize, struct HarbolThreadPool *const pool) {
+	size_t const chunks = _harbol_algo_split(vec, pool);
+	struct HarbolAlgoTask *const tasks = (chunks < 2)? NULL : _harbol_algo_tasks(vec, chunks, datasize, val, NULL);
+	if( tasks==NULL ) {
+		return harbol_array_find(vec, val, datasize, 0);
+	}
+	_harbol_algo_run(pool, _harbol_algo_find_task, tasks, chunks);
+	size_t index = SIZE_MAX;
+	for( size_t i=0; i < chunks && index==SIZE_MAX; i++ ) {
+		index = tasks[i].result;
+	}
+	free(tasks);
+	return index;
+}
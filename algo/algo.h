@@ -0,0 +1,59 @@
+#ifndef HARBOL_ALGO_INCLUDED
+#	define HARBOL_ALGO_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "../harbol_common_defines.h"
+#include "../harbol_common_includes.h"
+#include "../array/array.h"
+#include "../threadpool/threadpool.h"
+
+
+/// arrays shorter than this run the parallel funcs serially.
+#ifndef HARBOL_ALGO_PAR_THRESHOLD
+#	define HARBOL_ALGO_PAR_THRESHOLD    (1 << 15)
+#endif
+
+typedef int  HarbolCmpFunc(void const *a, void const *b);
+typedef bool HarbolPredFunc(void const *elem, void *userdata);
+
+
+/// sorting.
+HARBOL_EXPORT NO_NULL void harbol_array_sort(struct HarbolArray *vec, size_t datasize, HarbolCmpFunc *cmp);
+
+/// stable LSD sort on an unsigned or signed integer key of 'key_size' bytes (1, 2, 4 or 8) inside each element.
+HARBOL_EXPORT NO_NULL bool harbol_array_radix_sort(struct HarbolArray *vec, size_t datasize, size_t key_offset, size_t key_size, bool is_signed);
+
+/// searching a sorted array, returns SIZE_MAX if not found.
+HARBOL_EXPORT NO_NULL size_t harbol_array_bsearch(struct HarbolArray const *vec, void const *key, size_t datasize, HarbolCmpFunc *cmp);
+HARBOL_EXPORT NO_NULL size_t harbol_array_lower_bound(struct HarbolArray const *vec, void const *key, size_t datasize, HarbolCmpFunc *cmp);
+HARBOL_EXPORT NO_NULL size_t harbol_array_upper_bound(struct HarbolArray const *vec, void const *key, size_t datasize, HarbolCmpFunc *cmp);
+
+/// vectorized bytewise scans for 1, 2, 4 and 8 byte elements, generic memcmp otherwise.
+HARBOL_EXPORT NO_NULL size_t harbol_array_find(struct HarbolArray const *vec, void const *val, size_t datasize, size_t starting_index);
+HARBOL_EXPORT NO_NULL size_t harbol_array_count(struct HarbolArray const *vec, void const *val, size_t datasize);
+
+/// predicates.
+HARBOL_EXPORT NEVER_NULL(1, 3) size_t harbol_array_count_if(struct HarbolArray const *vec, size_t datasize, HarbolPredFunc *pred, void *userdata);
+HARBOL_EXPORT NEVER_NULL(1, 3) size_t harbol_array_find_if(struct HarbolArray const *vec, size_t datasize, HarbolPredFunc *pred, void *userdata);
+
+/// moves matching elements in front, keeping relative order, returns the split index or SIZE_MAX.
+HARBOL_EXPORT NEVER_NULL(1, 3) size_t harbol_array_stable_partition(struct HarbolArray *vec, size_t datasize, HarbolPredFunc *pred, void *userdata);
+
+/// removes adjacent duplicates, bytewise if 'cmp' is NULL; returns the new length.
+HARBOL_EXPORT NEVER_NULL(1) size_t harbol_array_dedupe(struct HarbolArray *vec, size_t datasize, HarbolCmpFunc *cmp);
+
+/// parallel variants, 'pool' may be NULL to run serially.
+HARBOL_EXPORT NEVER_NULL(1, 3) bool harbol_array_par_sort(struct HarbolArray *vec, size_t datasize, HarbolCmpFunc *cmp, struct HarbolThreadPool *pool);
+HARBOL_EXPORT NEVER_NULL(1, 2) size_t harbol_array_par_count(struct HarbolArray const *vec, void const *val, size_t datasize, struct HarbolThreadPool *pool);
+HARBOL_EXPORT NEVER_NULL(1, 2) size_t harbol_array_par_index_of(struct HarbolArray const *vec, void const *val, size_t datasize, struct HarbolThreadPool *pool);
+/********************************************************************/
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /** HARBOL_ALGO_INCLUDED */
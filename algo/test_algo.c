@@ -0,0 +1,197 @@
+#define _POSIX_C_SOURCE 200809L
+#include <assert.h>
+#include <stddef.h>
+#include <time.h>
+#include "algo.h"
+
+void test_harbol_algo(FILE *debug_stream);
+
+#ifdef HARBOL_USE_MEMPOOL
+struct HarbolMemPool *g_pool;
+#endif
+
+int main(void) {
+	FILE *debug_stream = fopen("harbol_algo_output.txt", "w");
+	if( debug_stream==NULL )
+		return -1;
+	
+#ifdef HARBOL_USE_MEMPOOL
+	struct HarbolMemPool m = harbol_mempool_create(1000000);
+	g_pool = &m;
+#endif
+	test_harbol_algo(debug_stream);
+	
+	fclose(debug_stream); debug_stream=NULL;
+#ifdef HARBOL_USE_MEMPOOL
+	harbol_mempool_clear(g_pool);
+#endif
+}
+
+struct Record {
+	int32_t  key;
+	uint32_t order;
+};
+
+static uint32_t g_rng = 0x9E3779B9u;
+static uint32_t next_rand(void) {
+	g_rng ^= g_rng << 13;
+	g_rng ^= g_rng >> 17;
+	g_rng ^= g_rng << 5;
+	return g_rng;
+}
+
+static int cmp_i32(void const *const a, void const *const b) {
+	int32_t const x = *( int32_t const* )(a), y = *( int32_t const* )(b);
+	return (x > y) - (x < y);
+}
+
+static bool is_even(void const *const elem, void *const userdata) {
+	(void)(userdata);
+	return (*( int32_t const* )(elem) & 1)==0;
+}
+
+static bool is_sorted_i32(struct HarbolArray const *const vec) {
+	int32_t const *const table = ( int32_t const* )(vec->table);
+	for( size_t i=1; i < vec->len; i++ ) {
+		if( table[i - 1] > table[i] ) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static double wall_seconds(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+void test_harbol_algo(FILE *const debug_stream) {
+	fputs("algo :: test introsort.\n", debug_stream);
+	{
+		struct HarbolArray vec = {0};
+		for( size_t i=0; i < 10000; i++ ) {
+			harbol_array_insert(&vec, &( int32_t ){ ( int32_t )(next_rand() % 1000) - 500 }, sizeof(int32_t));
+		}
+		harbol_array_sort(&vec, sizeof(int32_t), cmp_i32);
+		assert( is_sorted_i32(&vec) );
+		
+		/// all equal and already-sorted inputs.
+		harbol_array_fill(&vec, &( int32_t ){7}, sizeof(int32_t));
+		harbol_array_sort(&vec, sizeof(int32_t), cmp_i32);
+		assert( is_sorted_i32(&vec) );
+		for( size_t i=0; i < vec.len; i++ ) {
+			harbol_array_set(&vec, i, &( int32_t ){ ( int32_t )(vec.len - i) }, sizeof(int32_t));
+		}
+		harbol_array_sort(&vec, sizeof(int32_t), cmp_i32);
+		assert( is_sorted_i32(&vec) && *( int32_t const* )(harbol_array_get(&vec, 0, sizeof(int32_t)))==1 );
+		
+		fputs("\nalgo :: test searching.\n", debug_stream);
+		int32_t const key = 42;
+		size_t const found = harbol_array_bsearch(&vec, &key, sizeof key, cmp_i32);
+		assert( found != SIZE_MAX && *( int32_t const* )(harbol_array_get(&vec, found, sizeof key))==key );
+		assert( harbol_array_bsearch(&vec, &( int32_t ){-5}, sizeof key, cmp_i32)==SIZE_MAX );
+		assert( harbol_array_lower_bound(&vec, &( int32_t ){0}, sizeof key, cmp_i32)==0 );
+		assert( harbol_array_upper_bound(&vec, &key, sizeof key, cmp_i32)==42 );
+		fprintf(debug_stream, "index of %" PRIi32 ": %zu\n", key, found);
+		harbol_array_clear(&vec);
+	}
+	
+	fputs("\nalgo :: test radix sort.\n", debug_stream);
+	{
+		struct HarbolArray vec = {0};
+		for( uint32_t i=0; i < 5000; i++ ) {
+			struct Record const r = { .key = ( int32_t )(next_rand() % 200) - 100, .order = i };
+			harbol_array_insert(&vec, &r, sizeof r);
+		}
+		assert( harbol_array_radix_sort(&vec, sizeof(struct Record), offsetof(struct Record, key), sizeof(int32_t), true) );
+		struct Record const *const recs = ( struct Record const* )(vec.table);
+		for( size_t i=1; i < vec.len; i++ ) {
+			assert( recs[i - 1].key <= recs[i].key );
+			/// stable.
+			assert( recs[i - 1].key != recs[i].key || recs[i - 1].order < recs[i].order );
+		}
+		fprintf(debug_stream, "radix min: %" PRIi32 " | max: %" PRIi32 "\n", recs[0].key, recs[vec.len - 1].key);
+		assert( !harbol_array_radix_sort(&vec, sizeof(struct Record), 6, 4, false) );
+		harbol_array_clear(&vec);
+	}
+	
+	fputs("\nalgo :: test vectorized find/count.\n", debug_stream);
+	{
+		struct HarbolArray bytes = {0}, words = {0}, quads = {0};
+		for( size_t i=0; i < 1000; i++ ) {
+			harbol_array_insert(&bytes, &( uint8_t ){ ( uint8_t )(i % 7) }, sizeof(uint8_t));
+			harbol_array_insert(&words, &( uint32_t ){ ( uint32_t )(i % 13) }, sizeof(uint32_t));
+			harbol_array_insert(&quads, &( uint64_t ){ ( uint64_t )(i) << 33 }, sizeof(uint64_t));
+		}
+		assert( harbol_array_count(&bytes, &( uint8_t ){3}, 1)==harbol_array_item_count(&bytes, &( uint8_t ){3}, 1) );
+		assert( harbol_array_count(&words, &( uint32_t ){12}, 4)==harbol_array_item_count(&words, &( uint32_t ){12}, 4) );
+		assert( harbol_array_find(&words, &( uint32_t ){5}, 4, 100)==harbol_array_index_of(&words, &( uint32_t ){5}, 4, 100) );
+		assert( harbol_array_find(&quads, &( uint64_t ){ 999ull << 33 }, 8, 0)==999 );
+		assert( harbol_array_find(&quads, &( uint64_t ){1}, 8, 0)==SIZE_MAX );
+		assert( harbol_array_count(&quads, &( uint64_t ){0}, 8)==1 );
+		harbol_array_clear(&bytes);
+		harbol_array_clear(&words);
+		harbol_array_clear(&quads);
+	}
+	
+	fputs("\nalgo :: test partition and dedupe.\n", debug_stream);
+	{
+		struct HarbolArray vec = {0};
+		int32_t const vals[] = { 1, 2, 2, 3, 4, 4, 4, 5, 6, 6 };
+		harbol_array_append_n(&vec, vals, sizeof vals[0], sizeof vals / sizeof vals[0]);
+		size_t const split = harbol_array_stable_partition(&vec, sizeof(int32_t), is_even, NULL);
+		assert( split==7 );
+		int32_t const parted[] = { 2, 2, 4, 4, 4, 6, 6, 1, 3, 5 };
+		assert( !memcmp(vec.table, parted, sizeof parted) );
+		assert( harbol_array_count_if(&vec, sizeof(int32_t), is_even, NULL)==7 );
+		assert( harbol_array_find_if(&vec, sizeof(int32_t), is_even, NULL)==0 );
+		
+		assert( harbol_array_dedupe(&vec, sizeof(int32_t), NULL)==6 );
+		int32_t const deduped[] = { 2, 4, 6, 1, 3, 5 };
+		assert( !memcmp(vec.table, deduped, sizeof deduped) );
+		for( size_t i=0; i < vec.len; i++ ) {
+			fprintf(debug_stream, "vec[%zu] == %" PRIi32 "\n", i, *( int32_t const* )(harbol_array_get(&vec, i, sizeof(int32_t))));
+		}
+		harbol_array_clear(&vec);
+	}
+	
+	fputs("\nalgo :: test parallel algorithms.\n", debug_stream);
+	{
+		struct HarbolThreadPool *pool = harbol_threadpool_new(4);
+		assert( pool != NULL );
+		
+		enum { PAR_LEN = 1 << 21 };
+		struct HarbolArray vec = {0}, ref = {0};
+		harbol_array_reserve(&vec, sizeof(int32_t), PAR_LEN);
+		for( size_t i=0; i < PAR_LEN; i++ ) {
+			harbol_array_insert(&vec, &( int32_t ){ ( int32_t )(next_rand() >> 1) }, sizeof(int32_t));
+		}
+		harbol_array_reserve(&ref, sizeof(int32_t), PAR_LEN);
+		harbol_array_append_n(&ref, vec.table, sizeof(int32_t), vec.len);
+		
+		/// wall time, cpu time adds up every worker's share and hides the speedup.
+		double start = wall_seconds();
+		harbol_array_sort(&ref, sizeof(int32_t), cmp_i32);
+		double end = wall_seconds();
+		printf("algo serial sort time: %f\n", end - start);
+		
+		start = wall_seconds();
+		assert( harbol_array_par_sort(&vec, sizeof(int32_t), cmp_i32, pool) );
+		end = wall_seconds();
+		printf("algo parallel sort time (%zu workers): %f\n", harbol_threadpool_size(pool), end - start);
+		assert( is_sorted_i32(&vec) && !memcmp(vec.table, ref.table, vec.len * sizeof(int32_t)) );
+		
+		int32_t const needle = *( int32_t const* )(harbol_array_get(&vec, PAR_LEN / 2, sizeof(int32_t)));
+		assert( harbol_array_par_count(&vec, &needle, sizeof needle, pool)==harbol_array_item_count(&vec, &needle, sizeof needle) );
+		assert( harbol_array_par_index_of(&vec, &needle, sizeof needle, pool)==harbol_array_index_of(&vec, &needle, sizeof needle, 0) );
+		assert( harbol_array_par_index_of(&vec, &( int32_t ){-1}, sizeof needle, pool)==SIZE_MAX );
+		
+		/// no pool degrades to the serial path.
+		assert( harbol_array_par_count(&vec, &needle, sizeof needle, NULL)==harbol_array_count(&vec, &needle, sizeof needle) );
+		
+		harbol_array_clear(&vec);
+		harbol_array_clear(&ref);
+		harbol_threadpool_free(&pool);
+	}
+}
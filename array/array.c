@@ -20,6 +20,29 @@ static NO_NULL bool harbol_array_resizer(struct HarbolArray *const restrict vec,
 	return true;
 }
 
+static NO_NULL bool _harbol_array_reserve_extra(struct HarbolArray *const restrict vec, size_t const amount, size_t const datasize) {
+	if( vec->table != NULL && amount <= vec->cap - vec->len ) {
+		return true;
+	} else if( vec->borrowed || datasize==0 || amount > (SIZE_MAX / datasize) - vec->len ) {
+		return false;
+	}
+	
+	size_t const needed = vec->len + amount;
+	size_t const limit  = SIZE_MAX / datasize;
+	size_t new_cap = (vec->cap < ARRAY_DEFAULT_SIZE)? ARRAY_DEFAULT_SIZE : vec->cap;
+	while( new_cap < needed ) {
+		/// saturate instead of wrapping, the exact size still fits.
+		if( new_cap > limit / 2 ) {
+			new_cap = needed;
+			break;
+		}
+		/// a factor too small to move the capacity falls back to doubling so appends stay amortized O(1).
+		size_t const grown = ( size_t )(new_cap * HARBOL_ARRAY_GROWTH_FACTOR);
+		new_cap = (grown > new_cap && grown <= limit)? grown : new_cap << 1;
+	}
+	return harbol_array_resizer(vec, new_cap, datasize);
+}
+
 
 HARBOL_EXPORT bool harbol_array_init(struct HarbolArray *const vec, size_t const datasize, size_t const init_size) {
 	harbol_array_resizer(vec, (init_size < ARRAY_DEFAULT_SIZE? ARRAY_DEFAULT_SIZE : init_size), datasize);
@@ -33,7 +56,7 @@ HARBOL_EXPORT struct HarbolArray harbol_array_make(size_t const datasize, size_t
 }
 
 HARBOL_EXPORT struct HarbolArray harbol_array_make_from_array(void *const buf, size_t const cap, size_t const len) {
-	return( struct HarbolArray ){ .table = buf, .cap = cap, .len = len };
+	return( struct HarbolArray ){ .table = buf, .cap = cap, .len = len, .borrowed = true };
 }
 
 /// creator funcs.
@@ -56,8 +79,10 @@ HARBOL_EXPORT struct HarbolArray *harbol_array_new_from_array(void *const buf, s
 
 /// clean up funcs.
 HARBOL_EXPORT void harbol_array_clear(struct HarbolArray *const vec) {
-	free(vec->table); vec->table = NULL;
-	vec->cap = vec->len = 0;
+	if( !vec->borrowed ) {
+		free(vec->table);
+	}
+	*vec = ( struct HarbolArray ){0};
 }
 HARBOL_EXPORT void harbol_array_free(struct HarbolArray **const vecref) {
 	free(*vecref); *vecref = NULL;
@@ -93,6 +118,14 @@ HARBOL_EXPORT bool harbol_array_resize(struct HarbolArray *const vec, size_t con
 	harbol_array_resizer(vec, (vec->cap==0 || new_cap==0? ARRAY_DEFAULT_SIZE : next_pow_of_2(new_cap)), datasize);
 	return vec->cap != old_cap;
 }
+HARBOL_EXPORT bool harbol_array_reserve(struct HarbolArray *const vec, size_t const datasize, size_t const new_cap) {
+	if( new_cap <= vec->cap && vec->table != NULL ) {
+		return true;
+	} else if( vec->borrowed || datasize==0 || new_cap > SIZE_MAX / datasize ) {
+		return false;
+	}
+	return harbol_array_resizer(vec, new_cap, datasize);
+}
 HARBOL_EXPORT bool harbol_array_shrink(struct HarbolArray *const vec, size_t const datasize, bool const exact_fit) {
 	if( vec->cap <= ARRAY_DEFAULT_SIZE || vec->len==0 ) {
 		return false;
@@ -121,12 +154,12 @@ HARBOL_EXPORT bool harbol_array_full(struct HarbolArray const *const vec) {
 
 /// array to array ops.
 HARBOL_EXPORT bool harbol_array_add(struct HarbolArray *const vecA, struct HarbolArray const *const vecB, size_t const datasize) {
-	if( vecA->table==NULL || vecB->table==NULL || (vecA->len + vecB->len) >= vecA->cap ) {
+	if( vecB->table==NULL ) {
 		return false;
+	} else if( vecB->len==0 ) {
+		return true;
 	}
-	memcpy(&vecA->table[vecA->len * datasize], vecB->table, vecB->len * datasize);
-	vecA->len += vecB->len;
-	return true;
+	return harbol_array_append_n(vecA, vecB->table, datasize, vecB->len) != SIZE_MAX;
 }
 HARBOL_EXPORT bool harbol_array_copy(struct HarbolArray *const vecA, struct HarbolArray const *const vecB, size_t const datasize) {
 	if( vecA==vecB ) {
@@ -148,23 +181,72 @@ HARBOL_EXPORT size_t harbol_array_cap_diff(struct HarbolArray const *const vecA,
 
 
 /// array data ops.
+/// 'val' may point into our own table, 'append_n' keeps its offset across the realloc.
 HARBOL_EXPORT bool harbol_array_insert(struct HarbolArray *const vec, void const *const val, size_t const datasize) {
-	if( vec->table==NULL || vec->len >= vec->cap ) {
-		return false;
-	}
-	memcpy(&vec->table[vec->len++ * datasize], val, datasize);
-	return true;
+	return harbol_array_append_n(vec, val, datasize, 1) != SIZE_MAX;
 }
 HARBOL_EXPORT size_t harbol_array_append(struct HarbolArray *const vec, void const *const val, size_t const datasize) {
-	if( vec->table==NULL || vec->len >= vec->cap ) {
+	return harbol_array_append_n(vec, val, datasize, 1);
+}
+HARBOL_EXPORT size_t harbol_array_append_n(struct HarbolArray *const vec, void const *const vals, size_t const datasize, size_t const count) {
+	uint8_t const *src = vals;
+	bool const aliased = vec->table != NULL && src >= vec->table && src < &vec->table[vec->len * datasize];
+	size_t const src_offs = aliased? ( size_t )(src - vec->table) : 0;
+	if( count==0 ) {
+		return vec->len;
+	} else if( !_harbol_array_reserve_extra(vec, count, datasize) ) {
 		return SIZE_MAX;
 	}
 	
 	size_t const index = vec->len;
-	vec->len++;
-	memcpy(&vec->table[index * datasize], val, datasize);
+	memmove(&vec->table[index * datasize], aliased? &vec->table[src_offs] : src, count * datasize);
+	vec->len += count;
 	return index;
 }
+HARBOL_EXPORT bool harbol_array_insert_range(struct HarbolArray *const vec, size_t const index, void const *const vals, size_t const datasize, size_t const count) {
+	if( index > vec->len ) {
+		return false;
+	} else if( count==0 ) {
+		return true;
+	}
+	
+	/// 'vals' may point into our own table, keep its offset across the realloc.
+	uint8_t const *src = vals;
+	bool const aliased = vec->table != NULL && src >= vec->table && src < &vec->table[vec->len * datasize];
+	size_t const src_offs = aliased? ( size_t )(src - vec->table) : 0;
+	if( !_harbol_array_reserve_extra(vec, count, datasize) ) {
+		return false;
+	}
+	
+	uint8_t *const slot = &vec->table[index * datasize];
+	memmove(&vec->table[(index + count) * datasize], slot, (vec->len - index) * datasize);
+	if( aliased ) {
+		/// anything at or past the insertion point got pushed down by 'count' slots.
+		size_t const bytes = count * datasize;
+		size_t const split = index * datasize;
+		if( src_offs + bytes <= split ) {
+			memcpy(slot, &vec->table[src_offs], bytes);
+		} else if( src_offs >= split ) {
+			memcpy(slot, &vec->table[src_offs + bytes], bytes);
+		} else {
+			size_t const head = split - src_offs;
+			memcpy(slot, &vec->table[src_offs], head);
+			memcpy(&slot[head], &vec->table[split + bytes], bytes - head);
+		}
+	} else {
+		memcpy(slot, src, count * datasize);
+	}
+	vec->len += count;
+	return true;
+}
+HARBOL_EXPORT void *harbol_array_emplace(struct HarbolArray *const vec, size_t const datasize) {
+	if( !_harbol_array_reserve_extra(vec, 1, datasize) ) {
+		return NULL;
+	}
+	uint8_t *const slot = &vec->table[vec->len++ * datasize];
+	memset(slot, 0, datasize);
+	return slot;
+}
 HARBOL_EXPORT bool harbol_array_fill(struct HarbolArray *const vec, void const *const val, size_t const datasize) {
 	if( vec->table==NULL ) {
 		return false;
@@ -11,9 +11,15 @@ extern "C" {
 
 enum { ARRAY_DEFAULT_SIZE = 4 };
 
+/// multiplier used when insertion runs out of room, may be fractional (e.g. 1.5).
+#ifndef HARBOL_ARRAY_GROWTH_FACTOR
+#	define HARBOL_ARRAY_GROWTH_FACTOR    2
+#endif
+
 struct HarbolArray {
 	uint8_t *table;
 	size_t   cap, len;
+	bool     borrowed; /// 'table' was lent through 'make_from_array', insertion fails once it's full instead of growing it.
 };
 
 
@@ -41,6 +47,7 @@ HARBOL_EXPORT NO_NULL size_t harbol_array_len(struct HarbolArray const *const ve
 /// array table ops.
 HARBOL_EXPORT NO_NULL bool harbol_array_grow(struct HarbolArray *const vec, size_t const datasize);
 HARBOL_EXPORT NO_NULL bool harbol_array_resize(struct HarbolArray *const vec, size_t const datasize, size_t const new_cap);
+HARBOL_EXPORT NO_NULL bool harbol_array_reserve(struct HarbolArray *const vec, size_t const datasize, size_t const new_cap);
 HARBOL_EXPORT NO_NULL bool harbol_array_shrink(struct HarbolArray *const vec, size_t const datasize, bool const exact_fit);
 HARBOL_EXPORT NO_NULL void harbol_array_wipe(struct HarbolArray *const vec, size_t const datasize);
 
@@ -56,8 +63,13 @@ HARBOL_EXPORT NO_NULL size_t harbol_array_cap_diff(struct HarbolArray const *con
 
 
 /// array data ops.
+/// insertion grows the table when full.
 HARBOL_EXPORT NO_NULL bool harbol_array_insert(struct HarbolArray *const vec, void const *const val, size_t const datasize);
 HARBOL_EXPORT NO_NULL size_t harbol_array_append(struct HarbolArray *const vec, void const *const val, size_t const datasize);
+/// returns the index of the first appended item, appending nothing succeeds with the current length.
+HARBOL_EXPORT NO_NULL size_t harbol_array_append_n(struct HarbolArray *const vec, void const *const vals, size_t const datasize, size_t const count);
+HARBOL_EXPORT NO_NULL bool harbol_array_insert_range(struct HarbolArray *const vec, size_t const index, void const *const vals, size_t const datasize, size_t const count);
+HARBOL_EXPORT NO_NULL void *harbol_array_emplace(struct HarbolArray *const vec, size_t const datasize);
 HARBOL_EXPORT NO_NULL bool harbol_array_fill(struct HarbolArray *const vec, void const *const val, size_t const datasize);
 
 HARBOL_EXPORT NO_NULL void *harbol_array_pop(struct HarbolArray *const vec, size_t const datasize);
@@ -87,6 +99,109 @@ HARBOL_EXPORT NO_NULL bool harbol_array_del_by_val(struct HarbolArray *const vec
 /********************************************************************/
 
 
+/** type-specialized array funcs.
+ * HARBOL_ARRAY_DECLARE(name, T) generates 'name_insert', 'name_get', etc.
+ * that operate on a 'struct HarbolArray' of 'T' with a compile-time element size.
+ * semantics match the generic funcs, equality is still bytewise.
+ */
+#define HARBOL_ARRAY_DECLARE(name, T) \
+	static inline NEVER_NULL(1) bool name##_init(struct HarbolArray *const vec, size_t const init_size) { \
+		return harbol_array_init(vec, sizeof(T), init_size); \
+	} \
+	static inline NEVER_NULL(1) T *name##_data(struct HarbolArray const *const vec) { \
+		return ( T* )(vec->table); \
+	} \
+	static inline NEVER_NULL(1) bool name##_reserve(struct HarbolArray *const vec, size_t const new_cap) { \
+		return harbol_array_reserve(vec, sizeof(T), new_cap); \
+	} \
+	static inline NEVER_NULL(1) bool name##_insert(struct HarbolArray *const vec, T const val) { \
+		if( vec->len < vec->cap ) { \
+			(( T* )(vec->table))[vec->len++] = val; \
+			return true; \
+		} \
+		return harbol_array_insert(vec, &val, sizeof(T)); \
+	} \
+	static inline NEVER_NULL(1) size_t name##_append(struct HarbolArray *const vec, T const val) { \
+		if( vec->len < vec->cap ) { \
+			(( T* )(vec->table))[vec->len] = val; \
+			return vec->len++; \
+		} \
+		return harbol_array_append(vec, &val, sizeof(T)); \
+	} \
+	static inline NEVER_NULL(1) size_t name##_append_n(struct HarbolArray *const vec, T const vals[const], size_t const count) { \
+		return harbol_array_append_n(vec, vals, sizeof(T), count); \
+	} \
+	static inline NEVER_NULL(1) T *name##_emplace(struct HarbolArray *const vec) { \
+		return harbol_array_emplace(vec, sizeof(T)); \
+	} \
+	static inline NEVER_NULL(1) bool name##_fill(struct HarbolArray *const vec, T const val) { \
+		if( vec->table==NULL ) { \
+			return false; \
+		} \
+		T *const restrict table = ( T* )(vec->table); \
+		for( size_t i=0; i < vec->cap; i++ ) { \
+			table[i] = val; \
+		} \
+		vec->len = vec->cap; \
+		return true; \
+	} \
+	static inline NEVER_NULL(1) T *name##_pop(struct HarbolArray *const vec) { \
+		return( vec->table==NULL || vec->len==0 )? NULL : &(( T* )(vec->table))[--vec->len]; \
+	} \
+	static inline NEVER_NULL(1) bool name##_pop_ex(struct HarbolArray *const vec, T *const val) { \
+		if( vec->table==NULL || vec->len==0 ) { \
+			return false; \
+		} \
+		*val = (( T* )(vec->table))[--vec->len]; \
+		return true; \
+	} \
+	static inline NEVER_NULL(1) T *name##_peek(struct HarbolArray const *const vec) { \
+		return( vec->table==NULL || vec->len==0 )? NULL : &(( T* )(vec->table))[vec->len - 1]; \
+	} \
+	static inline NEVER_NULL(1) T *name##_get(struct HarbolArray const *const vec, size_t const index) { \
+		return( vec->table==NULL || index >= vec->len )? NULL : &(( T* )(vec->table))[index]; \
+	} \
+	static inline NEVER_NULL(1) bool name##_get_ex(struct HarbolArray const *const vec, size_t const index, T *const val) { \
+		if( vec->table==NULL || index >= vec->len ) { \
+			return false; \
+		} \
+		*val = (( T const* )(vec->table))[index]; \
+		return true; \
+	} \
+	static inline NEVER_NULL(1) bool name##_set(struct HarbolArray *const vec, size_t const index, T const val) { \
+		if( vec->table==NULL || index >= vec->len ) { \
+			return false; \
+		} \
+		(( T* )(vec->table))[index] = val; \
+		return true; \
+	} \
+	static inline NEVER_NULL(1) size_t name##_item_count(struct HarbolArray const *const vec, T const val) { \
+		T const *const restrict table = ( T const* )(vec->table); \
+		size_t count = 0; \
+		for( size_t i=0; table != NULL && i < vec->len; i++ ) { \
+			count += !memcmp(&table[i], &val, sizeof(T)); \
+		} \
+		return count; \
+	} \
+	static inline NEVER_NULL(1) size_t name##_index_of(struct HarbolArray const *const vec, T const val, size_t const starting_index) { \
+		T const *const restrict table = ( T const* )(vec->table); \
+		for( size_t i=starting_index; table != NULL && i < vec->len; i++ ) { \
+			if( !memcmp(&table[i], &val, sizeof(T)) ) { \
+				return i; \
+			} \
+		} \
+		return SIZE_MAX; \
+	} \
+	static inline NEVER_NULL(1) bool name##_del_by_index(struct HarbolArray *const vec, size_t const index) { \
+		return harbol_array_del_by_index(vec, index, sizeof(T)); \
+	} \
+	static inline NEVER_NULL(1) bool name##_del_by_val(struct HarbolArray *const vec, T const val) { \
+		size_t const index = name##_index_of(vec, val, 0); \
+		return( index != SIZE_MAX )? harbol_array_del_by_index(vec, index, sizeof(T)) : false; \
+	}
+/********************************************************************/
+
+
 #ifdef __cplusplus
 }
 #endif
@@ -4,6 +4,15 @@
 #include "array.h"
 
 void test_harbol_array(FILE *debug_stream);
+void test_harbol_typed_array(FILE *debug_stream);
+
+struct Vec3 {
+	int32_t x, y, z;
+};
+
+HARBOL_ARRAY_DECLARE(int_array, int32_t)
+HARBOL_ARRAY_DECLARE(ptr_array, void*)
+HARBOL_ARRAY_DECLARE(vec3_array, struct Vec3)
 
 #ifdef HARBOL_USE_MEMPOOL
 struct HarbolMemPool *g_pool;
@@ -23,6 +32,7 @@ int main(void) {
 	g_pool = &m;
 #endif
 	test_harbol_array(debug_stream);
+	test_harbol_typed_array(debug_stream);
 	
 	fclose(debug_stream); debug_stream=NULL;
 #ifdef HARBOL_USE_MEMPOOL
@@ -144,6 +154,70 @@ void test_harbol_array(FILE *const debug_stream) {
 	for( size_t i=0; i<p->len; i++ )
 		fprintf(debug_stream, "post-reversing ptr[%zu] == %" PRIi64 "\n", i, (( union Value const* )harbol_array_get(p, i, sizeof(union Value)))->int64);
 	
+	fputs("\narray :: test growing insertion.\n", debug_stream);
+	{
+		struct HarbolArray g = {0};
+		for( int64_t n=0; n < 100; n++ ) {
+			assert( harbol_array_insert(&g, &( union Value ){.int64=n}, sizeof(union Value)) );
+		}
+		assert( g.len==100 && g.cap >= 100 );
+		fprintf(debug_stream, "grown array len: %zu | cap: %zu\n", g.len, g.cap);
+		
+		union Value const block[] = { {.int64=-1}, {.int64=-2}, {.int64=-3} };
+		assert( harbol_array_append_n(&g, block, sizeof(union Value), 3)==100 );
+		assert( harbol_array_append_n(&g, block, sizeof(union Value), 0)==103 && harbol_array_insert_range(&g, 0, block, sizeof(union Value), 0) );
+		assert( harbol_array_insert_range(&g, 0, block, sizeof(union Value), 3) );
+		assert( g.len==106 );
+		assert( (( union Value const* )harbol_array_get(&g, 0, sizeof(union Value)))->int64==-1 );
+		assert( (( union Value const* )harbol_array_get(&g, 3, sizeof(union Value)))->int64==0 );
+		assert( (( union Value const* )harbol_array_get(&g, 105, sizeof(union Value)))->int64==-3 );
+		
+		/// inserting a slice of itself.
+		assert( harbol_array_insert_range(&g, 1, g.table, sizeof(union Value), 4) );
+		int64_t const expected[] = { -1, -1, -2, -3, 0, -2, -3, 0, 1 };
+		for( size_t n=0; n < sizeof expected / sizeof expected[0]; n++ ) {
+			assert( (( union Value const* )harbol_array_get(&g, n, sizeof(union Value)))->int64==expected[n] );
+		}
+		
+		union Value *const slot = harbol_array_emplace(&g, sizeof(union Value));
+		assert( slot != NULL && slot->int64==0 );
+		slot->int64 = 1234;
+		assert( (( union Value const* )harbol_array_peek(&g, sizeof(union Value)))->int64==1234 );
+		
+		assert( harbol_array_reserve(&g, sizeof(union Value), 1000) && g.cap==1000 );
+		harbol_array_clear(&g);
+		
+		/// appending its own items while it has to grow.
+		assert( harbol_array_insert(&g, &( union Value ){.int64=7}, sizeof(union Value)) );
+		while( !harbol_array_full(&g) ) {
+			assert( harbol_array_insert(&g, g.table, sizeof(union Value)) );
+		}
+		size_t const old_cap = g.cap;
+		assert( harbol_array_insert(&g, harbol_array_get(&g, g.len - 1, sizeof(union Value)), sizeof(union Value)) );
+		assert( g.cap > old_cap );
+		while( !harbol_array_full(&g) ) {
+			assert( harbol_array_append(&g, g.table, sizeof(union Value)) != SIZE_MAX );
+		}
+		assert( harbol_array_append(&g, g.table, sizeof(union Value))==g.len - 1 );
+		for( size_t n=0; n < g.len; n++ ) {
+			assert( (( union Value const* )harbol_array_get(&g, n, sizeof(union Value)))->int64==7 );
+		}
+		harbol_array_clear(&g);
+		
+		/// a lent table is never reallocated, a full one rejects more.
+		union Value lent[4];
+		struct HarbolArray b = harbol_array_make_from_array(lent, 4, 0);
+		for( int64_t n=0; n < 4; n++ ) {
+			assert( harbol_array_insert(&b, &( union Value ){.int64=n}, sizeof(union Value)) );
+		}
+		assert( !harbol_array_insert(&b, &( union Value ){.int64=4}, sizeof(union Value)) );
+		assert( harbol_array_append(&b, &( union Value ){.int64=4}, sizeof(union Value))==SIZE_MAX );
+		assert( harbol_array_emplace(&b, sizeof(union Value))==NULL );
+		assert( !harbol_array_reserve(&b, sizeof(union Value), 8) );
+		assert( b.table==( uint8_t* )(lent) && b.len==4 && b.cap==4 && lent[3].int64==3 );
+		harbol_array_clear(&b);
+		assert( b.table==NULL && !b.borrowed );
+	}
 	
 	/// free data
 	fputs("\narray :: test destruction.\n", debug_stream);
@@ -155,4 +229,92 @@ void test_harbol_array(FILE *const debug_stream) {
 	fprintf(debug_stream, "p's table is null? '%s'\n", p->table != NULL? "no" : "yes");
 	harbol_array_free(&p);
 	fprintf(debug_stream, "p is null? '%s'\n", p != NULL? "no" : "yes");
-}
\ No newline at end of file
+}
+
+enum { BENCH_LEN = 1 << 20, BENCH_SEARCHES = 64 };
+
+#define BENCH_GENERIC_VS_TYPED(label, T, prefix, make_val) \
+	do { \
+		struct HarbolArray g = {0}, t = {0}; \
+		clock_t start = clock(); \
+		for( size_t n=0; n < BENCH_LEN; n++ ) { \
+			T const v = make_val(n); \
+			harbol_array_insert(&g, &v, sizeof(T)); \
+		} \
+		size_t hits = 0; \
+		for( size_t n=0; n < BENCH_SEARCHES; n++ ) { \
+			T const v = make_val(BENCH_LEN - 1 - n); \
+			hits += harbol_array_index_of(&g, &v, sizeof(T), 0) != SIZE_MAX; \
+			hits += harbol_array_item_count(&g, &v, sizeof(T)); \
+		} \
+		clock_t end = clock(); \
+		double const generic_time = (end-start)/(double)CLOCKS_PER_SEC; \
+		\
+		start = clock(); \
+		for( size_t n=0; n < BENCH_LEN; n++ ) { \
+			prefix##_insert(&t, make_val(n)); \
+		} \
+		size_t typed_hits = 0; \
+		for( size_t n=0; n < BENCH_SEARCHES; n++ ) { \
+			T const v = make_val(BENCH_LEN - 1 - n); \
+			typed_hits += prefix##_index_of(&t, v, 0) != SIZE_MAX; \
+			typed_hits += prefix##_item_count(&t, v); \
+		} \
+		end = clock(); \
+		double const typed_time = (end-start)/(double)CLOCKS_PER_SEC; \
+		assert( hits==typed_hits && g.len==t.len && !memcmp(g.table, t.table, g.len * sizeof(T)) ); \
+		printf("array %s: generic time: %f | typed time: %f | speedup: %.2fx\n", label, generic_time, typed_time, typed_time > 0.0? generic_time / typed_time : 0.0); \
+		harbol_array_clear(&g); \
+		harbol_array_clear(&t); \
+	} while( 0 )
+
+#define MAKE_INT(n)     (( int32_t )(n))
+#define MAKE_PTR(n)     (( void* )(( uintptr_t )(n) * 8))
+#define MAKE_VEC3(n)    (( struct Vec3 ){ .x = ( int32_t )(n), .y = ( int32_t )(n) + 1, .z = ( int32_t )(n) * 2 })
+
+void test_harbol_typed_array(FILE *const debug_stream) {
+	fputs("\ntyped array :: test specialized funcs.\n", debug_stream);
+	struct HarbolArray ints = {0};
+	assert( int_array_init(&ints, 2) );
+	for( int32_t n=0; n < 10; n++ ) {
+		assert( int_array_insert(&ints, n % 3) );
+	}
+	assert( ints.len==10 && *int_array_get(&ints, 4)==1 );
+	assert( int_array_item_count(&ints, 0)==4 );
+	assert( int_array_index_of(&ints, 2, 3)==5 );
+	assert( int_array_set(&ints, 0, 42) && *int_array_peek(&ints)==0 );
+	assert( int_array_del_by_val(&ints, 42) && ints.len==9 );
+	
+	int32_t popped = -1;
+	assert( int_array_pop_ex(&ints, &popped) && popped==0 );
+	*int_array_emplace(&ints) = 7;
+	assert( int_array_data(&ints)[ints.len - 1]==7 );
+	for( size_t n=0; n < ints.len; n++ ) {
+		fprintf(debug_stream, "ints[%zu] == %" PRIi32 "\n", n, int_array_data(&ints)[n]);
+	}
+	harbol_array_clear(&ints);
+	
+	struct HarbolArray ptrs = {0};
+	assert( ptr_array_append(&ptrs, NULL)==0 );
+	assert( ptr_array_append(&ptrs, &ptrs)==1 );
+	assert( ptr_array_index_of(&ptrs, &ptrs, 0)==1 && ptr_array_index_of(&ptrs, NULL, 0)==0 );
+	harbol_array_clear(&ptrs);
+	
+	int32_t lent[2];
+	struct HarbolArray lent_ints = harbol_array_make_from_array(lent, 2, 0);
+	assert( int_array_insert(&lent_ints, 1) && int_array_insert(&lent_ints, 2) );
+	assert( !int_array_insert(&lent_ints, 3) && int_array_append(&lent_ints, 3)==SIZE_MAX );
+	assert( lent_ints.table==( uint8_t* )(lent) && lent[1]==2 );
+	
+	struct HarbolArray vecs = {0};
+	struct Vec3 const block[] = { MAKE_VEC3(1), MAKE_VEC3(2), MAKE_VEC3(3) };
+	assert( vec3_array_append_n(&vecs, block, 3)==0 );
+	assert( vec3_array_index_of(&vecs, MAKE_VEC3(3), 0)==2 );
+	assert( vec3_array_get(&vecs, 3)==NULL );
+	harbol_array_clear(&vecs);
+	
+	/// generic runtime datasize vs typed specializations.
+	BENCH_GENERIC_VS_TYPED("int32_t", int32_t, int_array, MAKE_INT);
+	BENCH_GENERIC_VS_TYPED("void*", void*, ptr_array, MAKE_PTR);
+	BENCH_GENERIC_VS_TYPED("struct Vec3", struct Vec3, vec3_array, MAKE_VEC3);
+}
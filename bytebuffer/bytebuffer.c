@@ -2,6 +2,11 @@
 
 #ifdef OS_WINDOWS
 #	define HARBOL_LIB
+#	include <io.h>
+#else
+#	include <errno.h>
+#	include <unistd.h>
+#	include <sys/uio.h>
 #endif
 
 
@@ -49,9 +54,56 @@ static NO_NULL bool _harbol_buffer_resize(struct HarbolByteBuf *const restrict b
 	return true;
 }
 
+/// makes sure there's room for `amount` more bytes, growing geometrically so N appends cost O(log N) reallocs.
+static NO_NULL bool _harbol_buffer_reserve_extra(struct HarbolByteBuf *const restrict buf, size_t const amount) {
+	if( amount > SIZE_MAX - buf->len ) {
+		return false;
+	}
+	size_t const needed = buf->len + amount;
+	if( needed <= buf->cap ) {
+		return true;
+	}
+	size_t new_cap = (buf->cap < HARBOL_BYTEBUFFER_MIN_CAP)? HARBOL_BYTEBUFFER_MIN_CAP : buf->cap;
+	while( new_cap < needed ) {
+		new_cap = (new_cap > SIZE_MAX / 2)? needed : new_cap << 1;
+	}
+	return _harbol_buffer_resize(buf, new_cap);
+}
+
+HARBOL_EXPORT bool harbol_bytebuffer_reserve(struct HarbolByteBuf *const buf, size_t const new_cap) {
+	return( new_cap <= buf->cap )? true : _harbol_buffer_resize(buf, new_cap);
+}
+
+HARBOL_EXPORT bool harbol_bytebuffer_shrink(struct HarbolByteBuf *const buf) {
+	if( buf->len==0 ) {
+		harbol_bytebuffer_clear(buf);
+		return true;
+	} else if( buf->len==buf->cap ) {
+		return true;
+	}
+	return _harbol_buffer_resize(buf, buf->len);
+}
+
+HARBOL_EXPORT uint8_t *harbol_bytebuffer_tail(struct HarbolByteBuf *const buf, size_t const amount) {
+	/// a buffer that never allocated has no end to point at, nothing gets written through it anyway.
+	static uint8_t empty_tail[1];
+	if( amount==0 && buf->table==NULL ) {
+		return empty_tail;
+	}
+	return( !_harbol_buffer_reserve_extra(buf, amount) )? NULL : &buf->table[buf->len];
+}
+
+HARBOL_EXPORT bool harbol_bytebuffer_commit(struct HarbolByteBuf *const buf, size_t const amount) {
+	if( amount > buf->cap - buf->len ) {
+		return false;
+	}
+	buf->len += amount;
+	return true;
+}
+
 #ifndef HARBOL_BYTEBUFFER_INSERTION
 #	define HARBOL_BYTEBUFFER_INSERTION \
-	if( buf->len + sizeof val >= buf->cap && !_harbol_buffer_resize(buf, buf->len + sizeof val) ) \
+	if( !_harbol_buffer_reserve_extra(buf, sizeof val) ) \
 		return false; \
 	\
 	memcpy(&buf->table[buf->len], &val, sizeof val); \
@@ -93,7 +145,7 @@ HARBOL_EXPORT bool harbol_bytebuffer_insert_floatmax(struct HarbolByteBuf *const
 
 HARBOL_EXPORT bool harbol_bytebuffer_insert_cstr(struct HarbolByteBuf *const restrict buf, char const cstr[static 1]) {
 	size_t const cstr_len = strlen(cstr);
-	if( buf->len + cstr_len + 1 >= buf->cap && !_harbol_buffer_resize(buf, buf->len + cstr_len + 1) ) {
+	if( !_harbol_buffer_reserve_extra(buf, cstr_len + 1) ) {
 		return false;
 	}
 	strcpy(( char* )(&buf->table[buf->len]), cstr);
@@ -103,7 +155,7 @@ HARBOL_EXPORT bool harbol_bytebuffer_insert_cstr(struct HarbolByteBuf *const res
 }
 
 HARBOL_EXPORT bool harbol_bytebuffer_insert_obj(struct HarbolByteBuf *const restrict buf, void const *const obj, size_t const size) {
-	if( buf->len + size >= buf->cap && !_harbol_buffer_resize(buf, buf->len + size) ) {
+	if( !_harbol_buffer_reserve_extra(buf, size) ) {
 		return false;
 	}
 	memcpy(&buf->table[buf->len], obj, size);
@@ -112,7 +164,7 @@ HARBOL_EXPORT bool harbol_bytebuffer_insert_obj(struct HarbolByteBuf *const rest
 }
 
 HARBOL_EXPORT bool harbol_bytebuffer_insert_zeros(struct HarbolByteBuf *const buf, size_t const amount) {
-	if( buf->len + amount >= buf->cap && !_harbol_buffer_resize(buf, buf->len + amount) ) {
+	if( !_harbol_buffer_reserve_extra(buf, amount) ) {
 		return false;
 	}
 	memset(&buf->table[buf->len], 0, amount);
@@ -151,7 +203,7 @@ HARBOL_EXPORT bool harbol_bytebuffer_insert_from_file(struct HarbolByteBuf *cons
 	}
 	
 	rewind(file);
-	if( buf->len + file_size >= buf->cap && !_harbol_buffer_resize(buf, buf->len + file_size) ) {
+	if( !_harbol_buffer_reserve_extra(buf, ( size_t )(file_size)) ) {
 		return false;
 	}
 	size_t const bytes_read = fread(&buf->table[buf->len], sizeof *buf->table, file_size, file);
@@ -160,7 +212,7 @@ HARBOL_EXPORT bool harbol_bytebuffer_insert_from_file(struct HarbolByteBuf *cons
 }
 
 HARBOL_EXPORT bool harbol_bytebuffer_append(struct HarbolByteBuf *const bufA, struct HarbolByteBuf const *const bufB) {
-	if( bufB->table==NULL || (bufA->len + bufB->len >= bufA->cap && !_harbol_buffer_resize(bufA, bufA->len + bufB->len)) ) {
+	if( bufB->table==NULL || !_harbol_buffer_reserve_extra(bufA, bufB->len) ) {
 		return false;
 	}
 	memcpy(&bufA->table[bufA->len], bufB->table, bufB->len);
@@ -169,10 +221,707 @@ HARBOL_EXPORT bool harbol_bytebuffer_append(struct HarbolByteBuf *const bufA, st
 }
 
 HARBOL_EXPORT bool harbol_bytebuffer_copy(struct HarbolByteBuf *const bufA, struct HarbolByteBuf const *const bufB) {
-	if( bufB->table==NULL || (bufB->len != bufA->len && !_harbol_buffer_resize(bufA, bufB->len)) ) {
+	if( bufB->table==NULL || (bufB->len > bufA->cap && !_harbol_buffer_resize(bufA, bufB->len)) ) {
 		return false;
 	}
 	memcpy(&bufA->table[0], &bufB->table[0], bufB->len);
 	bufA->len = bufB->len;
 	return true;
 }
+
+
+/// Binary encoding.
+static inline void _harbol_store_le(uint8_t *const restrict dst, uint64_t const val, size_t const bytes) {
+	for( size_t i=0; i < bytes; i++ ) {
+		dst[i] = ( uint8_t )(val >> (i * 8));
+	}
+}
+
+static inline void _harbol_store_be(uint8_t *const restrict dst, uint64_t const val, size_t const bytes) {
+	for( size_t i=0; i < bytes; i++ ) {
+		dst[i] = ( uint8_t )(val >> ((bytes - 1 - i) * 8));
+	}
+}
+
+static inline uint64_t _harbol_load_le(uint8_t const *const restrict src, size_t const bytes) {
+	uint64_t val = 0;
+	for( size_t i=0; i < bytes; i++ ) {
+		val |= ( uint64_t )(src[i]) << (i * 8);
+	}
+	return val;
+}
+
+static inline uint64_t _harbol_load_be(uint8_t const *const restrict src, size_t const bytes) {
+	uint64_t val = 0;
+	for( size_t i=0; i < bytes; i++ ) {
+		val = (val << 8) | src[i];
+	}
+	return val;
+}
+
+static inline size_t _harbol_encode_uvarint(uint8_t *const restrict dst, uint64_t val) {
+	size_t n = 0;
+	while( val >= 0x80 ) {
+		dst[n++] = ( uint8_t )(val) | 0x80;
+		val >>= 7;
+	}
+	dst[n++] = ( uint8_t )(val);
+	return n;
+}
+
+static inline uint64_t _harbol_zigzag(int64_t const val) {
+	return (( uint64_t )(val) << 1) ^ ( uint64_t )(-(( uint64_t )(val) >> 63));
+}
+
+static inline int64_t _harbol_unzigzag(uint64_t const val) {
+	return ( int64_t )((val >> 1) ^ -(val & 1));
+}
+
+enum { HARBOL_MAX_VARINT_BYTES = 10 };
+
+static NO_NULL bool _harbol_bytebuffer_insert_le(struct HarbolByteBuf *const buf, uint64_t const val, size_t const bytes) {
+	uint8_t *const tail = harbol_bytebuffer_tail(buf, bytes);
+	if( tail==NULL ) {
+		return false;
+	}
+	_harbol_store_le(tail, val, bytes);
+	buf->len += bytes;
+	return true;
+}
+
+static NO_NULL bool _harbol_bytebuffer_insert_be(struct HarbolByteBuf *const buf, uint64_t const val, size_t const bytes) {
+	uint8_t *const tail = harbol_bytebuffer_tail(buf, bytes);
+	if( tail==NULL ) {
+		return false;
+	}
+	_harbol_store_be(tail, val, bytes);
+	buf->len += bytes;
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_bytebuffer_insert_uvarint(struct HarbolByteBuf *const buf, uint64_t const val) {
+	uint8_t *const tail = harbol_bytebuffer_tail(buf, HARBOL_MAX_VARINT_BYTES);
+	if( tail==NULL ) {
+		return false;
+	}
+	buf->len += _harbol_encode_uvarint(tail, val);
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_bytebuffer_insert_svarint(struct HarbolByteBuf *const buf, int64_t const val) {
+	return harbol_bytebuffer_insert_uvarint(buf, _harbol_zigzag(val));
+}
+
+HARBOL_EXPORT bool harbol_bytebuffer_insert_uvarints(struct HarbolByteBuf *const restrict buf, uint64_t const vals[const restrict], size_t const len) {
+	if( len > SIZE_MAX / HARBOL_MAX_VARINT_BYTES ) {
+		return false;
+	}
+	/// one bounds check for the whole batch.
+	uint8_t *const tail = harbol_bytebuffer_tail(buf, len * HARBOL_MAX_VARINT_BYTES);
+	if( tail==NULL ) {
+		return false;
+	}
+	size_t written = 0;
+	for( size_t i=0; i < len; i++ ) {
+		written += _harbol_encode_uvarint(&tail[written], vals[i]);
+	}
+	buf->len += written;
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_bytebuffer_insert_le16(struct HarbolByteBuf *const buf, uint16_t const val) {
+	return _harbol_bytebuffer_insert_le(buf, val, sizeof val);
+}
+HARBOL_EXPORT bool harbol_bytebuffer_insert_le32(struct HarbolByteBuf *const buf, uint32_t const val) {
+	return _harbol_bytebuffer_insert_le(buf, val, sizeof val);
+}
+HARBOL_EXPORT bool harbol_bytebuffer_insert_le64(struct HarbolByteBuf *const buf, uint64_t const val) {
+	return _harbol_bytebuffer_insert_le(buf, val, sizeof val);
+}
+HARBOL_EXPORT bool harbol_bytebuffer_insert_be16(struct HarbolByteBuf *const buf, uint16_t const val) {
+	return _harbol_bytebuffer_insert_be(buf, val, sizeof val);
+}
+HARBOL_EXPORT bool harbol_bytebuffer_insert_be32(struct HarbolByteBuf *const buf, uint32_t const val) {
+	return _harbol_bytebuffer_insert_be(buf, val, sizeof val);
+}
+HARBOL_EXPORT bool harbol_bytebuffer_insert_be64(struct HarbolByteBuf *const buf, uint64_t const val) {
+	return _harbol_bytebuffer_insert_be(buf, val, sizeof val);
+}
+
+HARBOL_EXPORT bool harbol_bytebuffer_insert_float32_le(struct HarbolByteBuf *const buf, float32_t const val) {
+	uint32_t bits = 0;
+	memcpy(&bits, &val, sizeof bits);
+	return _harbol_bytebuffer_insert_le(buf, bits, sizeof bits);
+}
+HARBOL_EXPORT bool harbol_bytebuffer_insert_float64_le(struct HarbolByteBuf *const buf, float64_t const val) {
+	uint64_t bits = 0;
+	memcpy(&bits, &val, sizeof bits);
+	return _harbol_bytebuffer_insert_le(buf, bits, sizeof bits);
+}
+HARBOL_EXPORT bool harbol_bytebuffer_insert_float32_be(struct HarbolByteBuf *const buf, float32_t const val) {
+	uint32_t bits = 0;
+	memcpy(&bits, &val, sizeof bits);
+	return _harbol_bytebuffer_insert_be(buf, bits, sizeof bits);
+}
+HARBOL_EXPORT bool harbol_bytebuffer_insert_float64_be(struct HarbolByteBuf *const buf, float64_t const val) {
+	uint64_t bits = 0;
+	memcpy(&bits, &val, sizeof bits);
+	return _harbol_bytebuffer_insert_be(buf, bits, sizeof bits);
+}
+
+HARBOL_EXPORT bool harbol_bytebuffer_insert_blob(struct HarbolByteBuf *const restrict buf, void const *const data, size_t const len) {
+	if( len > SIZE_MAX - HARBOL_MAX_VARINT_BYTES || (len > 0 && data==NULL) ) {
+		return false;
+	}
+	uint8_t *const tail = harbol_bytebuffer_tail(buf, HARBOL_MAX_VARINT_BYTES + len);
+	if( tail==NULL ) {
+		return false;
+	}
+	size_t const prefix = _harbol_encode_uvarint(tail, len);
+	if( len > 0 ) {
+		memcpy(&tail[prefix], data, len);
+	}
+	buf->len += prefix + len;
+	return true;
+}
+
+static inline size_t _harbol_group_varint_bytes(uint32_t const val) {
+	return 1 + (val > 0xFF) + (val > 0xFFFF) + (val > 0xFFFFFF);
+}
+
+HARBOL_EXPORT bool harbol_bytebuffer_insert_group_varint32(struct HarbolByteBuf *const restrict buf, uint32_t const vals[const restrict], size_t const len) {
+	size_t const groups = (len + 3) / 4;
+	if( groups > SIZE_MAX / 17 ) {
+		return false;
+	}
+	/// worst case is a tag + 4 full ints per group.
+	uint8_t *const tail = harbol_bytebuffer_tail(buf, groups * 17);
+	if( tail==NULL ) {
+		return false;
+	}
+	size_t written = 0;
+	for( size_t g=0; g < groups; g++ ) {
+		uint8_t *const tag = &tail[written++];
+		*tag = 0;
+		for( size_t i=0; i < 4; i++ ) {
+			size_t   const idx   = g * 4 + i;
+			uint32_t const val   = (idx < len)? vals[idx] : 0;
+			size_t   const bytes = _harbol_group_varint_bytes(val);
+			*tag |= ( uint8_t )((bytes - 1) << (i * 2));
+			_harbol_store_le(&tail[written], val, bytes);
+			written += bytes;
+		}
+	}
+	buf->len += written;
+	return true;
+}
+
+
+/// Byte Reader.
+HARBOL_EXPORT struct HarbolByteReader harbol_bytereader_make(void const *const data, size_t const len) {
+	return( struct HarbolByteReader ){ .data = data, .len = (data==NULL)? 0 : len, .pos = 0 };
+}
+
+HARBOL_EXPORT struct HarbolByteReader harbol_bytereader_make_from_buf(struct HarbolByteBuf const *const buf) {
+	return harbol_bytereader_make(buf->table, buf->len);
+}
+
+HARBOL_EXPORT size_t harbol_bytereader_remaining(struct HarbolByteReader const *const reader) {
+	return reader->len - reader->pos;
+}
+
+HARBOL_EXPORT bool harbol_bytereader_skip(struct HarbolByteReader *const reader, size_t const amount) {
+	return harbol_bytereader_view(reader, amount) != NULL;
+}
+
+HARBOL_EXPORT uint8_t const *harbol_bytereader_view(struct HarbolByteReader *const reader, size_t const amount) {
+	if( amount > reader->len - reader->pos ) {
+		return NULL;
+	}
+	uint8_t const *const p = &reader->data[reader->pos];
+	reader->pos += amount;
+	return p;
+}
+
+HARBOL_EXPORT bool harbol_bytereader_read_bytes(struct HarbolByteReader *const restrict reader, void *const restrict out, size_t const amount) {
+	uint8_t const *const p = harbol_bytereader_view(reader, amount);
+	if( p==NULL ) {
+		return false;
+	} else if( amount > 0 ) {
+		memcpy(out, p, amount);
+	}
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_bytereader_read_byte(struct HarbolByteReader *const restrict reader, uint8_t *const restrict val) {
+	return harbol_bytereader_read_bytes(reader, val, sizeof *val);
+}
+
+#ifndef HARBOL_BYTEREADER_FIXED
+#	define HARBOL_BYTEREADER_FIXED(loader) \
+	uint8_t const *const p = harbol_bytereader_view(reader, sizeof *val); \
+	if( p==NULL ) \
+		return false; \
+	\
+	*val = loader(p, sizeof *val); \
+	return true;
+#endif
+
+HARBOL_EXPORT bool harbol_bytereader_read_le16(struct HarbolByteReader *const restrict reader, uint16_t *const restrict val) {
+	HARBOL_BYTEREADER_FIXED(( uint16_t )_harbol_load_le)
+}
+HARBOL_EXPORT bool harbol_bytereader_read_le32(struct HarbolByteReader *const restrict reader, uint32_t *const restrict val) {
+	HARBOL_BYTEREADER_FIXED(( uint32_t )_harbol_load_le)
+}
+HARBOL_EXPORT bool harbol_bytereader_read_le64(struct HarbolByteReader *const restrict reader, uint64_t *const restrict val) {
+	HARBOL_BYTEREADER_FIXED(_harbol_load_le)
+}
+HARBOL_EXPORT bool harbol_bytereader_read_be16(struct HarbolByteReader *const restrict reader, uint16_t *const restrict val) {
+	HARBOL_BYTEREADER_FIXED(( uint16_t )_harbol_load_be)
+}
+HARBOL_EXPORT bool harbol_bytereader_read_be32(struct HarbolByteReader *const restrict reader, uint32_t *const restrict val) {
+	HARBOL_BYTEREADER_FIXED(( uint32_t )_harbol_load_be)
+}
+HARBOL_EXPORT bool harbol_bytereader_read_be64(struct HarbolByteReader *const restrict reader, uint64_t *const restrict val) {
+	HARBOL_BYTEREADER_FIXED(_harbol_load_be)
+}
+
+HARBOL_EXPORT bool harbol_bytereader_read_float32_le(struct HarbolByteReader *const restrict reader, float32_t *const restrict val) {
+	uint32_t bits = 0;
+	if( !harbol_bytereader_read_le32(reader, &bits) ) {
+		return false;
+	}
+	memcpy(val, &bits, sizeof bits);
+	return true;
+}
+HARBOL_EXPORT bool harbol_bytereader_read_float64_le(struct HarbolByteReader *const restrict reader, float64_t *const restrict val) {
+	uint64_t bits = 0;
+	if( !harbol_bytereader_read_le64(reader, &bits) ) {
+		return false;
+	}
+	memcpy(val, &bits, sizeof bits);
+	return true;
+}
+HARBOL_EXPORT bool harbol_bytereader_read_float32_be(struct HarbolByteReader *const restrict reader, float32_t *const restrict val) {
+	uint32_t bits = 0;
+	if( !harbol_bytereader_read_be32(reader, &bits) ) {
+		return false;
+	}
+	memcpy(val, &bits, sizeof bits);
+	return true;
+}
+HARBOL_EXPORT bool harbol_bytereader_read_float64_be(struct HarbolByteReader *const restrict reader, float64_t *const restrict val) {
+	uint64_t bits = 0;
+	if( !harbol_bytereader_read_be64(reader, &bits) ) {
+		return false;
+	}
+	memcpy(val, &bits, sizeof bits);
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_bytereader_read_uvarint(struct HarbolByteReader *const restrict reader, uint64_t *const restrict val) {
+	uint64_t result = 0;
+	size_t   pos    = reader->pos;
+	for( size_t i=0; i < HARBOL_MAX_VARINT_BYTES; i++ ) {
+		if( pos >= reader->len ) {
+			return false;
+		}
+		uint8_t const byte = reader->data[pos++];
+		/// the 10th byte only has room for the top bit of a 64-bit value.
+		if( i==HARBOL_MAX_VARINT_BYTES - 1 && byte > 1 ) {
+			return false;
+		}
+		result |= ( uint64_t )(byte & 0x7F) << (i * 7);
+		if( (byte & 0x80)==0 ) {
+			*val = result;
+			reader->pos = pos;
+			return true;
+		}
+	}
+	return false;
+}
+
+HARBOL_EXPORT bool harbol_bytereader_read_svarint(struct HarbolByteReader *const restrict reader, int64_t *const restrict val) {
+	uint64_t zz = 0;
+	if( !harbol_bytereader_read_uvarint(reader, &zz) ) {
+		return false;
+	}
+	*val = _harbol_unzigzag(zz);
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_bytereader_read_uvarints(struct HarbolByteReader *const restrict reader, uint64_t vals[const restrict], size_t const len) {
+	size_t const start = reader->pos;
+	for( size_t i=0; i < len; i++ ) {
+		if( !harbol_bytereader_read_uvarint(reader, &vals[i]) ) {
+			reader->pos = start;
+			return false;
+		}
+	}
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_bytereader_read_blob(struct HarbolByteReader *const restrict reader, uint8_t const **const restrict data, size_t *const restrict len) {
+	size_t const start = reader->pos;
+	uint64_t blob_len = 0;
+	if( !harbol_bytereader_read_uvarint(reader, &blob_len) || blob_len > harbol_bytereader_remaining(reader) ) {
+		reader->pos = start;
+		return false;
+	}
+	*len  = ( size_t )(blob_len);
+	*data = harbol_bytereader_view(reader, *len);
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_bytereader_read_group_varint32(struct HarbolByteReader *const restrict reader, uint32_t vals[const restrict], size_t const len) {
+	size_t const groups = (len + 3) / 4;
+	size_t pos = reader->pos;
+	for( size_t g=0; g < groups; g++ ) {
+		if( pos >= reader->len ) {
+			return false;
+		}
+		uint8_t const tag = reader->data[pos++];
+		/// 2 bits per value, sum them up front so the whole group is checked once.
+		size_t const group_bytes = 4 + (tag & 3) + ((tag >> 2) & 3) + ((tag >> 4) & 3) + ((tag >> 6) & 3);
+		if( group_bytes > reader->len - pos ) {
+			return false;
+		}
+		for( size_t i=0; i < 4; i++ ) {
+			size_t const bytes = (( size_t )(tag >> (i * 2)) & 3) + 1;
+			size_t const idx   = g * 4 + i;
+			if( idx < len ) {
+				vals[idx] = ( uint32_t )(_harbol_load_le(&reader->data[pos], bytes));
+			}
+			pos += bytes;
+		}
+	}
+	reader->pos = pos;
+	return true;
+}
+
+
+/// Byte Rope.
+HARBOL_EXPORT struct HarbolByteRope *harbol_byterope_new(void) {
+	return calloc(1, sizeof(struct HarbolByteRope));
+}
+
+HARBOL_EXPORT struct HarbolByteRope harbol_byterope_make(void) {
+	struct HarbolByteRope rope = {0};
+	return rope;
+}
+
+HARBOL_EXPORT void harbol_byterope_clear(struct HarbolByteRope *const rope) {
+	for( size_t i=0; i < rope->len; i++ ) {
+		if( rope->caps[i] > 0 ) {
+			free(rope->chunks[i]);
+		}
+		rope->chunks[i] = NULL;
+	}
+	harbol_multi_cleanup(3, &rope->chunks, &rope->lens, &rope->caps);
+	*rope = ( struct HarbolByteRope ){0};
+}
+
+HARBOL_EXPORT void harbol_byterope_free(struct HarbolByteRope **const roperef) {
+	if( *roperef==NULL ) {
+		return;
+	}
+	harbol_byterope_clear(*roperef);
+	free(*roperef); *roperef = NULL;
+}
+
+HARBOL_EXPORT size_t harbol_byterope_len(struct HarbolByteRope const *const rope) {
+	return rope->total;
+}
+
+HARBOL_EXPORT size_t harbol_byterope_chunks(struct HarbolByteRope const *const rope) {
+	return rope->len;
+}
+
+static NO_NULL bool _harbol_byterope_reserve(struct HarbolByteRope *const rope, size_t const amount) {
+	if( rope->len + amount <= rope->cap ) {
+		return true;
+	}
+	size_t new_cap = (rope->cap==0)? 8 : rope->cap << 1;
+	while( new_cap < rope->len + amount ) {
+		new_cap <<= 1;
+	}
+	if( rope->cap==0 ) {
+		if( !harbol_multi_calloc(new_cap, 3,
+						&rope->chunks, sizeof *rope->chunks,
+						&rope->lens,   sizeof *rope->lens,
+						&rope->caps,   sizeof *rope->caps) ) {
+			return false;
+		}
+	} else if( !harbol_multi_recalloc(new_cap, rope->cap, 3,
+						&rope->chunks, sizeof *rope->chunks,
+						&rope->lens,   sizeof *rope->lens,
+						&rope->caps,   sizeof *rope->caps) ) {
+		return false;
+	}
+	rope->cap = new_cap;
+	return true;
+}
+
+static NO_NULL bool _harbol_byterope_push(struct HarbolByteRope *const rope, uint8_t *const chunk, size_t const len, size_t const cap) {
+	if( !_harbol_byterope_reserve(rope, 1) ) {
+		return false;
+	}
+	rope->chunks[rope->len] = chunk;
+	rope->lens[rope->len]   = len;
+	rope->caps[rope->len]   = cap;
+	rope->len++;
+	rope->total += len;
+	return true;
+}
+
+/// drops every chunk pushed after the rope had 'len' of them.
+static NO_NULL void _harbol_byterope_truncate(struct HarbolByteRope *const rope, size_t const len) {
+	while( rope->len > len ) {
+		rope->len--;
+		if( rope->caps[rope->len] > 0 ) {
+			free(rope->chunks[rope->len]);
+		}
+		rope->total -= rope->lens[rope->len];
+		rope->chunks[rope->len] = NULL;
+		rope->lens[rope->len]   = rope->caps[rope->len] = 0;
+	}
+}
+
+HARBOL_EXPORT bool harbol_byterope_append_ref(struct HarbolByteRope *const restrict rope, void const *const data, size_t const len) {
+	if( len==0 ) {
+		return true;
+	} else if( data==NULL ) {
+		return false;
+	}
+	/// borrowed chunks are never written through, the cast only satisfies the shared table type.
+	union {
+		void const *c;
+		uint8_t    *p;
+	} const conv = {data};
+	return _harbol_byterope_push(rope, conv.p, len, 0);
+}
+
+HARBOL_EXPORT bool harbol_byterope_append_copy(struct HarbolByteRope *const restrict rope, void const *const data, size_t const len) {
+	if( len==0 ) {
+		return true;
+	} else if( data==NULL ) {
+		return false;
+	}
+	
+	uint8_t const *src = data;
+	size_t left = len;
+	if( rope->len > 0 ) {
+		size_t const last  = rope->len - 1;
+		size_t const spare = rope->caps[last] - ((rope->caps[last] > 0)? rope->lens[last] : 0);
+		if( rope->caps[last] > 0 && spare > 0 ) {
+			size_t const amount = (spare < left)? spare : left;
+			memcpy(&rope->chunks[last][rope->lens[last]], src, amount);
+			rope->lens[last] += amount;
+			rope->total      += amount;
+			src  += amount;
+			left -= amount;
+		}
+	}
+	if( left==0 ) {
+		return true;
+	}
+	
+	size_t const chunk_cap = (left > HARBOL_BYTEROPE_CHUNK_SIZE)? left : HARBOL_BYTEROPE_CHUNK_SIZE;
+	uint8_t *const chunk = malloc(chunk_cap);
+	if( chunk==NULL ) {
+		return false;
+	}
+	memcpy(chunk, src, left);
+	if( !_harbol_byterope_push(rope, chunk, left, chunk_cap) ) {
+		free(chunk);
+		return false;
+	}
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_byterope_append_bytebuf(struct HarbolByteRope *const restrict rope, struct HarbolByteBuf *const restrict buf) {
+	if( buf->table==NULL || buf->len==0 ) {
+		return true;
+	} else if( !_harbol_byterope_push(rope, buf->table, buf->len, buf->cap) ) {
+		return false;
+	}
+	*buf = ( struct HarbolByteBuf ){0};
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_byterope_splice(struct HarbolByteRope *const restrict ropeA, struct HarbolByteRope *const restrict ropeB, size_t const index, size_t const count) {
+	if( ropeA==ropeB || index > ropeB->len || count > ropeB->len - index ) {
+		return false;
+	} else if( count==0 ) {
+		return true;
+	} else if( !_harbol_byterope_reserve(ropeA, count) ) {
+		return false;
+	}
+	
+	size_t moved = 0;
+	for( size_t i=0; i < count; i++ ) {
+		moved += ropeB->lens[index + i];
+	}
+	memcpy(&ropeA->chunks[ropeA->len], &ropeB->chunks[index], count * sizeof *ropeA->chunks);
+	memcpy(&ropeA->lens[ropeA->len],   &ropeB->lens[index],   count * sizeof *ropeA->lens);
+	memcpy(&ropeA->caps[ropeA->len],   &ropeB->caps[index],   count * sizeof *ropeA->caps);
+	ropeA->len   += count;
+	ropeA->total += moved;
+	
+	ropeB->total -= moved;
+	if( index + count < ropeB->len ) {
+		multi_array_shift_up(&ropeB->len, index, count, 3,
+			ropeB->chunks, sizeof *ropeB->chunks,
+			ropeB->lens,   sizeof *ropeB->lens,
+			ropeB->caps,   sizeof *ropeB->caps
+		);
+	} else {
+		memset(&ropeB->chunks[index], 0, count * sizeof *ropeB->chunks);
+		memset(&ropeB->lens[index],   0, count * sizeof *ropeB->lens);
+		memset(&ropeB->caps[index],   0, count * sizeof *ropeB->caps);
+		ropeB->len = index;
+	}
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_byterope_flatten(struct HarbolByteRope const *const restrict rope, struct HarbolByteBuf *const restrict buf) {
+	uint8_t *tail = harbol_bytebuffer_tail(buf, rope->total);
+	if( tail==NULL ) {
+		return false;
+	}
+	for( size_t i=0; i < rope->len; i++ ) {
+		tail = harbol_mempcpy(tail, rope->chunks[i], rope->lens[i]);
+	}
+	buf->len += rope->total;
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_byterope_to_file(struct HarbolByteRope const *const restrict rope, FILE *const file) {
+	for( size_t i=0; i < rope->len; i++ ) {
+		if( fwrite(rope->chunks[i], sizeof *rope->chunks[i], rope->lens[i], file) != rope->lens[i] ) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/// iovecs handed to each writev, kept at or under POSIX's IOV_MAX floor on common hosts.
+#ifndef HARBOL_BYTEROPE_IOV_BATCH
+#	define HARBOL_BYTEROPE_IOV_BATCH    64
+#endif
+
+HARBOL_EXPORT bool harbol_byterope_write_fd(struct HarbolByteRope const *const rope, int const fd) {
+	size_t chunk = 0, offset = 0;
+	while( chunk < rope->len ) {
+#ifdef OS_WINDOWS
+		size_t const left = rope->lens[chunk] - offset;
+		int const written = _write(fd, &rope->chunks[chunk][offset], (left > INT_MAX)? INT_MAX : ( unsigned )(left));
+		if( written < 0 ) {
+			return false;
+		}
+		size_t advance = ( size_t )(written);
+#else
+		struct iovec iov[HARBOL_BYTEROPE_IOV_BATCH];
+		size_t const max_iov = sizeof iov / sizeof iov[0];
+		size_t n = 0;
+		for( size_t i=chunk; i < rope->len && n < max_iov; i++ ) {
+			size_t const skip = (i==chunk)? offset : 0;
+			iov[n].iov_base = &rope->chunks[i][skip];
+			iov[n].iov_len  = rope->lens[i] - skip;
+			n++;
+		}
+		ssize_t const written = writev(fd, iov, ( int )(n));
+		if( written < 0 ) {
+			if( errno==EINTR ) {
+				continue;
+			}
+			return false;
+		}
+		size_t advance = ( size_t )(written);
+#endif
+		/// partial writes can stop anywhere, walk the cursor forward.
+		while( chunk < rope->len && advance >= rope->lens[chunk] - offset ) {
+			advance -= rope->lens[chunk] - offset;
+			chunk++;
+			offset = 0;
+		}
+		offset += advance;
+	}
+	return true;
+}
+
+HARBOL_EXPORT intmax_t harbol_byterope_read_fd(struct HarbolByteRope *const rope, int const fd, size_t const max_bytes) {
+	size_t const start_len = rope->len;
+	size_t total = 0;
+	while( total < max_bytes ) {
+		size_t const want = max_bytes - total;
+#ifdef OS_WINDOWS
+		size_t const chunk_cap = (want < HARBOL_BYTEROPE_CHUNK_SIZE)? want : HARBOL_BYTEROPE_CHUNK_SIZE;
+		uint8_t *const chunk = malloc(chunk_cap);
+		if( chunk==NULL ) {
+			_harbol_byterope_truncate(rope, start_len);
+			return -1;
+		}
+		int const got = _read(fd, chunk, ( unsigned )(chunk_cap));
+		if( got <= 0 ) {
+			free(chunk);
+			if( got < 0 ) {
+				_harbol_byterope_truncate(rope, start_len);
+				return -1;
+			}
+			return ( intmax_t )(total);
+		}
+		if( !_harbol_byterope_push(rope, chunk, ( size_t )(got), chunk_cap) ) {
+			free(chunk);
+			_harbol_byterope_truncate(rope, start_len);
+			return -1;
+		}
+		total += ( size_t )(got);
+#else
+		/// scatter into a batch of fresh chunks with one syscall.
+		enum { READ_BATCH = 8 };
+		struct iovec iov[READ_BATCH];
+		size_t n = 0, asked = 0;
+		while( n < READ_BATCH && asked < want ) {
+			size_t const chunk_cap = (want - asked < HARBOL_BYTEROPE_CHUNK_SIZE)? want - asked : HARBOL_BYTEROPE_CHUNK_SIZE;
+			iov[n].iov_base = malloc(chunk_cap);
+			if( iov[n].iov_base==NULL ) {
+				break;
+			}
+			iov[n].iov_len = chunk_cap;
+			asked += chunk_cap;
+			n++;
+		}
+		if( n==0 ) {
+			_harbol_byterope_truncate(rope, start_len);
+			return -1;
+		}
+		
+		ssize_t got = 0;
+		do {
+			got = readv(fd, iov, ( int )(n));
+		} while( got < 0 && errno==EINTR );
+		
+		size_t left = (got > 0)? ( size_t )(got) : 0;
+		bool ok = got >= 0;
+		for( size_t i=0; i < n; i++ ) {
+			size_t const used = (left < iov[i].iov_len)? left : iov[i].iov_len;
+			left -= used;
+			if( ok && used > 0 && _harbol_byterope_push(rope, iov[i].iov_base, used, iov[i].iov_len) ) {
+				continue;
+			} else if( used > 0 ) {
+				ok = false;
+			}
+			free(iov[i].iov_base);
+		}
+		if( !ok ) {
+			_harbol_byterope_truncate(rope, start_len);
+			return -1;
+		} else if( got==0 ) {
+			break;
+		}
+		total += ( size_t )(got);
+#endif
+	}
+	return ( intmax_t )(total);
+}
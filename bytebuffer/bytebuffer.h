@@ -10,6 +10,11 @@ extern "C" {
 #include "../array/array.h"
 
 
+/// smallest capacity a growing byte buffer allocates, growth doubles from there.
+#ifndef HARBOL_BYTEBUFFER_MIN_CAP
+#	define HARBOL_BYTEBUFFER_MIN_CAP    16
+#endif
+
 struct HarbolByteBuf {
 	uint8_t *table;
 	size_t   cap, len;
@@ -25,6 +30,16 @@ HARBOL_EXPORT NO_NULL size_t harbol_bytebuffer_cap(struct HarbolByteBuf const *b
 HARBOL_EXPORT NO_NULL size_t harbol_bytebuffer_len(struct HarbolByteBuf const *buf);
 HARBOL_EXPORT NO_NULL uint8_t *harbol_bytebuffer_get_buffer(struct HarbolByteBuf const *buf);
 
+/// makes sure the buffer can hold at least `new_cap` bytes total without reallocating.
+HARBOL_EXPORT NO_NULL bool harbol_bytebuffer_reserve(struct HarbolByteBuf *buf, size_t new_cap);
+HARBOL_EXPORT NO_NULL bool harbol_bytebuffer_shrink(struct HarbolByteBuf *buf);
+
+/// bulk writing: `tail` returns a pointer to at least `amount` writable bytes past the end (or NULL),
+/// then `commit` adds the bytes actually written to the length. an `amount` of 0 never allocates or fails.
+/// The pointer is invalidated by any other call that may grow the buffer.
+HARBOL_EXPORT NO_NULL uint8_t *harbol_bytebuffer_tail(struct HarbolByteBuf *buf, size_t amount);
+HARBOL_EXPORT NO_NULL bool harbol_bytebuffer_commit(struct HarbolByteBuf *buf, size_t amount);
+
 HARBOL_EXPORT NO_NULL bool harbol_bytebuffer_insert_byte(struct HarbolByteBuf *buf, uint8_t byte);
 HARBOL_EXPORT NO_NULL bool harbol_bytebuffer_insert_int16(struct HarbolByteBuf *buf, uint16_t integer);
 HARBOL_EXPORT NO_NULL bool harbol_bytebuffer_insert_int32(struct HarbolByteBuf *buf, uint32_t integer);
@@ -66,6 +81,113 @@ HARBOL_EXPORT NO_NULL bool harbol_bytebuffer_insert_from_filename(struct HarbolB
 
 HARBOL_EXPORT NO_NULL bool harbol_bytebuffer_append(struct HarbolByteBuf *bufA, struct HarbolByteBuf const *bufB);
 HARBOL_EXPORT NO_NULL bool harbol_bytebuffer_copy(struct HarbolByteBuf *bufA, struct HarbolByteBuf const *bufB);
+
+
+/// Binary encoding, all of these are independent of the host's byte order.
+/// LEB128 varints (max 10 bytes), 'svarint' zigzags the value first so small negatives stay small.
+HARBOL_EXPORT NO_NULL bool harbol_bytebuffer_insert_uvarint(struct HarbolByteBuf *buf, uint64_t val);
+HARBOL_EXPORT NO_NULL bool harbol_bytebuffer_insert_svarint(struct HarbolByteBuf *buf, int64_t val);
+HARBOL_EXPORT NO_NULL bool harbol_bytebuffer_insert_uvarints(struct HarbolByteBuf *buf, uint64_t const vals[], size_t len);
+
+HARBOL_EXPORT NO_NULL bool harbol_bytebuffer_insert_le16(struct HarbolByteBuf *buf, uint16_t val);
+HARBOL_EXPORT NO_NULL bool harbol_bytebuffer_insert_le32(struct HarbolByteBuf *buf, uint32_t val);
+HARBOL_EXPORT NO_NULL bool harbol_bytebuffer_insert_le64(struct HarbolByteBuf *buf, uint64_t val);
+HARBOL_EXPORT NO_NULL bool harbol_bytebuffer_insert_be16(struct HarbolByteBuf *buf, uint16_t val);
+HARBOL_EXPORT NO_NULL bool harbol_bytebuffer_insert_be32(struct HarbolByteBuf *buf, uint32_t val);
+HARBOL_EXPORT NO_NULL bool harbol_bytebuffer_insert_be64(struct HarbolByteBuf *buf, uint64_t val);
+
+HARBOL_EXPORT NO_NULL bool harbol_bytebuffer_insert_float32_le(struct HarbolByteBuf *buf, float32_t val);
+HARBOL_EXPORT NO_NULL bool harbol_bytebuffer_insert_float64_le(struct HarbolByteBuf *buf, float64_t val);
+HARBOL_EXPORT NO_NULL bool harbol_bytebuffer_insert_float32_be(struct HarbolByteBuf *buf, float32_t val);
+HARBOL_EXPORT NO_NULL bool harbol_bytebuffer_insert_float64_be(struct HarbolByteBuf *buf, float64_t val);
+
+/// uvarint length prefix followed by the raw bytes.
+HARBOL_EXPORT NEVER_NULL(1) bool harbol_bytebuffer_insert_blob(struct HarbolByteBuf *buf, void const *data, size_t len);
+
+/// Group varint: every 4 values share one tag byte holding 2-bit byte lengths, followed by 1-4 LE bytes per value.
+/// A trailing partial group is padded with zeros, the decoder needs the original count.
+HARBOL_EXPORT NO_NULL bool harbol_bytebuffer_insert_group_varint32(struct HarbolByteBuf *buf, uint32_t const vals[], size_t len);
+
+
+/// Bounds-checked cursor over encoded bytes. Reads never go past 'len';
+/// a failed read returns false and leaves the cursor where it was.
+struct HarbolByteReader {
+	uint8_t const *data;
+	size_t         len, pos;
+};
+
+HARBOL_EXPORT struct HarbolByteReader harbol_bytereader_make(void const *data, size_t len);
+HARBOL_EXPORT NO_NULL struct HarbolByteReader harbol_bytereader_make_from_buf(struct HarbolByteBuf const *buf);
+
+HARBOL_EXPORT NO_NULL size_t harbol_bytereader_remaining(struct HarbolByteReader const *reader);
+HARBOL_EXPORT NO_NULL bool harbol_bytereader_skip(struct HarbolByteReader *reader, size_t amount);
+HARBOL_EXPORT NO_NULL bool harbol_bytereader_read_bytes(struct HarbolByteReader *reader, void *out, size_t amount);
+/// zero-copy, returns a pointer into the reader's data or NULL.
+HARBOL_EXPORT NO_NULL uint8_t const *harbol_bytereader_view(struct HarbolByteReader *reader, size_t amount);
+
+HARBOL_EXPORT NO_NULL bool harbol_bytereader_read_byte(struct HarbolByteReader *reader, uint8_t *val);
+HARBOL_EXPORT NO_NULL bool harbol_bytereader_read_le16(struct HarbolByteReader *reader, uint16_t *val);
+HARBOL_EXPORT NO_NULL bool harbol_bytereader_read_le32(struct HarbolByteReader *reader, uint32_t *val);
+HARBOL_EXPORT NO_NULL bool harbol_bytereader_read_le64(struct HarbolByteReader *reader, uint64_t *val);
+HARBOL_EXPORT NO_NULL bool harbol_bytereader_read_be16(struct HarbolByteReader *reader, uint16_t *val);
+HARBOL_EXPORT NO_NULL bool harbol_bytereader_read_be32(struct HarbolByteReader *reader, uint32_t *val);
+HARBOL_EXPORT NO_NULL bool harbol_bytereader_read_be64(struct HarbolByteReader *reader, uint64_t *val);
+
+HARBOL_EXPORT NO_NULL bool harbol_bytereader_read_float32_le(struct HarbolByteReader *reader, float32_t *val);
+HARBOL_EXPORT NO_NULL bool harbol_bytereader_read_float64_le(struct HarbolByteReader *reader, float64_t *val);
+HARBOL_EXPORT NO_NULL bool harbol_bytereader_read_float32_be(struct HarbolByteReader *reader, float32_t *val);
+HARBOL_EXPORT NO_NULL bool harbol_bytereader_read_float64_be(struct HarbolByteReader *reader, float64_t *val);
+
+HARBOL_EXPORT NO_NULL bool harbol_bytereader_read_uvarint(struct HarbolByteReader *reader, uint64_t *val);
+HARBOL_EXPORT NO_NULL bool harbol_bytereader_read_svarint(struct HarbolByteReader *reader, int64_t *val);
+HARBOL_EXPORT NO_NULL bool harbol_bytereader_read_uvarints(struct HarbolByteReader *reader, uint64_t vals[], size_t len);
+
+/// zero-copy, '*data' points into the reader's data.
+HARBOL_EXPORT NO_NULL bool harbol_bytereader_read_blob(struct HarbolByteReader *reader, uint8_t const **data, size_t *len);
+
+HARBOL_EXPORT NO_NULL bool harbol_bytereader_read_group_varint32(struct HarbolByteReader *reader, uint32_t vals[], size_t len);
+
+
+/// Segmented byte buffer (rope of chunks) for building large outputs without concatenating.
+/// chunks with a 'caps' of 0 are borrowed: the rope never writes to or frees them.
+#ifndef HARBOL_BYTEROPE_CHUNK_SIZE
+#	define HARBOL_BYTEROPE_CHUNK_SIZE    4096
+#endif
+
+struct HarbolByteRope {
+	uint8_t **chunks;
+	size_t   *lens, *caps;
+	size_t    cap, len, total;
+};
+
+HARBOL_EXPORT struct HarbolByteRope *harbol_byterope_new(void);
+HARBOL_EXPORT struct HarbolByteRope harbol_byterope_make(void);
+
+HARBOL_EXPORT NO_NULL void harbol_byterope_clear(struct HarbolByteRope *rope);
+HARBOL_EXPORT NO_NULL void harbol_byterope_free(struct HarbolByteRope **roperef);
+
+HARBOL_EXPORT NO_NULL size_t harbol_byterope_len(struct HarbolByteRope const *rope);
+HARBOL_EXPORT NO_NULL size_t harbol_byterope_chunks(struct HarbolByteRope const *rope);
+
+/// zero-copy, 'data' must outlive the rope.
+HARBOL_EXPORT NEVER_NULL(1) bool harbol_byterope_append_ref(struct HarbolByteRope *rope, void const *data, size_t len);
+/// copies into the spare room of the last owned chunk when possible.
+HARBOL_EXPORT NEVER_NULL(1) bool harbol_byterope_append_copy(struct HarbolByteRope *rope, void const *data, size_t len);
+/// takes ownership of the byte buffer's table, leaving the buffer empty.
+HARBOL_EXPORT NO_NULL bool harbol_byterope_append_bytebuf(struct HarbolByteRope *rope, struct HarbolByteBuf *buf);
+
+/// moves 'count' chunks starting at chunk 'index' from 'ropeB' to the end of 'ropeA'.
+HARBOL_EXPORT NO_NULL bool harbol_byterope_splice(struct HarbolByteRope *ropeA, struct HarbolByteRope *ropeB, size_t index, size_t count);
+
+/// gathers all chunks into 'buf' with a single reservation.
+HARBOL_EXPORT NO_NULL bool harbol_byterope_flatten(struct HarbolByteRope const *rope, struct HarbolByteBuf *buf);
+
+HARBOL_EXPORT NO_NULL bool harbol_byterope_to_file(struct HarbolByteRope const *rope, FILE *file);
+/// scatter/gather I/O: writev/readv on POSIX, looped write/read elsewhere.
+HARBOL_EXPORT NO_NULL bool harbol_byterope_write_fd(struct HarbolByteRope const *rope, int fd);
+/// reads until EOF or 'max_bytes' into new owned chunks, returns bytes read.
+/// on a read error, returns -1 and drops whatever it read, the rope is left as it was.
+HARBOL_EXPORT NO_NULL intmax_t harbol_byterope_read_fd(struct HarbolByteRope *rope, int fd, size_t max_bytes);
 /********************************************************************/
 
 
@@ -3,6 +3,11 @@
 #include <time.h>
 #include "bytebuffer.h"
 
+#ifndef OS_WINDOWS
+#	include <unistd.h>
+#	include <fcntl.h>
+#endif
+
 void test_harbol_bytebuffer(FILE *debug_stream);
 
 #ifdef HARBOL_USE_MEMPOOL
@@ -156,6 +161,183 @@ void test_harbol_bytebuffer(FILE *const debug_stream) {
 		fprintf(debug_stream, "post-appending i[%zu]= %u\n", n, i.table[n]);
 	
 	
+	fputs("\nbytebuffer :: test geometric growth.\n", debug_stream);
+	{
+		struct HarbolByteBuf g = harbol_bytebuffer_make();
+		size_t reallocs = 0, last_cap = 0;
+		for( uint32_t n=0; n < 10000; n++ ) {
+			harbol_bytebuffer_insert_int32(&g, n);
+			if( g.cap != last_cap ) {
+				reallocs++;
+				last_cap = g.cap;
+			}
+		}
+		assert( g.len==10000 * sizeof(uint32_t) );
+		assert( reallocs < 20 );
+		fprintf(debug_stream, "appended %zu bytes with %zu reallocs, cap: %zu\n", g.len, reallocs, g.cap);
+		harbol_bytebuffer_clear(&g);
+	}
+	
+	fputs("\nbytebuffer :: test reserve and tail/commit.\n", debug_stream);
+	{
+		struct HarbolByteBuf g = harbol_bytebuffer_make();
+		assert( harbol_bytebuffer_reserve(&g, 100) );
+		assert( g.cap >= 100 && g.len==0 );
+		uint8_t *const table = g.table;
+		for( size_t n=0; n < 25; n++ ) {
+			harbol_bytebuffer_insert_int32(&g, ( uint32_t )(n));
+		}
+		assert( g.table==table );
+		
+		uint8_t *tail = harbol_bytebuffer_tail(&g, 64);
+		assert( tail != NULL && g.cap - g.len >= 64 );
+		for( size_t n=0; n < 64; n++ ) {
+			tail[n] = ( uint8_t )(n);
+		}
+		assert( harbol_bytebuffer_commit(&g, 64) );
+		assert( g.len==164 && g.table[100]==0 && g.table[163]==63 );
+		assert( !harbol_bytebuffer_commit(&g, g.cap - g.len + 1) );
+		
+		/// empty batches succeed without allocating.
+		{
+			struct HarbolByteBuf e = harbol_bytebuffer_make();
+			assert( harbol_bytebuffer_tail(&e, 0) != NULL && harbol_bytebuffer_commit(&e, 0) );
+			assert( harbol_bytebuffer_insert_uvarints(&e, &( uint64_t ){0}, 0) );
+			assert( harbol_bytebuffer_insert_group_varint32(&e, &( uint32_t ){0}, 0) );
+			assert( e.table==NULL && e.len==0 );
+		}
+		
+		assert( harbol_bytebuffer_shrink(&g) );
+		assert( g.cap==g.len );
+		for( size_t n=0; n < g.len; n++ ) {
+			fprintf(debug_stream, "g[%zu]= %u\n", n, g.table[n]);
+		}
+		harbol_bytebuffer_clear(&g);
+	}
+	
+	fputs("\nbytebuffer :: test binary encoding/decoding.\n", debug_stream);
+	{
+		struct HarbolByteBuf g = harbol_bytebuffer_make();
+		harbol_bytebuffer_insert_uvarint(&g, 300);
+		harbol_bytebuffer_insert_svarint(&g, -2);
+		harbol_bytebuffer_insert_uvarint(&g, UINT64_MAX);
+		harbol_bytebuffer_insert_le32(&g, 0x11223344);
+		harbol_bytebuffer_insert_be32(&g, 0x11223344);
+		harbol_bytebuffer_insert_be16(&g, 0xABCD);
+		harbol_bytebuffer_insert_float64_le(&g, 3.25);
+		harbol_bytebuffer_insert_float32_be(&g, -1.5f);
+		harbol_bytebuffer_insert_blob(&g, "hello", 5);
+		
+		uint32_t const group_in[] = { 1, 256, 70000, 0xFFFFFFFF, 7 };
+		harbol_bytebuffer_insert_group_varint32(&g, group_in, 5);
+		
+		uint64_t const batch_in[] = { 0, 127, 128, 16384, 1ULL << 40 };
+		harbol_bytebuffer_insert_uvarints(&g, batch_in, 5);
+		
+		/// fixed LE/BE layouts are host independent.
+		assert( g.table[0]==0xAC && g.table[1]==0x02 );
+		assert( g.table[2]==0x03 );
+		for( size_t n=0; n < g.len; n++ ) {
+			fprintf(debug_stream, "encoded[%zu]= %u\n", n, g.table[n]);
+		}
+		
+		struct HarbolByteReader r = harbol_bytereader_make_from_buf(&g);
+		uint64_t u64 = 0; int64_t i64 = 0; uint32_t u32 = 0; uint16_t u16 = 0;
+		float64_t f64 = 0; float32_t f32 = 0;
+		assert( harbol_bytereader_read_uvarint(&r, &u64) && u64==300 );
+		assert( harbol_bytereader_read_svarint(&r, &i64) && i64==-2 );
+		assert( harbol_bytereader_read_uvarint(&r, &u64) && u64==UINT64_MAX );
+		assert( harbol_bytereader_read_le32(&r, &u32) && u32==0x11223344 );
+		assert( harbol_bytereader_read_be32(&r, &u32) && u32==0x11223344 );
+		assert( harbol_bytereader_read_be16(&r, &u16) && u16==0xABCD );
+		assert( harbol_bytereader_read_float64_le(&r, &f64) && f64==3.25 );
+		assert( harbol_bytereader_read_float32_be(&r, &f32) && f32==-1.5f );
+		
+		uint8_t const *blob = NULL; size_t blob_len = 0;
+		assert( harbol_bytereader_read_blob(&r, &blob, &blob_len) && blob_len==5 && !memcmp(blob, "hello", 5) );
+		
+		uint32_t group_out[5] = {0};
+		assert( harbol_bytereader_read_group_varint32(&r, group_out, 5) );
+		assert( !memcmp(group_in, group_out, sizeof group_in) );
+		
+		uint64_t batch_out[5] = {0};
+		assert( harbol_bytereader_read_uvarints(&r, batch_out, 5) );
+		assert( !memcmp(batch_in, batch_out, sizeof batch_in) );
+		assert( harbol_bytereader_remaining(&r)==0 );
+		
+		/// bounds checking.
+		assert( !harbol_bytereader_read_le32(&r, &u32) );
+		struct HarbolByteReader bad = harbol_bytereader_make(( uint8_t const[] ){ 0x80, 0x80 }, 2);
+		assert( !harbol_bytereader_read_uvarint(&bad, &u64) && bad.pos==0 );
+		harbol_bytebuffer_clear(&g);
+	}
+	
+	fputs("\nbytebuffer :: test byte rope.\n", debug_stream);
+	{
+		struct HarbolByteRope rope = harbol_byterope_make();
+		struct HarbolByteBuf empty = harbol_bytebuffer_make();
+		assert( harbol_byterope_flatten(&rope, &empty) && empty.len==0 );
+		
+		static char const header[] = "HEAD";
+		assert( harbol_byterope_append_ref(&rope, header, 4) );
+		assert( harbol_byterope_append_copy(&rope, "ab", 2) );
+		/// small copies coalesce into the last owned chunk.
+		assert( harbol_byterope_append_copy(&rope, "cd", 2) );
+		assert( harbol_byterope_chunks(&rope)==2 && harbol_byterope_len(&rope)==8 );
+		
+		struct HarbolByteBuf body = harbol_bytebuffer_make();
+		for( size_t n=0; n < 5000; n++ ) {
+			harbol_bytebuffer_insert_byte(&body, ( uint8_t )(n));
+		}
+		assert( harbol_byterope_append_bytebuf(&rope, &body) );
+		assert( body.table==NULL && body.len==0 );
+		assert( harbol_byterope_len(&rope)==5008 );
+		
+		struct HarbolByteBuf flat = harbol_bytebuffer_make();
+		assert( harbol_byterope_flatten(&rope, &flat) && flat.len==5008 );
+		assert( !memcmp(flat.table, "HEADabcd", 8) && flat.table[8 + 300]==( uint8_t )(300) );
+		
+		/// move the stolen buffer chunk into another rope.
+		struct HarbolByteRope other = harbol_byterope_make();
+		assert( harbol_byterope_splice(&other, &rope, 2, 1) );
+		assert( harbol_byterope_chunks(&rope)==2 && harbol_byterope_len(&rope)==8 );
+		assert( harbol_byterope_chunks(&other)==1 && harbol_byterope_len(&other)==5000 );
+		assert( !harbol_byterope_splice(&other, &rope, 1, 2) );
+		
+#ifndef OS_WINDOWS
+		int fds[2];
+		assert( pipe(fds)==0 );
+		assert( harbol_byterope_write_fd(&rope, fds[1]) );
+		assert( harbol_byterope_write_fd(&other, fds[1]) );
+		close(fds[1]);
+		
+		struct HarbolByteRope in = harbol_byterope_make();
+		assert( harbol_byterope_read_fd(&in, fds[0], SIZE_MAX)==5008 );
+		close(fds[0]);
+		
+		struct HarbolByteBuf round = harbol_bytebuffer_make();
+		assert( harbol_byterope_flatten(&in, &round) );
+		assert( round.len==flat.len && !memcmp(round.table, flat.table, flat.len) );
+		fprintf(debug_stream, "read back %zu bytes in %zu chunks\n", harbol_byterope_len(&in), harbol_byterope_chunks(&in));
+		
+		/// a read that fails after some data came in leaves the rope as it was.
+		assert( pipe(fds)==0 );
+		assert( write(fds[1], "partial!", 8)==8 );
+		assert( fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK)==0 );
+		size_t const in_chunks = harbol_byterope_chunks(&in);
+		assert( harbol_byterope_read_fd(&in, fds[0], SIZE_MAX)==-1 );
+		assert( harbol_byterope_chunks(&in)==in_chunks && harbol_byterope_len(&in)==5008 );
+		close(fds[0]);
+		close(fds[1]);
+		harbol_bytebuffer_clear(&round);
+		harbol_byterope_clear(&in);
+#endif
+		harbol_bytebuffer_clear(&flat);
+		harbol_byterope_clear(&other);
+		harbol_byterope_clear(&rope);
+		assert( rope.chunks==NULL && rope.total==0 );
+	}
+	
 	/// free data
 	fputs("\nbytebuffer :: test destruction.\n", debug_stream);
 	harbol_bytebuffer_clear(&i);
@@ -0,0 +1,329 @@
+#include "cache.h"
+
+#ifdef OS_WINDOWS
+#	define HARBOL_LIB
+#endif
+
+
+/// every map value is this header followed by the user's data.
+struct HarbolCacheEntry {
+	size_t node; /// deque node holding this entry's map index.
+	bool   ref;  /// CLOCK reference bit.
+};
+
+enum {
+	HARBOL_CACHE_HDR_SIZE   = (sizeof(struct HarbolCacheEntry) + 15) & ~15,
+	HARBOL_CACHE_STACK_BLOB = 256,
+	HARBOL_CACHE_SKETCH_ROWS = 4,
+	HARBOL_CACHE_SKETCH_MIN  = 64,
+};
+
+
+HARBOL_EXPORT struct HarbolCache *harbol_cache_new(enum HarbolCachePolicy const policy, size_t const max_entries, size_t const max_bytes) {
+	struct HarbolCache *cache = calloc(1, sizeof *cache);
+	if( cache==NULL || !harbol_cache_init(cache, policy, max_entries, max_bytes) ) {
+		free(cache); cache = NULL;
+	}
+	return cache;
+}
+
+HARBOL_EXPORT struct HarbolCache harbol_cache_make(enum HarbolCachePolicy const policy, size_t const max_entries, size_t const max_bytes, bool *const res) {
+	struct HarbolCache cache = {0};
+	*res = harbol_cache_init(&cache, policy, max_entries, max_bytes);
+	return cache;
+}
+
+HARBOL_EXPORT bool harbol_cache_init(struct HarbolCache *const cache, enum HarbolCachePolicy const policy, size_t const max_entries, size_t const max_bytes) {
+	*cache = ( struct HarbolCache ){0};
+	/// size the tables for the entry budget up front so puts never rehash.
+	size_t const init_size = ( max_entries > 0 )? max_entries + (max_entries / 3) + 1 : 16;
+	if( !harbol_map_init(&cache->map, init_size) ) {
+		return false;
+	} else if( !harbol_deque_init(&cache->order, ( max_entries > 0 )? max_entries + 1 : 16) ) {
+		harbol_map_clear(&cache->map);
+		return false;
+	}
+
+	if( policy==HarbolCachePolicy_TinyLFU ) {
+		size_t width = ( max_entries > HARBOL_CACHE_SKETCH_MIN )? max_entries : HARBOL_CACHE_SKETCH_MIN;
+		width = bitwise_ceil(width - 1) + 1;
+		cache->sketch = calloc(width * HARBOL_CACHE_SKETCH_ROWS, sizeof *cache->sketch);
+		if( cache->sketch==NULL ) {
+			harbol_map_clear(&cache->map);
+			harbol_deque_clear(&cache->order);
+			return false;
+		}
+		cache->sketch_mask = width - 1;
+	}
+	cache->policy      = policy;
+	cache->max_entries = max_entries;
+	cache->max_bytes   = max_bytes;
+	cache->hand        = SIZE_MAX;
+	return true;
+}
+
+HARBOL_EXPORT void harbol_cache_clear(struct HarbolCache *const cache) {
+	harbol_map_clear(&cache->map);
+	harbol_deque_clear(&cache->order);
+	free(cache->sketch);
+	*cache = ( struct HarbolCache ){0};
+	cache->hand = SIZE_MAX;
+}
+
+HARBOL_EXPORT void harbol_cache_free(struct HarbolCache **const cache_ref) {
+	if( *cache_ref==NULL ) {
+		return;
+	}
+	harbol_cache_clear(*cache_ref);
+	free(*cache_ref); *cache_ref = NULL;
+}
+
+HARBOL_EXPORT void harbol_cache_set_evict_func(struct HarbolCache *const cache, HarbolCacheEvictFunc *const on_evict, void *const userdata) {
+	cache->on_evict = on_evict;
+	cache->userdata = userdata;
+}
+
+HARBOL_EXPORT size_t harbol_cache_count(struct HarbolCache const *const cache) {
+	return cache->map.len;
+}
+
+HARBOL_EXPORT bool harbol_cache_has_key(struct HarbolCache const *const cache, void const *const key, size_t const keylen) {
+	return harbol_map_has_key(&cache->map, key, keylen);
+}
+
+
+static inline struct HarbolCacheEntry *_harbol_cache_entry(struct HarbolCache const *const cache, size_t const index) {
+	return ( struct HarbolCacheEntry* )(cache->map.datum[index]);
+}
+
+static inline size_t _harbol_cache_entry_bytes(struct HarbolCache const *const cache, size_t const index) {
+	return cache->map.keylens[index] + (cache->map.datalens[index] - HARBOL_CACHE_HDR_SIZE);
+}
+
+static inline size_t _harbol_cache_node_index(struct HarbolCache const *const cache, size_t const node) {
+	return *( size_t const* )(harbol_deque_get_data(&cache->order, node));
+}
+
+
+/// count-min sketch with 4 rows of saturating 8-bit counters, rows picked by double hashing.
+static void _harbol_cache_sketch_hashes(struct HarbolCache const *const cache, void const *const key, size_t const keylen, size_t *const h1, size_t *const h2) {
+	*h1 = array_hash(key, keylen, cache->map.seed);
+	*h2 = (array_hash(key, keylen, ~cache->map.seed) << 1) | 1;
+}
+
+static uint_fast8_t _harbol_cache_frequency(struct HarbolCache const *const cache, void const *const key, size_t const keylen) {
+	size_t h1, h2;
+	_harbol_cache_sketch_hashes(cache, key, keylen, &h1, &h2);
+	size_t const width = cache->sketch_mask + 1;
+	uint_fast8_t freq = UINT8_MAX;
+	for( size_t r=0; r < HARBOL_CACHE_SKETCH_ROWS; r++ ) {
+		uint8_t const c = cache->sketch[r * width + ((h1 + r * h2) & cache->sketch_mask)];
+		if( c < freq ) {
+			freq = c;
+		}
+	}
+	return freq;
+}
+
+static void _harbol_cache_record(struct HarbolCache *const cache, void const *const key, size_t const keylen) {
+	size_t h1, h2;
+	_harbol_cache_sketch_hashes(cache, key, keylen, &h1, &h2);
+	size_t const width = cache->sketch_mask + 1;
+	for( size_t r=0; r < HARBOL_CACHE_SKETCH_ROWS; r++ ) {
+		uint8_t *const c = &cache->sketch[r * width + ((h1 + r * h2) & cache->sketch_mask)];
+		*c += *c < UINT8_MAX;
+	}
+
+	/// halve every counter once per sample window so old popularity fades.
+	if( ++cache->sketch_samples >= width * 10 ) {
+		for( size_t i=0; i < width * HARBOL_CACHE_SKETCH_ROWS; i++ ) {
+			cache->sketch[i] >>= 1;
+		}
+		cache->sketch_samples >>= 1;
+	}
+}
+
+
+static void _harbol_cache_remove(struct HarbolCache *const cache, size_t const index, bool const evicted) {
+	struct HarbolCacheEntry const *const entry = _harbol_cache_entry(cache, index);
+	size_t const node = entry->node;
+	if( evicted && cache->on_evict != NULL ) {
+		(*cache->on_evict)(cache->map.keys[index], cache->map.keylens[index], cache->map.datum[index] + HARBOL_CACHE_HDR_SIZE, cache->map.datalens[index] - HARBOL_CACHE_HDR_SIZE, cache->userdata);
+	}
+	if( cache->hand==node ) {
+		cache->hand = harbol_deque_prev(&cache->order, node);
+	}
+	cache->bytes -= _harbol_cache_entry_bytes(cache, index);
+	harbol_deque_remove(&cache->order, node, NULL, 0);
+
+	size_t const last = cache->map.len - 1;
+	harbol_map_idx_swap_rm(&cache->map, index);
+	if( index != last ) {
+		size_t const moved = _harbol_cache_entry(cache, index)->node;
+		*( size_t* )(harbol_deque_get_data(&cache->order, moved)) = index;
+	}
+}
+
+/// CLOCK sweeps from the oldest entry toward the newest, giving referenced entries a second chance.
+static size_t _harbol_cache_clock_victim(struct HarbolCache *const cache) {
+	for( ;; ) {
+		if( cache->hand==SIZE_MAX ) {
+			cache->hand = harbol_deque_tail(&cache->order);
+		}
+		size_t const index = _harbol_cache_node_index(cache, cache->hand);
+		struct HarbolCacheEntry *const entry = _harbol_cache_entry(cache, index);
+		if( !entry->ref ) {
+			return index;
+		}
+		entry->ref  = false;
+		cache->hand = harbol_deque_prev(&cache->order, cache->hand);
+	}
+}
+
+static size_t _harbol_cache_victim(struct HarbolCache *const cache) {
+	if( cache->map.len==0 ) {
+		return SIZE_MAX;
+	} else if( cache->policy==HarbolCachePolicy_CLOCK ) {
+		return _harbol_cache_clock_victim(cache);
+	}
+	return _harbol_cache_node_index(cache, harbol_deque_tail(&cache->order));
+}
+
+HARBOL_EXPORT bool harbol_cache_evict(struct HarbolCache *const cache) {
+	size_t const index = _harbol_cache_victim(cache);
+	if( index==SIZE_MAX ) {
+		return false;
+	}
+	_harbol_cache_remove(cache, index, true);
+	cache->evictions++;
+	return true;
+}
+
+static inline bool _harbol_cache_over_budget(struct HarbolCache const *const cache, size_t const new_entries, size_t const new_bytes) {
+	return (cache->max_entries > 0 && cache->map.len + new_entries > cache->max_entries)
+		|| (cache->max_bytes > 0 && cache->bytes + new_bytes > cache->max_bytes);
+}
+
+static void _harbol_cache_touch(struct HarbolCache *const cache, size_t const index) {
+	struct HarbolCacheEntry *const entry = _harbol_cache_entry(cache, index);
+	if( cache->policy==HarbolCachePolicy_CLOCK ) {
+		entry->ref = true;
+	} else {
+		harbol_deque_move_to_front(&cache->order, entry->node);
+	}
+}
+
+
+HARBOL_EXPORT void *harbol_cache_get(struct HarbolCache *const cache, void const *const key, size_t const keylen) {
+	if( cache->sketch != NULL ) {
+		_harbol_cache_record(cache, key, keylen);
+	}
+	size_t const index = harbol_map_get_entry_index(&cache->map, key, keylen);
+	if( index==SIZE_MAX ) {
+		cache->misses++;
+		return NULL;
+	}
+	cache->hits++;
+	_harbol_cache_touch(cache, index);
+	return cache->map.datum[index] + HARBOL_CACHE_HDR_SIZE;
+}
+
+HARBOL_EXPORT void *harbol_cache_peek(struct HarbolCache const *const cache, void const *const key, size_t const keylen) {
+	size_t const index = harbol_map_get_entry_index(&cache->map, key, keylen);
+	return( index==SIZE_MAX )? NULL : cache->map.datum[index] + HARBOL_CACHE_HDR_SIZE;
+}
+
+HARBOL_EXPORT bool harbol_cache_put(struct HarbolCache *const restrict cache, void const *const key, size_t const keylen, void const *const val, size_t const datasize) {
+	size_t const need = keylen + datasize;
+	if( cache->max_bytes > 0 && need > cache->max_bytes ) {
+		cache->rejections++;
+		return false;
+	}
+
+	if( cache->sketch != NULL ) {
+		_harbol_cache_record(cache, key, keylen);
+	}
+
+	size_t index = harbol_map_get_entry_index(&cache->map, key, keylen);
+	size_t const blobsize = HARBOL_CACHE_HDR_SIZE + datasize;
+	uint8_t stack_blob[HARBOL_CACHE_STACK_BLOB] = {0};
+	uint8_t *const blob = ( blobsize <= sizeof stack_blob )? stack_blob : calloc(blobsize, sizeof *blob);
+	if( blob==NULL ) {
+		return false;
+	}
+	memcpy(blob + HARBOL_CACHE_HDR_SIZE, val, datasize);
+
+	bool res = false;
+	if( index != SIZE_MAX ) {
+		/// replacing: drop the old size, then make room without evicting this entry.
+		struct HarbolCacheEntry *const entry = ( struct HarbolCacheEntry* )(blob);
+		*entry = *_harbol_cache_entry(cache, index);
+		entry->ref = true;
+		size_t const old_bytes = _harbol_cache_entry_bytes(cache, index);
+		cache->bytes -= old_bytes;
+		/// a rewrite counts as a fresh insert: the entry goes to the front, away from the CLOCK hand.
+		if( cache->hand==entry->node ) {
+			cache->hand = harbol_deque_prev(&cache->order, entry->node);
+		}
+		harbol_deque_move_to_front(&cache->order, entry->node);
+		while( _harbol_cache_over_budget(cache, 0, need) ) {
+			size_t const victim = _harbol_cache_victim(cache);
+			if( victim==index ) {
+				break;
+			}
+			/// the swap-remove moves the last map entry into the victim's slot.
+			bool const moves_index = index==cache->map.len - 1;
+			_harbol_cache_remove(cache, victim, true);
+			cache->evictions++;
+			if( moves_index ) {
+				index = victim;
+			}
+		}
+		if( _harbol_cache_over_budget(cache, 0, need) || !harbol_map_idx_set(&cache->map, index, blob, blobsize) ) {
+			cache->bytes += old_bytes;
+			goto cache_put_done;
+		}
+		cache->bytes += need;
+		res = true;
+		goto cache_put_done;
+	}
+
+	if( _harbol_cache_over_budget(cache, 1, need) ) {
+		/// TinyLFU only admits a newcomer that's been seen more often than what it would push out.
+		if( cache->sketch != NULL && cache->map.len > 0 ) {
+			size_t const victim = _harbol_cache_victim(cache);
+			if( _harbol_cache_frequency(cache, key, keylen) <= _harbol_cache_frequency(cache, cache->map.keys[victim], cache->map.keylens[victim]) ) {
+				cache->rejections++;
+				goto cache_put_done;
+			}
+		}
+		while( _harbol_cache_over_budget(cache, 1, need) && harbol_cache_evict(cache) );
+	}
+
+	size_t const node = harbol_deque_prepend(&cache->order, &cache->map.len, sizeof cache->map.len);
+	if( node==SIZE_MAX ) {
+		goto cache_put_done;
+	}
+	(( struct HarbolCacheEntry* )(blob))->node = node;
+	if( !harbol_map_insert(&cache->map, key, keylen, blob, blobsize) ) {
+		harbol_deque_remove(&cache->order, node, NULL, 0);
+		goto cache_put_done;
+	}
+	cache->bytes += need;
+	res = true;
+
+cache_put_done:
+	if( blob != stack_blob ) {
+		free(blob);
+	}
+	return res;
+}
+
+HARBOL_EXPORT bool harbol_cache_rm(struct HarbolCache *const cache, void const *const key, size_t const keylen) {
+	size_t const index = harbol_map_get_entry_index(&cache->map, key, keylen);
+	if( index==SIZE_MAX ) {
+		return false;
+	}
+	_harbol_cache_remove(cache, index, false);
+	return true;
+}
@@ -0,0 +1,67 @@
+#ifndef HARBOL_CACHE_INCLUDED
+#	define HARBOL_CACHE_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "../harbol_common_defines.h"
+#include "../harbol_common_includes.h"
+#include "../map/map.h"
+#include "../deque/deque.h"
+
+
+enum HarbolCachePolicy {
+	HarbolCachePolicy_LRU,     /// evict the least recently used entry.
+	HarbolCachePolicy_CLOCK,   /// second-chance sweep, hits only set a reference bit.
+	HarbolCachePolicy_TinyLFU, /// LRU eviction with frequency-sketch admission.
+};
+
+typedef void HarbolCacheEvictFunc(void const *key, size_t keylen, void *val, size_t datasize, void *userdata);
+
+/// bounded key/value cache.
+/// entries live in the map, recency order lives in the deque as map indices.
+struct HarbolCache {
+	struct HarbolMap      map;
+	struct HarbolDeque    order;
+	HarbolCacheEvictFunc *on_evict;
+	void                 *userdata;
+	uint8_t              *sketch;
+	size_t                sketch_mask, sketch_samples;
+	size_t                max_entries, max_bytes, bytes, hand;
+	size_t                hits, misses, evictions, rejections;
+	enum HarbolCachePolicy policy;
+};
+
+/// 'max_entries' or 'max_bytes' of 0 leaves that budget unbounded.
+HARBOL_EXPORT struct HarbolCache *harbol_cache_new(enum HarbolCachePolicy policy, size_t max_entries, size_t max_bytes);
+HARBOL_EXPORT NO_NULL bool harbol_cache_init(struct HarbolCache *cache, enum HarbolCachePolicy policy, size_t max_entries, size_t max_bytes);
+HARBOL_EXPORT NO_NULL struct HarbolCache harbol_cache_make(enum HarbolCachePolicy policy, size_t max_entries, size_t max_bytes, bool *res);
+
+HARBOL_EXPORT NO_NULL void harbol_cache_clear(struct HarbolCache *cache);
+HARBOL_EXPORT NO_NULL void harbol_cache_free(struct HarbolCache **cache_ref);
+
+HARBOL_EXPORT NEVER_NULL(1) void harbol_cache_set_evict_func(struct HarbolCache *cache, HarbolCacheEvictFunc *on_evict, void *userdata);
+
+HARBOL_EXPORT NO_NULL size_t harbol_cache_count(struct HarbolCache const *cache);
+HARBOL_EXPORT NO_NULL bool harbol_cache_has_key(struct HarbolCache const *cache, void const *key, size_t keylen);
+
+/// counts a hit or miss and refreshes the entry's recency.
+HARBOL_EXPORT NO_NULL void *harbol_cache_get(struct HarbolCache *cache, void const *key, size_t keylen);
+/// looks up without touching counters or recency.
+HARBOL_EXPORT NO_NULL void *harbol_cache_peek(struct HarbolCache const *cache, void const *key, size_t keylen);
+
+/// inserts or replaces, evicting as needed.
+/// returns false if the entry can't fit or TinyLFU declines to admit it.
+HARBOL_EXPORT NO_NULL bool harbol_cache_put(struct HarbolCache *cache, void const *key, size_t keylen, void const *val, size_t datasize);
+
+HARBOL_EXPORT NO_NULL bool harbol_cache_rm(struct HarbolCache *cache, void const *key, size_t keylen);
+/// evicts one entry according to the policy.
+HARBOL_EXPORT NO_NULL bool harbol_cache_evict(struct HarbolCache *cache);
+/********************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /** HARBOL_CACHE_INCLUDED */
@@ -0,0 +1,183 @@
+#include <assert.h>
+#include <time.h>
+#include "cache.h"
+
+void test_harbol_cache(FILE *debug_stream);
+
+#ifdef HARBOL_USE_MEMPOOL
+struct HarbolMemPool *g_pool;
+#endif
+
+int main(void) {
+	FILE *debug_stream = fopen("harbol_cache_output.txt", "w");
+	if( debug_stream==NULL )
+		return -1;
+
+#ifdef HARBOL_USE_MEMPOOL
+	struct HarbolMemPool m = harbol_mempool_create(1000000);
+	g_pool = &m;
+#endif
+	test_harbol_cache(debug_stream);
+
+	fclose(debug_stream); debug_stream=NULL;
+#ifdef HARBOL_USE_MEMPOOL
+	harbol_mempool_clear(g_pool);
+#endif
+}
+
+static uint32_t g_rng = 0x9E3779B9u;
+static uint32_t next_rand(void) {
+	g_rng ^= g_rng << 13;
+	g_rng ^= g_rng >> 17;
+	g_rng ^= g_rng << 5;
+	return g_rng;
+}
+
+struct EvictLog {
+	FILE  *stream;
+	size_t count;
+	int    last_key;
+};
+
+static void log_evict(void const *const key, size_t const keylen, void *const val, size_t const datasize, void *const userdata) {
+	struct EvictLog *const log = userdata;
+	(void)(keylen); (void)(datasize);
+	log->count++;
+	log->last_key = *( int const* )(key);
+	fprintf(log->stream, "evicted key '%i' - value == %i\n", *( int const* )(key), *( int const* )(val));
+}
+
+/// zipf-ish workload: most lookups land on a small hot set.
+static int skewed_key(int const keyspace) {
+	uint32_t const r = next_rand();
+	return( (r & 3) != 0 )? ( int )(r % 64) : ( int )(r % ( uint32_t )(keyspace));
+}
+
+static void run_workload(FILE *const debug_stream, enum HarbolCachePolicy const policy, char const name[]) {
+	struct HarbolCache cache = harbol_cache_make(policy, 256, 0, &( bool ){false});
+	g_rng = 0x9E3779B9u;
+	clock_t const start = clock();
+	for( int i=0; i < 1000000; i++ ) {
+		int const key = skewed_key(1 << 14);
+		if( harbol_cache_get(&cache, &key, sizeof key)==NULL ) {
+			harbol_cache_put(&cache, &key, sizeof key, &key, sizeof key);
+		}
+		assert( harbol_cache_count(&cache) <= 256 );
+	}
+	double const secs = (clock() - start) / ( double )(CLOCKS_PER_SEC);
+	printf("harbol cache :: %-7s 1M skewed lookups: %f secs, hit ratio %.3f, evictions %zu, rejections %zu\n", name, secs, cache.hits / ( double )(cache.hits + cache.misses), cache.evictions, cache.rejections);
+	fprintf(debug_stream, "%s hits: %zu | misses: %zu | evictions: %zu | rejections: %zu\n", name, cache.hits, cache.misses, cache.evictions, cache.rejections);
+	harbol_cache_clear(&cache);
+}
+
+void test_harbol_cache(FILE *const debug_stream) {
+	/// LRU ordering.
+	fputs("cache :: test LRU eviction.\n", debug_stream);
+	struct HarbolCache *lru = harbol_cache_new(HarbolCachePolicy_LRU, 3, 0);
+	assert( lru != NULL );
+	struct EvictLog log = { debug_stream, 0, -1 };
+	harbol_cache_set_evict_func(lru, log_evict, &log);
+	for( int i=0; i < 3; i++ ) {
+		int const val = i * 10;
+		assert( harbol_cache_put(lru, &i, sizeof i, &val, sizeof val) );
+	}
+	/// touch 0 so 1 becomes the oldest.
+	assert( *( int const* )(harbol_cache_get(lru, &( int ){0}, sizeof(int)))==0 );
+	assert( harbol_cache_put(lru, &( int ){3}, sizeof(int), &( int ){30}, sizeof(int)) );
+	assert( log.count==1 && log.last_key==1 );
+	assert( !harbol_cache_has_key(lru, &( int ){1}, sizeof(int)) );
+	assert( harbol_cache_get(lru, &( int ){1}, sizeof(int))==NULL );
+	assert( lru->hits==1 && lru->misses==1 && lru->evictions==1 );
+
+	/// replacing refreshes recency and doesn't evict.
+	assert( harbol_cache_put(lru, &( int ){2}, sizeof(int), &( int ){200}, sizeof(int)) );
+	assert( log.count==1 && harbol_cache_count(lru)==3 );
+	assert( *( int const* )(harbol_cache_peek(lru, &( int ){2}, sizeof(int)))==200 );
+	assert( harbol_cache_put(lru, &( int ){4}, sizeof(int), &( int ){40}, sizeof(int)) );
+	assert( log.last_key==0 );
+	assert( harbol_cache_rm(lru, &( int ){3}, sizeof(int)) && log.count==2 );
+	assert( harbol_cache_count(lru)==2 );
+	for( size_t i=0; i < lru->map.len; i++ ) {
+		fprintf(debug_stream, "key '%i' - value == %i\n", *( int const* )(lru->map.keys[i]), *( int const* )(harbol_cache_peek(lru, lru->map.keys[i], lru->map.keylens[i])));
+	}
+	harbol_cache_free(&lru);
+	assert( lru==NULL );
+
+	/// byte budget counts keys and values.
+	fputs("\ncache :: test byte budget.\n", debug_stream);
+	struct HarbolCache sized = harbol_cache_make(HarbolCachePolicy_LRU, 0, 64, &( bool ){false});
+	char blob[24] = {0};
+	for( int i=0; i < 8; i++ ) {
+		assert( harbol_cache_put(&sized, &i, sizeof i, blob, sizeof blob) );
+		assert( sized.bytes <= 64 );
+	}
+	assert( harbol_cache_count(&sized)==2 && sized.bytes==56 );
+	char big[128] = {0};
+	assert( !harbol_cache_put(&sized, &( int ){99}, sizeof(int), big, sizeof big) );
+	assert( sized.rejections==1 );
+	/// growing an entry in place evicts the others to make room.
+	assert( harbol_cache_put(&sized, &( int ){7}, sizeof(int), big, 56) );
+	assert( harbol_cache_count(&sized)==1 && sized.bytes==60 );
+	fprintf(debug_stream, "entries: %zu | bytes: %zu | evictions: %zu\n", harbol_cache_count(&sized), sized.bytes, sized.evictions);
+	harbol_cache_clear(&sized);
+
+	/// CLOCK gives referenced entries a second chance.
+	fputs("\ncache :: test CLOCK eviction.\n", debug_stream);
+	struct HarbolCache clk = harbol_cache_make(HarbolCachePolicy_CLOCK, 3, 0, &( bool ){false});
+	log = ( struct EvictLog ){ debug_stream, 0, -1 };
+	harbol_cache_set_evict_func(&clk, log_evict, &log);
+	for( int i=0; i < 3; i++ ) {
+		assert( harbol_cache_put(&clk, &i, sizeof i, &i, sizeof i) );
+	}
+	harbol_cache_get(&clk, &( int ){0}, sizeof(int));
+	assert( harbol_cache_put(&clk, &( int ){3}, sizeof(int), &( int ){3}, sizeof(int)) );
+	assert( log.last_key==1 && harbol_cache_has_key(&clk, &( int ){0}, sizeof(int)) );
+	harbol_cache_clear(&clk);
+
+	/// TinyLFU rejects one-hit wonders that would push out a hot entry.
+	fputs("\ncache :: test TinyLFU admission.\n", debug_stream);
+	struct HarbolCache lfu = harbol_cache_make(HarbolCachePolicy_TinyLFU, 4, 0, &( bool ){false});
+	for( int i=0; i < 4; i++ ) {
+		assert( harbol_cache_put(&lfu, &i, sizeof i, &i, sizeof i) );
+		for( int n=0; n < 8; n++ ) {
+			assert( harbol_cache_get(&lfu, &i, sizeof i) != NULL );
+		}
+	}
+	assert( !harbol_cache_put(&lfu, &( int ){100}, sizeof(int), &( int ){100}, sizeof(int)) );
+	assert( lfu.rejections==1 && harbol_cache_count(&lfu)==4 );
+	/// once the newcomer is popular enough it's let in.
+	for( int n=0; n < 16; n++ ) {
+		harbol_cache_get(&lfu, &( int ){100}, sizeof(int));
+	}
+	assert( harbol_cache_put(&lfu, &( int ){100}, sizeof(int), &( int ){100}, sizeof(int)) );
+	assert( harbol_cache_count(&lfu)==4 && lfu.evictions==1 );
+	harbol_cache_clear(&lfu);
+
+	/// random churn: cache contents stay consistent with a plain map.
+	fputs("\ncache :: test consistency under churn.\n", debug_stream);
+	struct HarbolCache churn = harbol_cache_make(HarbolCachePolicy_CLOCK, 100, 0, &( bool ){false});
+	for( int i=0; i < 200000; i++ ) {
+		int const key = ( int )(next_rand() % 512);
+		int const op  = ( int )(next_rand() % 8);
+		if( op==0 ) {
+			harbol_cache_rm(&churn, &key, sizeof key);
+		} else if( op < 4 ) {
+			int const val = key * 3;
+			harbol_cache_put(&churn, &key, sizeof key, &val, sizeof val);
+		} else {
+			int const *const val = harbol_cache_get(&churn, &key, sizeof key);
+			assert( val==NULL || *val==key * 3 );
+		}
+		assert( harbol_cache_count(&churn) <= 100 && harbol_deque_count(&churn.order)==churn.map.len );
+	}
+	for( size_t i=0; i < churn.map.len; i++ ) {
+		assert( harbol_map_get_entry_index(&churn.map, churn.map.keys[i], churn.map.keylens[i])==i );
+	}
+	assert( churn.bytes==churn.map.len * 2 * sizeof(int) );
+	harbol_cache_clear(&churn);
+
+	fputs("\ncache :: benchmark policies.\n", debug_stream);
+	run_workload(debug_stream, HarbolCachePolicy_LRU, "LRU");
+	run_workload(debug_stream, HarbolCachePolicy_CLOCK, "CLOCK");
+	run_workload(debug_stream, HarbolCachePolicy_TinyLFU, "TinyLFU");
+}
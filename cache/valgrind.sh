@@ -0,0 +1,3 @@
+#!/bin/bash
+cd "$(dirname "$0")"
+valgrind --leak-check=full --show-leak-kinds=all --track-origins=yes -v ./harbol_cache_test
@@ -1,7 +1,16 @@
 #include "cfg.h"
+#include <errno.h>
 
 #ifdef OS_WINDOWS
 #	define HARBOL_LIB
+#	include <windows.h>
+#	include <sys/stat.h>
+#	define stat _stat
+#else
+#	include <fcntl.h>
+#	include <unistd.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
 #endif
 
 
@@ -17,11 +26,18 @@ math    = "<math" expression ">" . /// See HarbolMath module for math parser's g
 ```
  */
 
-typedef struct {
-	size_t      errc;
-	intmax_t   *local_iota, *local_enum, global_iota, global_enum;
-	char const *cfg_filename;
-	uint32_t    curr_line;
+/// the parser only reports events, the map tree and the flat document are both built from them.
+typedef struct HarbolCfgState {
+	size_t                        errc, depth;
+	intmax_t                     *local_iota, *local_enum, global_iota, global_enum;
+	char const                   *cfg_filename;
+	struct HarbolCfgEvents const *events;
+	void                         *userdata;
+	struct HarbolCfgState const  *includer; /// state of the file that included this one.
+	struct HarbolArray           *deferred; /// if set, includes are left as slots for the parallel loader.
+	struct HarbolMap             *lazy;     /// if set, top-level sections are only indexed for the lazy parser.
+	uint32_t                      curr_line;
+	bool                          skipping, stopped;
 } HarbolCfgState;
 
 
@@ -76,8 +92,30 @@ static bool NO_NULL _lex_number(char const **restrict strref, struct HarbolStrin
 	return str->len > 0;
 }
 
-static NO_NULL bool harbol_cfg_parse_section(struct HarbolMap *cfg, char const **code_ref, HarbolCfgState *parse_state);
-static NO_NULL bool harbol_cfg_parse_number(struct HarbolMap *cfg, struct HarbolString const *key, char const **code_ref, HarbolCfgState *parse_state);
+static NO_NULL bool harbol_cfg_parse_section(char const **code_ref, HarbolCfgState *parse_state);
+static NO_NULL bool harbol_cfg_parse_value(struct HarbolString const *key, char const **code_ref, HarbolCfgState *parse_state);
+static NO_NULL bool harbol_cfg_parse_number(struct HarbolString const *key, char const **code_ref, HarbolCfgState *parse_state);
+static NO_NULL bool _harbol_cfg_parse_include(struct HarbolString const *filename, HarbolCfgState *parse_state);
+static NO_NULL bool _harbol_cfg_defer_section(struct HarbolString const *key, char const section[], uint32_t line, HarbolCfgState *parse_state);
+
+/// events are muted while skipping, a muted event just continues.
+static NEVER_NULL(1, 3) enum HarbolCfgEventRes _harbol_cfg_emit_key(HarbolCfgState *const restrict parse_state, HarbolCfgKeyEvent *const event, struct HarbolString const *const key) {
+	if( event==NULL || parse_state->skipping ) {
+		return HarbolCfgEvent_Continue;
+	}
+	enum HarbolCfgEventRes const res = (*event)(parse_state->userdata, key, parse_state->depth);
+	parse_state->stopped |= res==HarbolCfgEvent_Stop;
+	return res;
+}
+
+static NO_NULL bool _harbol_cfg_emit_value(HarbolCfgState *const restrict parse_state, struct HarbolString const *const key, enum HarbolCfgType const type, void *const val) {
+	if( parse_state->events->value==NULL || parse_state->skipping ) {
+		return true;
+	}
+	enum HarbolCfgEventRes const res = (*parse_state->events->value)(parse_state->userdata, key, type, val, parse_state->depth);
+	parse_state->stopped |= res==HarbolCfgEvent_Stop;
+	return res==HarbolCfgEvent_Continue || res==HarbolCfgEvent_Skip;
+}
 
 
 static void _harbol_cfg_math_var_func(
@@ -143,7 +181,7 @@ static inline bool _cfgmath_end_and_newline(int32_t const c) {
 }
 
 /// keyval = ( string | "<include>" | "<enum>" | math ) [':'] ( value | section ) [','] .
-static bool harbol_cfg_parse_key_val(struct HarbolMap *const restrict map, char const **cfgcoderef, HarbolCfgState *const restrict parse_state) {
+static bool harbol_cfg_parse_key_val(char const **cfgcoderef, HarbolCfgState *const restrict parse_state) {
 	if( *cfgcoderef==NULL ) {
 		harbol_write_msg(&parse_state->errc, stderr, parse_state->cfg_filename, "parse error", COLOR_RED, NULL, NULL, "Harbol Config Parser :: invalid config buffer!\n");
 		return false;
@@ -164,10 +202,6 @@ static bool harbol_cfg_parse_key_val(struct HarbolMap *const restrict map, char
 		harbol_write_msg(&parse_state->errc, stderr, parse_state->cfg_filename, "syntax error", COLOR_RED, &parse_state->curr_line, NULL, "Harbol Config Parser :: empty string key '%s'.\n", keystr.cstr);
 		harbol_string_clear(&keystr);
 		return false;
-	} else if( harbol_map_has_key(map, keystr.cstr, keystr.len+1) ) {
-		harbol_write_msg(&parse_state->errc, stderr, parse_state->cfg_filename, "syntax error", COLOR_RED, &parse_state->curr_line, NULL, "Harbol Config Parser :: duplicate string key '%s'.\n", keystr.cstr);
-		harbol_string_clear(&keystr);
-		return false;
 	}
 	skip_ws_and_comments(cfgcoderef, parse_state);
 	
@@ -187,18 +221,16 @@ static bool harbol_cfg_parse_key_val(struct HarbolMap *const restrict map, char
 		}
 		
 		harbol_string_clear(&keystr);
-		struct HarbolMap *included_cfg = harbol_cfg_parse_file(file_path.cstr);
-		if( included_cfg==NULL ) {
-			/// if we failed somehow, warn, and set the value as a null.
+		/// the included file becomes a section named after it.
+		enum HarbolCfgEventRes const key_res = _harbol_cfg_emit_key(parse_state, parse_state->events->key, &file_path);
+		if( key_res==HarbolCfgEvent_Error ) {
+			harbol_write_msg(&parse_state->errc, stderr, parse_state->cfg_filename, "syntax error", COLOR_RED, &parse_state->curr_line, NULL, "Harbol Config Parser :: duplicate or rejected string key '%s'.\n", file_path.cstr);
+		} else if( key_res==HarbolCfgEvent_Continue && !parse_state->skipping && !_harbol_cfg_parse_include(&file_path, parse_state) && !parse_state->stopped ) {
+			/// if we failed somehow, warn and leave the include out.
 			harbol_write_msg(NULL, stderr, parse_state->cfg_filename, "parse warning", COLOR_MAGENTA, &parse_state->curr_line, NULL, "Harbol Config Parser :: failed to include cfg file '%s'\n", file_path.cstr);
-			harbol_string_clear(&file_path);
-			return true;
-		} else {
-			struct HarbolVariant var = harbol_variant_make(&included_cfg, sizeof included_cfg, HarbolCfgType_Map, &( bool ){0});
-			bool const inclusion_res = harbol_map_insert(map, file_path.cstr, file_path.len+1, &var, sizeof var);
-			harbol_string_clear(&file_path);
-			return inclusion_res;
 		}
+		harbol_string_clear(&file_path);
+		return key_res != HarbolCfgEvent_Error && !parse_state->stopped;
 	} else {
 		intmax_t const local_enum_value    = *parse_state->local_enum;
 		intmax_t const global_enum_value   = parse_state->global_enum;
@@ -221,47 +253,114 @@ static bool harbol_cfg_parse_key_val(struct HarbolMap *const restrict map, char
 		_harbol_cfg_parse_inline_math(&keystr, parse_state, true);
 	}
 	
+	enum HarbolCfgEventRes const key_res = _harbol_cfg_emit_key(parse_state, parse_state->events->key, &keystr);
+	if( key_res==HarbolCfgEvent_Error ) {
+		harbol_write_msg(&parse_state->errc, stderr, parse_state->cfg_filename, "syntax error", COLOR_RED, &parse_state->curr_line, NULL, "Harbol Config Parser :: duplicate or rejected string key '%s'.\n", keystr.cstr);
+		harbol_string_clear(&keystr);
+		return false;
+	} else if( key_res==HarbolCfgEvent_Stop ) {
+		harbol_string_clear(&keystr);
+		return false;
+	}
+	
+	bool const was_skipping = parse_state->skipping;
+	parse_state->skipping |= key_res==HarbolCfgEvent_Skip;
+	bool const res = harbol_cfg_parse_value(&keystr, cfgcoderef, parse_state);
+	parse_state->skipping = was_skipping;
+	harbol_string_clear(&keystr);
+	skip_ws_and_comments(cfgcoderef, parse_state);
+	return res;
+}
+
+/// a skipped section is only scanned for its closing brace.
+/// gives up if the section could bump the global IOTA or ENUM counters, it's then parsed without reporting instead.
+static NO_NULL bool _harbol_cfg_skip_section(char const **const cfgcoderef, HarbolCfgState *const restrict parse_state) {
+	uint32_t lines = 0;
+	size_t nesting = 0;
+	for( char const *iter = *cfgcoderef; *iter != 0; ) {
+		if( *iter=='#' || (*iter=='/' && iter[1]=='/') ) {
+			iter = skip_single_line_comment(iter, &lines);
+		} else if( *iter=='/' && iter[1]=='*' ) {
+			iter = skip_multi_line_comment(iter, "*/", sizeof "*/"-1, &lines);
+		} else if( *iter=='"' || *iter=='\'' ) {
+			char const quote = *iter++;
+			for( ; *iter != 0 && *iter != quote; iter++ ) {
+				if( *iter=='\\' && iter[1] != 0 ) {
+					iter++;
+				} else if( *iter=='<' && !strncmp(iter, "<ENUM>", sizeof "<ENUM>"-1) ) {
+					return false;
+				}
+			}
+			iter += *iter != 0;
+		} else if( (*iter=='I' && !strncmp(iter, "IOTA", sizeof "IOTA"-1)) || (*iter=='E' && !strncmp(iter, "ENUM", sizeof "ENUM"-1)) ) {
+			return false;
+		} else {
+			lines += *iter=='\n';
+			if( *iter=='{' ) {
+				nesting++;
+			} else if( *iter=='}' && --nesting==0 ) {
+				*cfgcoderef = iter + 1;
+				parse_state->curr_line += lines;
+				return true;
+			}
+			iter++;
+		}
+	}
+	return false;
+}
+
+/// value = string | number | vec | "true" | "false" | "null" | "iota" | "<FILE>" | math | section .
+static bool harbol_cfg_parse_value(struct HarbolString const *const key, char const **cfgcoderef, HarbolCfgState *const restrict parse_state) {
 	bool res = false;
 	/// it's a section!
 	if( **cfgcoderef=='{' ) {
-		intmax_t *const old_iota = parse_state->local_iota;
-		intmax_t *const old_enum = parse_state->local_enum;
-		parse_state->local_iota = &( intmax_t ){0};
-		parse_state->local_enum = &( intmax_t ){0};
+		if( parse_state->lazy != NULL && parse_state->depth==0 && !parse_state->skipping ) {
+			char const *const section = *cfgcoderef;
+			uint32_t const line = parse_state->curr_line;
+			if( _harbol_cfg_skip_section(cfgcoderef, parse_state) ) {
+				return _harbol_cfg_defer_section(key, section, line, parse_state);
+			}
+		}
 		
-		struct HarbolMap *subsection = harbol_map_new(4);
-		if( subsection==NULL ) {
-			harbol_write_msg(&parse_state->errc, stderr, parse_state->cfg_filename, "memory error", COLOR_RED, &parse_state->curr_line, NULL, "Harbol Config Parser :: unable to allocate subsection for key '%s'.\n", keystr.cstr);
-			harbol_string_clear(&keystr);
+		enum HarbolCfgEventRes const begin_res = _harbol_cfg_emit_key(parse_state, parse_state->events->begin_section, key);
+		if( begin_res==HarbolCfgEvent_Error ) {
+			harbol_write_msg(&parse_state->errc, stderr, parse_state->cfg_filename, "memory error", COLOR_RED, &parse_state->curr_line, NULL, "Harbol Config Parser :: unable to allocate subsection for key '%s'.\n", key->cstr);
+			return false;
+		} else if( begin_res==HarbolCfgEvent_Stop ) {
 			return false;
 		}
 		
-		res = harbol_cfg_parse_section(subsection, cfgcoderef, parse_state);
-		struct HarbolVariant var = harbol_variant_make(&subsection, sizeof subsection, HarbolCfgType_Map, &( bool ){0});
-		if( !harbol_map_insert(map, keystr.cstr, keystr.len+1, &var, sizeof var) ) {
-			harbol_write_msg(NULL, stderr, parse_state->cfg_filename, "memory warning", COLOR_MAGENTA, &parse_state->curr_line, NULL, "Harbol Config Parser :: some how failed to insert subsection for key '%s', destroying...\n", keystr.cstr);
-			harbol_cfg_free(&subsection);
-			harbol_string_clear(&keystr);
-			harbol_variant_clear(&var);
+		bool const was_skipping = parse_state->skipping;
+		parse_state->skipping |= begin_res==HarbolCfgEvent_Skip;
+		if( parse_state->skipping && _harbol_cfg_skip_section(cfgcoderef, parse_state) ) {
+			parse_state->skipping = was_skipping;
+			return true;
+		}
+		
+		intmax_t *const old_iota = parse_state->local_iota;
+		intmax_t *const old_enum = parse_state->local_enum;
+		parse_state->local_iota = &( intmax_t ){0};
+		parse_state->local_enum = &( intmax_t ){0};
+		parse_state->depth++;
+		res = harbol_cfg_parse_section(cfgcoderef, parse_state);
+		parse_state->depth--;
+		if( !parse_state->stopped && _harbol_cfg_emit_key(parse_state, parse_state->events->end_section, key)==HarbolCfgEvent_Error ) {
+			harbol_write_msg(NULL, stderr, parse_state->cfg_filename, "memory warning", COLOR_MAGENTA, &parse_state->curr_line, NULL, "Harbol Config Parser :: some how failed to insert subsection for key '%s', destroying...\n", key->cstr);
 		}
+		parse_state->skipping = was_skipping;
+		res &= !parse_state->stopped;
 		parse_state->local_iota = old_iota;
 		parse_state->local_enum = old_enum;
 	} else if( **cfgcoderef=='"' || **cfgcoderef=='\'' ) {
 		/// string value.
-		struct HarbolString *str = harbol_string_new(NULL);
-		if( str==NULL ) {
-			harbol_write_msg(&parse_state->errc, stderr, parse_state->cfg_filename, "memory error", COLOR_RED, &parse_state->curr_line, NULL, "Harbol Config Parser :: unable to allocate string value for key '%s'.\n", keystr.cstr);
-			harbol_string_clear(&keystr);
-			return false;
-		}
-		
-		int const str_res = lex_c_style_str(*cfgcoderef, cfgcoderef, str);
+		struct HarbolString str = {0};
+		int const str_res = lex_c_style_str(*cfgcoderef, cfgcoderef, &str);
 		if( str_res > HarbolLexNoErr ) {
-			harbol_write_msg(&parse_state->errc, stderr, parse_state->cfg_filename, "syntax error", COLOR_RED, &parse_state->curr_line, NULL, "Harbol Config Parser :: invalid string value '%s' for key '%s' %s.\n", str->cstr, keystr.cstr, lex_get_err(str_res));
-			harbol_string_clear(&keystr);
+			harbol_write_msg(&parse_state->errc, stderr, parse_state->cfg_filename, "syntax error", COLOR_RED, &parse_state->curr_line, NULL, "Harbol Config Parser :: invalid string value '%s' for key '%s' %s.\n", str.cstr, key->cstr, lex_get_err(str_res));
+			harbol_string_clear(&str);
 			return false;
 		}
-		char *math_marker = strstr(str->cstr, "<math");
+		char *math_marker = ( str.cstr==NULL )? NULL : strstr(str.cstr, "<math");
 		if( math_marker != NULL ) {
 			char *const math_start = math_marker + sizeof "<math"-1;
 			char *const math_end = strchr(math_start, '>');
@@ -273,12 +372,11 @@ static bool harbol_cfg_parse_key_val(struct HarbolMap *const restrict map, char
 				*math_end = '>';
 			}
 			char *number = sprintf_alloc("%" PRIfMAX "", expr_result);
-			harbol_string_replace_range(str, math_marker - str->cstr, ( size_t )(math_end - str->cstr), number);
+			harbol_string_replace_range(&str, math_marker - str.cstr, ( size_t )(math_end - str.cstr), number);
 			free(number); number = NULL;
 		}
-		struct HarbolVariant var = harbol_variant_make(&str, sizeof str, HarbolCfgType_String, &( bool ){0});
-		harbol_map_insert(map, keystr.cstr, keystr.len+1, &var, sizeof var);
-		res = true;
+		res = _harbol_cfg_emit_value(parse_state, key, HarbolCfgType_String, &str);
+		harbol_string_clear(&str);
 	} else if( **cfgcoderef=='c' || **cfgcoderef=='v' ) {
 		/// color or vector value!
 		char const valtype = *(*cfgcoderef)++;
@@ -286,7 +384,6 @@ static bool harbol_cfg_parse_key_val(struct HarbolMap *const restrict map, char
 		
 		if( **cfgcoderef!='[' ) {
 			harbol_write_msg(&parse_state->errc, stderr, parse_state->cfg_filename, "syntax error", COLOR_RED, &parse_state->curr_line, NULL, "Harbol Config Parser :: missing '[', got '%c' instead.\n", **cfgcoderef);
-			harbol_string_clear(&keystr);
 			return false;
 		}
 		(*cfgcoderef)++;
@@ -317,96 +414,79 @@ static bool harbol_cfg_parse_key_val(struct HarbolMap *const restrict map, char
 			}
 			harbol_string_clear(&numstr);
 			if( !result ) {
-				harbol_write_msg(&parse_state->errc, stderr, parse_state->cfg_filename, "syntax error", COLOR_RED, &parse_state->curr_line, NULL, "Harbol Config Parser :: invalid number in %s array for key '%s'.\n", valtype=='c'? "color" : "vector", keystr.cstr);
-				harbol_string_clear(&keystr);
+				harbol_write_msg(&parse_state->errc, stderr, parse_state->cfg_filename, "syntax error", COLOR_RED, &parse_state->curr_line, NULL, "Harbol Config Parser :: invalid number in %s array for key '%s'.\n", valtype=='c'? "color" : "vector", key->cstr);
 				return false;
 			}
 			skip_ws_and_comments(cfgcoderef, parse_state);
 		}
 		if( **cfgcoderef==0 ) {
 			harbol_write_msg(&parse_state->errc, stderr, parse_state->cfg_filename, "syntax error", COLOR_RED, &parse_state->curr_line, NULL, "Harbol Config Parser :: unexpected end of file with ending ']' missing.\n");
-			harbol_string_clear(&keystr);
 			return false;
 		}
 		(*cfgcoderef)++;
 		
-		struct HarbolVariant var = (valtype=='c')?
-			  harbol_variant_make(&matrix_value.color, sizeof matrix_value.color, HarbolCfgType_Color, &( bool ){0})
-			: harbol_variant_make(&matrix_value.vec4d, sizeof matrix_value.vec4d, HarbolCfgType_Vec4D, &( bool ){0});
-		res = harbol_map_insert(map, keystr.cstr, keystr.len+1, &var, sizeof var);
+		res = (valtype=='c')?
+			  _harbol_cfg_emit_value(parse_state, key, HarbolCfgType_Color, &matrix_value.color)
+			: _harbol_cfg_emit_value(parse_state, key, HarbolCfgType_Vec4D, &matrix_value.vec4d);
 	} else if( **cfgcoderef=='t' ) {
 		/// true bool value.
 		if( strncmp("true", *cfgcoderef, sizeof("true")-1) ) {
 			harbol_write_msg(&parse_state->errc, stderr, parse_state->cfg_filename, "syntax error", COLOR_RED, &parse_state->curr_line, NULL, "Harbol Config Parser :: invalid keyword value, only 'true', 'false', 'null', 'iota', and 'IOTA' are allowed.\n");
-			harbol_string_clear(&keystr);
 			return false;
 		}
 		*cfgcoderef += sizeof("true") - 1;
-		struct HarbolVariant var = harbol_variant_make(&( bool ){true}, sizeof(bool), HarbolCfgType_Bool, &( bool ){0});
-		res = harbol_map_insert(map, keystr.cstr, keystr.len+1, &var, sizeof var);
+		res = _harbol_cfg_emit_value(parse_state, key, HarbolCfgType_Bool, &( bool ){true});
 	} else if( **cfgcoderef=='f' ) {
 		/// false bool value
 		if( strncmp("false", *cfgcoderef, sizeof("false")-1) ) {
 			harbol_write_msg(&parse_state->errc, stderr, parse_state->cfg_filename, "syntax error", COLOR_RED, &parse_state->curr_line, NULL, "Harbol Config Parser :: invalid keyword value, only 'true', 'false', 'null', 'iota', and 'IOTA' are allowed.\n");
-			harbol_string_clear(&keystr);
 			return false;
 		}
 		*cfgcoderef += sizeof("false") - 1;
-		struct HarbolVariant var = harbol_variant_make(&( bool ){false}, sizeof(bool), HarbolCfgType_Bool, &( bool ){0});
-		res = harbol_map_insert(map, keystr.cstr, keystr.len+1, &var, sizeof var);
+		res = _harbol_cfg_emit_value(parse_state, key, HarbolCfgType_Bool, &( bool ){false});
 	} else if( **cfgcoderef=='n' ) {
 		/// null value.
 		if( strncmp("null", *cfgcoderef, sizeof("null")-1) ) {
 			harbol_write_msg(&parse_state->errc, stderr, parse_state->cfg_filename, "syntax error", COLOR_RED, &parse_state->curr_line, NULL, "Harbol Config Parser :: invalid keyword value, only 'true', 'false', 'null', 'iota', and 'IOTA' are allowed.\n");
-			harbol_string_clear(&keystr);
 			return false;
 		}
 		*cfgcoderef += sizeof("null") - 1;
-		struct HarbolVariant var = harbol_variant_make(&( char ){0}, sizeof(char), HarbolCfgType_Null, &( bool ){0});
-		res = harbol_map_insert(map, keystr.cstr, keystr.len+1, &var, sizeof var);
+		res = _harbol_cfg_emit_value(parse_state, key, HarbolCfgType_Null, &( char ){0});
 	} else if( **cfgcoderef=='I' ) {
 		/// local iota value.
 		if( strncmp("IOTA", *cfgcoderef, sizeof("IOTA")-1) ) {
 			harbol_write_msg(&parse_state->errc, stderr, parse_state->cfg_filename, "syntax error", COLOR_RED, &parse_state->curr_line, NULL, "Harbol Config Parser :: invalid keyword value, only 'true', 'false', 'null', 'iota', and 'IOTA' are allowed.\n");
-			harbol_string_clear(&keystr);
 			return false;
 		}
 		*cfgcoderef += sizeof("IOTA") - 1;
-		struct HarbolVariant var = harbol_variant_make(&parse_state->global_iota, sizeof parse_state->global_iota, HarbolCfgType_Int, &( bool ){0});
+		res = _harbol_cfg_emit_value(parse_state, key, HarbolCfgType_Int, &( intmax_t ){parse_state->global_iota});
 		parse_state->global_iota++;
-		res = harbol_map_insert(map, keystr.cstr, keystr.len+1, &var, sizeof var);
 	} else if( **cfgcoderef=='i' ) {
 		/// local iota value.
 		if( strncmp("iota", *cfgcoderef, sizeof("iota")-1) ) {
 			harbol_write_msg(&parse_state->errc, stderr, parse_state->cfg_filename, "syntax error", COLOR_RED, &parse_state->curr_line, NULL, "Harbol Config Parser :: invalid keyword value, only 'true', 'false', 'null', 'iota', and 'IOTA' are allowed.\n");
-			harbol_string_clear(&keystr);
 			return false;
 		}
 		*cfgcoderef += sizeof("iota") - 1;
-		struct HarbolVariant var = harbol_variant_make(parse_state->local_iota, sizeof *parse_state->local_iota, HarbolCfgType_Int, &( bool ){0});
+		res = _harbol_cfg_emit_value(parse_state, key, HarbolCfgType_Int, &( intmax_t ){*parse_state->local_iota});
 		++*parse_state->local_iota;
-		res = harbol_map_insert(map, keystr.cstr, keystr.len+1, &var, sizeof var);
 	} else if( is_decimal(**cfgcoderef) || **cfgcoderef=='.' || **cfgcoderef=='-' || **cfgcoderef=='+' ) {
 		/// numeric value.
-		res = harbol_cfg_parse_number(map, &keystr, cfgcoderef, parse_state);
+		res = harbol_cfg_parse_number(key, cfgcoderef, parse_state);
 	} else if( **cfgcoderef=='[' ) {
 		harbol_write_msg(&parse_state->errc, stderr, parse_state->cfg_filename, "syntax error", COLOR_RED, &parse_state->curr_line, NULL, "Harbol Config Parser :: array bracket missing 'c' or 'v' tag.\n");
-		harbol_string_clear(&keystr);
 		return false;
 	} else if( **cfgcoderef=='<' ) { /// control/special value.
 		/// <FILE> is the name of the config file we're parsing.
 		size_t const file_cstr_len = sizeof("<file>") - 1;
 		if( !strncmp("<file>", *cfgcoderef, file_cstr_len) || !strncmp("<FILE>", *cfgcoderef, file_cstr_len) ) {
-			struct HarbolString *str = harbol_string_new(NULL);
-			if( str==NULL ) {
-				harbol_write_msg(&parse_state->errc, stderr, parse_state->cfg_filename, "memory error", COLOR_RED, &parse_state->curr_line, NULL, "Harbol Config Parser :: unable to allocate string value for key '%s'.\n", keystr.cstr);
-				harbol_string_clear(&keystr);
+			struct HarbolString str = harbol_string_make(( parse_state->cfg_filename==NULL )? "C-string-cfg" : parse_state->cfg_filename, &( bool ){false});
+			if( str.cstr==NULL ) {
+				harbol_write_msg(&parse_state->errc, stderr, parse_state->cfg_filename, "memory error", COLOR_RED, &parse_state->curr_line, NULL, "Harbol Config Parser :: unable to allocate string value for key '%s'.\n", key->cstr);
 				return false;
 			}
-			
-			harbol_string_copy_cstr(str, ( parse_state->cfg_filename==NULL )? "C-string-cfg" : parse_state->cfg_filename);
-			struct HarbolVariant var = harbol_variant_make(&str, sizeof str, HarbolCfgType_String, &( bool ){0});
-			res = harbol_map_insert(map, keystr.cstr, keystr.len+1, &var, sizeof var);
+			res = _harbol_cfg_emit_value(parse_state, key, HarbolCfgType_String, &str);
+			harbol_string_clear(&str);
 			*cfgcoderef += file_cstr_len;
 		} else {
 			harbol_write_msg(&parse_state->errc, stderr, parse_state->cfg_filename, "syntax error", COLOR_RED, &parse_state->curr_line, NULL, "Harbol Config Parser :: unknown control/command '%c'.\n", (*cfgcoderef)[1]);
@@ -416,12 +496,10 @@ static bool harbol_cfg_parse_key_val(struct HarbolMap *const restrict map, char
 		harbol_write_msg(&parse_state->errc, stderr, parse_state->cfg_filename, "syntax error", COLOR_RED, &parse_state->curr_line, NULL, "Harbol Config Parser :: unknown character detected '%c'.\n", **cfgcoderef);
 		res = false;
 	}
-	harbol_string_clear(&keystr);
-	skip_ws_and_comments(cfgcoderef, parse_state);
 	return res;
 }
 
-static bool harbol_cfg_parse_number(struct HarbolMap *const restrict map, struct HarbolString const *const key, char const **cfgcoderef, HarbolCfgState *const restrict parse_state) {
+static bool harbol_cfg_parse_number(struct HarbolString const *const key, char const **cfgcoderef, HarbolCfgState *const restrict parse_state) {
 	struct HarbolString numstr = {0};
 	enum HarbolCfgType type = HarbolCfgType_Null;
 	if( !_lex_number(cfgcoderef, &numstr, &type, parse_state) ) {
@@ -430,20 +508,20 @@ static bool harbol_cfg_parse_number(struct HarbolMap *const restrict map, struct
 		return false;
 	}
 	
-	struct HarbolVariant var = {0};
+	bool res = false;
 	if( type==HarbolCfgType_Float ) {
 		floatmax_t f = lex_string_to_float(&numstr);
-		var = harbol_variant_make(&f, sizeof f, type, &( bool ){0});
+		res = _harbol_cfg_emit_value(parse_state, key, HarbolCfgType_Float, &f);
 	} else {
 		intmax_t i = strtoll(numstr.cstr, NULL, 0);
-		var = harbol_variant_make(&i, sizeof i, HarbolCfgType_Int, &( bool ){0});
+		res = _harbol_cfg_emit_value(parse_state, key, HarbolCfgType_Int, &i);
 	}
 	harbol_string_clear(&numstr);
-	return harbol_map_insert(map, key->cstr, key->len+1, &var, sizeof var);
+	return res;
 }
 
 /// section = '{' <keyval> '}' ;
-static bool harbol_cfg_parse_section(struct HarbolMap *const restrict map, char const **cfgcoderef, HarbolCfgState *const restrict parse_state) {
+static bool harbol_cfg_parse_section(char const **cfgcoderef, HarbolCfgState *const restrict parse_state) {
 	if( **cfgcoderef!='{' ) {
 		harbol_write_msg(&parse_state->errc, stderr, parse_state->cfg_filename, "syntax error", COLOR_RED, &parse_state->curr_line, NULL, "Harbol Config Parser :: missing '{' but got '%c' for section.\n", **cfgcoderef);
 		return false;
@@ -452,7 +530,7 @@ static bool harbol_cfg_parse_section(struct HarbolMap *const restrict map, char
 	skip_ws_and_comments(cfgcoderef, parse_state);
 	
 	while( **cfgcoderef != 0 && **cfgcoderef != '}' ) {
-		bool const res = harbol_cfg_parse_key_val(map, cfgcoderef, parse_state);
+		bool const res = harbol_cfg_parse_key_val(cfgcoderef, parse_state);
 		if( !res ) {
 			return false;
 		}
@@ -466,49 +544,6 @@ static bool harbol_cfg_parse_section(struct HarbolMap *const restrict map, char
 	return true;
 }
 
-static struct HarbolMap *_harbol_cfg_parse(char const cfgcode[static 1], HarbolCfgState *const restrict parse_state) {
-	parse_state->curr_line = 1;
-	char const *iter = cfgcode;
-	struct HarbolMap *objs = harbol_map_new(8);
-	if( objs==NULL ) {
-		return NULL;
-	}
-	parse_state->local_iota = &( intmax_t ){0};
-	parse_state->local_enum = &( intmax_t ){0};
-	while( harbol_cfg_parse_key_val(objs, &iter, parse_state) );
-	return objs;
-}
-
-HARBOL_EXPORT struct HarbolMap *harbol_cfg_parse_file(char const filename[static 1]) {
-	HarbolCfgState parse_state = {0};
-	FILE *restrict cfgfile = fopen(filename, "r");
-	if( cfgfile==NULL ) {
-		harbol_write_msg(&parse_state.errc, stderr, NULL, "parse error", COLOR_RED, NULL, NULL, "Harbol Config Parser :: unable to find file '%s'.\n", filename);
-		return NULL;
-	}
-	
-	struct HarbolString cfg = {0};
-	bool const read_result = harbol_string_read_from_file(&cfg, cfgfile);
-	fclose(cfgfile); cfgfile = NULL;
-	if( !read_result ) {
-		harbol_write_msg(&parse_state.errc, stderr, NULL, "parse error", COLOR_RED, NULL, NULL, "Harbol Config Parser :: failed to read file '%s' into string.\n", filename);
-		return NULL;
-	}
-	/// fix up new lines and tabs.
-	lex_fix_newlines(&cfg, true);
-	parse_state.cfg_filename = filename;
-	struct HarbolMap *const restrict objs = _harbol_cfg_parse(cfg.cstr, &parse_state);
-	harbol_string_clear(&cfg);
-	return objs;
-}
-
-
-HARBOL_EXPORT struct HarbolMap *harbol_cfg_parse_cstr(char const cfgcode[static 1]) {
-	HarbolCfgState parse_state = {0};
-	return _harbol_cfg_parse(cfgcode, &parse_state);
-}
-
-
 union ConfigVal {
 	uint8_t              *restrict data;
 	struct HarbolMap    **restrict section;
@@ -521,7 +556,7 @@ union ConfigVal {
 };
 
 static void _harbol_cfgkey_clear(struct HarbolVariant *const var) {
-	union ConfigVal cv = {var->data};
+	union ConfigVal cv = {harbol_variant_data(var)};
 	switch( var->tag ) {
 		case HarbolCfgType_Map:       harbol_cfg_free(cv.section); break;
 		case HarbolCfgType_String:    harbol_string_free(cv.str);  break;
@@ -541,363 +576,3255 @@ HARBOL_EXPORT void harbol_cfg_free(struct HarbolMap **const cfg_ref) {
 	harbol_map_free(cfg_ref);
 }
 
-static NO_NULL void _concat_tabs(struct HarbolString *const str, size_t const tabs) {
-	for( size_t i=0; i < tabs; i++ ) {
-		harbol_string_add_cstr(str, "\t");
+static size_t _harbol_cfg_type_size(enum HarbolCfgType const type) {
+	switch( type ) {
+		case HarbolCfgType_Map:    return sizeof(struct HarbolMap*);
+		case HarbolCfgType_String: return sizeof(struct HarbolString*);
+		case HarbolCfgType_Float:  return sizeof(floatmax_t);
+		case HarbolCfgType_Int:    return sizeof(intmax_t);
+		case HarbolCfgType_Bool:   return sizeof(bool);
+		case HarbolCfgType_Color:  return sizeof(union HarbolColor);
+		case HarbolCfgType_Vec4D:  return sizeof(struct HarbolVec4D);
+		default:                   return sizeof(char);
 	}
 }
 
-HARBOL_EXPORT struct HarbolString harbol_cfg_to_str(struct HarbolMap const *const map) {
-	static size_t tabs = 0;
-	struct HarbolString cfg_str = harbol_string_make(NULL, &( bool ){false});
-	struct HarbolString *str = &cfg_str;
-	for( size_t i=0; i < map->len; i++ ) {
-		struct HarbolVariant const *const var = ( struct HarbolVariant const* )(map->datum[i]);
-		union ConfigVal const cv = { var->data };
-		
-		_concat_tabs(str, tabs);
-		harbol_string_format(str, false, "\"%s\": ", ( char const* )(map->keys[i]));
-		switch( var->tag ) {
-			case HarbolCfgType_Null:
-				harbol_string_add_cstr(str, "null\n");
-				break;
-			case HarbolCfgType_Map: {
-				harbol_string_add_cstr(str, "{\n");
-				tabs++;
-				struct HarbolString inner_str = harbol_cfg_to_str(*cv.section);
-				if( !harbol_string_empty(&inner_str) ) {
-					harbol_string_add_str(str, &inner_str);
-				}
-				harbol_string_clear(&inner_str);
-				_concat_tabs(str, --tabs);
-				harbol_string_add_cstr(str, "}\n");
-				break;
-			}
-			case HarbolCfgType_String:
-				harbol_string_format(str, false, "\"%s\"\n", (*cv.str)->cstr);
-				break;
-			case HarbolCfgType_Float:
-				harbol_string_format(str, false, "%" PRIfMAX "\n", *cv.f);
-				break;
-			case HarbolCfgType_Int:
-				harbol_string_format(str, false, "%" PRIiMAX "\n", *cv.i);
-				break;
-			case HarbolCfgType_Bool:
-				harbol_string_add_cstr(str, *cv.b? "true\n" : "false\n");
-				break;
-			case HarbolCfgType_Color:
-				harbol_string_format(str, false, "c[ %u, %u, %u, %u ]\n", cv.c->bytes.r, cv.c->bytes.g, cv.c->bytes.b, cv.c->bytes.a);
-				break;
-			case HarbolCfgType_Vec4D:
-				harbol_string_format(str, false, "v[ %" PRIf32 ", %" PRIf32 ", %" PRIf32 ", %" PRIf32 " ]\n", cv.v->x, cv.v->y, cv.v->z, cv.v->w);
-				break;
-		}
-	}
-	return cfg_str;
+/// the map tree is built from parse events, the sections being filled are kept on a stack.
+struct HarbolCfgTreeBuilder {
+	struct HarbolArray open; /// struct HarbolMap*
+};
+
+static NO_NULL struct HarbolMap *_harbol_cfg_tree_section(struct HarbolCfgTreeBuilder const *const tb) {
+	return *( struct HarbolMap *const* )(harbol_array_peek(&tb->open, sizeof(struct HarbolMap*)));
 }
 
-static NO_NULL bool harbol_cfg_parse_target_path(char const key[static 1], struct HarbolString *const restrict str) {
-	/// parse something like: "root.section1.section2.section3.\\.dotsection"
-	char const *iter = key;
-	iter += strlen(key) - 1;
-	while( iter != key ) {
-		if( *iter=='.' ) {
-			if( iter[-1]=='\\' ) {
-				iter--;
-			} else {
-				iter++;
-				break;
-			}
-		} else {
-			iter--;
-		}
-	}
-	
-	/// now we save the target section and then use the resulting string.
-	while( *iter != 0 ) {
-		if( *iter=='\\' ) {
-			iter++;
-			continue;
-		}
-		harbol_string_add_char(str, *iter++);
-	}
-	return str->len > 0;
+static enum HarbolCfgEventRes _harbol_cfg_tree_check_key(void *const data, struct HarbolString const *const key, size_t const depth) {
+	(void)(depth);
+	return( harbol_map_has_key(_harbol_cfg_tree_section(data), key->cstr, key->len+1) )? HarbolCfgEvent_Error : HarbolCfgEvent_Continue;
 }
 
-static NO_NULL struct HarbolVariant *_get_var(struct HarbolMap const *const cfgmap, char const key[const]) {
-	/// first check if we're getting a singular value OR we iterate through a sectional path.
-	char const *dot = strchr(key, '.');
-	
-	/// Patch: dot and escaped dot glitching out the hashmap hashing...
-	if( dot==NULL || (dot > key && (dot[-1] == '\\')) ) {
-		struct HarbolVariant *const restrict var = harbol_map_key_get(cfgmap, key, strlen(key)+1);
-		return( var==NULL || var->tag==HarbolCfgType_Null )? NULL : var;
-	}
-	
-	/// ok, not a singular value, iterate to the specific map section then.
-	/// parse the target key first.
-	char const *iter = key;
-	struct HarbolString
-		sectionstr = {0},
-		targetstr = {0}
-	;
-	
-	harbol_cfg_parse_target_path(key, &targetstr);
-	struct HarbolMap const *itermap = cfgmap;
-	struct HarbolVariant *restrict var = NULL;
-	while( itermap != NULL ) {
-		harbol_string_clear(&sectionstr);
-		/// Patch: allow keys to use dot without interfering with dot path.
-		while( *iter != 0 ) {
-			if( *iter=='\\' && iter[1] != 0 && iter[1]=='.' ) {
-				iter++;
-				harbol_string_add_char(&sectionstr, *iter++);
-			} else if( *iter=='.' ) {
-				iter++;
-				break;
-			} else {
-				harbol_string_add_char(&sectionstr, *iter++);
-			}
-		}
-		if( harbol_string_empty(&sectionstr) ) {
-			break;
-		}
-		var = harbol_map_key_get(itermap, sectionstr.cstr, sectionstr.len+1);
-		if( var==NULL || !harbol_string_cmpstr(&sectionstr, &targetstr) ) {
-			break;
-		} else if( var->tag==HarbolCfgType_Map ) {
-			itermap = *( struct HarbolMap const** )(var->data);
-		}
+static enum HarbolCfgEventRes _harbol_cfg_tree_begin_section(void *const data, struct HarbolString const *const key, size_t const depth) {
+	(void)(key); (void)(depth);
+	struct HarbolCfgTreeBuilder *const tb = data;
+	struct HarbolMap *submap = harbol_map_new(4);
+	if( submap==NULL ) {
+		return HarbolCfgEvent_Error;
+	} else if( harbol_array_append(&tb->open, &submap, sizeof submap)==SIZE_MAX ) {
+		harbol_cfg_free(&submap);
+		return HarbolCfgEvent_Error;
 	}
-	harbol_string_clear(&sectionstr);
-	harbol_string_clear(&targetstr);
-	return var;
+	return HarbolCfgEvent_Continue;
 }
 
-HARBOL_EXPORT struct HarbolMap *harbol_cfg_get_section(struct HarbolMap const *const restrict cfgmap, char const key[static 1]) {
-	struct HarbolVariant const *const var = _get_var(cfgmap, key);
-	//printf("harbol_cfg_get_section :: var->tag==HarbolCfgType_Map: %u\n", var != NULL? var->tag==HarbolCfgType_Map : -1);
-	return( var==NULL || var->tag != HarbolCfgType_Map )? NULL : *( struct HarbolMap** )(var->data);
+static enum HarbolCfgEventRes _harbol_cfg_tree_end_section(void *const data, struct HarbolString const *const key, size_t const depth) {
+	(void)(depth);
+	struct HarbolCfgTreeBuilder *const tb = data;
+	struct HarbolMap *submap = *( struct HarbolMap** )(harbol_array_pop(&tb->open, sizeof submap));
+	struct HarbolVariant var = harbol_variant_make(&submap, sizeof submap, HarbolCfgType_Map, &( bool ){0});
+	if( !harbol_map_insert(_harbol_cfg_tree_section(tb), key->cstr, key->len+1, &var, sizeof var) ) {
+		harbol_cfg_free(&submap);
+		harbol_variant_clear(&var);
+		return HarbolCfgEvent_Error;
+	}
+	return HarbolCfgEvent_Continue;
 }
 
-HARBOL_EXPORT char *harbol_cfg_get_cstr(struct HarbolMap const *const cfgmap, char const key[static 1], size_t *const len) {
-	struct HarbolVariant const *const var = _get_var(cfgmap, key);
-	if( var==NULL || var->tag != HarbolCfgType_String ) {
-		return NULL;
+static enum HarbolCfgEventRes _harbol_cfg_tree_add_value(void *const data, struct HarbolString const *const key, enum HarbolCfgType const type, void *const val, size_t const depth) {
+	(void)(depth);
+	struct HarbolVariant var = {0};
+	if( type==HarbolCfgType_String ) {
+		/// take the lexed buffer instead of copying it.
+		struct HarbolString *str = malloc(sizeof *str);
+		if( str==NULL ) {
+			return HarbolCfgEvent_Error;
+		}
+		*str = *( struct HarbolString* )(val);
+		*( struct HarbolString* )(val) = ( struct HarbolString ){0};
+		var = harbol_variant_make(&str, sizeof str, type, &( bool ){0});
 	} else {
-		struct HarbolString const *const str = *( struct HarbolString** )(var->data);
-		*len = str->len;
-		return str->cstr;
+		var = harbol_variant_make(val, _harbol_cfg_type_size(type), type, &( bool ){0});
 	}
+	
+	if( !harbol_map_insert(_harbol_cfg_tree_section(data), key->cstr, key->len+1, &var, sizeof var) ) {
+		_harbol_cfgkey_clear(&var);
+		return HarbolCfgEvent_Error;
+	}
+	return HarbolCfgEvent_Continue;
 }
 
-HARBOL_EXPORT struct HarbolString *harbol_cfg_get_str(struct HarbolMap const *const cfgmap, char const key[static 1]) {
-	struct HarbolVariant const *const var = _get_var(cfgmap, key);
-	return( var==NULL || var->tag != HarbolCfgType_String )? NULL : *( struct HarbolString** )(var->data);
-}
-
-HARBOL_EXPORT floatmax_t *harbol_cfg_get_float(struct HarbolMap const *const cfgmap, char const key[static 1]) {
-	struct HarbolVariant const *const var = _get_var(cfgmap, key);
-	return( var==NULL || var->tag != HarbolCfgType_Float )? NULL : ( floatmax_t* )(var->data);
-}
-
-HARBOL_EXPORT intmax_t *harbol_cfg_get_int(struct HarbolMap const *const cfgmap, char const key[static 1]) {
-	struct HarbolVariant const *const var = _get_var(cfgmap, key);
-	return( var==NULL || var->tag != HarbolCfgType_Int )? NULL : ( intmax_t* )(var->data);
-}
+static struct HarbolCfgEvents const _harbol_cfg_tree_events = {
+	_harbol_cfg_tree_check_key,
+	_harbol_cfg_tree_begin_section,
+	_harbol_cfg_tree_end_section,
+	_harbol_cfg_tree_add_value,
+};
 
-HARBOL_EXPORT bool *harbol_cfg_get_bool(struct HarbolMap const *const cfgmap, char const key[static 1]) {
-	struct HarbolVariant const *const var = _get_var(cfgmap, key);
-	return( var==NULL || var->tag != HarbolCfgType_Bool )? NULL : ( bool* )(var->data);
+/// parses key-values until the end of 'iter' or the first failure.
+static NO_NULL bool _harbol_cfg_parse_key_vals(char const *iter, HarbolCfgState *const restrict parse_state) {
+	while( skip_ws_and_comments(&iter, parse_state) ) {
+		if( !harbol_cfg_parse_key_val(&iter, parse_state) ) {
+			return false;
+		}
+	}
+	return true;
 }
 
-HARBOL_EXPORT union HarbolColor *harbol_cfg_get_color(struct HarbolMap const *const cfgmap, char const key[static 1]) {
-	struct HarbolVariant const *const var = _get_var(cfgmap, key);
-	return( var==NULL || var->tag != HarbolCfgType_Color )? NULL : ( union HarbolColor* )(var->data);
+/// parses top-level key-values, reporting them to the state's events.
+static bool _harbol_cfg_parse(char const cfgcode[static 1], HarbolCfgState *const restrict parse_state) {
+	intmax_t local_iota = 0, local_enum = 0;
+	parse_state->curr_line  = 1;
+	parse_state->local_iota = &local_iota;
+	parse_state->local_enum = &local_enum;
+	bool const res = _harbol_cfg_parse_key_vals(cfgcode, parse_state);
+	parse_state->local_iota = parse_state->local_enum = NULL;
+	return res;
 }
 
-
-HARBOL_EXPORT struct HarbolVec4D *harbol_cfg_get_vec4D(struct HarbolMap const *const cfgmap, char const key[static 1]) {
-	struct HarbolVariant const *const var = _get_var(cfgmap, key);
-	return( var==NULL || var->tag != HarbolCfgType_Vec4D )? NULL : ( struct HarbolVec4D* )(var->data);
+static bool _harbol_cfg_read_file(char const filename[static 1], struct HarbolString *const restrict cfg, HarbolCfgState *const restrict parse_state) {
+	FILE *restrict cfgfile = fopen(filename, "r");
+	if( cfgfile==NULL ) {
+		harbol_write_msg(&parse_state->errc, stderr, NULL, "parse error", COLOR_RED, NULL, NULL, "Harbol Config Parser :: unable to find file '%s'.\n", filename);
+		return false;
+	}
+	
+	bool const read_result = harbol_string_read_from_file(cfg, cfgfile);
+	fclose(cfgfile); cfgfile = NULL;
+	if( !read_result ) {
+		harbol_write_msg(&parse_state->errc, stderr, NULL, "parse error", COLOR_RED, NULL, NULL, "Harbol Config Parser :: failed to read file '%s' into string.\n", filename);
+		return false;
+	}
+	/// fix up new lines and tabs.
+	lex_fix_newlines(cfg, true);
+	parse_state->cfg_filename = filename;
+	return true;
 }
 
-HARBOL_EXPORT enum HarbolCfgType harbol_cfg_get_type(struct HarbolMap const *const cfgmap, char const key[static 1]) {
-	struct HarbolVariant const *const var = _get_var(cfgmap, key);
-	return( var==NULL )? HarbolCfgType_Invalid : var->tag;
-}
+/// an include the parallel loader fills in once every file is parsed.
+/// 'section' holds an empty placeholder section under the file's name.
+struct HarbolCfgIncludeSlot {
+	struct HarbolMap *section;
+	char             *filename;
+};
 
-HARBOL_EXPORT bool harbol_cfg_set_str(struct HarbolMap *const restrict cfgmap, char const keypath[restrict static 1], struct HarbolString const str, bool const override_convert) {
-	return harbol_cfg_set_cstr(cfgmap, keypath, str.cstr, override_convert);
-}
+static NO_NULL bool _harbol_cfg_defer_include(struct HarbolString const *filename, HarbolCfgState *parse_state);
 
-HARBOL_EXPORT bool harbol_cfg_set_cstr(struct HarbolMap *const restrict cfgmap, char const key[static 1], char const cstr[static 1], bool const override_convert) {
-	struct HarbolVariant *const restrict var = _get_var(cfgmap, key);
-	if( var==NULL ) {
-		return false;
-	} else if( var->tag != HarbolCfgType_String ) {
-		if( override_convert ) {
-			_harbol_cfgkey_clear(var);
-			struct HarbolString *str = harbol_string_new(cstr);
-			*var = harbol_variant_make(&str, sizeof str, HarbolCfgType_String, &( bool ){0});
+/// an included file gets its own counters and is reported as a section named after the file.
+/// returns false if the file couldn't be included, an include cycle is left out with its own warning.
+static bool _harbol_cfg_parse_include(struct HarbolString const *const filename, HarbolCfgState *const restrict parse_state) {
+	if( parse_state->deferred != NULL ) {
+		return _harbol_cfg_defer_include(filename, parse_state);
+	}
+	for( HarbolCfgState const *includer = parse_state; includer != NULL; includer = includer->includer ) {
+		if( includer->cfg_filename != NULL && !strcmp(includer->cfg_filename, filename->cstr) ) {
+			harbol_write_msg(NULL, stderr, parse_state->cfg_filename, "parse warning", COLOR_MAGENTA, &parse_state->curr_line, NULL, "Harbol Config Parser :: include cycle through cfg file '%s', leaving it out\n", filename->cstr);
 			return true;
 		}
+	}
+	
+	HarbolCfgState include_state = {
+		.depth    = parse_state->depth + 1,
+		.events   = parse_state->events,
+		.userdata = parse_state->userdata,
+		.includer = parse_state,
+	};
+	struct HarbolString cfg = {0};
+	if( !_harbol_cfg_read_file(filename->cstr, &cfg, &include_state) ) {
 		return false;
 	}
-	harbol_string_copy_cstr(*( struct HarbolString** )(var->data), cstr);
-	return true;
+	
+	enum HarbolCfgEventRes const begin_res = _harbol_cfg_emit_key(parse_state, parse_state->events->begin_section, filename);
+	if( begin_res==HarbolCfgEvent_Continue ) {
+		_harbol_cfg_parse(cfg.cstr, &include_state);
+		parse_state->stopped = include_state.stopped;
+		if( !parse_state->stopped ) {
+			_harbol_cfg_emit_key(parse_state, parse_state->events->end_section, filename);
+		}
+	}
+	harbol_string_clear(&cfg);
+	return begin_res != HarbolCfgEvent_Error && !parse_state->stopped;
 }
 
-HARBOL_EXPORT bool harbol_cfg_set_float(struct HarbolMap *const restrict cfgmap, char const key[static 1], floatmax_t const val, bool const override_convert) {
-	struct HarbolVariant *const restrict var = _get_var(cfgmap, key);
-	if( var==NULL ) {
-		return false;
-	} else if( var->tag != HarbolCfgType_Float ) {
-		if( override_convert ) {
-			_harbol_cfgkey_clear(var);
-			*var = harbol_variant_make(&val, sizeof val, HarbolCfgType_Float, &( bool ){0});
-			return true;
-		}
-		return false;
+static struct HarbolMap *_harbol_cfg_parse_tree(char const cfgcode[static 1], HarbolCfgState *const restrict parse_state) {
+	struct HarbolCfgTreeBuilder tb = {0};
+	struct HarbolMap *objs = harbol_map_new(8);
+	if( objs==NULL ) {
+		return NULL;
+	} else if( !harbol_array_init(&tb.open, sizeof objs, 8) || harbol_array_append(&tb.open, &objs, sizeof objs)==SIZE_MAX ) {
+		harbol_array_clear(&tb.open);
+		harbol_cfg_free(&objs);
+		return NULL;
 	}
-	*( floatmax_t* )(var->data) = val;
-	return true;
+	parse_state->events   = &_harbol_cfg_tree_events;
+	parse_state->userdata = &tb;
+	_harbol_cfg_parse(cfgcode, parse_state);
+	harbol_array_clear(&tb.open);
+	return objs;
 }
 
-HARBOL_EXPORT bool harbol_cfg_set_int(struct HarbolMap *const restrict cfgmap, char const key[static 1], intmax_t const val, bool const override_convert) {
-	struct HarbolVariant *const restrict var = _get_var(cfgmap, key);
-	if( var==NULL ) {
+/// deferring only happens while building a tree, the placeholder goes into the section being filled.
+static bool _harbol_cfg_defer_include(struct HarbolString const *const filename, HarbolCfgState *const restrict parse_state) {
+	if( _harbol_cfg_emit_key(parse_state, parse_state->events->begin_section, filename) != HarbolCfgEvent_Continue ) {
 		return false;
-	} else if( var->tag != HarbolCfgType_Int ) {
-		if( override_convert ) {
-			_harbol_cfgkey_clear(var);
-			*var = harbol_variant_make(&val, sizeof val, HarbolCfgType_Int, &( bool ){0});
-			return true;
-		}
+	} else if( _harbol_cfg_emit_key(parse_state, parse_state->events->end_section, filename) != HarbolCfgEvent_Continue ) {
+		return false;
+	}
+	
+	struct HarbolCfgIncludeSlot slot = {
+		.section  = _harbol_cfg_tree_section(parse_state->userdata),
+		.filename = dup_cstr(filename->len, filename->cstr),
+	};
+	if( slot.filename==NULL || harbol_array_append(parse_state->deferred, &slot, sizeof slot)==SIZE_MAX ) {
+		free(slot.filename);
 		return false;
 	}
-	*( intmax_t* )(var->data) = val;
 	return true;
 }
 
-HARBOL_EXPORT bool harbol_cfg_set_bool(struct HarbolMap *const restrict cfgmap, char const key[static 1], bool const val, bool const override_convert) {
-	struct HarbolVariant *const restrict var = _get_var(cfgmap, key);
-	if( var==NULL ) {
+/// where a lazily parsed section's text starts, and the global counters its math expressions would've read there.
+struct HarbolCfgLazySection {
+	char const *section;
+	uint32_t    line;
+	intmax_t    global_iota, global_enum;
+};
+
+/// the section is left empty in the tree until it's first looked up.
+static bool _harbol_cfg_defer_section(struct HarbolString const *const key, char const section[static 1], uint32_t const line, HarbolCfgState *const restrict parse_state) {
+	if( _harbol_cfg_emit_key(parse_state, parse_state->events->begin_section, key) != HarbolCfgEvent_Continue ) {
 		return false;
-	} else if( var->tag != HarbolCfgType_Bool ) {
-		if( override_convert ) {
-			_harbol_cfgkey_clear(var);
-			*var = harbol_variant_make(&val, sizeof val, HarbolCfgType_Bool, &( bool ){0});
-			return true;
-		}
+	} else if( _harbol_cfg_emit_key(parse_state, parse_state->events->end_section, key) != HarbolCfgEvent_Continue ) {
 		return false;
 	}
-	*( bool* )(var->data) = val;
-	return true;
+	
+	struct HarbolCfgLazySection const lazy = { section, line, parse_state->global_iota, parse_state->global_enum };
+	return harbol_map_insert(parse_state->lazy, key->cstr, key->len + 1, &lazy, sizeof lazy);
+}
+
+HARBOL_EXPORT struct HarbolMap *harbol_cfg_parse_file(char const filename[static 1]) {
+	HarbolCfgState parse_state = {0};
+	struct HarbolString cfg = {0};
+	if( !_harbol_cfg_read_file(filename, &cfg, &parse_state) ) {
+		return NULL;
+	}
+	struct HarbolMap *const restrict objs = _harbol_cfg_parse_tree(cfg.cstr, &parse_state);
+	harbol_string_clear(&cfg);
+	return objs;
+}
+
+
+HARBOL_EXPORT struct HarbolMap *harbol_cfg_parse_cstr(char const cfgcode[static 1]) {
+	HarbolCfgState parse_state = {0};
+	return _harbol_cfg_parse_tree(cfgcode, &parse_state);
+}
+
+
+/// each file is parsed once, however many times it's included.
+struct HarbolCfgIncludeFile {
+	char              *filename;
+	struct HarbolMap  *cfg;
+	struct HarbolArray slots; /// struct HarbolCfgIncludeSlot
+	size_t             errc;  /// errors from its last parse, 'cfg' may only hold part of the file.
+	time_t             mtime;
+	uint8_t            mark;
+	bool               taken; /// whether 'cfg' was stitched in somewhere.
+};
+
+enum {
+	HarbolCfgStitch_Unvisited,
+	HarbolCfgStitch_Visiting,
+	HarbolCfgStitch_Done,
+};
+
+static time_t _harbol_cfg_file_mtime(char const filename[static 1]) {
+	struct stat result = {0};
+	return ( !stat(filename, &result) )? result.st_mtime : 0;
+}
+
+static void _harbol_cfg_parse_include_task(void *const arg) {
+	struct HarbolCfgIncludeFile *const file = arg;
+	HarbolCfgState parse_state = { .deferred = &file->slots };
+	struct HarbolString cfg = {0};
+	file->mtime = _harbol_cfg_file_mtime(file->filename);
+	if( _harbol_cfg_read_file(file->filename, &cfg, &parse_state) ) {
+		file->cfg = _harbol_cfg_parse_tree(cfg.cstr, &parse_state);
+	}
+	file->errc = parse_state.errc;
+	harbol_string_clear(&cfg);
+}
+
+/// frees what a file's parse produced so it can be parsed again.
+static NO_NULL void _harbol_cfg_include_file_reset(struct HarbolCfgIncludeFile *const file) {
+	for( size_t i=0; i < file->slots.len; i++ ) {
+		free((( struct HarbolCfgIncludeSlot* )(harbol_array_get(&file->slots, i, sizeof(struct HarbolCfgIncludeSlot))))->filename);
+	}
+	file->slots.len = 0;
+	if( !file->taken ) {
+		harbol_cfg_free(&file->cfg);
+	}
+	file->cfg   = NULL;
+	file->mark  = HarbolCfgStitch_Unvisited;
+	file->taken = false;
+}
+
+static NO_NULL void _harbol_cfg_include_files_clear(struct HarbolArray *const files, struct HarbolMap *const seen) {
+	for( size_t i=0; i < files->len; i++ ) {
+		struct HarbolCfgIncludeFile *const file = harbol_array_get(files, i, sizeof *file);
+		_harbol_cfg_include_file_reset(file);
+		harbol_array_clear(&file->slots);
+		free(file->filename);
+	}
+	harbol_array_clear(files);
+	harbol_map_clear(seen);
+}
+
+/// queues a file to be parsed unless it already is.
+static NO_NULL bool _harbol_cfg_include_files_add(struct HarbolArray *const files, struct HarbolMap *const seen, char const filename[static 1]) {
+	size_t const keylen = strlen(filename) + 1;
+	if( harbol_map_has_key(seen, filename, keylen) ) {
+		return true;
+	}
+	struct HarbolCfgIncludeFile file = { .filename = dup_cstr(keylen - 1, filename) };
+	size_t const index = files->len;
+	bool const res = file.filename != NULL
+			&& harbol_array_init(&file.slots, sizeof(struct HarbolCfgIncludeSlot), 4)
+			&& harbol_map_insert(seen, file.filename, keylen, &index, sizeof index)
+			&& harbol_array_append(files, &file, sizeof file) != SIZE_MAX;
+	if( !res ) {
+		free(file.filename);
+		harbol_array_clear(&file.slots);
+	}
+	return res;
+}
+
+/// parses level by level from 'round': every file found by the last round is parsed concurrently, then their includes are queued.
+static NEVER_NULL(1, 2) bool _harbol_cfg_include_files_parse(struct HarbolArray *const files, struct HarbolMap *const seen, size_t round, struct HarbolThreadPool *const pool) {
+	bool res = true;
+	while( res && round < files->len ) {
+		size_t const round_end = files->len;
+		/// only this call's parses are waited on, the pool may be shared or this may be running on it.
+		struct HarbolTaskGroup group = {0};
+		for( size_t i = round; i < round_end; i++ ) {
+			struct HarbolCfgIncludeFile *const file = harbol_array_get(files, i, sizeof *file);
+			if( pool==NULL || !harbol_threadpool_submit_group(pool, &group, _harbol_cfg_parse_include_task, file) ) {
+				_harbol_cfg_parse_include_task(file);
+			}
+		}
+		if( pool != NULL ) {
+			harbol_threadpool_wait_group(pool, &group);
+		}
+		
+		for( size_t i = round; res && i < round_end; i++ ) {
+			struct HarbolCfgIncludeFile const *const file = harbol_array_get(files, i, sizeof *file);
+			for( size_t n=0; res && n < file->slots.len; n++ ) {
+				res = _harbol_cfg_include_files_add(files, seen, (( struct HarbolCfgIncludeSlot const* )(harbol_array_get(&file->slots, n, sizeof(struct HarbolCfgIncludeSlot))))->filename);
+			}
+		}
+		round = round_end;
+	}
+	return res;
+}
+
+/// finds the file an include slot refers to, warning if it can't be stitched in.
+static NO_NULL struct HarbolCfgIncludeFile *_harbol_cfg_included_file(struct HarbolArray const *const files, struct HarbolMap const *const seen, struct HarbolCfgIncludeFile const *const file, char const filename[static 1]) {
+	size_t const index = *( size_t const* )(harbol_map_key_get(seen, filename, strlen(filename) + 1));
+	struct HarbolCfgIncludeFile *const kid = harbol_array_get(files, index, sizeof *kid);
+	if( kid->mark==HarbolCfgStitch_Visiting ) {
+		harbol_write_msg(NULL, stderr, file->filename, "parse warning", COLOR_MAGENTA, NULL, NULL, "Harbol Config Parser :: include cycle through cfg file '%s', leaving it out\n", filename);
+		return NULL;
+	} else if( kid->cfg==NULL ) {
+		harbol_write_msg(NULL, stderr, file->filename, "parse warning", COLOR_MAGENTA, NULL, NULL, "Harbol Config Parser :: failed to include cfg file '%s'\n", filename);
+		return NULL;
+	}
+	return kid;
+}
+
+static NO_NULL struct HarbolCfgIncludeSlot const *_harbol_cfg_include_slot(struct HarbolCfgIncludeFile const *const file, struct HarbolMap const *const section, char const key[static 1]) {
+	for( size_t i=0; i < file->slots.len; i++ ) {
+		struct HarbolCfgIncludeSlot const *const slot = harbol_array_get(&file->slots, i, sizeof *slot);
+		if( slot->section==section && !strcmp(slot->filename, key) ) {
+			return slot;
+		}
+	}
+	return NULL;
+}
+
+static NO_NULL struct HarbolMap *_harbol_cfg_copy_file(struct HarbolArray const *files, struct HarbolMap const *seen, struct HarbolCfgIncludeFile *file);
+
+/// deep copy. given the file 'cfg' was parsed from, its include placeholders are replaced with copies of the included files.
+static NEVER_NULL(1) struct HarbolMap *_harbol_cfg_copy(struct HarbolMap const *const cfg, struct HarbolArray const *const files, struct HarbolMap const *const seen, struct HarbolCfgIncludeFile *const file) {
+	struct HarbolMap *cpy = harbol_map_new(cfg->len);
+	for( size_t i=0; cpy != NULL && i < cfg->len; i++ ) {
+		struct HarbolVariant const *const var = ( struct HarbolVariant const* )(cfg->datum[i]);
+		union ConfigVal const cv = { harbol_variant_data(var) };
+		struct HarbolVariant copy = {0};
+		if( var->tag==HarbolCfgType_Map ) {
+			struct HarbolMap *section = NULL;
+			if( file != NULL && _harbol_cfg_include_slot(file, cfg, ( char const* )(cfg->keys[i])) != NULL ) {
+				struct HarbolCfgIncludeFile *const kid = _harbol_cfg_included_file(files, seen, file, ( char const* )(cfg->keys[i]));
+				if( kid==NULL ) {
+					continue;
+				}
+				section = _harbol_cfg_copy_file(files, seen, kid);
+			} else {
+				section = _harbol_cfg_copy(*cv.section, files, seen, file);
+			}
+			copy = harbol_variant_make(&section, sizeof section, var->tag, &( bool ){0});
+		} else if( var->tag==HarbolCfgType_String ) {
+			struct HarbolString *const str = harbol_string_new((*cv.str)->cstr);
+			copy = harbol_variant_make(&str, sizeof str, var->tag, &( bool ){0});
+		} else {
+			copy = harbol_variant_make(cv.data, _harbol_cfg_type_size(var->tag), var->tag, &( bool ){0});
+		}
+		if( (( var->tag==HarbolCfgType_Map || var->tag==HarbolCfgType_String ) && *( void** )(harbol_variant_data(&copy))==NULL)
+				|| !harbol_map_insert(cpy, cfg->keys[i], cfg->keylens[i], &copy, sizeof copy) ) {
+			_harbol_cfgkey_clear(&copy);
+			harbol_cfg_free(&cpy);
+		}
+	}
+	return cpy;
+}
+
+/// the file is marked while it's copied so an include of it from within is caught as a cycle.
+static struct HarbolMap *_harbol_cfg_copy_file(struct HarbolArray const *const files, struct HarbolMap const *const seen, struct HarbolCfgIncludeFile *const file) {
+	file->mark = HarbolCfgStitch_Visiting;
+	struct HarbolMap *const cpy = _harbol_cfg_copy(file->cfg, files, seen, file);
+	file->mark = HarbolCfgStitch_Unvisited;
+	return cpy;
+}
+
+/// fills a file's include slots depth-first, an include of a file that's still being stitched is a cycle.
+/// the first include of a file takes its tree, later ones get a copy.
+static NO_NULL void _harbol_cfg_stitch(struct HarbolArray *const files, struct HarbolMap const *const seen, struct HarbolCfgIncludeFile *const file) {
+	file->mark = HarbolCfgStitch_Visiting;
+	for( size_t i=0; i < file->slots.len; i++ ) {
+		struct HarbolCfgIncludeSlot const *const slot = harbol_array_get(&file->slots, i, sizeof *slot);
+		size_t const keylen = strlen(slot->filename) + 1;
+		struct HarbolCfgIncludeFile *const kid = harbol_array_get(files, *( size_t const* )(harbol_map_key_get(seen, slot->filename, keylen)), sizeof *kid);
+		if( kid->mark==HarbolCfgStitch_Unvisited && kid->cfg != NULL ) {
+			_harbol_cfg_stitch(files, seen, kid);
+		}
+		
+		struct HarbolMap *included = NULL;
+		if( _harbol_cfg_included_file(files, seen, file, slot->filename) != NULL ) {
+			included = ( kid->taken )? _harbol_cfg_copy(kid->cfg, files, seen, NULL) : kid->cfg;
+			kid->taken = true;
+		}
+		
+		struct HarbolVariant *const var = harbol_map_key_get(slot->section, slot->filename, keylen);
+		struct HarbolMap **const placeholder = ( struct HarbolMap** )(harbol_variant_data(var));
+		harbol_cfg_free(placeholder);
+		if( included != NULL ) {
+			*placeholder = included;
+		} else {
+			harbol_variant_clear(var);
+			harbol_map_key_rm(slot->section, slot->filename, keylen);
+		}
+	}
+	file->mark = HarbolCfgStitch_Done;
+}
+
+HARBOL_EXPORT struct HarbolMap *harbol_cfg_parse_file_parallel(char const filename[static 1], struct HarbolThreadPool *const pool) {
+	bool res = true;
+	struct HarbolArray files = harbol_array_make(sizeof(struct HarbolCfgIncludeFile), 16, &res);
+	struct HarbolMap   seen  = harbol_map_make(16, &res); /// filename -> index into 'files'.
+	res = res && _harbol_cfg_include_files_add(&files, &seen, filename) && _harbol_cfg_include_files_parse(&files, &seen, 0, pool);
+	
+	struct HarbolMap *cfg = NULL;
+	if( res ) {
+		struct HarbolCfgIncludeFile *const root = harbol_array_get(&files, 0, sizeof *root);
+		if( root->cfg != NULL ) {
+			_harbol_cfg_stitch(&files, &seen, root);
+			cfg = root->cfg;
+			root->taken = true;
+		}
+	}
+	_harbol_cfg_include_files_clear(&files, &seen);
+	return cfg;
+}
+
+
+HARBOL_EXPORT bool harbol_cfg_file_init(struct HarbolCfgFile *const file, char const filename[static 1]) {
+	*file = ( struct HarbolCfgFile ){0};
+	if( !harbol_array_init(&file->files, sizeof(struct HarbolCfgIncludeFile), 8) || !harbol_map_init(&file->seen, 8) ) {
+		harbol_cfg_file_clear(file);
+		return false;
+	} else if( !_harbol_cfg_include_files_add(&file->files, &file->seen, filename) || !_harbol_cfg_include_files_parse(&file->files, &file->seen, 0, NULL) ) {
+		harbol_cfg_file_clear(file);
+		return false;
+	}
+	
+	struct HarbolCfgIncludeFile *const root = harbol_array_get(&file->files, 0, sizeof *root);
+	file->cfg = ( root->cfg != NULL )? _harbol_cfg_copy_file(&file->files, &file->seen, root) : NULL;
+	if( file->cfg==NULL ) {
+		harbol_cfg_file_clear(file);
+		return false;
+	}
+	return true;
+}
+
+HARBOL_EXPORT struct HarbolCfgFile harbol_cfg_file_make(char const filename[static 1], bool *const res) {
+	struct HarbolCfgFile file = {0};
+	*res = harbol_cfg_file_init(&file, filename);
+	return file;
+}
+
+HARBOL_EXPORT void harbol_cfg_file_clear(struct HarbolCfgFile *const file) {
+	harbol_cfg_free(&file->cfg);
+	_harbol_cfg_include_files_clear(&file->files, &file->seen);
+}
+
+HARBOL_EXPORT bool harbol_cfg_file_changed(struct HarbolCfgFile const *const file) {
+	for( size_t i=0; i < file->files.len; i++ ) {
+		struct HarbolCfgIncludeFile const *const inc = harbol_array_get(&file->files, i, sizeof *inc);
+		if( inc->mtime != _harbol_cfg_file_mtime(inc->filename) ) {
+			return true;
+		}
+	}
+	return false;
+}
+
+struct HarbolCfgDiff {
+	HarbolCfgChangeFunc *on_change;
+	void                *userdata;
+	struct HarbolString  keypath;
+	size_t               changes;
+};
+
+/// appends an escaped key to the keypath and returns the keypath's previous length.
+static NO_NULL size_t _harbol_cfg_diff_push(struct HarbolCfgDiff *const diff, char const key[static 1]) {
+	size_t const parent_len = diff->keypath.len;
+	if( diff->on_change==NULL ) {
+		return parent_len;
+	} else if( parent_len > 0 ) {
+		harbol_string_add_char(&diff->keypath, '.');
+	}
+	for( char const *iter = key; *iter != 0; iter++ ) {
+		if( *iter=='.' ) {
+			harbol_string_add_char(&diff->keypath, '\\');
+		}
+		harbol_string_add_char(&diff->keypath, *iter);
+	}
+	return parent_len;
+}
+
+static NO_NULL void _harbol_cfg_diff_pop(struct HarbolCfgDiff *const diff, size_t const parent_len) {
+	/// an empty string is reallocated from scratch when it grows, so it's freed rather than truncated.
+	if( parent_len==0 ) {
+		harbol_string_clear(&diff->keypath);
+	} else if( diff->keypath.cstr != NULL ) {
+		diff->keypath.len = parent_len;
+		diff->keypath.cstr[parent_len] = 0;
+	}
+}
+
+static NO_NULL void _harbol_cfg_diff_report(struct HarbolCfgDiff *const diff, char const key[static 1], enum HarbolCfgChange const change) {
+	diff->changes++;
+	if( diff->on_change != NULL ) {
+		size_t const parent_len = _harbol_cfg_diff_push(diff, key);
+		diff->on_change(diff->userdata, ( diff->keypath.cstr != NULL )? diff->keypath.cstr : "", change);
+		_harbol_cfg_diff_pop(diff, parent_len);
+	}
+}
+
+static bool _harbol_cfg_same_value(struct HarbolVariant const *const a, struct HarbolVariant const *const b) {
+	if( a->tag != b->tag ) {
+		return false;
+	}
+	union ConfigVal const ca = { harbol_variant_data(a) }, cb = { harbol_variant_data(b) };
+	switch( a->tag ) {
+		case HarbolCfgType_Null:   return true;
+		case HarbolCfgType_String: return !strcmp((*ca.str)->cstr, (*cb.str)->cstr);
+		default:                   return !memcmp(ca.data, cb.data, _harbol_cfg_type_size(a->tag));
+	}
+}
+
+/// makes 'live' match 'fresh' while keeping every section and value that didn't change where it is.
+/// values taken from 'fresh' are swapped out of it, so freeing 'fresh' afterwards frees what was replaced.
+static NO_NULL bool _harbol_cfg_diff_apply(struct HarbolMap *const live, struct HarbolMap *const fresh, struct HarbolCfgDiff *const diff) {
+	for( size_t i=0; i < live->len; ) {
+		if( harbol_map_has_key(fresh, live->keys[i], live->keylens[i]) ) {
+			i++;
+			continue;
+		}
+		_harbol_cfg_diff_report(diff, ( char const* )(live->keys[i]), HarbolCfgChange_Removed);
+		_harbol_cfgkey_clear(( struct HarbolVariant* )(live->datum[i]));
+		harbol_map_idx_rm(live, i);
+	}
+	
+	for( size_t i=0; i < fresh->len; i++ ) {
+		char const *const key = ( char const* )(fresh->keys[i]);
+		struct HarbolVariant *const var = ( struct HarbolVariant* )(fresh->datum[i]);
+		struct HarbolVariant *const old = harbol_map_key_get(live, fresh->keys[i], fresh->keylens[i]);
+		if( old==NULL ) {
+			if( !harbol_map_insert(live, fresh->keys[i], fresh->keylens[i], var, sizeof *var) ) {
+				return false;
+			}
+			*var = ( struct HarbolVariant ){0};
+			_harbol_cfg_diff_report(diff, key, HarbolCfgChange_Added);
+		} else if( old->tag==HarbolCfgType_Map && var->tag==HarbolCfgType_Map ) {
+			size_t const parent_len = _harbol_cfg_diff_push(diff, key);
+			bool const res = _harbol_cfg_diff_apply(*( struct HarbolMap** )(harbol_variant_data(old)), *( struct HarbolMap** )(harbol_variant_data(var)), diff);
+			_harbol_cfg_diff_pop(diff, parent_len);
+			if( !res ) {
+				return false;
+			}
+		} else if( !_harbol_cfg_same_value(old, var) ) {
+			struct HarbolVariant const swap = *old;
+			*old = *var;
+			*var = swap;
+			_harbol_cfg_diff_report(diff, key, HarbolCfgChange_Changed);
+		}
+	}
+	return true;
+}
+
+/// a changed file's new parse, kept apart until every changed file parsed cleanly.
+struct HarbolCfgReparse {
+	size_t                      index;
+	struct HarbolCfgIncludeFile file; /// 'filename' is borrowed from the file it replaces.
+};
+
+HARBOL_EXPORT size_t harbol_cfg_reload(struct HarbolCfgFile *const file, HarbolCfgChangeFunc *const on_change, void *const userdata) {
+	if( file->cfg==NULL || file->files.len==0 ) {
+		return SIZE_MAX;
+	}
+	
+	/// changed files are parsed aside first, a half-saved or broken edit leaves the tree and every file's last good parse alone.
+	struct HarbolArray reparsed = {0}; /// struct HarbolCfgReparse
+	bool parsed = true;
+	for( size_t i=0; parsed && i < file->files.len; i++ ) {
+		struct HarbolCfgIncludeFile const *const inc = harbol_array_get(&file->files, i, sizeof *inc);
+		if( inc->mtime==_harbol_cfg_file_mtime(inc->filename) ) {
+			continue;
+		}
+		struct HarbolCfgReparse re = { .index = i, .file = { .filename = inc->filename } };
+		if( !harbol_array_init(&re.file.slots, sizeof(struct HarbolCfgIncludeSlot), 4) || harbol_array_append(&reparsed, &re, sizeof re)==SIZE_MAX ) {
+			harbol_array_clear(&re.file.slots);
+			parsed = false;
+			break;
+		}
+		struct HarbolCfgReparse *const last = harbol_array_get(&reparsed, reparsed.len - 1, sizeof *last);
+		_harbol_cfg_parse_include_task(&last->file);
+		parsed = last->file.cfg != NULL && last->file.errc==0;
+	}
+	for( size_t i=0; i < reparsed.len; i++ ) {
+		struct HarbolCfgReparse *const re = harbol_array_get(&reparsed, i, sizeof *re);
+		if( parsed ) {
+			struct HarbolCfgIncludeFile *const inc = harbol_array_get(&file->files, re->index, sizeof *inc);
+			_harbol_cfg_include_file_reset(inc);
+			harbol_array_clear(&inc->slots);
+			inc->cfg   = re->file.cfg;
+			inc->slots = re->file.slots;
+			inc->errc  = re->file.errc;
+			inc->mtime = re->file.mtime;
+		} else {
+			_harbol_cfg_include_file_reset(&re->file);
+			harbol_array_clear(&re->file.slots);
+		}
+	}
+	size_t const changed_files = reparsed.len;
+	harbol_array_clear(&reparsed);
+	if( !parsed ) {
+		return SIZE_MAX;
+	} else if( changed_files==0 ) {
+		return 0;
+	}
+	
+	/// a re-parsed file may include files that weren't part of the tree before.
+	size_t const known = file->files.len;
+	for( size_t i=0; i < known; i++ ) {
+		struct HarbolCfgIncludeFile const *const inc = harbol_array_get(&file->files, i, sizeof *inc);
+		for( size_t n=0; n < inc->slots.len; n++ ) {
+			if( !_harbol_cfg_include_files_add(&file->files, &file->seen, (( struct HarbolCfgIncludeSlot const* )(harbol_array_get(&inc->slots, n, sizeof(struct HarbolCfgIncludeSlot))))->filename) ) {
+				return SIZE_MAX;
+			}
+		}
+	}
+	if( !_harbol_cfg_include_files_parse(&file->files, &file->seen, known, NULL) ) {
+		return SIZE_MAX;
+	}
+	
+	struct HarbolCfgIncludeFile *const root = harbol_array_get(&file->files, 0, sizeof *root);
+	struct HarbolMap *fresh = ( root->cfg != NULL )? _harbol_cfg_copy_file(&file->files, &file->seen, root) : NULL;
+	if( fresh==NULL ) {
+		return SIZE_MAX;
+	}
+	struct HarbolCfgDiff diff = { .on_change = on_change, .userdata = userdata };
+	bool const res = _harbol_cfg_diff_apply(file->cfg, fresh, &diff);
+	harbol_string_clear(&diff.keypath);
+	harbol_cfg_free(&fresh);
+	return ( res )? diff.changes : SIZE_MAX;
+}
+
+HARBOL_EXPORT bool harbol_cfg_parse_events_cstr(char const cfgcode[static 1], struct HarbolCfgEvents const *const events, void *const userdata) {
+	HarbolCfgState parse_state = { .events = events, .userdata = userdata };
+	return _harbol_cfg_parse(cfgcode, &parse_state) || parse_state.stopped;
+}
+
+HARBOL_EXPORT bool harbol_cfg_parse_events_file(FILE *const file, struct HarbolCfgEvents const *const events, void *const userdata) {
+	struct HarbolCfgStream stream = harbol_cfg_stream_make(events, userdata, &( bool ){false});
+	char chunk[4096];
+	size_t read = 0;
+	while( (read = fread(chunk, sizeof *chunk, sizeof chunk, file)) > 0 && harbol_cfg_stream_feed(&stream, chunk, read) );
+	bool const res = harbol_cfg_stream_finish(&stream) && !ferror(file);
+	harbol_cfg_stream_clear(&stream);
+	return res;
+}
+
+
+/// the stream's scanner only tracks enough of the grammar to see where a top-level key-value ends:
+/// strings, comments, nesting and whether the current key-value's value has started.
+enum {
+	HarbolCfgScan_Key,   /// before or inside the key.
+	HarbolCfgScan_Value, /// after the key, before the value.
+	HarbolCfgScan_After, /// in or after the value, the next top-level quote starts the next key.
+};
+enum {
+	HarbolCfgScan_NoComment,
+	HarbolCfgScan_LineComment,
+	HarbolCfgScan_BlockComment,
+};
+
+HARBOL_EXPORT bool harbol_cfg_stream_init(struct HarbolCfgStream *const stream, struct HarbolCfgEvents const *const events, void *const userdata) {
+	*stream = ( struct HarbolCfgStream ){ .events = events, .userdata = userdata, .curr_line = 1 };
+	return harbol_array_init(&stream->pending, sizeof(char), 4096);
+}
+
+HARBOL_EXPORT struct HarbolCfgStream harbol_cfg_stream_make(struct HarbolCfgEvents const *const events, void *const userdata, bool *const res) {
+	struct HarbolCfgStream stream;
+	*res = harbol_cfg_stream_init(&stream, events, userdata);
+	return stream;
+}
+
+HARBOL_EXPORT void harbol_cfg_stream_clear(struct HarbolCfgStream *const stream) {
+	harbol_array_clear(&stream->pending);
+	*stream = ( struct HarbolCfgStream ){0};
+}
+
+/// parses complete key-values in place, 'text' has to be nul-terminated.
+static NO_NULL bool _harbol_cfg_stream_parse(struct HarbolCfgStream *const stream, char const text[const]) {
+	HarbolCfgState parse_state = {
+		.errc         = stream->errc,
+		.local_iota   = &stream->local_iota,
+		.local_enum   = &stream->local_enum,
+		.global_iota  = stream->global_iota,
+		.global_enum  = stream->global_enum,
+		.cfg_filename = stream->filename,
+		.events       = stream->events,
+		.userdata     = stream->userdata,
+		.curr_line    = stream->curr_line,
+	};
+	bool const res = _harbol_cfg_parse_key_vals(text, &parse_state);
+	stream->errc        = parse_state.errc;
+	stream->global_iota = parse_state.global_iota;
+	stream->global_enum = parse_state.global_enum;
+	stream->curr_line   = parse_state.curr_line;
+	stream->stopped     = parse_state.stopped;
+	stream->failed      = !res && !parse_state.stopped;
+	return res;
+}
+
+/// newlines and tabs are fixed up the same way as when reading a whole file.
+static NO_NULL bool _harbol_cfg_stream_append(struct HarbolCfgStream *const stream, char const chunk[const], size_t const len) {
+	size_t span = 0;
+	for( size_t i=0; i < len; i++ ) {
+		char const c = chunk[i];
+		bool const crlf = c=='\n' && stream->last_cr;
+		stream->last_cr = c=='\r';
+		if( c != '\r' && c != '\t' && !crlf ) {
+			continue;
+		} else if( i > span && harbol_array_append_n(&stream->pending, &chunk[span], sizeof *chunk, i - span)==SIZE_MAX ) {
+			return false;
+		}
+		span = i + 1;
+		if( (c=='\r' && harbol_array_append(&stream->pending, "\n", sizeof(char))==SIZE_MAX)
+				|| (c=='\t' && harbol_array_append_n(&stream->pending, "    ", sizeof(char), 4)==SIZE_MAX) ) {
+			return false;
+		}
+	}
+	if( len > span && harbol_array_append_n(&stream->pending, &chunk[span], sizeof *chunk, len - span)==SIZE_MAX ) {
+		return false;
+	}
+	/// keep a nul just past the text.
+	if( harbol_array_append(&stream->pending, "", sizeof(char))==SIZE_MAX ) {
+		return false;
+	}
+	stream->pending.len--;
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_cfg_stream_feed(struct HarbolCfgStream *const stream, char const chunk[static 1], size_t const len) {
+	if( stream->stopped || stream->failed ) {
+		return false;
+	} else if( !_harbol_cfg_stream_append(stream, chunk, len) ) {
+		stream->failed = true;
+		return false;
+	}
+	
+	char *const text = ( char* )(stream->pending.table);
+	size_t const text_len = stream->pending.len;
+	size_t unit = 0, i = stream->scanned;
+	for( ; i < text_len; i++ ) {
+		char const c = text[i];
+		/// a '/' or '*' at the end might start or end a comment, wait for the next chunk.
+		if( i + 1==text_len && (c=='/' || (c=='*' && stream->comment==HarbolCfgScan_BlockComment)) ) {
+			break;
+		} else if( stream->comment==HarbolCfgScan_LineComment ) {
+			/// a backslash carries the comment over to the next line.
+			if( c=='\n' && !stream->escaped ) {
+				stream->comment = HarbolCfgScan_NoComment;
+			}
+			stream->escaped = ( c=='\\' ) || (stream->escaped && c != '\n');
+		} else if( stream->comment==HarbolCfgScan_BlockComment ) {
+			if( c=='*' && text[i + 1]=='/' ) {
+				stream->comment = HarbolCfgScan_NoComment;
+				i++;
+			}
+		} else if( stream->quote != 0 ) {
+			if( stream->escaped ) {
+				stream->escaped = false;
+			} else if( c=='\\' ) {
+				stream->escaped = true;
+			} else if( c==stream->quote ) {
+				stream->quote = 0;
+				if( stream->nesting==0 && stream->phase==HarbolCfgScan_Key ) {
+					stream->phase = HarbolCfgScan_Value;
+				}
+			}
+		} else if( c=='#' || (c=='/' && (text[i + 1]=='/' || text[i + 1]=='*')) ) {
+			stream->comment = ( c=='/' && text[i + 1]=='*' )? HarbolCfgScan_BlockComment : HarbolCfgScan_LineComment;
+			i += ( c=='/' );
+		} else if( c=='"' || c=='\'' ) {
+			if( stream->nesting==0 && stream->phase==HarbolCfgScan_After ) {
+				/// the previous key-value is complete.
+				text[i] = 0;
+				bool const res = _harbol_cfg_stream_parse(stream, &text[unit]);
+				text[i] = c;
+				if( !res ) {
+					return false;
+				}
+				unit = i;
+				stream->phase = HarbolCfgScan_Key;
+			} else if( stream->nesting==0 && stream->phase==HarbolCfgScan_Value ) {
+				stream->phase = HarbolCfgScan_After;
+			}
+			stream->quote = ( uint8_t )(c);
+		} else if( !is_whitespace(c) && c != ':' && c != ',' ) {
+			if( c=='{' || c=='[' ) {
+				stream->nesting++;
+			} else if( (c=='}' || c==']') && stream->nesting > 0 ) {
+				stream->nesting--;
+			}
+			if( stream->phase==HarbolCfgScan_Value ) {
+				stream->phase = HarbolCfgScan_After;
+			}
+		}
+	}
+	
+	/// drop what's been parsed, keeping the nul.
+	memmove(text, &text[unit], text_len - unit + 1);
+	stream->pending.len = text_len - unit;
+	stream->scanned     = i - unit;
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_cfg_stream_finish(struct HarbolCfgStream *const stream) {
+	if( !stream->stopped && !stream->failed && stream->pending.len > 0 ) {
+		_harbol_cfg_stream_parse(stream, ( char const* )(stream->pending.table));
+	}
+	harbol_array_wipe(&stream->pending, sizeof(char));
+	stream->scanned = 0;
+	return !stream->failed;
+}
+
+
+/// serializer output goes into one buffer grown geometrically, nothing is formatted through printf on the fast paths.
+struct HarbolCfgWriter {
+	char  *buf;
+	size_t len, cap;
+	bool   compact, failed;
+};
+
+static NO_NULL bool _harbol_cfg_writer_reserve(struct HarbolCfgWriter *const w, size_t const bytes) {
+	if( w->failed ) {
+		return false;
+	} else if( w->len + bytes < w->cap ) {
+		return true;
+	}
+	size_t new_cap = ( w->cap > 0 )? w->cap : 256;
+	while( new_cap <= w->len + bytes ) {
+		new_cap <<= 1;
+	}
+	char *const new_buf = realloc(w->buf, new_cap);
+	if( new_buf==NULL ) {
+		w->failed = true;
+		return false;
+	}
+	w->buf = new_buf;
+	w->cap = new_cap;
+	return true;
+}
+
+static NO_NULL void _harbol_cfg_write(struct HarbolCfgWriter *const w, char const bytes[const], size_t const len) {
+	if( _harbol_cfg_writer_reserve(w, len) ) {
+		memcpy(&w->buf[w->len], bytes, len);
+		w->len += len;
+	}
+}
+
+static NO_NULL void _harbol_cfg_write_char(struct HarbolCfgWriter *const w, char const c) {
+	if( _harbol_cfg_writer_reserve(w, 1) ) {
+		w->buf[w->len++] = c;
+	}
+}
+
+static NO_NULL void _harbol_cfg_write_indent(struct HarbolCfgWriter *const w, size_t depth) {
+	static char const tabs[] = "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t";
+	if( w->compact ) {
+		return;
+	}
+	for( ; depth > sizeof tabs - 1; depth -= sizeof tabs - 1 ) {
+		_harbol_cfg_write(w, tabs, sizeof tabs - 1);
+	}
+	_harbol_cfg_write(w, tabs, depth);
+}
+
+static NO_NULL void _harbol_cfg_write_uint(struct HarbolCfgWriter *const w, uintmax_t n) {
+	char digits[sizeof n * CHAR_BIT / 3 + 1];
+	size_t i = sizeof digits;
+	do {
+		digits[--i] = ( char )('0' + n % 10);
+		n /= 10;
+	} while( n > 0 );
+	_harbol_cfg_write(w, &digits[i], sizeof digits - i);
+}
+
+static NO_NULL void _harbol_cfg_write_int(struct HarbolCfgWriter *const w, intmax_t const i) {
+	if( i < 0 ) {
+		_harbol_cfg_write_char(w, '-');
+		_harbol_cfg_write_uint(w, -( uintmax_t )(i));
+	} else {
+		_harbol_cfg_write_uint(w, ( uintmax_t )(i));
+	}
+}
+
+/// same text as "%f": six decimals, rounded as printf rounds.
+/// values too large for the fixed-point path, or too close to a rounding tie to be sure of, go through snprintf.
+static NO_NULL void _harbol_cfg_write_float(struct HarbolCfgWriter *const w, floatmax_t const f) {
+	floatmax_t const mag = fabsl(f);
+	if( mag < ( floatmax_t )(1e12) ) {
+		floatmax_t const scaled = mag * 1000000;
+		uintmax_t const whole = ( uintmax_t )(scaled);
+		floatmax_t const frac = scaled - ( floatmax_t )(whole);
+		floatmax_t const slack = scaled * (( sizeof(floatmax_t)==sizeof(float) )? FLT_EPSILON : DBL_EPSILON) * 2;
+		if( fabsl(frac - ( floatmax_t )(0.5)) > slack ) {
+			uintmax_t const units = whole + (frac > ( floatmax_t )(0.5));
+			uintmax_t decimals = units % 1000000;
+			char buf[7] = ".000000";
+			for( size_t i=6; decimals > 0; i-- ) {
+				buf[i] = ( char )('0' + decimals % 10);
+				decimals /= 10;
+			}
+			if( signbit(f) ) {
+				_harbol_cfg_write_char(w, '-');
+			}
+			_harbol_cfg_write_uint(w, units / 1000000);
+			_harbol_cfg_write(w, buf, sizeof buf);
+			return;
+		}
+	}
+	int const len = snprintf(NULL, 0, "%" PRIfMAX, f);
+	if( len > 0 && _harbol_cfg_writer_reserve(w, ( size_t )(len) + 1) ) {
+		snprintf(&w->buf[w->len], ( size_t )(len) + 1, "%" PRIfMAX, f);
+		w->len += ( size_t )(len);
+	}
+}
+
+static NO_NULL void _harbol_cfg_write_quoted(struct HarbolCfgWriter *const w, char const cstr[const], size_t const len) {
+	if( _harbol_cfg_writer_reserve(w, len + 2) ) {
+		w->buf[w->len++] = '"';
+		memcpy(&w->buf[w->len], cstr, len);
+		w->len += len;
+		w->buf[w->len++] = '"';
+	}
+}
+
+static NO_NULL void _harbol_cfg_write_key(struct HarbolCfgWriter *const w, char const key[const], size_t const len, size_t const depth, bool const first) {
+	if( w->compact && !first ) {
+		_harbol_cfg_write_char(w, ',');
+	}
+	_harbol_cfg_write_indent(w, depth);
+	_harbol_cfg_write_quoted(w, key, len);
+	_harbol_cfg_write(w, ": ", ( w->compact )? 1 : 2);
+}
+
+/// any value that isn't a section or a string. each ends its own line unless the output is compact.
+static NO_NULL void _harbol_cfg_write_scalar(struct HarbolCfgWriter *const w, enum HarbolCfgType const type, void const *const val) {
+	char const *const sep = ( w->compact )? "," : ", ";
+	size_t const sep_len = ( w->compact )? 1 : 2;
+	switch( type ) {
+		case HarbolCfgType_Float: _harbol_cfg_write_float(w, *( floatmax_t const* )(val)); break;
+		case HarbolCfgType_Int:   _harbol_cfg_write_int(w, *( intmax_t const* )(val));     break;
+		case HarbolCfgType_Bool:
+			if( *( bool const* )(val) ) {
+				_harbol_cfg_write(w, "true", sizeof "true" - 1);
+			} else {
+				_harbol_cfg_write(w, "false", sizeof "false" - 1);
+			}
+			break;
+		case HarbolCfgType_Color: {
+			union HarbolColor const *const c = val;
+			uint8_t const bytes[] = { c->bytes.r, c->bytes.g, c->bytes.b, c->bytes.a };
+			_harbol_cfg_write(w, "c[ ", ( w->compact )? 2 : 3);
+			for( size_t i=0; i < sizeof bytes; i++ ) {
+				if( i > 0 ) {
+					_harbol_cfg_write(w, sep, sep_len);
+				}
+				_harbol_cfg_write_uint(w, bytes[i]);
+			}
+			_harbol_cfg_write(w, " ]", ( w->compact )? 0 : 1);
+			_harbol_cfg_write_char(w, ']');
+			break;
+		}
+		case HarbolCfgType_Vec4D: {
+			struct HarbolVec4D const *const v = val;
+			float32_t const axes[] = { v->x, v->y, v->z, v->w };
+			_harbol_cfg_write(w, "v[ ", ( w->compact )? 2 : 3);
+			for( size_t i=0; i < sizeof axes / sizeof axes[0]; i++ ) {
+				if( i > 0 ) {
+					_harbol_cfg_write(w, sep, sep_len);
+				}
+				_harbol_cfg_write_float(w, axes[i]);
+			}
+			_harbol_cfg_write(w, " ]", ( w->compact )? 0 : 1);
+			_harbol_cfg_write_char(w, ']');
+			break;
+		}
+		default: _harbol_cfg_write(w, "null", sizeof "null" - 1); break;
+	}
+}
+
+static NO_NULL void _harbol_cfg_write_eol(struct HarbolCfgWriter *const w) {
+	if( !w->compact ) {
+		_harbol_cfg_write_char(w, '\n');
+	}
+}
+
+static NO_NULL void _harbol_cfg_write_map(struct HarbolCfgWriter *const w, struct HarbolMap const *const map, size_t const depth) {
+	for( size_t i=0; i < map->len; i++ ) {
+		struct HarbolVariant const *const var = ( struct HarbolVariant const* )(map->datum[i]);
+		union ConfigVal const cv = { harbol_variant_data(var) };
+		_harbol_cfg_write_key(w, ( char const* )(map->keys[i]), map->keylens[i] - 1, depth, i==0);
+		switch( var->tag ) {
+			case HarbolCfgType_Map:
+				_harbol_cfg_write_char(w, '{');
+				_harbol_cfg_write_eol(w);
+				_harbol_cfg_write_map(w, *cv.section, depth + 1);
+				_harbol_cfg_write_indent(w, depth);
+				_harbol_cfg_write_char(w, '}');
+				break;
+			case HarbolCfgType_String:
+				_harbol_cfg_write_quoted(w, (*cv.str)->cstr, (*cv.str)->len);
+				break;
+			default:
+				_harbol_cfg_write_scalar(w, var->tag, cv.data);
+				break;
+		}
+		_harbol_cfg_write_eol(w);
+	}
+}
+
+/// the writer's buffer is handed over as the string, an empty or failed write gives an empty string.
+static NO_NULL struct HarbolString _harbol_cfg_writer_str(struct HarbolCfgWriter *const w) {
+	if( w->failed || w->len==0 ) {
+		free(w->buf);
+		return harbol_string_make(NULL, &( bool ){false});
+	}
+	w->buf[w->len] = 0;
+	return ( struct HarbolString ){ w->buf, w->len };
+}
+
+HARBOL_EXPORT struct HarbolString harbol_cfg_to_str(struct HarbolMap const *const map) {
+	struct HarbolCfgWriter w = {0};
+	_harbol_cfg_write_map(&w, map, 0);
+	return _harbol_cfg_writer_str(&w);
+}
+
+HARBOL_EXPORT struct HarbolString harbol_cfg_to_str_compact(struct HarbolMap const *const map) {
+	struct HarbolCfgWriter w = { .compact = true };
+	_harbol_cfg_write_map(&w, map, 0);
+	return _harbol_cfg_writer_str(&w);
+}
+
+/// splits the next segment off a keypath like "root.section1.\\.dotsection", "\\." being a literal dot.
+/// copies at most 'cap' unescaped bytes into 'buf' and returns the full unescaped length.
+static size_t _harbol_cfg_next_segment(char const **const restrict iterref, char *const restrict buf, size_t const cap, bool *const restrict more) {
+	char const *iter = *iterref;
+	size_t len = 0;
+	*more = false;
+	while( *iter != 0 ) {
+		char c = *iter++;
+		if( c=='\\' && *iter=='.' ) {
+			c = *iter++;
+		} else if( c=='.' ) {
+			*more = true;
+			break;
+		}
+		if( len < cap ) {
+			buf[len] = c;
+		}
+		len++;
+	}
+	*iterref = iter;
+	return len;
+}
+
+/// called with each unescaped keypath segment, 'keylen' counting the nul.
+/// returning false ends the walk.
+typedef bool HarbolCfgSegmentFunc(void *ctx, char const key[], size_t keylen);
+
+static NO_NULL bool _harbol_cfg_walk_keypath(char const keypath[const], HarbolCfgSegmentFunc *const step, void *const ctx) {
+	/// segments are unescaped into a stack buffer, only very long keypaths need the heap.
+	size_t const keylen = strlen(keypath);
+	char stackbuf[256];
+	char *const restrict segment = ( keylen < sizeof stackbuf )? stackbuf : malloc(keylen + 1);
+	if( segment==NULL ) {
+		return false;
+	}
+	
+	bool res = true;
+	char const *iter = keypath;
+	for( bool more = true; more && res; ) {
+		size_t const len = _harbol_cfg_next_segment(&iter, segment, keylen, &more);
+		if( len==0 ) {
+			res = false;
+			break;
+		}
+		segment[len] = 0;
+		res = step(ctx, segment, len+1);
+	}
+	
+	if( segment != stackbuf ) {
+		free(segment);
+	}
+	return res;
+}
+
+struct HarbolCfgVarWalk {
+	struct HarbolMap const *map;
+	struct HarbolVariant   *var;
+};
+
+static bool _harbol_cfg_var_step(void *const ctx, char const key[const], size_t const keylen) {
+	struct HarbolCfgVarWalk *const walk = ctx;
+	walk->var = ( walk->map==NULL )? NULL : harbol_map_key_get(walk->map, key, keylen);
+	if( walk->var==NULL ) {
+		return false;
+	}
+	walk->map = ( walk->var->tag==HarbolCfgType_Map )? *( struct HarbolMap const** )(harbol_variant_data(walk->var)) : NULL;
+	return true;
+}
+
+static NO_NULL struct HarbolVariant *_get_var(struct HarbolMap const *const cfgmap, char const key[const]) {
+	struct HarbolCfgVarWalk walk = { cfgmap, NULL };
+	return( _harbol_cfg_walk_keypath(key, _harbol_cfg_var_step, &walk) )? walk.var : NULL;
+}
+
+HARBOL_EXPORT struct HarbolCfgPath *harbol_cfg_path_new(char const keypath[static 1]) {
+	struct HarbolCfgPath *path = calloc(1, sizeof *path);
+	if( path==NULL || !harbol_cfg_path_init(path, keypath) ) {
+		free(path); path = NULL;
+	}
+	return path;
+}
+
+HARBOL_EXPORT struct HarbolCfgPath harbol_cfg_path_make(char const keypath[static 1], bool *const res) {
+	struct HarbolCfgPath path = {0};
+	*res = harbol_cfg_path_init(&path, keypath);
+	return path;
+}
+
+HARBOL_EXPORT bool harbol_cfg_path_init(struct HarbolCfgPath *const path, char const keypath[static 1]) {
+	*path = ( struct HarbolCfgPath ){0};
+	/// first pass counts and validates the segments, empty ones aren't valid keys.
+	size_t segs = 0;
+	char const *iter = keypath;
+	for( bool more = true; more; segs++ ) {
+		if( _harbol_cfg_next_segment(&iter, NULL, 0, &more)==0 ) {
+			return false;
+		}
+	}
+	
+	/// every separator becomes a nul terminator so the unescaped keys fit in the keypath's length.
+	path->keys = calloc(strlen(keypath) + 1, sizeof *path->keys);
+	if( path->keys==NULL ) {
+		return false;
+	} else if( !harbol_multi_calloc(segs, 3,
+						&path->segs,    sizeof *path->segs,
+						&path->keylens, sizeof *path->keylens,
+						&path->hashes,  sizeof *path->hashes) ) {
+		free(path->keys); path->keys = NULL;
+		return false;
+	}
+	
+	char *key = path->keys;
+	iter = keypath;
+	for( bool more = true; more; path->len++ ) {
+		size_t const len = _harbol_cfg_next_segment(&iter, key, SIZE_MAX, &more);
+		key[len] = 0;
+		path->segs[path->len]    = key;
+		path->keylens[path->len] = len + 1;
+		path->hashes[path->len]  = harbol_map_key_hash(key, len + 1);
+		key += len + 1;
+	}
+	return true;
+}
+
+HARBOL_EXPORT void harbol_cfg_path_clear(struct HarbolCfgPath *const path) {
+	free(path->keys); path->keys = NULL;
+	harbol_multi_cleanup(3, &path->segs, &path->keylens, &path->hashes);
+	path->len = 0;
+}
+
+HARBOL_EXPORT void harbol_cfg_path_free(struct HarbolCfgPath **const path_ref) {
+	if( *path_ref==NULL ) {
+		return;
+	}
+	harbol_cfg_path_clear(*path_ref);
+	free(*path_ref); *path_ref = NULL;
+}
+
+static NO_NULL struct HarbolVariant *_get_var_path(struct HarbolMap const *const cfgmap, struct HarbolCfgPath const *const path) {
+	struct HarbolMap const *itermap = cfgmap;
+	struct HarbolVariant *restrict var = NULL;
+	for( size_t i=0; i < path->len; i++ ) {
+		if( itermap==NULL ) {
+			return NULL;
+		}
+		size_t const entry = harbol_map_get_entry_index_hashed(itermap, path->segs[i], path->keylens[i], path->hashes[i]);
+		var = harbol_map_idx_get(itermap, entry);
+		if( var==NULL ) {
+			return NULL;
+		}
+		itermap = ( var->tag==HarbolCfgType_Map )? *( struct HarbolMap const** )(harbol_variant_data(var)) : NULL;
+	}
+	return var;
+}
+
+static struct HarbolMap *_harbol_cfg_var_section(struct HarbolVariant const *const var) {
+	return( var==NULL || var->tag != HarbolCfgType_Map )? NULL : *( struct HarbolMap** )(harbol_variant_data(var));
+}
+
+static char *_harbol_cfg_var_cstr(struct HarbolVariant const *const var, size_t *const len) {
+	if( var==NULL || var->tag != HarbolCfgType_String ) {
+		return NULL;
+	} else {
+		struct HarbolString const *const str = *( struct HarbolString** )(harbol_variant_data(var));
+		*len = str->len;
+		return str->cstr;
+	}
+}
+
+static struct HarbolString *_harbol_cfg_var_str(struct HarbolVariant const *const var) {
+	return( var==NULL || var->tag != HarbolCfgType_String )? NULL : *( struct HarbolString** )(harbol_variant_data(var));
+}
+
+static floatmax_t *_harbol_cfg_var_float(struct HarbolVariant const *const var) {
+	return( var==NULL || var->tag != HarbolCfgType_Float )? NULL : ( floatmax_t* )(harbol_variant_data(var));
+}
+
+static intmax_t *_harbol_cfg_var_int(struct HarbolVariant const *const var) {
+	return( var==NULL || var->tag != HarbolCfgType_Int )? NULL : ( intmax_t* )(harbol_variant_data(var));
+}
+
+static bool *_harbol_cfg_var_bool(struct HarbolVariant const *const var) {
+	return( var==NULL || var->tag != HarbolCfgType_Bool )? NULL : ( bool* )(harbol_variant_data(var));
+}
+
+static union HarbolColor *_harbol_cfg_var_color(struct HarbolVariant const *const var) {
+	return( var==NULL || var->tag != HarbolCfgType_Color )? NULL : ( union HarbolColor* )(harbol_variant_data(var));
+}
+
+static struct HarbolVec4D *_harbol_cfg_var_vec4D(struct HarbolVariant const *const var) {
+	return( var==NULL || var->tag != HarbolCfgType_Vec4D )? NULL : ( struct HarbolVec4D* )(harbol_variant_data(var));
+}
+
+static enum HarbolCfgType _harbol_cfg_var_type(struct HarbolVariant const *const var) {
+	return( var==NULL )? HarbolCfgType_Invalid : var->tag;
+}
+
+HARBOL_EXPORT struct HarbolMap *harbol_cfg_get_section(struct HarbolMap const *const restrict cfgmap, char const key[static 1]) {
+	return _harbol_cfg_var_section(_get_var(cfgmap, key));
+}
+
+HARBOL_EXPORT char *harbol_cfg_get_cstr(struct HarbolMap const *const cfgmap, char const key[static 1], size_t *const len) {
+	return _harbol_cfg_var_cstr(_get_var(cfgmap, key), len);
+}
+
+HARBOL_EXPORT struct HarbolString *harbol_cfg_get_str(struct HarbolMap const *const cfgmap, char const key[static 1]) {
+	return _harbol_cfg_var_str(_get_var(cfgmap, key));
+}
+
+HARBOL_EXPORT floatmax_t *harbol_cfg_get_float(struct HarbolMap const *const cfgmap, char const key[static 1]) {
+	return _harbol_cfg_var_float(_get_var(cfgmap, key));
+}
+
+HARBOL_EXPORT intmax_t *harbol_cfg_get_int(struct HarbolMap const *const cfgmap, char const key[static 1]) {
+	return _harbol_cfg_var_int(_get_var(cfgmap, key));
+}
+
+HARBOL_EXPORT bool *harbol_cfg_get_bool(struct HarbolMap const *const cfgmap, char const key[static 1]) {
+	return _harbol_cfg_var_bool(_get_var(cfgmap, key));
+}
+
+HARBOL_EXPORT union HarbolColor *harbol_cfg_get_color(struct HarbolMap const *const cfgmap, char const key[static 1]) {
+	return _harbol_cfg_var_color(_get_var(cfgmap, key));
+}
+
+HARBOL_EXPORT struct HarbolVec4D *harbol_cfg_get_vec4D(struct HarbolMap const *const cfgmap, char const key[static 1]) {
+	return _harbol_cfg_var_vec4D(_get_var(cfgmap, key));
+}
+
+HARBOL_EXPORT enum HarbolCfgType harbol_cfg_get_type(struct HarbolMap const *const cfgmap, char const key[static 1]) {
+	return _harbol_cfg_var_type(_get_var(cfgmap, key));
+}
+
+HARBOL_EXPORT struct HarbolMap *harbol_cfg_get_section_path(struct HarbolMap const *const cfgmap, struct HarbolCfgPath const *const path) {
+	return _harbol_cfg_var_section(_get_var_path(cfgmap, path));
+}
+
+HARBOL_EXPORT char *harbol_cfg_get_cstr_path(struct HarbolMap const *const cfgmap, struct HarbolCfgPath const *const path, size_t *const len) {
+	return _harbol_cfg_var_cstr(_get_var_path(cfgmap, path), len);
+}
+
+HARBOL_EXPORT struct HarbolString *harbol_cfg_get_str_path(struct HarbolMap const *const cfgmap, struct HarbolCfgPath const *const path) {
+	return _harbol_cfg_var_str(_get_var_path(cfgmap, path));
+}
+
+HARBOL_EXPORT floatmax_t *harbol_cfg_get_float_path(struct HarbolMap const *const cfgmap, struct HarbolCfgPath const *const path) {
+	return _harbol_cfg_var_float(_get_var_path(cfgmap, path));
+}
+
+HARBOL_EXPORT intmax_t *harbol_cfg_get_int_path(struct HarbolMap const *const cfgmap, struct HarbolCfgPath const *const path) {
+	return _harbol_cfg_var_int(_get_var_path(cfgmap, path));
+}
+
+HARBOL_EXPORT bool *harbol_cfg_get_bool_path(struct HarbolMap const *const cfgmap, struct HarbolCfgPath const *const path) {
+	return _harbol_cfg_var_bool(_get_var_path(cfgmap, path));
+}
+
+HARBOL_EXPORT union HarbolColor *harbol_cfg_get_color_path(struct HarbolMap const *const cfgmap, struct HarbolCfgPath const *const path) {
+	return _harbol_cfg_var_color(_get_var_path(cfgmap, path));
+}
+
+HARBOL_EXPORT struct HarbolVec4D *harbol_cfg_get_vec4D_path(struct HarbolMap const *const cfgmap, struct HarbolCfgPath const *const path) {
+	return _harbol_cfg_var_vec4D(_get_var_path(cfgmap, path));
+}
+
+HARBOL_EXPORT enum HarbolCfgType harbol_cfg_get_type_path(struct HarbolMap const *const cfgmap, struct HarbolCfgPath const *const path) {
+	return _harbol_cfg_var_type(_get_var_path(cfgmap, path));
+}
+
+HARBOL_EXPORT bool harbol_cfg_set_str(struct HarbolMap *const restrict cfgmap, char const keypath[restrict static 1], struct HarbolString const str, bool const override_convert) {
+	return harbol_cfg_set_cstr(cfgmap, keypath, str.cstr, override_convert);
+}
+
+HARBOL_EXPORT bool harbol_cfg_set_cstr(struct HarbolMap *const restrict cfgmap, char const key[static 1], char const cstr[static 1], bool const override_convert) {
+	struct HarbolVariant *const restrict var = _get_var(cfgmap, key);
+	if( var==NULL ) {
+		return false;
+	} else if( var->tag != HarbolCfgType_String ) {
+		if( override_convert ) {
+			_harbol_cfgkey_clear(var);
+			struct HarbolString *str = harbol_string_new(cstr);
+			*var = harbol_variant_make(&str, sizeof str, HarbolCfgType_String, &( bool ){0});
+			return true;
+		}
+		return false;
+	}
+	harbol_string_copy_cstr(*( struct HarbolString** )(harbol_variant_data(var)), cstr);
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_cfg_set_float(struct HarbolMap *const restrict cfgmap, char const key[static 1], floatmax_t const val, bool const override_convert) {
+	struct HarbolVariant *const restrict var = _get_var(cfgmap, key);
+	if( var==NULL ) {
+		return false;
+	} else if( var->tag != HarbolCfgType_Float ) {
+		if( override_convert ) {
+			_harbol_cfgkey_clear(var);
+			*var = harbol_variant_make(&val, sizeof val, HarbolCfgType_Float, &( bool ){0});
+			return true;
+		}
+		return false;
+	}
+	*( floatmax_t* )(harbol_variant_data(var)) = val;
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_cfg_set_int(struct HarbolMap *const restrict cfgmap, char const key[static 1], intmax_t const val, bool const override_convert) {
+	struct HarbolVariant *const restrict var = _get_var(cfgmap, key);
+	if( var==NULL ) {
+		return false;
+	} else if( var->tag != HarbolCfgType_Int ) {
+		if( override_convert ) {
+			_harbol_cfgkey_clear(var);
+			*var = harbol_variant_make(&val, sizeof val, HarbolCfgType_Int, &( bool ){0});
+			return true;
+		}
+		return false;
+	}
+	*( intmax_t* )(harbol_variant_data(var)) = val;
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_cfg_set_bool(struct HarbolMap *const restrict cfgmap, char const key[static 1], bool const val, bool const override_convert) {
+	struct HarbolVariant *const restrict var = _get_var(cfgmap, key);
+	if( var==NULL ) {
+		return false;
+	} else if( var->tag != HarbolCfgType_Bool ) {
+		if( override_convert ) {
+			_harbol_cfgkey_clear(var);
+			*var = harbol_variant_make(&val, sizeof val, HarbolCfgType_Bool, &( bool ){0});
+			return true;
+		}
+		return false;
+	}
+	*( bool* )(harbol_variant_data(var)) = val;
+	return true;
 }
 
 HARBOL_EXPORT bool harbol_cfg_set_color(struct HarbolMap *const restrict cfgmap, char const key[static 1], union HarbolColor const val, bool const override_convert) {
 	struct HarbolVariant *const restrict var = _get_var(cfgmap, key);
 	if( var==NULL ) {
 		return false;
-	} else if( var->tag != HarbolCfgType_Color ) {
-		if( override_convert ) {
-			_harbol_cfgkey_clear(var);
-			*var = harbol_variant_make(&val, sizeof val, HarbolCfgType_Color, &( bool ){0});
+	} else if( var->tag != HarbolCfgType_Color ) {
+		if( override_convert ) {
+			_harbol_cfgkey_clear(var);
+			*var = harbol_variant_make(&val, sizeof val, HarbolCfgType_Color, &( bool ){0});
+			return true;
+		}
+		return false;
+	}
+	*( union HarbolColor* )(harbol_variant_data(var)) = val;
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_cfg_set_vec4D(struct HarbolMap *const restrict cfgmap, char const key[static 1], struct HarbolVec4D const val, bool const override_convert) {
+	struct HarbolVariant *const restrict var = _get_var(cfgmap, key);
+	if( var==NULL ) {
+		return false;
+	} else if( var->tag != HarbolCfgType_Vec4D ) {
+		if( override_convert ) {
+			_harbol_cfgkey_clear(var);
+			*var = harbol_variant_make(&val, sizeof val, HarbolCfgType_Vec4D, &( bool ){0});
+			return true;
+		}
+		return false;
+	}
+	
+	*( struct HarbolVec4D* )(harbol_variant_data(var)) = val;
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_cfg_set_to_null(struct HarbolMap *const restrict cfgmap, char const key[static 1]) {
+	struct HarbolVariant *const restrict var = _get_var(cfgmap, key);
+	if( var==NULL ) {
+		return false;
+	}
+	
+	_harbol_cfgkey_clear(var);
+	*var = harbol_variant_make(&( char ){0}, 1, HarbolCfgType_Null, &( bool ){0});
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_cfg_build_file(struct HarbolMap const *const cfg, char const filename[static 1], bool const overwrite) {
+	FILE *restrict cfgfile = fopen(filename, overwrite? "w+" : "a+");
+	if( cfgfile==NULL ) {
+		fputs("harbol_cfg_build_file :: unable to create file.\n", stderr);
+		return false;
+	}
+	struct HarbolCfgWriter w = {0};
+	_harbol_cfg_write_map(&w, cfg, 0);
+	bool const result = !w.failed && fwrite(w.buf, sizeof *w.buf, w.len, cfgfile)==w.len;
+	free(w.buf);
+	fclose(cfgfile); cfgfile=NULL;
+	return result;
+}
+
+
+HARBOL_EXPORT floatmax_t harbol_cfg_calc_math(struct HarbolMap const *const restrict cfg, char const key[const restrict static 1], HarbolMathVarFunc *const var_func, void *const restrict data, size_t const data_len) {
+	struct HarbolString *const restrict str = harbol_cfg_get_str(cfg, key);
+	if( str==NULL ) {
+		union {
+			uintmax_t const  u;
+			floatmax_t const f;
+		} const c = { -1ULL };
+		return c.f;
+	}
+	return harbol_math_parse_expr(str->cstr, var_func==NULL? harbol_math_default_var_func : var_func, data, data_len);
+}
+
+
+/// finds where a keypath is written in the source by re-parsing it, only sections on the keypath are entered.
+struct HarbolCfgLocator {
+	struct HarbolCfgPath   path;
+	HarbolCfgState const  *state;
+	size_t                 matched; /// keypath segments whose sections are open.
+	uint32_t               line;
+};
+
+static enum HarbolCfgEventRes _harbol_cfg_locate_key(void *const data, struct HarbolString const *const key, size_t const depth) {
+	struct HarbolCfgLocator *const loc = data;
+	if( depth != loc->matched || key->len + 1 != loc->path.keylens[depth] || memcmp(key->cstr, loc->path.segs[depth], key->len) ) {
+		return HarbolCfgEvent_Skip;
+	} else if( depth + 1==loc->path.len ) {
+		loc->line = loc->state->curr_line;
+		return HarbolCfgEvent_Stop;
+	}
+	return HarbolCfgEvent_Continue;
+}
+
+static enum HarbolCfgEventRes _harbol_cfg_locate_begin(void *const data, struct HarbolString const *const key, size_t const depth) {
+	(void)(key); (void)(depth);
+	struct HarbolCfgLocator *const loc = data;
+	loc->matched++;
+	return HarbolCfgEvent_Continue;
+}
+
+static enum HarbolCfgEventRes _harbol_cfg_locate_end(void *const data, struct HarbolString const *const key, size_t const depth) {
+	(void)(key);
+	struct HarbolCfgLocator *const loc = data;
+	loc->matched = depth;
+	return HarbolCfgEvent_Continue;
+}
+
+static struct HarbolCfgEvents const _harbol_cfg_locate_events = {
+	_harbol_cfg_locate_key,
+	_harbol_cfg_locate_begin,
+	_harbol_cfg_locate_end,
+	NULL,
+};
+
+/// span of the key's last segment in the source, a line of 0 if it can't be found (an included file's key, for one).
+static NO_NULL struct HarbolTokenSpan _harbol_cfg_key_span(struct HarbolString const *const src, struct HarbolMsgSpan const *const msgspan, char const keypath[static 1]) {
+	struct HarbolTokenSpan span = {0};
+	struct HarbolCfgLocator loc = {0};
+	if( !harbol_cfg_path_init(&loc.path, keypath) ) {
+		return span;
+	}
+	HarbolCfgState parse_state = { .events = &_harbol_cfg_locate_events, .userdata = &loc };
+	loc.state = &parse_state;
+	_harbol_cfg_parse(src->cstr, &parse_state);
+	
+	struct HarbolString const *const line = ( loc.line > 0 )? harbol_msg_span_get_line(msgspan, loc.line - 1) : NULL;
+	if( line != NULL && line->cstr != NULL ) {
+		span.line_start = span.line_end = loc.line;
+		span.colm_end = ( uint32_t )(line->len);
+		size_t const seglen = loc.path.keylens[loc.path.len - 1] - 1;
+		for( char const *iter = line->cstr; (iter = strpbrk(iter, "\"'")) != NULL; iter++ ) {
+			if( !strncmp(iter + 1, loc.path.segs[loc.path.len - 1], seglen) && iter[seglen + 1]==*iter ) {
+				span.colm_start = ( uint32_t )(iter - line->cstr);
+				span.colm_end   = span.colm_start + ( uint32_t )(seglen) + 2;
+				break;
+			}
+		}
+	}
+	harbol_cfg_path_clear(&loc.path);
+	return span;
+}
+
+static size_t _harbol_cfg_field_size(enum HarbolCfgType const type) {
+	switch( type ) {
+		case HarbolCfgType_String: return sizeof(char const*);
+		default:                   return _harbol_cfg_type_size(type);
+	}
+}
+
+static char const *_harbol_cfg_type_name(enum HarbolCfgType const type) {
+	switch( type ) {
+		case HarbolCfgType_Null:   return "null";
+		case HarbolCfgType_Map:    return "section";
+		case HarbolCfgType_String: return "string";
+		case HarbolCfgType_Float:  return "float";
+		case HarbolCfgType_Int:    return "int";
+		case HarbolCfgType_Bool:   return "bool";
+		case HarbolCfgType_Color:  return "color";
+		case HarbolCfgType_Vec4D:  return "vector";
+		default:                   return "invalid";
+	}
+}
+
+/// a schema keypath, or a section some schema keypath goes through.
+struct HarbolCfgBindKey {
+	size_t field; /// SIZE_MAX if the keypath is only a section on the way.
+	bool   section;
+};
+
+enum {
+	HarbolCfgBind_Missing,
+	HarbolCfgBind_Bound,
+	HarbolCfgBind_Mismatched,
+};
+
+struct HarbolCfgBinder {
+	struct HarbolCfgField const *schema;
+	uint8_t                     *out;
+	struct HarbolMap             keys;    /// keypath -> struct HarbolCfgBindKey
+	uint8_t                     *found;   /// per field.
+	struct HarbolMsgSpan        *msgspan;
+	struct HarbolString          keypath, src;
+	size_t                       errc;
+};
+
+static NO_NULL void _harbol_cfg_bind_error(struct HarbolCfgBinder *const binder, char const keypath[static 1], bool const locate, char const msg[static 1], char const type[static 1]) {
+	if( binder->msgspan==NULL ) {
+		harbol_write_msg(&binder->errc, stderr, NULL, "bind error", COLOR_RED, NULL, NULL, "Harbol Config Bind :: '%s' %s %s.\n", keypath, msg, type);
+		return;
+	}
+	
+	struct HarbolTokenSpan span = {0};
+	if( locate ) {
+		if( binder->src.cstr==NULL ) {
+			/// the message span keeps its source split up in lines, joined back once for re-parsing.
+			for( size_t i=0; i < harbol_msg_span_get_num_lines(binder->msgspan); i++ ) {
+				struct HarbolString const *const line = harbol_msg_span_get_line(binder->msgspan, i);
+				if( line->cstr != NULL ) {
+					harbol_string_add_str(&binder->src, line);
+				}
+				harbol_string_add_char(&binder->src, '\n');
+			}
+		}
+		if( binder->src.cstr != NULL ) {
+			span = _harbol_cfg_key_span(&binder->src, binder->msgspan, keypath);
+		}
+	}
+	char const *const filename = binder->msgspan->src.filename.cstr;
+	if( span.line_start > 0 ) {
+		harbol_msg_span_add_label(binder->msgspan, span, COLOR_RED, '^', NULL, "%s %s", msg, type);
+		uint32_t const colm = span.colm_start + 1;
+		harbol_msg_span_emit_to_stream(binder->msgspan, &binder->errc, stderr, filename, "bind error", NULL, COLOR_RED, &span.line_start, &colm, "Harbol Config Bind :: '%s' %s %s.", keypath, msg, type);
+	} else {
+		harbol_msg_span_emit_to_stream(binder->msgspan, &binder->errc, stderr, filename, "bind error", NULL, COLOR_RED, NULL, NULL, "Harbol Config Bind :: '%s' %s %s.", keypath, msg, type);
+	}
+	fputc('\n', stderr);
+}
+
+static NO_NULL void _harbol_cfg_bind_field(struct HarbolCfgBinder *const binder, size_t const index, struct HarbolVariant const *const var) {
+	struct HarbolCfgField const *const field = &binder->schema[index];
+	union ConfigVal const cv = { harbol_variant_data(var) };
+	uint8_t *const dest = &binder->out[field->offset];
+	if( var->tag==field->type ) {
+		if( field->type==HarbolCfgType_String ) {
+			char const *const cstr = (*cv.str)->cstr;
+			memcpy(dest, &cstr, sizeof cstr);
+		} else {
+			memcpy(dest, cv.data, _harbol_cfg_field_size(field->type));
+		}
+		binder->found[index] = HarbolCfgBind_Bound;
+	} else if( var->tag==HarbolCfgType_Int && field->type==HarbolCfgType_Float ) {
+		floatmax_t const f = ( floatmax_t )(*cv.i);
+		memcpy(dest, &f, sizeof f);
+		binder->found[index] = HarbolCfgBind_Bound;
+	} else {
+		binder->found[index] = HarbolCfgBind_Mismatched;
+		char msg[64];
+		snprintf(msg, sizeof msg, "is %s %s, expected", ( var->tag==HarbolCfgType_Int )? "an" : "a", _harbol_cfg_type_name(var->tag));
+		_harbol_cfg_bind_error(binder, field->keypath, true, msg, _harbol_cfg_type_name(field->type));
+	}
+}
+
+/// walks only the sections a schema keypath goes through.
+static NO_NULL void _harbol_cfg_bind_section(struct HarbolCfgBinder *const binder, struct HarbolMap const *const section) {
+	size_t const parent_len = binder->keypath.len;
+	for( size_t i=0; i < section->len; i++ ) {
+		if( parent_len > 0 ) {
+			harbol_string_add_char(&binder->keypath, '.');
+		}
+		for( char const *iter = ( char const* )(section->keys[i]); *iter != 0; iter++ ) {
+			if( *iter=='.' ) {
+				harbol_string_add_char(&binder->keypath, '\\');
+			}
+			harbol_string_add_char(&binder->keypath, *iter);
+		}
+		
+		struct HarbolVariant const *const var = ( struct HarbolVariant const* )(section->datum[i]);
+		struct HarbolCfgBindKey const *const key = ( binder->keypath.cstr != NULL )? harbol_map_key_get(&binder->keys, binder->keypath.cstr, binder->keypath.len + 1) : NULL;
+		if( key != NULL && key->field != SIZE_MAX ) {
+			_harbol_cfg_bind_field(binder, key->field, var);
+		}
+		if( key != NULL && key->section && var->tag==HarbolCfgType_Map ) {
+			_harbol_cfg_bind_section(binder, *( struct HarbolMap const *const* )(harbol_variant_data(var)));
+		}
+		
+		/// an empty string is reallocated from scratch when it grows, so it's freed rather than truncated.
+		if( parent_len==0 ) {
+			harbol_string_clear(&binder->keypath);
+		} else {
+			binder->keypath.len = parent_len;
+			binder->keypath.cstr[parent_len] = 0;
+		}
+	}
+}
+
+/// indexes every schema keypath and every section on the way to one.
+static NO_NULL bool _harbol_cfg_bind_index(struct HarbolCfgBinder *const binder, size_t const schema_len) {
+	for( size_t i=0; i < schema_len; i++ ) {
+		char const *const keypath = binder->schema[i].keypath;
+		size_t const len = strlen(keypath);
+		struct HarbolCfgBindKey *const field = harbol_map_key_get(&binder->keys, keypath, len + 1);
+		if( field != NULL ) {
+			/// the first field wins a keypath listed twice.
+			if( field->field==SIZE_MAX ) {
+				field->field = i;
+			}
+		} else if( !harbol_map_insert(&binder->keys, keypath, len + 1, &( struct HarbolCfgBindKey ){ i, false }, sizeof(struct HarbolCfgBindKey)) ) {
+			return false;
+		}
+		
+		for( size_t n=0; n < len; n++ ) {
+			if( keypath[n]=='\\' && keypath[n+1]=='.' ) {
+				n++;
+				continue;
+			} else if( keypath[n] != '.' ) {
+				continue;
+			}
+			char prefix[n + 1];
+			memcpy(prefix, keypath, n);
+			prefix[n] = 0;
+			struct HarbolCfgBindKey *const section = harbol_map_key_get(&binder->keys, prefix, n + 1);
+			if( section != NULL ) {
+				section->section = true;
+			} else if( !harbol_map_insert(&binder->keys, prefix, n + 1, &( struct HarbolCfgBindKey ){ SIZE_MAX, true }, sizeof(struct HarbolCfgBindKey)) ) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+HARBOL_EXPORT size_t harbol_cfg_bind(struct HarbolMap const *const cfg, struct HarbolCfgField const schema[const static 1], size_t const schema_len, void *const out, struct HarbolMsgSpan *const msgspan) {
+	struct HarbolCfgBinder binder = {
+		.schema  = schema,
+		.out     = out,
+		.found   = calloc(schema_len, sizeof *binder.found),
+		.msgspan = msgspan,
+	};
+	if( binder.found==NULL || !harbol_map_init(&binder.keys, schema_len * 2) || !_harbol_cfg_bind_index(&binder, schema_len) ) {
+		harbol_write_msg(NULL, stderr, NULL, "memory error", COLOR_RED, NULL, NULL, "Harbol Config Bind :: unable to index the schema.\n");
+		free(binder.found);
+		harbol_map_clear(&binder.keys);
+		return SIZE_MAX;
+	}
+	
+	_harbol_cfg_bind_section(&binder, cfg);
+	/// a mismatched field was reported when it was found, it still gets its default.
+	for( size_t i=0; i < schema_len; i++ ) {
+		if( binder.found[i]==HarbolCfgBind_Bound ) {
+			continue;
+		} else if( schema[i].def != NULL ) {
+			memcpy(&binder.out[schema[i].offset], schema[i].def, _harbol_cfg_field_size(schema[i].type));
+		} else if( binder.found[i]==HarbolCfgBind_Missing ) {
+			_harbol_cfg_bind_error(&binder, schema[i].keypath, false, "is missing, expected", _harbol_cfg_type_name(schema[i].type));
+		}
+	}
+	free(binder.found);
+	harbol_map_clear(&binder.keys);
+	harbol_string_clear(&binder.keypath);
+	harbol_string_clear(&binder.src);
+	return binder.errc;
+}
+
+
+
+HARBOL_EXPORT bool harbol_cfg_lazy_init(struct HarbolCfgLazy *const lazy, char const filename[static 1]) {
+	*lazy = ( struct HarbolCfgLazy ){ .filename = dup_cstr(strlen(filename), filename) };
+	HarbolCfgState parse_state = { .lazy = &lazy->pending };
+	if( lazy->filename==NULL || !harbol_map_init(&lazy->pending, 8) || !_harbol_cfg_read_file(lazy->filename, &lazy->src, &parse_state) ) {
+		harbol_cfg_lazy_clear(lazy);
+		return false;
+	}
+	lazy->cfg = _harbol_cfg_parse_tree(lazy->src.cstr, &parse_state);
+	if( lazy->cfg==NULL ) {
+		harbol_cfg_lazy_clear(lazy);
+		return false;
+	}
+	return true;
+}
+
+HARBOL_EXPORT struct HarbolCfgLazy harbol_cfg_lazy_make(char const filename[static 1], bool *const res) {
+	struct HarbolCfgLazy lazy = {0};
+	*res = harbol_cfg_lazy_init(&lazy, filename);
+	return lazy;
+}
+
+HARBOL_EXPORT void harbol_cfg_lazy_clear(struct HarbolCfgLazy *const lazy) {
+	harbol_cfg_free(&lazy->cfg);
+	harbol_map_clear(&lazy->pending);
+	harbol_string_clear(&lazy->src);
+	free(lazy->filename);
+	*lazy = ( struct HarbolCfgLazy ){0};
+}
+
+/// parses a pending top-level section into its placeholder, the same way it'd have been parsed in place.
+static NO_NULL bool _harbol_cfg_lazy_load(struct HarbolCfgLazy *const lazy, char const key[static 1], size_t const keylen) {
+	struct HarbolCfgLazySection const *const pending = harbol_map_key_get(&lazy->pending, key, keylen);
+	if( pending==NULL ) {
+		return true;
+	}
+	
+	/// the placeholder might've been removed or replaced since.
+	struct HarbolVariant const *const var = harbol_map_key_get(lazy->cfg, key, keylen);
+	if( var==NULL || var->tag != HarbolCfgType_Map ) {
+		harbol_map_key_rm(&lazy->pending, key, keylen);
+		return true;
+	}
+	
+	struct HarbolMap *const section = *( struct HarbolMap *const* )(harbol_variant_data(var));
+	struct HarbolCfgTreeBuilder tb = {0};
+	bool res = harbol_array_init(&tb.open, sizeof section, 8) && harbol_array_append(&tb.open, &section, sizeof section) != SIZE_MAX;
+	if( res ) {
+		intmax_t local_iota = 0, local_enum = 0;
+		HarbolCfgState parse_state = {
+			.depth        = 1,
+			.local_iota   = &local_iota,
+			.local_enum   = &local_enum,
+			.cfg_filename = lazy->filename,
+			.events       = &_harbol_cfg_tree_events,
+			.userdata     = &tb,
+			.curr_line    = pending->line,
+			.global_iota  = pending->global_iota,
+			.global_enum  = pending->global_enum,
+		};
+		char const *iter = pending->section;
+		res = harbol_cfg_parse_section(&iter, &parse_state);
+		parse_state.local_iota = parse_state.local_enum = NULL;
+	}
+	harbol_array_clear(&tb.open);
+	harbol_map_key_rm(&lazy->pending, key, keylen);
+	return res;
+}
+
+static bool _harbol_cfg_lazy_step(void *const ctx, char const key[const], size_t const keylen) {
+	_harbol_cfg_lazy_load(ctx, key, keylen);
+	/// only the top-level segment can be pending.
+	return false;
+}
+
+HARBOL_EXPORT struct HarbolMap *harbol_cfg_lazy_touch(struct HarbolCfgLazy *const lazy, char const keypath[static 1]) {
+	if( lazy->pending.len > 0 ) {
+		_harbol_cfg_walk_keypath(keypath, _harbol_cfg_lazy_step, lazy);
+	}
+	return lazy->cfg;
+}
+
+HARBOL_EXPORT struct HarbolMap *harbol_cfg_lazy_get_section(struct HarbolCfgLazy *const lazy, char const keypath[static 1]) {
+	return harbol_cfg_get_section(harbol_cfg_lazy_touch(lazy, keypath), keypath);
+}
+
+HARBOL_EXPORT bool harbol_cfg_lazy_load_all(struct HarbolCfgLazy *const lazy) {
+	bool res = true;
+	while( lazy->pending.len > 0 ) {
+		res &= _harbol_cfg_lazy_load(lazy, ( char const* )(lazy->pending.keys[0]), lazy->pending.keylens[0]);
+	}
+	return res;
+}
+
+/// JSON is parsed in two passes, the way simdjson does it: the first finds every structural character
+/// 64 bytes at a time and records their offsets, the second walks that index to build the tree
+/// without rescanning the text between tokens.
+/// bytes are classified 16 at a time with the compiler's vector extensions where there are any,
+/// 16 being the width every SIMD target has so GCC never splits the compares into scalar code,
+/// otherwise eight at a time in 64-bit words (SWAR) so the first pass stays portable C99.
+#define HARBOL_JSON_ONES  0x0101010101010101ULL
+#define HARBOL_JSON_LOW7  0x7F7F7F7F7F7F7F7FULL
+
+static inline uint64_t _harbol_json_load_word(uint8_t const p[static 8]) {
+	/// byte order independent, compilers turn this into a single load on little-endian targets.
+	return ( uint64_t )(p[0])       | ( uint64_t )(p[1]) << 8  | ( uint64_t )(p[2]) << 16 | ( uint64_t )(p[3]) << 24
+		 | ( uint64_t )(p[4]) << 32 | ( uint64_t )(p[5]) << 40 | ( uint64_t )(p[6]) << 48 | ( uint64_t )(p[7]) << 56;
+}
+
+/// sets the high bit of every byte equal to 'c', exactly, no borrows leak into neighbouring bytes.
+static inline uint64_t _harbol_json_eq_bytes(uint64_t const word, uint8_t const c) {
+	uint64_t const v = word ^ (HARBOL_JSON_ONES * c);
+	return ~(((v & HARBOL_JSON_LOW7) + HARBOL_JSON_LOW7) | v | HARBOL_JSON_LOW7);
+}
+
+/// sets the high bit of every byte below 0x20.
+static inline uint64_t _harbol_json_ctrl_bytes(uint64_t const word) {
+	return ~(((word & HARBOL_JSON_LOW7) + HARBOL_JSON_ONES * 0x60) | word | HARBOL_JSON_LOW7);
+}
+
+/// packs the high bit of each byte into 8 bits, byte 0 going into bit 0.
+static inline uint64_t _harbol_json_movemask(uint64_t const hibits) {
+	return ((hibits >> 7) * 0x0102040810204080ULL) >> 56;
+}
+
+#if defined(COMPILER_GCC) || defined(COMPILER_CLANG)
+typedef uint8_t _harbol_json_vec SIMD_VEC(16);
+
+static inline _harbol_json_vec _harbol_json_vec_eq(_harbol_json_vec const v, uint8_t const c) {
+	return ( _harbol_json_vec )(v==((( _harbol_json_vec ){0}) + c));
+}
+
+/// packs the lanes of a 16-byte compare into 16 bits, lane 0 going into bit 0.
+/// each lane keeps only its bit, so summing a half's bytes with a multiply can't carry, whatever the byte order.
+static inline uint64_t _harbol_json_vec_bits(_harbol_json_vec const m) {
+	_harbol_json_vec const weights = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+	_harbol_json_vec const w = m & weights;
+	uint64_t halves[2]; memcpy(halves, &w, sizeof halves);
+	return ((halves[0] * HARBOL_JSON_ONES) >> 56) | ((halves[1] * HARBOL_JSON_ONES) >> 56) << 8;
+}
+#endif
+
+static inline uint64_t _harbol_json_prefix_xor(uint64_t x) {
+	x ^= x << 1;
+	x ^= x << 2;
+	x ^= x << 4;
+	x ^= x << 8;
+	x ^= x << 16;
+	x ^= x << 32;
+	return x;
+}
+
+static inline size_t _harbol_json_ctz(uint64_t const x) {
+#if defined(COMPILER_CLANG) || defined(COMPILER_GCC)
+	return ( size_t )(__builtin_ctzll(x));
+#else
+	size_t n = 0;
+	for( uint64_t b = x; (b & 1)==0; b >>= 1 ) {
+		n++;
+	}
+	return n;
+#endif
+}
+
+/// marks the bytes escaped by an odd-length run of backslashes.
+/// '*prev_odd' carries a run that's still odd at the end of the previous block.
+static inline uint64_t _harbol_json_escaped(uint64_t const backslash, uint64_t *const prev_odd) {
+	uint64_t const even_bits = 0x5555555555555555ULL, odd_bits = ~even_bits;
+	uint64_t const start_edges = backslash & ~(backslash << 1);
+	uint64_t const even_start_mask = even_bits ^ *prev_odd;
+	uint64_t const even_starts = start_edges & even_start_mask;
+	uint64_t const odd_starts = start_edges & ~even_start_mask;
+	uint64_t const even_carries = backslash + even_starts;
+	uint64_t odd_carries = backslash + odd_starts;
+	bool const ends_odd = odd_carries < backslash;
+	odd_carries |= *prev_odd;
+	*prev_odd = ends_odd;
+	uint64_t const even_carry_ends = even_carries & ~backslash;
+	uint64_t const odd_carry_ends = odd_carries & ~backslash;
+	return (even_carry_ends & odd_bits) | (odd_carry_ends & even_bits);
+}
+
+struct HarbolJsonParser {
+	char const *src;
+	char const *filename;
+	size_t     *index; /// offsets of structural characters and of the first byte of each bare scalar.
+	size_t      index_len, pos;
+	size_t      errc;
+	struct HarbolCfgWriter key; /// scratch space for unescaped keys.
+};
+
+static NO_NULL uint32_t _harbol_json_line(struct HarbolJsonParser const *const p, size_t const offset) {
+	uint32_t line = 1;
+	for( char const *iter = p->src, *const end = &p->src[offset]; (iter = memchr(iter, '\n', ( size_t )(end - iter))) != NULL; iter++ ) {
+		line++;
+	}
+	return line;
+}
+
+/// first pass, every unescaped quote is indexed so a string's closing quote is always the next entry after its opening one.
+static NO_NULL bool _harbol_json_index(struct HarbolJsonParser *const p, size_t const len) {
+	size_t cap = len / 4 + 64;
+	p->index = malloc(cap * sizeof *p->index);
+	if( p->index==NULL ) {
+		return false;
+	}
+	
+	uint64_t prev_odd = 0, prev_in_str = 0, prev_scalar = 0;
+	for( size_t offset=0; offset < len; offset += 64 ) {
+		uint8_t tail[64];
+		uint8_t const *block = ( uint8_t const* )(&p->src[offset]);
+		if( len - offset < 64 ) {
+			memset(tail, ' ', sizeof tail);
+			memcpy(tail, block, len - offset);
+			block = tail;
+		}
+		
+		uint64_t quote = 0, backslash = 0, op = 0, ws = 0, ctrl = 0;
+#if defined(COMPILER_GCC) || defined(COMPILER_CLANG)
+		for( size_t i=0; i < 4; i++ ) {
+			_harbol_json_vec v; memcpy(&v, &block[i * 16], sizeof v);
+			_harbol_json_vec const ops = _harbol_json_vec_eq(v, '{') | _harbol_json_vec_eq(v, '}')
+									   | _harbol_json_vec_eq(v, '[') | _harbol_json_vec_eq(v, ']')
+									   | _harbol_json_vec_eq(v, ':') | _harbol_json_vec_eq(v, ',');
+			_harbol_json_vec const spaces = _harbol_json_vec_eq(v, ' ') | _harbol_json_vec_eq(v, '\t')
+										  | _harbol_json_vec_eq(v, '\n') | _harbol_json_vec_eq(v, '\r');
+			quote     |= _harbol_json_vec_bits(_harbol_json_vec_eq(v, '"')) << (i * 16);
+			backslash |= _harbol_json_vec_bits(_harbol_json_vec_eq(v, '\\')) << (i * 16);
+			op        |= _harbol_json_vec_bits(ops) << (i * 16);
+			ws        |= _harbol_json_vec_bits(spaces) << (i * 16);
+			ctrl      |= _harbol_json_vec_bits(_harbol_json_vec_eq(v & 0xE0, 0)) << (i * 16);
+		}
+#else
+		for( size_t i=0; i < 8; i++ ) {
+			uint64_t const word = _harbol_json_load_word(&block[i * 8]);
+			uint64_t const ops = _harbol_json_eq_bytes(word, '{') | _harbol_json_eq_bytes(word, '}')
+							   | _harbol_json_eq_bytes(word, '[') | _harbol_json_eq_bytes(word, ']')
+							   | _harbol_json_eq_bytes(word, ':') | _harbol_json_eq_bytes(word, ',');
+			uint64_t const spaces = _harbol_json_eq_bytes(word, ' ') | _harbol_json_eq_bytes(word, '\t')
+								  | _harbol_json_eq_bytes(word, '\n') | _harbol_json_eq_bytes(word, '\r');
+			quote     |= _harbol_json_movemask(_harbol_json_eq_bytes(word, '"')) << (i * 8);
+			backslash |= _harbol_json_movemask(_harbol_json_eq_bytes(word, '\\')) << (i * 8);
+			op        |= _harbol_json_movemask(ops) << (i * 8);
+			ws        |= _harbol_json_movemask(spaces) << (i * 8);
+			ctrl      |= _harbol_json_movemask(_harbol_json_ctrl_bytes(word)) << (i * 8);
+		}
+#endif
+		
+		quote &= ~_harbol_json_escaped(backslash, &prev_odd);
+		/// set from an opening quote up to, not including, its closing quote.
+		uint64_t const in_str = _harbol_json_prefix_xor(quote) ^ prev_in_str;
+		prev_in_str = 0 - (in_str >> 63);
+		if( (ctrl & in_str) != 0 ) {
+			uint32_t const line = _harbol_json_line(p, offset + _harbol_json_ctz(ctrl & in_str));
+			harbol_write_msg(&p->errc, stderr, p->filename, "syntax error", COLOR_RED, &line, NULL, "Harbol JSON Parser :: unescaped control character in string.\n");
+			return false;
+		}
+		
+		uint64_t const scalar = ~(op | ws | quote | in_str);
+		uint64_t structural = (op & ~in_str) | quote | (scalar & ~((scalar << 1) | prev_scalar));
+		prev_scalar = scalar >> 63;
+		
+		if( cap - p->index_len < 64 ) {
+			cap <<= 1;
+			size_t *const new_index = realloc(p->index, cap * sizeof *p->index);
+			if( new_index==NULL ) {
+				return false;
+			}
+			p->index = new_index;
+		}
+		for( ; structural != 0; structural &= structural - 1 ) {
+			p->index[p->index_len++] = offset + _harbol_json_ctz(structural);
+		}
+	}
+	
+	if( prev_in_str != 0 ) {
+		uint32_t const line = _harbol_json_line(p, len);
+		harbol_write_msg(&p->errc, stderr, p->filename, "syntax error", COLOR_RED, &line, NULL, "Harbol JSON Parser :: unterminated string.\n");
+		return false;
+	}
+	return true;
+}
+
+/// the structural character at the next index entry, 0 once the index runs out.
+static NO_NULL char _harbol_json_next(struct HarbolJsonParser *const p) {
+	return ( p->pos++ < p->index_len )? p->src[p->index[p->pos - 1]] : 0;
+}
+
+static NO_NULL size_t _harbol_json_last_offset(struct HarbolJsonParser const *const p) {
+	return ( p->pos > 0 && p->pos <= p->index_len )? p->index[p->pos - 1] : strlen(p->src);
+}
+
+static bool _harbol_json_is_delim(char const c) {
+	switch( c ) {
+		case 0: case ' ': case '\t': case '\n': case '\r':
+		case '{': case '}': case '[': case ']': case ':': case ',': case '"':
 			return true;
+		default:
+			return false;
+	}
+}
+
+static NO_NULL bool _harbol_json_hex4(char const hex[static 4], int32_t *const code) {
+	*code = 0;
+	for( size_t i=0; i < 4; i++ ) {
+		if( !is_hex(hex[i]) ) {
+			return false;
+		}
+		*code = (*code << 4) | ( int32_t )(( hex[i] <= '9' )? hex[i] - '0' : (hex[i] | 0x20) - 'a' + 10);
+	}
+	return true;
+}
+
+/// unescapes 'len' bytes of string body into 'dst', which never needs more than 'len' bytes.
+static NO_NULL bool _harbol_json_unescape(char const src[const], size_t const len, char dst[const], size_t *const dst_len) {
+	size_t n = 0;
+	for( size_t i=0; i < len; ) {
+		char const *const esc = memchr(&src[i], '\\', len - i);
+		size_t const run = ( esc==NULL )? len - i : ( size_t )(esc - &src[i]);
+		memcpy(&dst[n], &src[i], run);
+		n += run;
+		i += run;
+		if( esc==NULL ) {
+			break;
+		} else if( ++i >= len ) {
+			return false;
+		}
+		switch( src[i++] ) {
+			case '"':  dst[n++] = '"';  break;
+			case '\\': dst[n++] = '\\'; break;
+			case '/':  dst[n++] = '/';  break;
+			case 'b':  dst[n++] = '\b'; break;
+			case 'f':  dst[n++] = '\f'; break;
+			case 'n':  dst[n++] = '\n'; break;
+			case 'r':  dst[n++] = '\r'; break;
+			case 't':  dst[n++] = '\t'; break;
+			case 'u': {
+				int32_t rune = 0;
+				if( len - i < 4 || !_harbol_json_hex4(&src[i], &rune) ) {
+					return false;
+				}
+				i += 4;
+				if( rune >= 0xD800 && rune <= 0xDBFF ) {
+					/// a high surrogate has to be followed by its low half.
+					int32_t low = 0;
+					if( len - i < 6 || src[i] != '\\' || src[i+1] != 'u' || !_harbol_json_hex4(&src[i+2], &low) || low < 0xDC00 || low > 0xDFFF ) {
+						return false;
+					}
+					i += 6;
+					rune = 0x10000 + ((rune - 0xD800) << 10) + (low - 0xDC00);
+				} else if( rune >= 0xDC00 && rune <= 0xDFFF ) {
+					return false;
+				}
+				n += write_utf8_cstr(&dst[n], 4, rune);
+				break;
+			}
+			default:
+				return false;
+		}
+	}
+	dst[n] = 0;
+	*dst_len = n;
+	return true;
+}
+
+/// decodes the string whose opening quote was just read, into the scratch key buffer or a new HarbolString.
+static NO_NULL bool _harbol_json_string(struct HarbolJsonParser *const p, bool const is_key, struct HarbolString *const str) {
+	size_t const start = p->index[p->pos - 1] + 1;
+	size_t const end = p->index[p->pos++];
+	size_t const raw_len = end - start;
+	char *buf = NULL;
+	if( is_key ) {
+		p->key.len = 0;
+		if( !_harbol_cfg_writer_reserve(&p->key, raw_len + 1) ) {
+			return false;
+		}
+		buf = p->key.buf;
+	} else if( (buf = malloc(raw_len + 1))==NULL ) {
+		return false;
+	}
+	
+	size_t len = 0;
+	if( !_harbol_json_unescape(&p->src[start], raw_len, buf, &len) ) {
+		uint32_t const line = _harbol_json_line(p, start);
+		harbol_write_msg(&p->errc, stderr, p->filename, "syntax error", COLOR_RED, &line, NULL, "Harbol JSON Parser :: invalid escape sequence in string.\n");
+		if( !is_key ) {
+			free(buf);
+		}
+		return false;
+	}
+	*str = ( struct HarbolString ){ buf, len };
+	if( is_key ) {
+		p->key.len = len;
+	}
+	return true;
+}
+
+static inline bool _harbol_json_digit(char const c) {
+	return c >= '0' && c <= '9';
+}
+
+/// numbers without a fraction or exponent are ints, like the cfg lexer decides, unless they overflow intmax_t.
+/// returns where the number ends, NULL if it isn't a valid JSON number.
+static NO_NULL char const *_harbol_json_number(char const s[static 1], struct HarbolVariant *const var) {
+	char const *iter = s;
+	bool is_float = false;
+	iter += *iter=='-';
+	if( *iter=='0' ) {
+		iter++;
+	} else if( _harbol_json_digit(*iter) ) {
+		while( _harbol_json_digit(*iter) ) iter++;
+	} else {
+		return NULL;
+	}
+	if( *iter=='.' ) {
+		is_float = true;
+		if( !_harbol_json_digit(*++iter) ) {
+			return NULL;
+		}
+		while( _harbol_json_digit(*iter) ) iter++;
+	}
+	if( *iter=='e' || *iter=='E' ) {
+		is_float = true;
+		iter++;
+		iter += *iter=='+' || *iter=='-';
+		if( !_harbol_json_digit(*iter) ) {
+			return NULL;
+		}
+		while( _harbol_json_digit(*iter) ) iter++;
+	}
+	
+	if( !is_float ) {
+		errno = 0;
+		intmax_t const i = strtoimax(s, NULL, 10);
+		if( errno==0 ) {
+			*var = harbol_variant_make(&i, sizeof i, HarbolCfgType_Int, &( bool ){0});
+			return iter;
+		}
+	}
+	floatmax_t const f = strtofmax(s, NULL);
+	*var = harbol_variant_make(&f, sizeof f, HarbolCfgType_Float, &( bool ){0});
+	return iter;
+}
+
+static NO_NULL bool _harbol_json_scalar(struct HarbolJsonParser *const p, struct HarbolVariant *const var) {
+	char const *const s = &p->src[_harbol_json_last_offset(p)];
+	char const *iter = s;
+	if( !strncmp(s, "true", sizeof "true" - 1) || !strncmp(s, "false", sizeof "false" - 1) ) {
+		bool const b = *s=='t';
+		iter += ( b )? sizeof "true" - 1 : sizeof "false" - 1;
+		*var = harbol_variant_make(&b, sizeof b, HarbolCfgType_Bool, &( bool ){0});
+	} else if( !strncmp(s, "null", sizeof "null" - 1) ) {
+		iter += sizeof "null" - 1;
+		*var = harbol_variant_make(&( char ){0}, 1, HarbolCfgType_Null, &( bool ){0});
+	} else {
+		iter = _harbol_json_number(s, var);
+	}
+	
+	if( iter != NULL && _harbol_json_is_delim(*iter) ) {
+		return true;
+	} else if( iter != NULL ) {
+		harbol_variant_clear(var);
+	}
+	uint32_t const line = _harbol_json_line(p, ( size_t )(s - p->src));
+	harbol_write_msg(&p->errc, stderr, p->filename, "syntax error", COLOR_RED, &line, NULL, "Harbol JSON Parser :: invalid value starting with '%c'.\n", *s);
+	return false;
+}
+
+/// an open object or array, arrays are built as sections keyed by their element indices.
+struct HarbolJsonOpen {
+	struct HarbolMap     *map;
+	struct HarbolVariant *slot; /// the variant holding 'map' in its parent, NULL for the root.
+	bool                  array;
+};
+
+/// arrays of four numbers are what colors and vectors are written as.
+/// four ints in 0-255 make a color, four numbers with any float among them make a vector.
+static NO_NULL bool _harbol_json_matrix(struct HarbolVariant const *const elems[static 4], struct HarbolVariant *const var) {
+	bool any_float = false, all_bytes = true;
+	for( size_t i=0; i < 4; i++ ) {
+		if( elems[i]->tag==HarbolCfgType_Float ) {
+			any_float = true;
+		} else if( elems[i]->tag==HarbolCfgType_Int ) {
+			intmax_t const n = *( intmax_t const* )(harbol_variant_data(elems[i]));
+			all_bytes &= n >= 0 && n <= UINT8_MAX;
+		} else {
+			return false;
+		}
+	}
+	
+	if( any_float ) {
+		float32_t axes[4];
+		for( size_t i=0; i < 4; i++ ) {
+			void const *const data = harbol_variant_data(elems[i]);
+			axes[i] = ( float32_t )(( elems[i]->tag==HarbolCfgType_Float )? *( floatmax_t const* )(data) : ( floatmax_t )(*( intmax_t const* )(data)));
+		}
+		struct HarbolVec4D const vec = { axes[0], axes[1], axes[2], axes[3] };
+		*var = harbol_variant_make(&vec, sizeof vec, HarbolCfgType_Vec4D, &( bool ){0});
+	} else if( all_bytes ) {
+		union HarbolColor color = {0};
+		for( size_t i=0; i < 4; i++ ) {
+			color.array[i] = ( uint8_t )(*( intmax_t const* )(harbol_variant_data(elems[i])));
+		}
+		*var = harbol_variant_make(&color, sizeof color, HarbolCfgType_Color, &( bool ){0});
+	} else {
+		return false;
+	}
+	return true;
+}
+
+static NO_NULL void _harbol_json_close_array(struct HarbolJsonOpen const *const closed) {
+	struct HarbolMap const *const map = closed->map;
+	struct HarbolVariant var = {0};
+	if( map->len==4 && _harbol_json_matrix(( struct HarbolVariant const *const* )(map->datum), &var) ) {
+		_harbol_cfgkey_clear(closed->slot);
+		*closed->slot = var;
+	}
+}
+
+/// most arrays in a generated cfg are colors and vectors, those are read straight off the index
+/// instead of building a section only to throw it away.
+static NO_NULL bool _harbol_json_try_matrix(struct HarbolJsonParser *const p, struct HarbolVariant *const var) {
+	size_t const pos = p->pos;
+	if( p->index_len - pos < 8 || p->src[p->index[pos + 7]] != ']' ) {
+		return false;
+	}
+	struct HarbolVariant elems[4];
+	memset(elems, 0, sizeof elems);
+	struct HarbolVariant const *const refs[] = { &elems[0], &elems[1], &elems[2], &elems[3] };
+	bool res = true;
+	for( size_t i=0; i < 4 && res; i++ ) {
+		char const *const s = &p->src[p->index[pos + i*2]];
+		char const *const end = ( *s=='-' || _harbol_json_digit(*s) )? _harbol_json_number(s, &elems[i]) : NULL;
+		res = end != NULL && _harbol_json_is_delim(*end) && *end != '"' && (i==3 || p->src[p->index[pos + i*2 + 1]]==',');
+	}
+	res = res && _harbol_json_matrix(refs, var);
+	for( size_t i=0; i < 4; i++ ) {
+		harbol_variant_clear(&elems[i]);
+	}
+	if( res ) {
+		p->pos += 8;
+	}
+	return res;
+}
+
+static NO_NULL bool _harbol_json_add(struct HarbolJsonParser *const p, struct HarbolJsonOpen const *const top, char const key[const], size_t const keylen, struct HarbolVariant *const var) {
+	if( harbol_map_insert(top->map, key, keylen + 1, var, sizeof *var) ) {
+		return true;
+	}
+	if( harbol_map_has_key(top->map, key, keylen + 1) ) {
+		uint32_t const line = _harbol_json_line(p, _harbol_json_last_offset(p));
+		harbol_write_msg(&p->errc, stderr, p->filename, "syntax error", COLOR_RED, &line, NULL, "Harbol JSON Parser :: duplicate key '%s'.\n", key);
+	}
+	_harbol_cfgkey_clear(var);
+	return false;
+}
+
+/// second pass, walks the index with an explicit stack of open objects and arrays.
+static NO_NULL bool _harbol_json_build(struct HarbolJsonParser *const p, struct HarbolMap *const root) {
+	struct HarbolArray open = {0};
+	struct HarbolJsonOpen frame = { root, NULL, false };
+	if( !harbol_array_init(&open, sizeof frame, 16) || harbol_array_append(&open, &frame, sizeof frame)==SIZE_MAX ) {
+		harbol_array_clear(&open);
+		return false;
+	}
+	
+	bool first = true, res = false;
+	char const *expected = "'{'";
+	while( open.len > 0 ) {
+		struct HarbolJsonOpen const top = *( struct HarbolJsonOpen const* )(harbol_array_peek(&open, sizeof top));
+		char const closer = ( top.array )? ']' : '}';
+		if( first ) {
+			first = false;
+			if( p->pos < p->index_len && p->src[p->index[p->pos]]==closer ) {
+				p->pos++;
+				goto close_container;
+			}
+		} else {
+			char const tok = _harbol_json_next(p);
+			if( tok==closer ) {
+				goto close_container;
+			} else if( tok != ',' ) {
+				expected = ( top.array )? "',' or ']'" : "',' or '}'";
+				goto syntax_error;
+			}
+		}
+		
+		char numkey[sizeof(size_t) * CHAR_BIT / 3 + 2];
+		char const *key = numkey;
+		size_t keylen = 0;
+		if( top.array ) {
+			keylen = ( size_t )(snprintf(numkey, sizeof numkey, "%zu", top.map->len));
+		} else {
+			struct HarbolString keystr = {0};
+			if( _harbol_json_next(p) != '"' ) {
+				expected = "a string key";
+				goto syntax_error;
+			} else if( !_harbol_json_string(p, true, &keystr) ) {
+				goto done;
+			} else if( _harbol_json_next(p) != ':' ) {
+				expected = "':'";
+				goto syntax_error;
+			}
+			key = keystr.cstr;
+			keylen = keystr.len;
+		}
+		
+		struct HarbolVariant var = {0};
+		switch( _harbol_json_next(p) ) {
+			case '{': case '[': {
+				bool const array = p->src[_harbol_json_last_offset(p)]=='[';
+				if( array && _harbol_json_try_matrix(p, &var) ) {
+					break;
+				}
+				struct HarbolMap *submap = harbol_map_new(4);
+				if( submap==NULL ) {
+					goto done;
+				}
+				var = harbol_variant_make(&submap, sizeof submap, HarbolCfgType_Map, &( bool ){0});
+				if( !_harbol_json_add(p, &top, key, keylen, &var) ) {
+					goto done;
+				}
+				frame = ( struct HarbolJsonOpen ){ submap, harbol_map_idx_get(top.map, top.map->len - 1), array };
+				if( harbol_array_append(&open, &frame, sizeof frame)==SIZE_MAX ) {
+					goto done;
+				}
+				first = true;
+				continue;
+			}
+			case '"': {
+				struct HarbolString *str = malloc(sizeof *str);
+				if( str==NULL ) {
+					goto done;
+				} else if( !_harbol_json_string(p, false, str) ) {
+					free(str);
+					goto done;
+				}
+				var = harbol_variant_make(&str, sizeof str, HarbolCfgType_String, &( bool ){0});
+				break;
+			}
+			case 0: case '}': case ']': case ':': case ',':
+				expected = "a value";
+				goto syntax_error;
+			default:
+				if( !_harbol_json_scalar(p, &var) ) {
+					goto done;
+				}
+				break;
+		}
+		if( !_harbol_json_add(p, &top, key, keylen, &var) ) {
+			goto done;
+		}
+		continue;
+		
+	close_container:
+		harbol_array_pop(&open, sizeof top);
+		if( top.array ) {
+			_harbol_json_close_array(&top);
+		}
+	}
+	
+	if( p->pos < p->index_len ) {
+		expected = "the end of input";
+		p->pos++;
+		goto syntax_error;
+	}
+	res = true;
+	goto done;
+	
+syntax_error:;
+	size_t const offset = _harbol_json_last_offset(p);
+	uint32_t const line = _harbol_json_line(p, offset);
+	if( p->src[offset]==0 ) {
+		harbol_write_msg(&p->errc, stderr, p->filename, "syntax error", COLOR_RED, &line, NULL, "Harbol JSON Parser :: expected %s, got the end of input.\n", expected);
+	} else {
+		harbol_write_msg(&p->errc, stderr, p->filename, "syntax error", COLOR_RED, &line, NULL, "Harbol JSON Parser :: expected %s, got '%c'.\n", expected, p->src[offset]);
+	}
+done:
+	harbol_array_clear(&open);
+	return res;
+}
+
+static NEVER_NULL(1) struct HarbolMap *_harbol_json_parse(char const json[static 1], char const filename[const]) {
+	struct HarbolJsonParser p = { .src = json, .filename = filename };
+	struct HarbolMap *root = NULL;
+	if( _harbol_json_index(&p, strlen(json)) ) {
+		if( p.index_len==0 || json[p.index[0]] != '{' ) {
+			uint32_t const line = 1;
+			harbol_write_msg(&p.errc, stderr, filename, "syntax error", COLOR_RED, &line, NULL, "Harbol JSON Parser :: a cfg has to be a JSON object.\n");
+		} else if( (root = harbol_map_new(8)) != NULL ) {
+			p.pos = 1;
+			if( !_harbol_json_build(&p, root) ) {
+				harbol_cfg_free(&root);
+			}
+		}
+	}
+	free(p.index);
+	free(p.key.buf);
+	return root;
+}
+
+HARBOL_EXPORT struct HarbolMap *harbol_cfg_parse_json(char const json[static 1]) {
+	return _harbol_json_parse(json, NULL);
+}
+
+HARBOL_EXPORT struct HarbolMap *harbol_cfg_parse_json_file(char const filename[static 1]) {
+	HarbolCfgState parse_state = {0};
+	struct HarbolString json = {0};
+	if( !_harbol_cfg_read_file(filename, &json, &parse_state) ) {
+		return NULL;
+	}
+	struct HarbolMap *const restrict objs = _harbol_json_parse(( json.cstr==NULL )? "" : json.cstr, filename);
+	harbol_string_clear(&json);
+	return objs;
+}
+
+
+static NO_NULL void _harbol_json_write_str(struct HarbolCfgWriter *const w, char const cstr[const], size_t const len) {
+	static char const hex[] = "0123456789abcdef";
+	_harbol_cfg_write_char(w, '"');
+	size_t run = 0;
+	for( size_t i=0; i < len; i++ ) {
+		uint8_t const c = ( uint8_t )(cstr[i]);
+		if( c >= 0x20 && c != '"' && c != '\\' ) {
+			continue;
+		}
+		_harbol_cfg_write(w, &cstr[run], i - run);
+		run = i + 1;
+		switch( c ) {
+			case '"':  _harbol_cfg_write(w, "\\\"", 2); break;
+			case '\\': _harbol_cfg_write(w, "\\\\", 2); break;
+			case '\n': _harbol_cfg_write(w, "\\n", 2);  break;
+			case '\r': _harbol_cfg_write(w, "\\r", 2);  break;
+			case '\t': _harbol_cfg_write(w, "\\t", 2);  break;
+			default: {
+				char const esc[] = { '\\', 'u', '0', '0', hex[c >> 4], hex[c & 15] };
+				_harbol_cfg_write(w, esc, sizeof esc);
+				break;
+			}
+		}
+	}
+	_harbol_cfg_write(w, &cstr[run], len - run);
+	_harbol_cfg_write_char(w, '"');
+}
+
+/// shortest "%g" text that parses back to the same value, 'single' for vector axes which are read back into a float32_t.
+/// JSON has no infinities or NaNs, so those become null.
+static NO_NULL void _harbol_json_write_float(struct HarbolCfgWriter *const w, floatmax_t const f, bool const single) {
+	if( !isfinite(f) ) {
+		_harbol_cfg_write(w, "null", sizeof "null" - 1);
+		return;
+	}
+	
+	char buf[64];
+	int len = 0;
+	for( int prec=1; prec <= DECIMAL_DIG; prec++ ) {
+		len = snprintf(buf, sizeof buf - 2, "%.*Lg", prec, ( long double )(f));
+		floatmax_t const back = strtofmax(buf, NULL);
+		if( (single && ( float32_t )(back)==( float32_t )(f)) || back==f ) {
+			break;
+		}
+	}
+	/// keep a fraction so it's read back as a float rather than an int.
+	if( strpbrk(buf, ".e")==NULL ) {
+		buf[len++] = '.';
+		buf[len++] = '0';
+	}
+	_harbol_cfg_write(w, buf, ( size_t )(len));
+}
+
+static NO_NULL void _harbol_json_write_map(struct HarbolCfgWriter *const w, struct HarbolMap const *const map) {
+	_harbol_cfg_write_char(w, '{');
+	for( size_t i=0; i < map->len; i++ ) {
+		struct HarbolVariant const *const var = ( struct HarbolVariant const* )(map->datum[i]);
+		union ConfigVal const cv = { harbol_variant_data(var) };
+		if( i > 0 ) {
+			_harbol_cfg_write_char(w, ',');
+		}
+		_harbol_json_write_str(w, ( char const* )(map->keys[i]), map->keylens[i] - 1);
+		_harbol_cfg_write_char(w, ':');
+		switch( var->tag ) {
+			case HarbolCfgType_Map:    _harbol_json_write_map(w, *cv.section);                    break;
+			case HarbolCfgType_String: _harbol_json_write_str(w, (*cv.str)->cstr, (*cv.str)->len); break;
+			case HarbolCfgType_Float:  _harbol_json_write_float(w, *cv.f, false);                  break;
+			case HarbolCfgType_Color: {
+				uint8_t const bytes[] = { cv.c->bytes.r, cv.c->bytes.g, cv.c->bytes.b, cv.c->bytes.a };
+				for( size_t n=0; n < sizeof bytes; n++ ) {
+					_harbol_cfg_write_char(w, ( n==0 )? '[' : ',');
+					_harbol_cfg_write_uint(w, bytes[n]);
+				}
+				_harbol_cfg_write_char(w, ']');
+				break;
+			}
+			case HarbolCfgType_Vec4D: {
+				float32_t const axes[] = { cv.v->x, cv.v->y, cv.v->z, cv.v->w };
+				for( size_t n=0; n < sizeof axes / sizeof axes[0]; n++ ) {
+					_harbol_cfg_write_char(w, ( n==0 )? '[' : ',');
+					_harbol_json_write_float(w, axes[n], true);
+				}
+				_harbol_cfg_write_char(w, ']');
+				break;
+			}
+			default:
+				_harbol_cfg_write_scalar(w, var->tag, cv.data);
+				break;
 		}
+	}
+	_harbol_cfg_write_char(w, '}');
+}
+
+HARBOL_EXPORT struct HarbolString harbol_cfg_to_json(struct HarbolMap const *const cfg) {
+	struct HarbolCfgWriter w = { .compact = true };
+	_harbol_json_write_map(&w, cfg);
+	return _harbol_cfg_writer_str(&w);
+}
+
+HARBOL_EXPORT bool harbol_cfg_build_json_file(struct HarbolMap const *const cfg, char const filename[static 1]) {
+	FILE *restrict jsonfile = fopen(filename, "w+");
+	if( jsonfile==NULL ) {
+		fputs("harbol_cfg_build_json_file :: unable to create file.\n", stderr);
 		return false;
 	}
-	*( union HarbolColor* )(var->data) = val;
+	struct HarbolCfgWriter w = { .compact = true };
+	_harbol_json_write_map(&w, cfg);
+	bool const result = !w.failed && fwrite(w.buf, sizeof *w.buf, w.len, jsonfile)==w.len;
+	free(w.buf);
+	fclose(jsonfile); jsonfile=NULL;
+	return result;
+}
+
+/// document builder: nodes and strings grow in scratch arrays and are packed into one block at the end.
+struct HarbolCfgDocBuilder {
+	struct HarbolArray nodes, pool, open; /// 'open' is the stack of sections being filled.
+	/// open-addressed (parent, key) hashes and their nodes for duplicate key checks.
+	/// the hash is kept in the slot so most probes don't touch the nodes.
+	struct HarbolCfgDocSlot {
+		size_t hash, node;
+	}                 *seen;
+	size_t             seen_cap;
+	bool               failed;
+};
+
+
+/// keys differing in their last char hash to neighbouring values, so the bits get mixed before masking.
+static inline size_t _harbol_cfg_mix(size_t h) {
+	h ^= h >> 16;
+	h *= 0x85EBCA6Bu;
+	h ^= h >> 13;
+	h *= 0xC2B2AE35u;
+	h ^= h >> 16;
+	return h;
+}
+
+static inline size_t _harbol_cfg_doc_seen_hash(size_t const parent, size_t const hash) {
+	return _harbol_cfg_mix(hash + parent * 0x9E3779B9u);
+}
+
+static NO_NULL size_t _harbol_cfg_doc_builder_find(struct HarbolCfgDocBuilder const *const db, size_t const parent, char const key[const], size_t const keylen, size_t const hash) {
+	if( db->seen==NULL ) {
+		return SIZE_MAX;
+	}
+	struct HarbolCfgNode const *const nodes = ( struct HarbolCfgNode const* )(db->nodes.table);
+	char const *const pool = ( char const* )(db->pool.table);
+	size_t const mask = db->seen_cap - 1;
+	size_t const seen_hash = _harbol_cfg_doc_seen_hash(parent, hash);
+	for( size_t i = seen_hash & mask;; i = (i + 1) & mask ) {
+		size_t const n = db->seen[i].node;
+		if( n==SIZE_MAX ) {
+			return SIZE_MAX;
+		} else if( db->seen[i].hash==seen_hash && nodes[n].parent==parent && nodes[n].keylen==keylen && !memcmp(&pool[nodes[n].key], key, keylen) ) {
+			return n;
+		}
+	}
+}
+
+static NO_NULL void _harbol_cfg_doc_builder_link(struct HarbolCfgDocBuilder *const db, size_t const n) {
+	struct HarbolCfgNode const *const node = &(( struct HarbolCfgNode const* )(db->nodes.table))[n];
+	size_t const mask = db->seen_cap - 1;
+	size_t const seen_hash = _harbol_cfg_doc_seen_hash(node->parent, node->hash);
+	size_t i = seen_hash & mask;
+	while( db->seen[i].node != SIZE_MAX ) {
+		i = (i + 1) & mask;
+	}
+	db->seen[i] = ( struct HarbolCfgDocSlot ){ seen_hash, n };
+}
+
+/// nodes after the root are all in the table, which is kept at most half full.
+static NO_NULL bool _harbol_cfg_doc_builder_remember(struct HarbolCfgDocBuilder *const db, size_t const n) {
+	if( n + 1 > (db->seen_cap >> 1) ) {
+		size_t const new_cap = ( db->seen_cap==0 )? 64 : db->seen_cap << 1;
+		struct HarbolCfgDocSlot *const seen = malloc(new_cap * sizeof *seen);
+		if( seen==NULL ) {
+			return false;
+		}
+		for( size_t i=0; i < new_cap; i++ ) {
+			seen[i].node = SIZE_MAX;
+		}
+		free(db->seen);
+		db->seen     = seen;
+		db->seen_cap = new_cap;
+		for( size_t i=1; i < n; i++ ) {
+			_harbol_cfg_doc_builder_link(db, i);
+		}
+	}
+	_harbol_cfg_doc_builder_link(db, n);
 	return true;
 }
 
-HARBOL_EXPORT bool harbol_cfg_set_vec4D(struct HarbolMap *const restrict cfgmap, char const key[static 1], struct HarbolVec4D const val, bool const override_convert) {
-	struct HarbolVariant *const restrict var = _get_var(cfgmap, key);
-	if( var==NULL ) {
-		return false;
-	} else if( var->tag != HarbolCfgType_Vec4D ) {
-		if( override_convert ) {
-			_harbol_cfgkey_clear(var);
-			*var = harbol_variant_make(&val, sizeof val, HarbolCfgType_Vec4D, &( bool ){0});
-			return true;
+static NO_NULL size_t _harbol_cfg_doc_builder_add(struct HarbolCfgDocBuilder *const db, struct HarbolString const *const key, enum HarbolCfgType const type) {
+	size_t const parent = *( size_t const* )(harbol_array_peek(&db->open, sizeof parent));
+	size_t const keylen = key->len + 1;
+	size_t const hash   = harbol_map_key_hash(key->cstr, keylen).base;
+	if( _harbol_cfg_doc_builder_find(db, parent, key->cstr, keylen, hash) != SIZE_MAX ) {
+		return SIZE_MAX;
+	}
+	
+	struct HarbolCfgNode const node = {
+		.key    = harbol_array_append_n(&db->pool, key->cstr, sizeof *key->cstr, keylen),
+		.keylen = keylen,
+		.hash   = hash,
+		.parent = parent,
+		.end    = db->nodes.len + 1,
+		.type   = type,
+	};
+	size_t const n = ( node.key==SIZE_MAX )? SIZE_MAX : harbol_array_append(&db->nodes, &node, sizeof node);
+	if( n==SIZE_MAX || !_harbol_cfg_doc_builder_remember(db, n) ) {
+		db->failed = true;
+		return SIZE_MAX;
+	}
+	(( struct HarbolCfgNode* )(db->nodes.table))[parent].len++;
+	return n;
+}
+
+static enum HarbolCfgEventRes _harbol_cfg_doc_check_key(void *const data, struct HarbolString const *const key, size_t const depth) {
+	(void)(depth);
+	struct HarbolCfgDocBuilder const *const db = data;
+	size_t const parent = *( size_t const* )(harbol_array_peek(&db->open, sizeof parent));
+	return( _harbol_cfg_doc_builder_find(db, parent, key->cstr, key->len+1, harbol_map_key_hash(key->cstr, key->len+1).base) != SIZE_MAX )? HarbolCfgEvent_Error : HarbolCfgEvent_Continue;
+}
+
+static enum HarbolCfgEventRes _harbol_cfg_doc_begin_section(void *const data, struct HarbolString const *const key, size_t const depth) {
+	(void)(depth);
+	struct HarbolCfgDocBuilder *const db = data;
+	size_t const n = _harbol_cfg_doc_builder_add(db, key, HarbolCfgType_Map);
+	if( n==SIZE_MAX ) {
+		return HarbolCfgEvent_Error;
+	} else if( harbol_array_append(&db->open, &n, sizeof n)==SIZE_MAX ) {
+		db->failed = true;
+		return HarbolCfgEvent_Error;
+	}
+	return HarbolCfgEvent_Continue;
+}
+
+static enum HarbolCfgEventRes _harbol_cfg_doc_end_section(void *const data, struct HarbolString const *const key, size_t const depth) {
+	(void)(key); (void)(depth);
+	struct HarbolCfgDocBuilder *const db = data;
+	size_t const n = *( size_t const* )(harbol_array_pop(&db->open, sizeof n));
+	(( struct HarbolCfgNode* )(db->nodes.table))[n].end = db->nodes.len;
+	return HarbolCfgEvent_Continue;
+}
+
+static enum HarbolCfgEventRes _harbol_cfg_doc_add_value(void *const data, struct HarbolString const *const key, enum HarbolCfgType const type, void *const val, size_t const depth) {
+	(void)(depth);
+	struct HarbolCfgDocBuilder *const db = data;
+	size_t const n = _harbol_cfg_doc_builder_add(db, key, type);
+	if( n==SIZE_MAX ) {
+		return HarbolCfgEvent_Error;
+	}
+	
+	struct HarbolCfgNode *const node = &(( struct HarbolCfgNode* )(db->nodes.table))[n];
+	if( type==HarbolCfgType_String ) {
+		struct HarbolString const *const str = val;
+		node->len     = str->len;
+		node->val.str = ( str->cstr==NULL )? harbol_array_append(&db->pool, "", 1) : harbol_array_append_n(&db->pool, str->cstr, 1, str->len + 1);
+		if( node->val.str==SIZE_MAX ) {
+			db->failed = true;
+			return HarbolCfgEvent_Error;
 		}
+	} else if( type != HarbolCfgType_Null ) {
+		memcpy(&node->val, val, _harbol_cfg_type_size(type));
+	}
+	return HarbolCfgEvent_Continue;
+}
+
+static struct HarbolCfgEvents const _harbol_cfg_doc_events = {
+	_harbol_cfg_doc_check_key,
+	_harbol_cfg_doc_begin_section,
+	_harbol_cfg_doc_end_section,
+	_harbol_cfg_doc_add_value,
+};
+
+static NO_NULL bool _harbol_cfg_doc_builder_init(struct HarbolCfgDocBuilder *const db) {
+	struct HarbolCfgNode const root = { .parent = SIZE_MAX, .end = 1, .keylen = 1, .type = HarbolCfgType_Map };
+	size_t const root_idx = 0;
+	*db = ( struct HarbolCfgDocBuilder ){0};
+	if( !harbol_array_init(&db->nodes, sizeof root, 64) || !harbol_array_init(&db->pool, sizeof(char), 1024) || !harbol_array_init(&db->open, sizeof root_idx, 8) ) {
+		db->failed = true;
 		return false;
 	}
+	/// the root's key is the empty string at the start of the pool.
+	db->failed = harbol_array_append(&db->nodes, &root, sizeof root)==SIZE_MAX
+			|| harbol_array_append(&db->pool, "", 1)==SIZE_MAX
+			|| harbol_array_append(&db->open, &root_idx, sizeof root_idx)==SIZE_MAX;
+	return !db->failed;
+}
+
+/// hash-and-displace: a first hash groups a section's keys into buckets, then each bucket,
+/// largest first, gets a displacement that drops all of its keys into free slots.
+/// a bucket with a single key stores its slot directly as 'SIZE_MAX - slot'.
+static inline size_t _harbol_cfg_doc_slot(size_t const hash, size_t const disp, size_t const mask) {
+	return( disp > SIZE_MAX - (mask + 1) )? SIZE_MAX - disp : _harbol_cfg_mix(hash + disp * 0x9E3779B9u) & mask;
+}
+
+static int _harbol_cfg_doc_bucket_cmp(void const *const a, void const *const b) {
+	size_t const x = *( size_t const* )(a), y = *( size_t const* )(b);
+	return( x < y ) - ( x > y );
+}
+
+/// fills 'table' with 'cap' displacements followed by 'cap' slots.
+/// returns false if a displacement search runs out, the section then goes without a table.
+static NO_NULL bool _harbol_cfg_doc_index_section(struct HarbolCfgNode const nodes[const], size_t const section, size_t table[const], size_t const cap, size_t scratch[const]) {
+	size_t const n    = nodes[section].len;
+	size_t const mask = cap - 1;
+	size_t *const disp    = table;
+	size_t *const slots   = &table[cap];
+	size_t *const members = scratch;           /// kids grouped by bucket.
+	size_t *const starts  = &scratch[n];       /// each bucket's first member, then a fill cursor.
+	size_t *const order   = &scratch[n + cap + 1];
+	
+	for( size_t i=0; i < cap; i++ ) {
+		disp[i] = 0; slots[i] = SIZE_MAX;
+		starts[i] = 0;
+	}
+	starts[cap] = 0;
+	for( size_t k = section + 1; k < nodes[section].end; k = nodes[k].end ) {
+		starts[_harbol_cfg_mix(nodes[k].hash) & mask]++;
+	}
+	/// sort buckets by size, descending, encoding the size above the bucket number.
+	for( size_t b=0; b < cap; b++ ) {
+		order[b] = starts[b] * cap + b;
+	}
+	qsort(order, cap, sizeof *order, _harbol_cfg_doc_bucket_cmp);
+	for( size_t b=0, sum=0; b <= cap; b++ ) {
+		size_t const count = starts[b];
+		starts[b] = sum;
+		sum += count;
+	}
+	for( size_t k = section + 1; k < nodes[section].end; k = nodes[k].end ) {
+		size_t const b = _harbol_cfg_mix(nodes[k].hash) & mask;
+		size_t cursor = starts[b];
+		while( cursor < n && members[cursor] != SIZE_MAX && cursor < starts[b + 1] ) {
+			cursor++;
+		}
+		members[cursor] = k;
+	}
 	
-	*( struct HarbolVec4D* )(var->data) = val;
+	size_t free_slot = 0;
+	for( size_t o=0; o < cap; o++ ) {
+		size_t const b = order[o] & mask, count = order[o] / cap;
+		size_t const *const bucket = &members[starts[b]];
+		if( count==0 ) {
+			break;
+		} else if( count==1 ) {
+			while( slots[free_slot] != SIZE_MAX ) {
+				free_slot++;
+			}
+			slots[free_slot] = bucket[0];
+			disp[b] = SIZE_MAX - free_slot;
+			continue;
+		}
+		
+		size_t d = 1;
+		for( ; d < (1 << 16); d++ ) {
+			size_t placed = 0;
+			while( placed < count ) {
+				size_t const slot = _harbol_cfg_mix(nodes[bucket[placed]].hash + d * 0x9E3779B9u) & mask;
+				if( slots[slot] != SIZE_MAX ) {
+					break;
+				}
+				slots[slot] = bucket[placed++];
+			}
+			if( placed==count ) {
+				break;
+			}
+			while( placed-- > 0 ) {
+				slots[_harbol_cfg_mix(nodes[bucket[placed]].hash + d * 0x9E3779B9u) & mask] = SIZE_MAX;
+			}
+		}
+		if( d==(1 << 16) ) {
+			return false;
+		}
+		disp[b] = d;
+	}
 	return true;
 }
 
-HARBOL_EXPORT bool harbol_cfg_set_to_null(struct HarbolMap *const restrict cfgmap, char const key[static 1]) {
-	struct HarbolVariant *const restrict var = _get_var(cfgmap, key);
-	if( var==NULL ) {
-		return false;
+/// sections with enough keys get their perfect hash tables here,
+/// then header, nodes, tables and strings are packed into one block.
+static NO_NULL struct HarbolCfgDoc *_harbol_cfg_doc_builder_pack(struct HarbolCfgDocBuilder *const db) {
+	struct HarbolCfgNode *const nodes = ( struct HarbolCfgNode* )(db->nodes.table);
+	size_t tables_len = 0, most_kids = 0, most_cap = 0;
+	if( !db->failed ) {
+		nodes[0].end = db->nodes.len;
+		for( size_t i=0; i < db->nodes.len; i++ ) {
+			if( nodes[i].type==HarbolCfgType_Map && nodes[i].len >= HARBOL_CFG_DOC_INDEX_THRESHOLD ) {
+				nodes[i].val.keys.cap = bitwise_ceil(nodes[i].len - 1) + 1;
+				tables_len += nodes[i].val.keys.cap * 2;
+				most_kids = ( nodes[i].len > most_kids )? nodes[i].len : most_kids;
+				most_cap  = ( nodes[i].val.keys.cap > most_cap )? nodes[i].val.keys.cap : most_cap;
+			}
+		}
 	}
 	
-	_harbol_cfgkey_clear(var);
-	*var = harbol_variant_make(&( char ){0}, 1, HarbolCfgType_Null, &( bool ){0});
-	return true;
+	size_t *const tables  = ( tables_len==0 || db->failed )? NULL : malloc(tables_len * sizeof *tables);
+	size_t *const scratch = ( tables==NULL )? NULL : malloc((most_kids + most_cap * 2 + 1) * sizeof *scratch);
+	if( tables_len > 0 && scratch==NULL ) {
+		db->failed = true;
+	}
+	for( size_t i=0, offs=0; i < db->nodes.len && !db->failed; i++ ) {
+		if( nodes[i].type != HarbolCfgType_Map || nodes[i].len < HARBOL_CFG_DOC_INDEX_THRESHOLD ) {
+			continue;
+		}
+		size_t const cap = nodes[i].val.keys.cap;
+		for( size_t k=0; k < nodes[i].len; k++ ) {
+			scratch[k] = SIZE_MAX;
+		}
+		nodes[i].val.keys.table = offs;
+		if( !_harbol_cfg_doc_index_section(nodes, i, &tables[offs], cap, scratch) ) {
+			/// keep the space but fall back to scanning the section.
+			nodes[i].val.keys.cap = 0;
+		}
+		offs += cap * 2;
+	}
+	
+	struct HarbolCfgDoc *doc = NULL;
+	if( !db->failed ) {
+		size_t const nodes_offs  = sizeof(union { struct HarbolCfgDoc doc; floatmax_t f; intmax_t i; size_t s; });
+		size_t const tables_offs = nodes_offs + db->nodes.len * sizeof *nodes;
+		size_t const pool_offs   = tables_offs + tables_len * sizeof *tables;
+		uint8_t *const block     = malloc(pool_offs + db->pool.len);
+		if( block != NULL ) {
+			memcpy(&block[nodes_offs], nodes, db->nodes.len * sizeof *nodes);
+			if( tables_len > 0 ) {
+				memcpy(&block[tables_offs], tables, tables_len * sizeof *tables);
+			}
+			memcpy(&block[pool_offs], db->pool.table, db->pool.len);
+			doc = ( struct HarbolCfgDoc* )(block);
+			doc->nodes      = ( struct HarbolCfgNode const* )(&block[nodes_offs]);
+			doc->tables     = ( size_t const* )(&block[tables_offs]);
+			doc->pool       = ( char const* )(&block[pool_offs]);
+			doc->len        = db->nodes.len;
+			doc->tables_len = tables_len;
+			doc->pool_len   = db->pool.len;
+		}
+	}
+	free(tables);
+	free(scratch);
+	harbol_array_clear(&db->nodes);
+	harbol_array_clear(&db->pool);
+	harbol_array_clear(&db->open);
+	free(db->seen); db->seen = NULL;
+	return doc;
 }
 
-static NO_NULL void _write_tabs(FILE *const file, size_t const tabs) {
-	for( size_t i=0; i < tabs; i++ ) {
-		fputs("\t", file);
+static struct HarbolCfgDoc *_harbol_cfg_doc_parse(char const cfgcode[static 1], HarbolCfgState *const restrict parse_state) {
+	struct HarbolCfgDocBuilder db;
+	if( _harbol_cfg_doc_builder_init(&db) ) {
+		parse_state->events   = &_harbol_cfg_doc_events;
+		parse_state->userdata = &db;
+		_harbol_cfg_parse(cfgcode, parse_state);
 	}
+	return _harbol_cfg_doc_builder_pack(&db);
 }
 
-static NO_NULL bool _harbol_cfg_build_file(struct HarbolMap const *const map, FILE *const file, size_t const tabs) {
+static NO_NULL bool _harbol_cfg_doc_add_map(struct HarbolCfgDocBuilder *const db, struct HarbolMap const *const map) {
 	for( size_t i=0; i < map->len; i++ ) {
-		struct HarbolVariant const *const v = ( struct HarbolVariant const* )(map->datum[i]);
-		int32_t const type = v->tag;
-		_write_tabs(file, tabs);
-		/// using double pointer iterators as we need the key.
-		fprintf(file, "\"%s\": ", ( char const* )(map->keys[i]));
-		
-		union ConfigVal const cv = { v->data };
-		switch( type ) {
-			case HarbolCfgType_Null:
-				fputs("null\n", file); break;
-			case HarbolCfgType_Map:
-				fputs("{\n", file);
-				_harbol_cfg_build_file(*cv.section, file, tabs+1);
-				_write_tabs(file, tabs);
-				fputs("}\n", file);
-				break;
-			
-			case HarbolCfgType_String: fprintf(file, "\"%s\"\n", (*cv.str)->cstr);       break;
-			case HarbolCfgType_Float:  fprintf(file, "%" PRIfMAX "\n", *cv.f);           break;
-			case HarbolCfgType_Int:    fprintf(file, "%" PRIiMAX "\n", *cv.i);           break;
-			case HarbolCfgType_Bool:   fprintf(file, "%s\n", (*cv.b)? "true" : "false"); break;
-			case HarbolCfgType_Color:
-				fprintf(file, "c[ %u, %u, %u, %u ]\n", cv.c->bytes.r, cv.c->bytes.g, cv.c->bytes.b, cv.c->bytes.a); break;
-			case HarbolCfgType_Vec4D:
-				fprintf(file, "v[ %" PRIf32 ", %" PRIf32 ", %" PRIf32 ", %" PRIf32 " ]\n", cv.v->x, cv.v->y, cv.v->z, cv.v->w); break;
+		struct HarbolString const key = { ( char* )(map->keys[i]), map->keylens[i] - 1 };
+		struct HarbolVariant const *const var = ( struct HarbolVariant const* )(map->datum[i]);
+		union ConfigVal const cv = { harbol_variant_data(var) };
+		if( var->tag==HarbolCfgType_Map ) {
+			if( _harbol_cfg_doc_begin_section(db, &key, 0) != HarbolCfgEvent_Continue ) {
+				return false;
+			}
+			bool const res = _harbol_cfg_doc_add_map(db, *cv.section);
+			_harbol_cfg_doc_end_section(db, &key, 0);
+			if( !res ) {
+				return false;
+			}
+		} else if( _harbol_cfg_doc_add_value(db, &key, var->tag, ( var->tag==HarbolCfgType_String )? ( void* )(*cv.str) : cv.data, 0) != HarbolCfgEvent_Continue ) {
+			return false;
 		}
 	}
 	return true;
 }
 
-HARBOL_EXPORT bool harbol_cfg_build_file(struct HarbolMap const *const cfg, char const filename[static 1], bool const overwrite) {
-	FILE *restrict cfgfile = fopen(filename, overwrite? "w+" : "a+");
-	if( cfgfile==NULL ) {
-		fputs("harbol_cfg_build_file :: unable to create file.\n", stderr);
+HARBOL_EXPORT struct HarbolCfgDoc *harbol_cfg_doc_parse_file(char const filename[static 1]) {
+	HarbolCfgState parse_state = {0};
+	struct HarbolString cfg = {0};
+	if( !_harbol_cfg_read_file(filename, &cfg, &parse_state) ) {
+		return NULL;
+	}
+	struct HarbolCfgDoc *const doc = _harbol_cfg_doc_parse(cfg.cstr, &parse_state);
+	harbol_string_clear(&cfg);
+	return doc;
+}
+
+HARBOL_EXPORT struct HarbolCfgDoc *harbol_cfg_doc_parse_cstr(char const cfgcode[static 1]) {
+	HarbolCfgState parse_state = {0};
+	return _harbol_cfg_doc_parse(cfgcode, &parse_state);
+}
+
+HARBOL_EXPORT void harbol_cfg_doc_free(struct HarbolCfgDoc **const docref) {
+	free(*docref); *docref = NULL;
+}
+
+HARBOL_EXPORT struct HarbolCfgDoc *harbol_cfg_doc_from_map(struct HarbolMap const *const cfg) {
+	struct HarbolCfgDocBuilder db;
+	if( _harbol_cfg_doc_builder_init(&db) && !_harbol_cfg_doc_add_map(&db, cfg) ) {
+		db.failed = true;
+	}
+	return _harbol_cfg_doc_builder_pack(&db);
+}
+
+
+/// binary layout: header | nodes | tables | pool, every reference inside is an offset or a node index.
+#define HARBOL_CFG_BIN_VERSION    1u
+
+struct HarbolCfgBinHeader {
+	char     magic[8];
+	uint32_t version, node_size, word_size, float_size, endian;
+	uint64_t len, tables_len, pool_len;
+};
+
+static struct HarbolCfgBinHeader _harbol_cfg_bin_header(size_t const len, size_t const tables_len, size_t const pool_len) {
+	struct HarbolCfgBinHeader const header = {
+		.magic      = "HRBLCFG",
+		.version    = HARBOL_CFG_BIN_VERSION,
+		.node_size  = sizeof(struct HarbolCfgNode),
+		.word_size  = sizeof(size_t),
+		.float_size = sizeof(floatmax_t),
+		.endian     = 0x01020304u,
+		.len        = len,
+		.tables_len = tables_len,
+		.pool_len   = pool_len,
+	};
+	return header;
+}
+
+/// padded so the nodes after it stay aligned in the mapping.
+#define HARBOL_CFG_BIN_HEADER_SIZE    sizeof(union { struct HarbolCfgBinHeader h; floatmax_t f; intmax_t i; size_t s; })
+
+HARBOL_EXPORT bool harbol_cfg_doc_build_binary(struct HarbolCfgDoc const *const doc, char const filename[static 1]) {
+	FILE *const file = fopen(filename, "wb");
+	if( file==NULL ) {
 		return false;
 	}
-	bool const result = _harbol_cfg_build_file(cfg, cfgfile, 0);
-	fclose(cfgfile); cfgfile=NULL;
-	return result;
+	uint8_t header[HARBOL_CFG_BIN_HEADER_SIZE] = {0};
+	struct HarbolCfgBinHeader const h = _harbol_cfg_bin_header(doc->len, doc->tables_len, doc->pool_len);
+	memcpy(header, &h, sizeof h);
+	bool const res = fwrite(header, sizeof header, 1, file)==1
+			&& fwrite(doc->nodes, sizeof *doc->nodes, doc->len, file)==doc->len
+			&& ( doc->tables_len==0 || fwrite(doc->tables, sizeof *doc->tables, doc->tables_len, file)==doc->tables_len )
+			&& fwrite(doc->pool, sizeof *doc->pool, doc->pool_len, file)==doc->pool_len;
+	return fclose(file)==0 && res;
 }
 
+HARBOL_EXPORT bool harbol_cfg_build_binary(struct HarbolMap const *const cfg, char const filename[static 1]) {
+	struct HarbolCfgDoc *doc = harbol_cfg_doc_from_map(cfg);
+	if( doc==NULL ) {
+		return false;
+	}
+	bool const res = harbol_cfg_doc_build_binary(doc, filename);
+	harbol_cfg_doc_free(&doc);
+	return res;
+}
 
-HARBOL_EXPORT floatmax_t harbol_cfg_calc_math(struct HarbolMap const *const restrict cfg, char const key[const restrict static 1], HarbolMathVarFunc *const var_func, void *const restrict data, size_t const data_len) {
-	struct HarbolString *const restrict str = harbol_cfg_get_str(cfg, key);
-	if( str==NULL ) {
-		union {
-			uintmax_t const  u;
-			floatmax_t const f;
-		} const c = { -1ULL };
-		return c.f;
+/// only the header and sizes are checked, the rest of the file is trusted as a build artifact.
+static NO_NULL bool _harbol_cfg_bin_view(uint8_t const block[const], size_t const size, struct HarbolCfgDoc *const doc) {
+	struct HarbolCfgBinHeader const expected = _harbol_cfg_bin_header(0, 0, 0);
+	struct HarbolCfgBinHeader h;
+	if( size < HARBOL_CFG_BIN_HEADER_SIZE ) {
+		return false;
 	}
-	return harbol_math_parse_expr(str->cstr, var_func==NULL? harbol_math_default_var_func : var_func, data, data_len);
+	memcpy(&h, block, sizeof h);
+	if( memcmp(h.magic, expected.magic, sizeof h.magic) != 0 || h.version != expected.version || h.node_size != expected.node_size
+			|| h.word_size != expected.word_size || h.float_size != expected.float_size || h.endian != expected.endian ) {
+		return false;
+	}
+	
+	size_t const room = size - HARBOL_CFG_BIN_HEADER_SIZE;
+	if( h.len==0 || h.len > room / sizeof *doc->nodes || h.tables_len > (room - h.len * sizeof *doc->nodes) / sizeof *doc->tables ) {
+		return false;
+	}
+	size_t const tables_offs = HARBOL_CFG_BIN_HEADER_SIZE + h.len * sizeof *doc->nodes;
+	size_t const pool_offs   = tables_offs + h.tables_len * sizeof *doc->tables;
+	if( h.pool_len==0 || h.pool_len != size - pool_offs || block[size - 1] != 0 ) {
+		return false;
+	}
+	
+	doc->nodes      = ( struct HarbolCfgNode const* )(&block[HARBOL_CFG_BIN_HEADER_SIZE]);
+	doc->tables     = ( size_t const* )(&block[tables_offs]);
+	doc->pool       = ( char const* )(&block[pool_offs]);
+	doc->len        = h.len;
+	doc->tables_len = h.tables_len;
+	doc->pool_len   = h.pool_len;
+	return doc->nodes[0].type==HarbolCfgType_Map && doc->nodes[0].end==doc->len;
+}
+
+HARBOL_EXPORT struct HarbolCfgMapping harbol_cfg_load_binary(char const filename[static 1], bool *const res) {
+	struct HarbolCfgMapping mapping = {0};
+	*res = false;
+#ifdef OS_WINDOWS
+	HANDLE const file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if( file==INVALID_HANDLE_VALUE ) {
+		return mapping;
+	}
+	LARGE_INTEGER size;
+	HANDLE const view = ( GetFileSizeEx(file, &size) && size.QuadPart > 0 )? CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL) : NULL;
+	CloseHandle(file);
+	if( view==NULL ) {
+		return mapping;
+	}
+	mapping.addr = MapViewOfFile(view, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(view);
+	if( mapping.addr==NULL ) {
+		return mapping;
+	}
+	mapping.size = ( size_t )(size.QuadPart);
+#else
+	int const fd = open(filename, O_RDONLY);
+	if( fd < 0 ) {
+		return mapping;
+	}
+	struct stat info;
+	if( fstat(fd, &info) != 0 || info.st_size <= 0 ) {
+		close(fd);
+		return mapping;
+	}
+	void *const addr = mmap(NULL, ( size_t )(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if( addr==MAP_FAILED ) {
+		return mapping;
+	}
+	mapping.addr = addr;
+	mapping.size = ( size_t )(info.st_size);
+#endif
+	if( !_harbol_cfg_bin_view(mapping.addr, mapping.size, &mapping.doc) ) {
+		harbol_cfg_unload_binary(&mapping);
+		return mapping;
+	}
+	*res = true;
+	return mapping;
+}
+
+HARBOL_EXPORT void harbol_cfg_unload_binary(struct HarbolCfgMapping *const mapping) {
+	if( mapping->addr != NULL ) {
+#ifdef OS_WINDOWS
+		UnmapViewOfFile(mapping->addr);
+#else
+		munmap(mapping->addr, mapping->size);
+#endif
+	}
+	*mapping = ( struct HarbolCfgMapping ){0};
+}
+
+static NO_NULL void _harbol_cfg_doc_write(struct HarbolCfgWriter *const w, struct HarbolCfgDoc const *const doc, size_t const section, size_t const depth) {
+	for( size_t i = section + 1; i < doc->nodes[section].end; i = doc->nodes[i].end ) {
+		struct HarbolCfgNode const *const node = &doc->nodes[i];
+		_harbol_cfg_write_key(w, &doc->pool[node->key], node->keylen - 1, depth, i==section + 1);
+		switch( node->type ) {
+			case HarbolCfgType_Map:
+				_harbol_cfg_write_char(w, '{');
+				_harbol_cfg_write_eol(w);
+				_harbol_cfg_doc_write(w, doc, i, depth + 1);
+				_harbol_cfg_write_indent(w, depth);
+				_harbol_cfg_write_char(w, '}');
+				break;
+			case HarbolCfgType_String:
+				_harbol_cfg_write_quoted(w, &doc->pool[node->val.str], node->len);
+				break;
+			default:
+				_harbol_cfg_write_scalar(w, node->type, &node->val);
+				break;
+		}
+		_harbol_cfg_write_eol(w);
+	}
+}
+
+HARBOL_EXPORT struct HarbolString harbol_cfg_doc_to_str(struct HarbolCfgDoc const *const doc) {
+	struct HarbolCfgWriter w = {0};
+	_harbol_cfg_doc_write(&w, doc, 0, 0);
+	return _harbol_cfg_writer_str(&w);
+}
+
+/// a section's keys are scanned sibling to sibling, skipping over nested subtrees.
+static NO_NULL size_t _harbol_cfg_doc_kid(struct HarbolCfgDoc const *const doc, size_t const section, char const key[const], size_t const keylen, size_t const hash) {
+	struct HarbolCfgNode const *const sect = &doc->nodes[section];
+	if( sect->type != HarbolCfgType_Map ) {
+		return SIZE_MAX;
+	} else if( sect->val.keys.cap > 0 ) {
+		size_t const mask = sect->val.keys.cap - 1;
+		size_t const *const disp = &doc->tables[sect->val.keys.table];
+		size_t const n = disp[mask + 1 + _harbol_cfg_doc_slot(hash, disp[_harbol_cfg_mix(hash) & mask], mask)];
+		return( n != SIZE_MAX && doc->nodes[n].hash==hash && doc->nodes[n].keylen==keylen && !memcmp(&doc->pool[doc->nodes[n].key], key, keylen) )? n : SIZE_MAX;
+	}
+	for( size_t i = section + 1; i < doc->nodes[section].end; i = doc->nodes[i].end ) {
+		struct HarbolCfgNode const *const node = &doc->nodes[i];
+		if( node->hash==hash && node->keylen==keylen && !memcmp(&doc->pool[node->key], key, keylen) ) {
+			return i;
+		}
+	}
+	return SIZE_MAX;
+}
+
+struct HarbolCfgDocWalk {
+	struct HarbolCfgDoc const *doc;
+	size_t                     node;
+};
+
+static bool _harbol_cfg_doc_step(void *const ctx, char const key[const], size_t const keylen) {
+	struct HarbolCfgDocWalk *const walk = ctx;
+	walk->node = _harbol_cfg_doc_kid(walk->doc, walk->node, key, keylen, harbol_map_key_hash(key, keylen).base);
+	return walk->node != SIZE_MAX;
+}
+
+HARBOL_EXPORT size_t harbol_cfg_doc_find(struct HarbolCfgDoc const *const doc, size_t const section, char const keypath[static 1]) {
+	if( section >= doc->len ) {
+		return SIZE_MAX;
+	}
+	struct HarbolCfgDocWalk walk = { doc, section };
+	return( _harbol_cfg_walk_keypath(keypath, _harbol_cfg_doc_step, &walk) )? walk.node : SIZE_MAX;
+}
+
+HARBOL_EXPORT size_t harbol_cfg_doc_find_path(struct HarbolCfgDoc const *const doc, size_t const section, struct HarbolCfgPath const *const path) {
+	size_t node = ( section < doc->len && path->len > 0 )? section : SIZE_MAX;
+	for( size_t i=0; i < path->len && node != SIZE_MAX; i++ ) {
+		node = _harbol_cfg_doc_kid(doc, node, path->segs[i], path->keylens[i], path->hashes[i].base);
+	}
+	return node;
+}
+
+HARBOL_EXPORT char const *harbol_cfg_doc_key(struct HarbolCfgDoc const *const doc, size_t const node) {
+	return( node >= doc->len )? NULL : &doc->pool[doc->nodes[node].key];
+}
+
+static NO_NULL struct HarbolCfgNode const *_harbol_cfg_doc_get(struct HarbolCfgDoc const *const doc, char const keypath[const], enum HarbolCfgType const type) {
+	size_t const n = harbol_cfg_doc_find(doc, 0, keypath);
+	return( n==SIZE_MAX || doc->nodes[n].type != type )? NULL : &doc->nodes[n];
+}
+
+HARBOL_EXPORT size_t harbol_cfg_doc_get_section(struct HarbolCfgDoc const *const doc, char const keypath[static 1]) {
+	struct HarbolCfgNode const *const node = _harbol_cfg_doc_get(doc, keypath, HarbolCfgType_Map);
+	return( node==NULL )? SIZE_MAX : ( size_t )(node - doc->nodes);
+}
+
+HARBOL_EXPORT char const *harbol_cfg_doc_get_cstr(struct HarbolCfgDoc const *const doc, char const keypath[static 1], size_t *const len) {
+	struct HarbolCfgNode const *const node = _harbol_cfg_doc_get(doc, keypath, HarbolCfgType_String);
+	if( node==NULL ) {
+		return NULL;
+	}
+	*len = node->len;
+	return &doc->pool[node->val.str];
+}
+
+HARBOL_EXPORT floatmax_t const *harbol_cfg_doc_get_float(struct HarbolCfgDoc const *const doc, char const keypath[static 1]) {
+	struct HarbolCfgNode const *const node = _harbol_cfg_doc_get(doc, keypath, HarbolCfgType_Float);
+	return( node==NULL )? NULL : &node->val.f;
+}
+
+HARBOL_EXPORT intmax_t const *harbol_cfg_doc_get_int(struct HarbolCfgDoc const *const doc, char const keypath[static 1]) {
+	struct HarbolCfgNode const *const node = _harbol_cfg_doc_get(doc, keypath, HarbolCfgType_Int);
+	return( node==NULL )? NULL : &node->val.i;
+}
+
+HARBOL_EXPORT bool const *harbol_cfg_doc_get_bool(struct HarbolCfgDoc const *const doc, char const keypath[static 1]) {
+	struct HarbolCfgNode const *const node = _harbol_cfg_doc_get(doc, keypath, HarbolCfgType_Bool);
+	return( node==NULL )? NULL : &node->val.b;
+}
+
+HARBOL_EXPORT union HarbolColor const *harbol_cfg_doc_get_color(struct HarbolCfgDoc const *const doc, char const keypath[static 1]) {
+	struct HarbolCfgNode const *const node = _harbol_cfg_doc_get(doc, keypath, HarbolCfgType_Color);
+	return( node==NULL )? NULL : &node->val.c;
+}
+
+HARBOL_EXPORT struct HarbolVec4D const *harbol_cfg_doc_get_vec4D(struct HarbolCfgDoc const *const doc, char const keypath[static 1]) {
+	struct HarbolCfgNode const *const node = _harbol_cfg_doc_get(doc, keypath, HarbolCfgType_Vec4D);
+	return( node==NULL )? NULL : &node->val.v;
+}
+
+HARBOL_EXPORT enum HarbolCfgType harbol_cfg_doc_get_type(struct HarbolCfgDoc const *const doc, char const keypath[static 1]) {
+	size_t const n = harbol_cfg_doc_find(doc, 0, keypath);
+	return( n==SIZE_MAX )? HarbolCfgType_Invalid : doc->nodes[n].type;
 }
@@ -8,10 +8,13 @@ extern "C" {
 #include "../harbol_common_defines.h"
 #include "../harbol_common_includes.h"
 #include "../msg_sys/msg_sys.h"
+#include "../msg_span/msg_span.h"
 #include "../map/map.h"
+#include "../array/array.h"
 #include "../variant/variant.h"
 #include "../lex/lex.h"
 #include "../math/math_parser.h"
+#include "../threadpool/threadpool.h"
 
 
 /** CFG Parser in EBNF grammar:
@@ -48,8 +51,59 @@ struct HarbolVec4D {
 
 HARBOL_EXPORT NO_NULL struct HarbolMap *harbol_cfg_parse_file(char const filename[]);
 HARBOL_EXPORT NO_NULL struct HarbolMap *harbol_cfg_parse_cstr(char const cstr[]);
+/// parses the file and, level by level, the files it includes on 'pool', then stitches them in declaration order.
+/// each file is parsed once however often it's included, include cycles are left out. a NULL pool parses serially.
+HARBOL_EXPORT NEVER_NULL(1) struct HarbolMap *harbol_cfg_parse_file_parallel(char const filename[], struct HarbolThreadPool *pool);
 HARBOL_EXPORT NO_NULL void harbol_cfg_free(struct HarbolMap **cfgref);
 HARBOL_EXPORT NO_NULL struct HarbolString harbol_cfg_to_str(struct HarbolMap const *cfg);
+/// no whitespace, entries are separated by commas. parses back to the same cfg.
+HARBOL_EXPORT NO_NULL struct HarbolString harbol_cfg_to_str_compact(struct HarbolMap const *cfg);
+
+
+/// event-driven parsing: the parser reports what it reads instead of building anything.
+enum HarbolCfgEventRes {
+	HarbolCfgEvent_Continue,
+	HarbolCfgEvent_Skip,  /// from a key or section event: parse the value or section without reporting it.
+	HarbolCfgEvent_Stop,  /// ends parsing early without an error, no more events follow.
+	HarbolCfgEvent_Error, /// rejects the key or value, parsing fails.
+};
+
+/// 'depth' is 0 for top-level keys, included files are reported as a section named by the file.
+typedef enum HarbolCfgEventRes HarbolCfgKeyEvent(void *userdata, struct HarbolString const *key, size_t depth);
+/// 'val' points to the value as stored by the cfg tree, except strings come as a 'struct HarbolString*' whose buffer the callback may take.
+typedef enum HarbolCfgEventRes HarbolCfgValueEvent(void *userdata, struct HarbolString const *key, enum HarbolCfgType type, void *val, size_t depth);
+
+/// any event may be NULL. 'key' comes before each value or section.
+struct HarbolCfgEvents {
+	HarbolCfgKeyEvent   *key, *begin_section, *end_section;
+	HarbolCfgValueEvent *value;
+};
+
+HARBOL_EXPORT NEVER_NULL(1, 2) bool harbol_cfg_parse_events_cstr(char const cstr[], struct HarbolCfgEvents const *events, void *userdata);
+HARBOL_EXPORT NEVER_NULL(1, 2) bool harbol_cfg_parse_events_file(FILE *file, struct HarbolCfgEvents const *events, void *userdata);
+
+/// incremental input: text is fed in chunks of any size and each top-level key-value is parsed once it's complete,
+/// so memory use is bounded by the largest top-level key-value rather than the whole input.
+struct HarbolCfgStream {
+	struct HarbolArray            pending; /// chars, nul-terminated past 'len'.
+	struct HarbolCfgEvents const *events;
+	void                         *userdata;
+	char const                   *filename;
+	intmax_t                      global_iota, global_enum, local_iota, local_enum;
+	size_t                        errc, scanned, nesting;
+	uint32_t                      curr_line;
+	uint8_t                       phase, quote, comment;
+	bool                          escaped, last_cr, stopped, failed;
+};
+
+HARBOL_EXPORT NEVER_NULL(1, 2) bool harbol_cfg_stream_init(struct HarbolCfgStream *stream, struct HarbolCfgEvents const *events, void *userdata);
+HARBOL_EXPORT NEVER_NULL(1, 3) struct HarbolCfgStream harbol_cfg_stream_make(struct HarbolCfgEvents const *events, void *userdata, bool *res);
+HARBOL_EXPORT NO_NULL void harbol_cfg_stream_clear(struct HarbolCfgStream *stream);
+
+/// returns false once parsing failed or was stopped.
+HARBOL_EXPORT NO_NULL bool harbol_cfg_stream_feed(struct HarbolCfgStream *stream, char const chunk[], size_t len);
+/// parses whatever is left, returns whether the whole input parsed.
+HARBOL_EXPORT NO_NULL bool harbol_cfg_stream_finish(struct HarbolCfgStream *stream);
 
 HARBOL_EXPORT NO_NULL struct HarbolMap *harbol_cfg_get_section(struct HarbolMap const *cfg, char const keypath[]);
 HARBOL_EXPORT NO_NULL char *harbol_cfg_get_cstr(struct HarbolMap const *cfg, char const keypath[], size_t *len);
@@ -61,6 +115,32 @@ HARBOL_EXPORT NO_NULL union HarbolColor *harbol_cfg_get_color(struct HarbolMap c
 HARBOL_EXPORT NO_NULL struct HarbolVec4D *harbol_cfg_get_vec4D(struct HarbolMap const *cfg, char const keypath[]);
 HARBOL_EXPORT NO_NULL enum HarbolCfgType harbol_cfg_get_type(struct HarbolMap const *cfg, char const keypath[]);
 
+/// keypath compiled once into unescaped, prehashed segments.
+/// lookups through it don't parse, hash or allocate.
+struct HarbolCfgPath {
+	char                   **segs;
+	size_t                  *keylens; /// includes the nul terminator, as cfg keys are stored.
+	struct HarbolMapKeyHash *hashes;
+	char                    *keys;
+	size_t                   len;
+};
+
+HARBOL_EXPORT NO_NULL struct HarbolCfgPath *harbol_cfg_path_new(char const keypath[]);
+HARBOL_EXPORT NO_NULL struct HarbolCfgPath harbol_cfg_path_make(char const keypath[], bool *res);
+HARBOL_EXPORT NO_NULL bool harbol_cfg_path_init(struct HarbolCfgPath *path, char const keypath[]);
+HARBOL_EXPORT NO_NULL void harbol_cfg_path_clear(struct HarbolCfgPath *path);
+HARBOL_EXPORT NO_NULL void harbol_cfg_path_free(struct HarbolCfgPath **path_ref);
+
+HARBOL_EXPORT NO_NULL struct HarbolMap *harbol_cfg_get_section_path(struct HarbolMap const *cfg, struct HarbolCfgPath const *path);
+HARBOL_EXPORT NO_NULL char *harbol_cfg_get_cstr_path(struct HarbolMap const *cfg, struct HarbolCfgPath const *path, size_t *len);
+HARBOL_EXPORT NO_NULL struct HarbolString *harbol_cfg_get_str_path(struct HarbolMap const *cfg, struct HarbolCfgPath const *path);
+HARBOL_EXPORT NO_NULL floatmax_t *harbol_cfg_get_float_path(struct HarbolMap const *cfg, struct HarbolCfgPath const *path);
+HARBOL_EXPORT NO_NULL intmax_t *harbol_cfg_get_int_path(struct HarbolMap const *cfg, struct HarbolCfgPath const *path);
+HARBOL_EXPORT NO_NULL bool *harbol_cfg_get_bool_path(struct HarbolMap const *cfg, struct HarbolCfgPath const *path);
+HARBOL_EXPORT NO_NULL union HarbolColor *harbol_cfg_get_color_path(struct HarbolMap const *cfg, struct HarbolCfgPath const *path);
+HARBOL_EXPORT NO_NULL struct HarbolVec4D *harbol_cfg_get_vec4D_path(struct HarbolMap const *cfg, struct HarbolCfgPath const *path);
+HARBOL_EXPORT NO_NULL enum HarbolCfgType harbol_cfg_get_type_path(struct HarbolMap const *cfg, struct HarbolCfgPath const *path);
+
 HARBOL_EXPORT NO_NULL bool harbol_cfg_set_str(struct HarbolMap *cfg, char const keypath[], struct HarbolString str, bool override_convert);
 HARBOL_EXPORT NO_NULL bool harbol_cfg_set_cstr(struct HarbolMap *cfg, char const keypath[], char const cstr[], bool override_convert);
 HARBOL_EXPORT NO_NULL bool harbol_cfg_set_float(struct HarbolMap *cfg, char const keypath[], floatmax_t fltval, bool override_convert);
@@ -92,6 +172,159 @@ HARBOL_EXPORT NEVER_NULL(1, 2) floatmax_t harbol_cfg_calc_math(struct HarbolMap
 #endif
 
 HARBOL_EXPORT NO_NULL bool harbol_cfg_build_file(struct HarbolMap const *cfg, char const filename[], bool overwrite);
+
+/// one field of a struct bound from a cfg. 'def' points to a value of the field's type, a NULL 'def' makes the key required.
+/// strings bind as 'char const*' and sections as 'struct HarbolMap*', both pointing into the cfg.
+/// an int also binds to a float field.
+struct HarbolCfgField {
+	char const        *keypath;
+	enum HarbolCfgType type;
+	size_t             offset;
+	void const        *def;
+};
+
+/// fills 'out' in one walk over the sections the schema's keypaths go through.
+/// every missing or mistyped key is reported, with its place in the source when 'msgspan' holds the cfg's file.
+/// returns how many were reported, SIZE_MAX if the schema couldn't be indexed.
+HARBOL_EXPORT NEVER_NULL(1, 2, 4) size_t harbol_cfg_bind(struct HarbolMap const *cfg, struct HarbolCfgField const schema[], size_t schema_len, void *out, struct HarbolMsgSpan *msgspan);
+
+
+/// read-only cfg document laid out in a single allocation.
+/// nodes are stored in preorder: a section's kids are 'nodes[i+1]' onward, each kid's 'end' leads to its next sibling.
+/// keys and strings are nul-terminated and live in the shared string pool.
+struct HarbolCfgNode {
+	union {
+		floatmax_t         f;
+		intmax_t           i;
+		bool               b;
+		union HarbolColor  c;
+		struct HarbolVec4D v;
+		size_t             str; /// offset into the pool.
+		struct {
+			size_t table, cap; /// a section's key table, 'cap' of 0 means its keys get scanned.
+		} keys;
+	} val;
+	size_t             key, keylen; /// pool offset and length, the nul included.
+	size_t             hash;        /// 'base' of the key's HarbolMapKeyHash.
+	size_t             parent;      /// SIZE_MAX for the root section.
+	size_t             len;         /// string length or a section's number of keys.
+	size_t             end;         /// one past the node's subtree.
+	enum HarbolCfgType type;
+};
+
+#ifndef HARBOL_CFG_DOC_INDEX_THRESHOLD
+#	define HARBOL_CFG_DOC_INDEX_THRESHOLD    8
+#endif
+
+/// sections with at least HARBOL_CFG_DOC_INDEX_THRESHOLD keys get a perfect hash table:
+/// 'cap' displacements followed by 'cap' node indices.
+struct HarbolCfgDoc {
+	struct HarbolCfgNode const *nodes; /// nodes[0] is the unnamed root section.
+	size_t const               *tables;
+	char const                 *pool;
+	size_t                      len, tables_len, pool_len;
+};
+
+HARBOL_EXPORT NO_NULL struct HarbolCfgDoc *harbol_cfg_doc_parse_file(char const filename[]);
+HARBOL_EXPORT NO_NULL struct HarbolCfgDoc *harbol_cfg_doc_parse_cstr(char const cstr[]);
+/// the whole document is one allocation.
+HARBOL_EXPORT NO_NULL void harbol_cfg_doc_free(struct HarbolCfgDoc **docref);
+HARBOL_EXPORT NO_NULL struct HarbolString harbol_cfg_doc_to_str(struct HarbolCfgDoc const *doc);
+HARBOL_EXPORT NO_NULL struct HarbolCfgDoc *harbol_cfg_doc_from_map(struct HarbolMap const *cfg);
+
+/// node index of 'keypath' relative to the 'section' node, SIZE_MAX if there's no such key.
+HARBOL_EXPORT NO_NULL size_t harbol_cfg_doc_find(struct HarbolCfgDoc const *doc, size_t section, char const keypath[]);
+HARBOL_EXPORT NO_NULL size_t harbol_cfg_doc_find_path(struct HarbolCfgDoc const *doc, size_t section, struct HarbolCfgPath const *path);
+HARBOL_EXPORT NO_NULL char const *harbol_cfg_doc_key(struct HarbolCfgDoc const *doc, size_t node);
+
+HARBOL_EXPORT NO_NULL size_t harbol_cfg_doc_get_section(struct HarbolCfgDoc const *doc, char const keypath[]);
+HARBOL_EXPORT NO_NULL char const *harbol_cfg_doc_get_cstr(struct HarbolCfgDoc const *doc, char const keypath[], size_t *len);
+HARBOL_EXPORT NO_NULL floatmax_t const *harbol_cfg_doc_get_float(struct HarbolCfgDoc const *doc, char const keypath[]);
+HARBOL_EXPORT NO_NULL intmax_t const *harbol_cfg_doc_get_int(struct HarbolCfgDoc const *doc, char const keypath[]);
+HARBOL_EXPORT NO_NULL bool const *harbol_cfg_doc_get_bool(struct HarbolCfgDoc const *doc, char const keypath[]);
+HARBOL_EXPORT NO_NULL union HarbolColor const *harbol_cfg_doc_get_color(struct HarbolCfgDoc const *doc, char const keypath[]);
+HARBOL_EXPORT NO_NULL struct HarbolVec4D const *harbol_cfg_doc_get_vec4D(struct HarbolCfgDoc const *doc, char const keypath[]);
+HARBOL_EXPORT NO_NULL enum HarbolCfgType harbol_cfg_doc_get_type(struct HarbolCfgDoc const *doc, char const keypath[]);
+
+
+/// precompiled cfg: a document written out as-is and memory-mapped back in.
+/// the layout is native, loading rejects files built for a different word size, float size or endianness.
+struct HarbolCfgMapping {
+	struct HarbolCfgDoc doc; /// points into the mapping.
+	void               *addr;
+	size_t              size;
+};
+
+HARBOL_EXPORT NO_NULL bool harbol_cfg_doc_build_binary(struct HarbolCfgDoc const *doc, char const filename[]);
+HARBOL_EXPORT NO_NULL bool harbol_cfg_build_binary(struct HarbolMap const *cfg, char const filename[]);
+
+HARBOL_EXPORT NO_NULL struct HarbolCfgMapping harbol_cfg_load_binary(char const filename[], bool *res);
+HARBOL_EXPORT NO_NULL void harbol_cfg_unload_binary(struct HarbolCfgMapping *mapping);
+
+
+/// a cfg tree that's reloaded in place. every file it's built from stays parsed along with its modification time,
+/// so a reload only re-parses the files that were written since.
+struct HarbolCfgFile {
+	struct HarbolMap  *cfg;
+	struct HarbolArray files; /// parsed files, the first is the one the tree was loaded from.
+	struct HarbolMap   seen;  /// filename -> index into 'files'.
+};
+
+enum HarbolCfgChange {
+	HarbolCfgChange_Added,
+	HarbolCfgChange_Removed,
+	HarbolCfgChange_Changed,
+};
+
+/// 'keypath' is escaped like any other keypath. an added or removed section is reported once, not per key.
+typedef void HarbolCfgChangeFunc(void *userdata, char const keypath[], enum HarbolCfgChange change);
+
+HARBOL_EXPORT NO_NULL bool harbol_cfg_file_init(struct HarbolCfgFile *file, char const filename[]);
+HARBOL_EXPORT NO_NULL struct HarbolCfgFile harbol_cfg_file_make(char const filename[], bool *res);
+HARBOL_EXPORT NO_NULL void harbol_cfg_file_clear(struct HarbolCfgFile *file);
+
+/// whether the file or any file it includes was written since it was last parsed.
+HARBOL_EXPORT NO_NULL bool harbol_cfg_file_changed(struct HarbolCfgFile const *file);
+
+/// applies only the differences to 'file->cfg', sections and values that didn't change keep their addresses.
+/// returns how many keypaths changed, 0 if no file did, or SIZE_MAX if the root file can't be parsed or memory runs out.
+/// a changed file that can't be read or has syntax errors also gives SIZE_MAX, nothing is applied and it's retried next reload.
+HARBOL_EXPORT NEVER_NULL(1) size_t harbol_cfg_reload(struct HarbolCfgFile *file, HarbolCfgChangeFunc *on_change, void *userdata);
+
+
+/// a cfg file whose top-level sections are only indexed when it's loaded, each one is parsed the first time it's looked up.
+/// 'cfg' holds what's parsed so far, pending sections are empty in it until touched.
+/// sections that bump the global IOTA or ENUM counters are parsed right away, as their values depend on parse order.
+/// math expressions in a deferred section read the counters as they were where the section sits in the file.
+struct HarbolCfgLazy {
+	struct HarbolMap   *cfg;
+	struct HarbolMap    pending; /// top-level key -> where its section's text starts in 'src'.
+	struct HarbolString src;
+	char               *filename;
+};
+
+HARBOL_EXPORT NO_NULL bool harbol_cfg_lazy_init(struct HarbolCfgLazy *lazy, char const filename[]);
+HARBOL_EXPORT NO_NULL struct HarbolCfgLazy harbol_cfg_lazy_make(char const filename[], bool *res);
+HARBOL_EXPORT NO_NULL void harbol_cfg_lazy_clear(struct HarbolCfgLazy *lazy);
+
+/// parses the top-level section 'keypath' starts in if it's still pending, then returns 'lazy->cfg' for 'keypath' to be looked up in.
+HARBOL_EXPORT NO_NULL struct HarbolMap *harbol_cfg_lazy_touch(struct HarbolCfgLazy *lazy, char const keypath[]);
+HARBOL_EXPORT NO_NULL struct HarbolMap *harbol_cfg_lazy_get_section(struct HarbolCfgLazy *lazy, char const keypath[]);
+/// parses every pending section, 'lazy->cfg' is then what 'harbol_cfg_parse_file' would've given.
+HARBOL_EXPORT NO_NULL bool harbol_cfg_lazy_load_all(struct HarbolCfgLazy *lazy);
+
+
+/// JSON fast path for machine-generated cfgs, the document has to be an object.
+/// strings, numbers, bools, nulls and objects map to the same values the cfg parser gives,
+/// arrays of four numbers become colors (four ints in 0-255) or vectors (any float), other arrays become sections keyed "0", "1", ...
+/// returns NULL if the JSON is malformed.
+HARBOL_EXPORT NO_NULL struct HarbolMap *harbol_cfg_parse_json(char const json[]);
+HARBOL_EXPORT NO_NULL struct HarbolMap *harbol_cfg_parse_json_file(char const filename[]);
+
+/// compact JSON, colors and vectors are written as arrays of four numbers so they parse back the same.
+/// floats get the fewest digits that parse back to the same value, infinities and NaNs are written as null.
+HARBOL_EXPORT NO_NULL struct HarbolString harbol_cfg_to_json(struct HarbolMap const *cfg);
+HARBOL_EXPORT NO_NULL bool harbol_cfg_build_json_file(struct HarbolMap const *cfg, char const filename[]);
 /********************************************************************/
 
 
@@ -1,6 +1,8 @@
 #include <assert.h>
+#include <stddef.h>
 #include <stdalign.h>
 #include <time.h>
+#include <utime.h>
 #include "cfg.h"
 
 void test_harbol_cfg(FILE *debug_stream);
@@ -31,6 +33,158 @@ int main(void) {
 }
 
 
+/// writes every parse event as a line so different ways of feeding the parser can be compared.
+struct EventLog {
+	struct HarbolString text;
+	char const         *skip, *stop;
+	size_t              values;
+};
+
+static enum HarbolCfgEventRes log_key(void *const userdata, struct HarbolString const *const key, size_t const depth) {
+	struct EventLog *const log = userdata;
+	if( log->stop != NULL && !strcmp(key->cstr, log->stop) ) {
+		return HarbolCfgEvent_Stop;
+	}
+	harbol_string_format(&log->text, false, "%zu key '%s'\n", depth, key->cstr);
+	return( log->skip != NULL && !strcmp(key->cstr, log->skip) )? HarbolCfgEvent_Skip : HarbolCfgEvent_Continue;
+}
+
+static enum HarbolCfgEventRes log_begin(void *const userdata, struct HarbolString const *const key, size_t const depth) {
+	harbol_string_format(&(( struct EventLog* )(userdata))->text, false, "%zu begin '%s'\n", depth, key->cstr);
+	return HarbolCfgEvent_Continue;
+}
+
+static enum HarbolCfgEventRes log_end(void *const userdata, struct HarbolString const *const key, size_t const depth) {
+	harbol_string_format(&(( struct EventLog* )(userdata))->text, false, "%zu end '%s'\n", depth, key->cstr);
+	return HarbolCfgEvent_Continue;
+}
+
+static enum HarbolCfgEventRes log_value(void *const userdata, struct HarbolString const *const key, enum HarbolCfgType const type, void *const val, size_t const depth) {
+	struct EventLog *const log = userdata;
+	log->values++;
+	harbol_string_format(&log->text, false, "%zu value '%s' = ", depth, key->cstr);
+	switch( type ) {
+		case HarbolCfgType_String: harbol_string_format(&log->text, false, "'%s'\n", (( struct HarbolString const* )(val))->cstr); break;
+		case HarbolCfgType_Float:  harbol_string_format(&log->text, false, "%" PRIfMAX "\n", *( floatmax_t const* )(val)); break;
+		case HarbolCfgType_Int:    harbol_string_format(&log->text, false, "%" PRIiMAX "\n", *( intmax_t const* )(val)); break;
+		case HarbolCfgType_Bool:   harbol_string_format(&log->text, false, "%s\n", *( bool const* )(val)? "true" : "false"); break;
+		case HarbolCfgType_Color:  harbol_string_format(&log->text, false, "c[%u]\n", (( union HarbolColor const* )(val))->uint32); break;
+		case HarbolCfgType_Vec4D:  harbol_string_format(&log->text, false, "v[%f]\n", ( double )((( struct HarbolVec4D const* )(val))->w)); break;
+		default:                   harbol_string_add_cstr(&log->text, "null\n"); break;
+	}
+	return HarbolCfgEvent_Continue;
+}
+
+static struct HarbolCfgEvents const g_log_events = { log_key, log_begin, log_end, log_value };
+
+static void write_cfg_file(char const filename[const], char const cfg[const]) {
+	FILE *const file = fopen(filename, "w");
+	assert( file != NULL );
+	fputs(cfg, file);
+	fclose(file);
+}
+
+/// mtimes only have a resolution of seconds, so rewritten files are stamped explicitly.
+static void rewrite_cfg_file(char const filename[const], char const cfg[const], time_t const stamp) {
+	write_cfg_file(filename, cfg);
+	assert( !utime(filename, &( struct utimbuf ){ stamp, stamp }) );
+}
+
+/// parses on the same pool it's running on.
+struct ParseJob {
+	struct HarbolThreadPool *pool;
+	char const              *filename;
+	struct HarbolMap        *cfg;
+};
+
+static void parse_job(void *const arg) {
+	struct ParseJob *const job = arg;
+	job->cfg = harbol_cfg_parse_file_parallel(job->filename, job->pool);
+}
+
+struct ChangeLog {
+	FILE  *stream;
+	size_t added, removed, changed;
+};
+
+static void log_change(void *const userdata, char const keypath[const], enum HarbolCfgChange const change) {
+	struct ChangeLog *const log = userdata;
+	char const *const kinds[] = { "added", "removed", "changed" };
+	fprintf(log->stream, "%s: '%s'\n", kinds[change], keypath);
+	switch( change ) {
+		case HarbolCfgChange_Added:   log->added++;   break;
+		case HarbolCfgChange_Removed: log->removed++; break;
+		case HarbolCfgChange_Changed: log->changed++; break;
+	}
+}
+
+/// the serializer as it was before writing into a single buffer, kept to compare output and speed against.
+static void legacy_cfg_to_str(struct HarbolMap const *const map, struct HarbolString *const str, size_t const tabs) {
+	for( size_t i=0; i < map->len; i++ ) {
+		struct HarbolVariant const *const var = ( struct HarbolVariant const* )(map->datum[i]);
+		void *const data = harbol_variant_data(var);
+		for( size_t t=0; t < tabs; t++ ) {
+			harbol_string_add_cstr(str, "\t");
+		}
+		harbol_string_format(str, false, "\"%s\": ", ( char const* )(map->keys[i]));
+		switch( var->tag ) {
+			case HarbolCfgType_Null: harbol_string_add_cstr(str, "null\n"); break;
+			case HarbolCfgType_Map: {
+				harbol_string_add_cstr(str, "{\n");
+				struct HarbolString inner = {0};
+				legacy_cfg_to_str(*( struct HarbolMap** )(data), &inner, tabs + 1);
+				if( !harbol_string_empty(&inner) ) {
+					harbol_string_add_str(str, &inner);
+				}
+				harbol_string_clear(&inner);
+				for( size_t t=0; t < tabs; t++ ) {
+					harbol_string_add_cstr(str, "\t");
+				}
+				harbol_string_add_cstr(str, "}\n");
+				break;
+			}
+			case HarbolCfgType_String: harbol_string_format(str, false, "\"%s\"\n", (*( struct HarbolString** )(data))->cstr); break;
+			case HarbolCfgType_Float:  harbol_string_format(str, false, "%" PRIfMAX "\n", *( floatmax_t* )(data)); break;
+			case HarbolCfgType_Int:    harbol_string_format(str, false, "%" PRIiMAX "\n", *( intmax_t* )(data)); break;
+			case HarbolCfgType_Bool:   harbol_string_add_cstr(str, *( bool* )(data)? "true\n" : "false\n"); break;
+			case HarbolCfgType_Color: {
+				union HarbolColor const *const c = data;
+				harbol_string_format(str, false, "c[ %u, %u, %u, %u ]\n", c->bytes.r, c->bytes.g, c->bytes.b, c->bytes.a);
+				break;
+			}
+			case HarbolCfgType_Vec4D: {
+				struct HarbolVec4D const *const v = data;
+				harbol_string_format(str, false, "v[ %" PRIf32 ", %" PRIf32 ", %" PRIf32 ", %" PRIf32 " ]\n", v->x, v->y, v->z, v->w);
+				break;
+			}
+		}
+	}
+}
+
+/// keeps only 'section399' of the benchmark cfg.
+static enum HarbolCfgEventRes bench_key(void *const userdata, struct HarbolString const *const key, size_t const depth) {
+	(void)(userdata);
+	return( depth==0 && strcmp(key->cstr, "section399") )? HarbolCfgEvent_Skip : HarbolCfgEvent_Continue;
+}
+
+static enum HarbolCfgEventRes bench_value(void *const userdata, struct HarbolString const *const key, enum HarbolCfgType const type, void *const val, size_t const depth) {
+	(void)(key); (void)(type); (void)(val); (void)(depth);
+	(( struct EventLog* )(userdata))->values++;
+	return HarbolCfgEvent_Continue;
+}
+
+static bool stream_in_chunks(char const cfg[const], size_t const chunk, struct EventLog *const log) {
+	struct HarbolCfgStream stream = harbol_cfg_stream_make(&g_log_events, log, &( bool ){false});
+	size_t const len = strlen(cfg);
+	for( size_t i=0; i < len; i += chunk ) {
+		harbol_cfg_stream_feed(&stream, &cfg[i], ( len - i < chunk )? len - i : chunk);
+	}
+	bool const res = harbol_cfg_stream_finish(&stream);
+	harbol_cfg_stream_clear(&stream);
+	return res;
+}
+
+
 void test_harbol_cfg(FILE *const debug_stream) {
 	/// Test allocation and initializations
 	fputs("cfg :: test allocation/initialization.\n", debug_stream);
@@ -177,6 +331,824 @@ void test_harbol_cfg(FILE *const debug_stream) {
 		fprintf(debug_stream, "Type of root.money: %i\n", harbol_cfg_get_type(larger_cfg, "root.money"));
 		fprintf(debug_stream, "Type of root.origin: %i\n", harbol_cfg_get_type(larger_cfg, "root.origin"));
 		
+		fputs("\ncfg :: test compiled keypaths\n", debug_stream);
+		{
+			struct HarbolCfgPath *type_path = harbol_cfg_path_new("root.phoneNumbers\\..1.type");
+			assert( type_path != NULL && type_path->len==4 );
+			assert( !strcmp(type_path->segs[1], "phoneNumbers.") && type_path->keylens[1]==sizeof "phoneNumbers." );
+			size_t path_len = 0, str_len = 0;
+			char const *const by_path = harbol_cfg_get_cstr_path(larger_cfg, type_path, &path_len);
+			assert( by_path != NULL && by_path==harbol_cfg_get_cstr(larger_cfg, "root.phoneNumbers\\..1.type", &str_len) && path_len==str_len );
+			fprintf(debug_stream, "root.phoneNumbers\\..1.type by path: %s\n", by_path);
+			harbol_cfg_path_free(&type_path);
+			assert( type_path==NULL );
+			
+			bool res = false;
+			struct HarbolCfgPath age_path = harbol_cfg_path_make("root.age", &res);
+			assert( res && harbol_cfg_get_int_path(larger_cfg, &age_path)==harbol_cfg_get_int(larger_cfg, "root.age") );
+			assert( harbol_cfg_get_float_path(larger_cfg, &age_path)==NULL );
+			assert( harbol_cfg_get_type_path(larger_cfg, &age_path)==HarbolCfgType_Int );
+			harbol_cfg_path_clear(&age_path);
+			
+			/// values can't be walked through and empty segments don't compile.
+			struct HarbolCfgPath past_value = harbol_cfg_path_make("root.age.x", &res);
+			assert( res && harbol_cfg_get_type_path(larger_cfg, &past_value)==HarbolCfgType_Invalid );
+			assert( harbol_cfg_get_type(larger_cfg, "root.age.x")==HarbolCfgType_Invalid );
+			harbol_cfg_path_clear(&past_value);
+			assert( harbol_cfg_path_new("root..age")==NULL && harbol_cfg_path_new("")==NULL );
+			
+			struct HarbolCfgPath section_path = harbol_cfg_path_make("root.address", &res);
+			assert( res && harbol_cfg_get_section_path(larger_cfg, &section_path)==harbol_cfg_get_section(larger_cfg, "root.address") );
+			harbol_cfg_path_clear(&section_path);
+		}
+		
+		fputs("\ncfg :: test a keypath repeating a section name\n", debug_stream);
+		{
+			struct HarbolMap *nested = harbol_cfg_parse_cstr("'a': { 'b': { 'a': 1 } }");
+			assert( nested != NULL );
+			intmax_t const *const inner = harbol_cfg_get_int(nested, "a.b.a");
+			assert( inner != NULL && *inner==1 );
+			fprintf(debug_stream, "a.b.a: %" PRIiMAX "\n", *inner);
+			harbol_cfg_free(&nested);
+		}
+		
+		fputs("\ncfg :: benchmark keypath lookups\n", debug_stream);
+		{
+			char const *const keypaths[] = {
+				"root.age", "root.money", "root.address.city", "root.phoneNumbers\\..2.number",
+				"root.colors", "root.origin", "root.test_iota.1.c", "root.test_IOTA.7",
+			};
+			enum { NUM_KEYPATHS = sizeof keypaths / sizeof *keypaths, ROUNDS = 200000 };
+			struct HarbolCfgPath paths[NUM_KEYPATHS];
+			for( size_t n=0; n < NUM_KEYPATHS; n++ ) {
+				assert( harbol_cfg_path_init(&paths[n], keypaths[n]) );
+				assert( harbol_cfg_get_type_path(larger_cfg, &paths[n])==harbol_cfg_get_type(larger_cfg, keypaths[n]) );
+				assert( harbol_cfg_get_type_path(larger_cfg, &paths[n]) != HarbolCfgType_Invalid );
+			}
+			size_t found_str = 0, found_path = 0;
+			clock_t const str_start = clock();
+			for( size_t r=0; r < ROUNDS; r++ ) {
+				for( size_t n=0; n < NUM_KEYPATHS; n++ ) {
+					found_str += harbol_cfg_get_type(larger_cfg, keypaths[n]) != HarbolCfgType_Invalid;
+				}
+			}
+			clock_t const path_start = clock();
+			for( size_t r=0; r < ROUNDS; r++ ) {
+				for( size_t n=0; n < NUM_KEYPATHS; n++ ) {
+					found_path += harbol_cfg_get_type_path(larger_cfg, &paths[n]) != HarbolCfgType_Invalid;
+				}
+			}
+			clock_t const end = clock();
+			assert( found_str==found_path && found_path==( size_t )(ROUNDS) * NUM_KEYPATHS );
+			printf("cfg keypath lookups (%zu): string %f secs | compiled %f secs\n", found_path, (path_start - str_start) / ( double )(CLOCKS_PER_SEC), (end - path_start) / ( double )(CLOCKS_PER_SEC));
+			for( size_t n=0; n < NUM_KEYPATHS; n++ ) {
+				harbol_cfg_path_clear(&paths[n]);
+			}
+		}
+		
+		fputs("\ncfg :: test flat cfg document\n", debug_stream);
+		{
+			struct HarbolCfgDoc *doc = harbol_cfg_doc_parse_cstr(test_cfg);
+			struct HarbolMap *fresh = harbol_cfg_parse_cstr(test_cfg);
+			assert( doc != NULL && fresh != NULL );
+			struct HarbolString doc_str  = harbol_cfg_doc_to_str(doc);
+			struct HarbolString tree_str = harbol_cfg_to_str(fresh);
+			assert( !strcmp(doc_str.cstr, tree_str.cstr) );
+			fprintf(debug_stream, "doc nodes: %zu | pool bytes: %zu\n%s\n", doc->len, doc->pool_len, doc_str.cstr);
+			harbol_string_clear(&doc_str);
+			harbol_string_clear(&tree_str);
+			
+			size_t doc_len = 0, tree_len = 0;
+			char const *const doc_type = harbol_cfg_doc_get_cstr(doc, "root.phoneNumbers\\..1.type", &doc_len);
+			char const *const tree_type = harbol_cfg_get_cstr(fresh, "root.phoneNumbers\\..1.type", &tree_len);
+			assert( doc_type != NULL && !strcmp(doc_type, tree_type) && doc_len==tree_len );
+			assert( *harbol_cfg_doc_get_int(doc, "root.age")==*harbol_cfg_get_int(fresh, "root.age") );
+			assert( *harbol_cfg_doc_get_float(doc, "root.money")==*harbol_cfg_get_float(fresh, "root.money") );
+			assert( *harbol_cfg_doc_get_bool(doc, "root.isAlive") );
+			assert( harbol_cfg_doc_get_color(doc, "root.colors")->uint32==harbol_cfg_get_color(fresh, "root.colors")->uint32 );
+			assert( harbol_cfg_doc_get_vec4D(doc, "root.origin")->w==harbol_cfg_get_vec4D(fresh, "root.origin")->w );
+			assert( harbol_cfg_doc_get_type(doc, "root.spouse")==HarbolCfgType_Null );
+			assert( harbol_cfg_doc_get_type(doc, "root.age.x")==HarbolCfgType_Invalid );
+			assert( harbol_cfg_doc_get_int(doc, "root.money")==NULL );
+			
+			/// sections are node ranges that keypaths and compiled paths can start from.
+			size_t const address = harbol_cfg_doc_get_section(doc, "root.address");
+			assert( address != SIZE_MAX && doc->nodes[address].len==4 );
+			assert( !strcmp(harbol_cfg_doc_key(doc, address), "address") );
+			size_t const city = harbol_cfg_doc_find(doc, address, "city");
+			assert( city != SIZE_MAX && doc->nodes[city].parent==address );
+			bool res = false;
+			struct HarbolCfgPath city_path = harbol_cfg_path_make("root.address.city", &res);
+			assert( res && harbol_cfg_doc_find_path(doc, 0, &city_path)==city );
+			harbol_cfg_path_clear(&city_path);
+			
+			harbol_cfg_doc_free(&doc);
+			assert( doc==NULL );
+			harbol_cfg_free(&fresh);
+		}
+		
+		fputs("\ncfg :: test includes and duplicates in cfg documents\n", debug_stream);
+		{
+			FILE *inc = fopen("harbol_cfg_include.ini", "w");
+			assert( inc != NULL );
+			fputs("'inner': { 'x': 1, 'y': 'two' }\n'z': 3.5\n", inc);
+			fclose(inc);
+			char const *const with_include = "'before': 1 '<include>': 'harbol_cfg_include.ini' 'after': c[1, 2, 3, 4]";
+			struct HarbolCfgDoc *doc = harbol_cfg_doc_parse_cstr(with_include);
+			struct HarbolMap *tree = harbol_cfg_parse_cstr(with_include);
+			assert( doc != NULL && tree != NULL );
+			struct HarbolString doc_str  = harbol_cfg_doc_to_str(doc);
+			struct HarbolString tree_str = harbol_cfg_to_str(tree);
+			assert( !strcmp(doc_str.cstr, tree_str.cstr) );
+			fprintf(debug_stream, "%s\n", doc_str.cstr);
+			assert( *harbol_cfg_doc_get_int(doc, "harbol_cfg_include\\.ini.inner.x")==1 );
+			harbol_string_clear(&doc_str);
+			harbol_string_clear(&tree_str);
+			harbol_cfg_doc_free(&doc);
+			harbol_cfg_free(&tree);
+			remove("harbol_cfg_include.ini");
+			
+			/// same key in different sections is fine, twice in one section stops the parse.
+			doc = harbol_cfg_doc_parse_cstr("'a': { 'k': 1 } 'b': { 'k': 2 'k': 3 } 'c': 4");
+			assert( doc != NULL );
+			assert( *harbol_cfg_doc_get_int(doc, "a.k")==1 && *harbol_cfg_doc_get_int(doc, "b.k")==2 );
+			assert( harbol_cfg_doc_get_type(doc, "c")==HarbolCfgType_Invalid );
+			harbol_cfg_doc_free(&doc);
+		}
+		
+		fputs("\ncfg :: test parse events and streamed input\n", debug_stream);
+		{
+			struct EventLog whole = {0};
+			assert( harbol_cfg_parse_events_cstr(test_cfg, &g_log_events, &whole) );
+			fputs(whole.text.cstr, debug_stream);
+			/// however the text is split up, the events come out the same.
+			size_t const chunks[] = { 1, 2, 3, 7, 64, 4096 };
+			for( size_t i=0; i < sizeof chunks / sizeof chunks[0]; i++ ) {
+				struct EventLog streamed = {0};
+				assert( stream_in_chunks(test_cfg, chunks[i], &streamed) );
+				assert( !strcmp(whole.text.cstr, streamed.text.cstr) );
+				harbol_string_clear(&streamed.text);
+			}
+			
+			/// comments, escaped quotes and bare values right before the next key.
+			char const *const tricky = "# 'not a key'\n'a': 1,'b': \"q\\\"'\" /* 'c': 2 */ 'd': c[1, 2] // 'e' \\\n'z': 9\n'f': { 'g': 'x}' } 'h': true";
+			struct EventLog tricky_whole = {0};
+			assert( harbol_cfg_parse_events_cstr(tricky, &g_log_events, &tricky_whole) && tricky_whole.values==5 );
+			for( size_t chunk=1; chunk < 8; chunk++ ) {
+				struct EventLog streamed = {0};
+				assert( stream_in_chunks(tricky, chunk, &streamed) );
+				assert( !strcmp(tricky_whole.text.cstr, streamed.text.cstr) );
+				harbol_string_clear(&streamed.text);
+			}
+			harbol_string_clear(&tricky_whole.text);
+			
+			/// a skipped section is parsed but not reported, iota keeps counting past it.
+			struct EventLog skipped = { .skip = "address" };
+			assert( stream_in_chunks(test_cfg, 16, &skipped) );
+			assert( strstr(skipped.text.cstr, "streetAddress")==NULL && strstr(skipped.text.cstr, "end 'address'")==NULL );
+			assert( strstr(skipped.text.cstr, "key 'address'") != NULL && strstr(skipped.text.cstr, "phoneNumbers") != NULL );
+			assert( skipped.values==whole.values - 4 );
+			harbol_string_clear(&skipped.text);
+			struct EventLog counted = { .skip = "s" };
+			assert( harbol_cfg_parse_events_cstr("'s': { 'x': IOTA } 't': IOTA", &g_log_events, &counted) );
+			assert( strstr(counted.text.cstr, "0 value 't' = 1\n") != NULL );
+			harbol_string_clear(&counted.text);
+			
+			/// stopping ends the parse without failing it.
+			struct EventLog stopped = { .stop = "age" };
+			assert( harbol_cfg_parse_events_cstr(test_cfg, &g_log_events, &stopped) );
+			assert( strstr(stopped.text.cstr, "isAlive") != NULL && strstr(stopped.text.cstr, "money")==NULL );
+			harbol_string_clear(&stopped.text);
+			harbol_string_clear(&whole.text);
+			
+			/// a syntax error fails the stream.
+			struct EventLog broken = {0};
+			assert( !stream_in_chunks("'a': 1 'b': { 'c': 2 ", 4, &broken) && broken.values==2 );
+			harbol_string_clear(&broken.text);
+			
+			FILE *file = fopen("harbol_cfg_events.ini", "w");
+			assert( file != NULL );
+			for( size_t i=0; i < 2000; i++ ) {
+				fprintf(file, "'key%zu': { 'n': %zu\r\n\t's': 'tab\tbed' }\r\n", i, i);
+			}
+			fclose(file);
+			file = fopen("harbol_cfg_events.ini", "rb");
+			struct EventLog from_file = {0};
+			assert( file != NULL && harbol_cfg_parse_events_file(file, &g_log_events, &from_file) && from_file.values==4000 );
+			assert( strstr(from_file.text.cstr, "'tab    bed'") != NULL );
+			fclose(file);
+			harbol_string_clear(&from_file.text);
+			remove("harbol_cfg_events.ini");
+		}
+		
+		fputs("\ncfg :: benchmark cfg serializer on 100k keys\n", debug_stream);
+		{
+			struct HarbolString big = {0};
+			uint32_t rng = 0x2545F491u;
+			for( size_t sect=0; sect < 1000; sect++ ) {
+				harbol_string_format(&big, false, "'section%zu': {\n", sect);
+				for( size_t key=0; key < 20; key++ ) {
+					rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5;
+					harbol_string_format(&big, false, "\t'int%zu': %" PRIi32 ", 'str%zu': 'value %zu', 'flt%zu': %s%u.%06u%u, 'on%zu': %s, 'vec%zu': v[%u.25, -%u.5, 0.%u, %u]\n",
+							key, ( int32_t )(rng), key, sect, key, ( rng & 1 )? "-" : "", rng % 100000, rng % 1000000, rng % 10, key, ( rng & 2 )? "true" : "false", key, rng % 1000, rng % 77, rng % 10000, rng % 3);
+				}
+				harbol_string_add_cstr(&big, "}\n");
+			}
+			struct HarbolMap *tree = harbol_cfg_parse_cstr(big.cstr);
+			assert( tree != NULL && harbol_cfg_get_section(tree, "section999") != NULL );
+			harbol_cfg_set_float(tree, "section0.flt0", 123456789012345.125, true);
+			harbol_cfg_set_float(tree, "section0.flt1", -0.0, true);
+			
+			enum { ROUNDS = 5 };
+			double legacy_secs = 0.0, new_secs = 0.0, compact_secs = 0.0;
+			size_t legacy_len = 0, new_len = 0, compact_len = 0;
+			for( int r=0; r < ROUNDS; r++ ) {
+				clock_t const t0 = clock();
+				struct HarbolString legacy = {0};
+				legacy_cfg_to_str(tree, &legacy, 0);
+				clock_t const t1 = clock();
+				struct HarbolString fresh = harbol_cfg_to_str(tree);
+				clock_t const t2 = clock();
+				struct HarbolString compact = harbol_cfg_to_str_compact(tree);
+				clock_t const t3 = clock();
+				assert( !strcmp(legacy.cstr, fresh.cstr) );
+				legacy_secs  += (t1 - t0) / ( double )(CLOCKS_PER_SEC);
+				new_secs     += (t2 - t1) / ( double )(CLOCKS_PER_SEC);
+				compact_secs += (t3 - t2) / ( double )(CLOCKS_PER_SEC);
+				legacy_len = legacy.len; new_len = fresh.len; compact_len = compact.len;
+				harbol_string_clear(&legacy);
+				harbol_string_clear(&fresh);
+				harbol_string_clear(&compact);
+			}
+			printf("cfg 100k keys x%d: legacy to_str %f secs (%zu bytes) | to_str %f secs (%zu bytes) | compact %f secs (%zu bytes)\n", ROUNDS, legacy_secs, legacy_len, new_secs, new_len, compact_secs, compact_len);
+			fprintf(debug_stream, "legacy: %zu bytes | to_str: %zu bytes | compact: %zu bytes\n", legacy_len, new_len, compact_len);
+			
+			/// compact output parses back to the same cfg.
+			struct HarbolString compact = harbol_cfg_to_str_compact(tree);
+			struct HarbolMap *reparsed = harbol_cfg_parse_cstr(compact.cstr);
+			assert( reparsed != NULL );
+			struct HarbolString a = harbol_cfg_to_str(tree), b = harbol_cfg_to_str(reparsed);
+			assert( !strcmp(a.cstr, b.cstr) );
+			harbol_string_clear(&a);
+			harbol_string_clear(&b);
+			harbol_string_clear(&compact);
+			harbol_cfg_free(&reparsed);
+			harbol_cfg_free(&tree);
+			harbol_string_clear(&big);
+			
+			struct HarbolMap *small = harbol_cfg_parse_cstr("'a': 1 'b': { 'c': 'two', 'd': c[1, 2, 3, 4] } 'e': null 'f': {}");
+			compact = harbol_cfg_to_str_compact(small);
+			fprintf(debug_stream, "%s\n", compact.cstr);
+			assert( !strcmp(compact.cstr, "\"a\":1,\"b\":{\"c\":\"two\",\"d\":c[1,2,3,4]},\"e\":null,\"f\":{}") );
+			harbol_string_clear(&compact);
+			harbol_cfg_free(&small);
+		}
+		
+		fputs("\ncfg :: benchmark cfg tree vs document load and teardown\n", debug_stream);
+		{
+			struct HarbolString big = {0};
+			for( size_t sect=0; sect < 400; sect++ ) {
+				harbol_string_format(&big, false, "'section%zu': {\n", sect);
+				for( size_t key=0; key < 25; key++ ) {
+					harbol_string_format(&big, false, "\t'int%zu': %zu, 'str%zu': 'value %zu', 'flt%zu': %zu.5\n", key, key, key, sect, key, key);
+				}
+				harbol_string_add_cstr(&big, "}\n");
+			}
+			enum { ROUNDS = 10 };
+			double tree_load = 0.0, tree_free = 0.0, doc_load = 0.0, doc_free = 0.0;
+			for( int r=0; r < ROUNDS; r++ ) {
+				clock_t const t0 = clock();
+				struct HarbolMap *tree = harbol_cfg_parse_cstr(big.cstr);
+				clock_t const t1 = clock();
+				assert( tree != NULL && *harbol_cfg_get_int(tree, "section399.int24")==24 );
+				clock_t const t2 = clock();
+				harbol_cfg_free(&tree);
+				clock_t const t3 = clock();
+				struct HarbolCfgDoc *doc = harbol_cfg_doc_parse_cstr(big.cstr);
+				clock_t const t4 = clock();
+				assert( doc != NULL && *harbol_cfg_doc_get_int(doc, "section399.int24")==24 );
+				clock_t const t5 = clock();
+				harbol_cfg_doc_free(&doc);
+				clock_t const t6 = clock();
+				tree_load += (t1 - t0) / ( double )(CLOCKS_PER_SEC);
+				tree_free += (t3 - t2) / ( double )(CLOCKS_PER_SEC);
+				doc_load  += (t4 - t3) / ( double )(CLOCKS_PER_SEC);
+				doc_free  += (t6 - t5) / ( double )(CLOCKS_PER_SEC);
+			}
+			printf("cfg %zu bytes x%d: tree load %f free %f secs | document load %f free %f secs\n", big.len, ROUNDS, tree_load, tree_free, doc_load, doc_free);
+			
+			/// same document, precompiled: mapping it replaces the whole parse.
+			struct HarbolCfgDoc *doc = harbol_cfg_doc_parse_cstr(big.cstr);
+			assert( doc != NULL && harbol_cfg_doc_build_binary(doc, "harbol_cfg_bench.bin") );
+			harbol_cfg_doc_free(&doc);
+			double bin_load = 0.0;
+			for( int r=0; r < ROUNDS; r++ ) {
+				clock_t const t0 = clock();
+				bool res = false;
+				struct HarbolCfgMapping mapping = harbol_cfg_load_binary("harbol_cfg_bench.bin", &res);
+				assert( res && *harbol_cfg_doc_get_int(&mapping.doc, "section399.int24")==24 );
+				harbol_cfg_unload_binary(&mapping);
+				bin_load += (clock() - t0) / ( double )(CLOCKS_PER_SEC);
+			}
+			printf("cfg %zu bytes x%d: binary load+unload %f secs\n", big.len, ROUNDS, bin_load);
+			
+			/// streaming through the big cfg for one section, skipping the rest.
+			struct EventLog one = { .skip = NULL };
+			double stream_load = 0.0;
+			for( int r=0; r < ROUNDS; r++ ) {
+				one.values = 0;
+				struct HarbolCfgEvents const only_last = { bench_key, NULL, NULL, bench_value };
+				clock_t const t0 = clock();
+				struct HarbolCfgStream stream = harbol_cfg_stream_make(&only_last, &one, &( bool ){false});
+				for( size_t i=0; i < big.len; i += 4096 ) {
+					harbol_cfg_stream_feed(&stream, &big.cstr[i], ( big.len - i < 4096 )? big.len - i : 4096);
+				}
+				assert( harbol_cfg_stream_finish(&stream) && one.values==75 );
+				harbol_cfg_stream_clear(&stream);
+				stream_load += (clock() - t0) / ( double )(CLOCKS_PER_SEC);
+			}
+			printf("cfg %zu bytes x%d: streamed events for one section %f secs\n", big.len, ROUNDS, stream_load);
+			remove("harbol_cfg_bench.bin");
+			harbol_string_clear(&big);
+		}
+		
+		fputs("\ncfg :: test precompiled binary cfg\n", debug_stream);
+		{
+			assert( harbol_cfg_build_binary(larger_cfg, "harbol_cfg_test.bin") );
+			bool res = false;
+			struct HarbolCfgMapping mapping = harbol_cfg_load_binary("harbol_cfg_test.bin", &res);
+			assert( res && mapping.addr != NULL );
+			struct HarbolString bin_str  = harbol_cfg_doc_to_str(&mapping.doc);
+			struct HarbolString tree_str = harbol_cfg_to_str(larger_cfg);
+			assert( !strcmp(bin_str.cstr, tree_str.cstr) );
+			fprintf(debug_stream, "binary nodes: %zu | table words: %zu | pool bytes: %zu\n", mapping.doc.len, mapping.doc.tables_len, mapping.doc.pool_len);
+			harbol_string_clear(&bin_str);
+			harbol_string_clear(&tree_str);
+			assert( *harbol_cfg_doc_get_int(&mapping.doc, "root.age")==*harbol_cfg_get_int(larger_cfg, "root.age") );
+			size_t bin_len = 0, tree_len = 0;
+			assert( !strcmp(harbol_cfg_doc_get_cstr(&mapping.doc, "root.lastName", &bin_len), harbol_cfg_get_cstr(larger_cfg, "root.lastName", &tree_len)) && bin_len==tree_len );
+			harbol_cfg_unload_binary(&mapping);
+			assert( mapping.addr==NULL );
+			
+			/// a wide section is looked up through its table.
+			struct HarbolString wide = {0};
+			harbol_string_add_cstr(&wide, "'wide': {");
+			for( size_t i=0; i < 100; i++ ) {
+				harbol_string_format(&wide, false, " 'key%zu': %zu", i, i);
+			}
+			harbol_string_add_cstr(&wide, " } 'narrow': { 'a': 1 }");
+			struct HarbolCfgDoc *doc = harbol_cfg_doc_parse_cstr(wide.cstr);
+			assert( doc != NULL && harbol_cfg_doc_build_binary(doc, "harbol_cfg_test.bin") );
+			harbol_cfg_doc_free(&doc);
+			harbol_string_clear(&wide);
+			mapping = harbol_cfg_load_binary("harbol_cfg_test.bin", &res);
+			assert( res );
+			size_t const sect = harbol_cfg_doc_get_section(&mapping.doc, "wide");
+			assert( sect != SIZE_MAX && mapping.doc.nodes[sect].val.keys.cap >= 100 );
+			assert( mapping.doc.nodes[harbol_cfg_doc_get_section(&mapping.doc, "narrow")].val.keys.cap==0 );
+			for( intmax_t i=0; i < 100; i++ ) {
+				char key[32];
+				snprintf(key, sizeof key, "wide.key%jd", i);
+				assert( *harbol_cfg_doc_get_int(&mapping.doc, key)==i );
+			}
+			assert( harbol_cfg_doc_get_type(&mapping.doc, "wide.key100")==HarbolCfgType_Invalid );
+			assert( harbol_cfg_doc_get_type(&mapping.doc, "wide.narrow")==HarbolCfgType_Invalid );
+			harbol_cfg_unload_binary(&mapping);
+			
+			/// text cfgs and truncated files are turned away.
+			assert( harbol_cfg_build_file(larger_cfg, "harbol_cfg_test.bin", true) );
+			mapping = harbol_cfg_load_binary("harbol_cfg_test.bin", &res);
+			assert( !res && mapping.addr==NULL );
+			remove("harbol_cfg_test.bin");
+			mapping = harbol_cfg_load_binary("harbol_cfg_test.bin", &res);
+			assert( !res );
+		}
+		
+		fputs("\ncfg :: test parallel parsing of included cfg files\n", debug_stream);
+		{
+			char const *const parts[] = { "harbol_cfg_par0.ini", "harbol_cfg_par1.ini", "harbol_cfg_par2.ini", "harbol_cfg_par3.ini", "harbol_cfg_par4.ini", "harbol_cfg_par5.ini" };
+			size_t const part_count = sizeof parts / sizeof parts[0];
+			struct HarbolString root = {0};
+			harbol_string_add_cstr(&root, "'first': 1\n");
+			for( size_t i=0; i < part_count; i++ ) {
+				/// every part also includes the same shared file.
+				char part[512];
+				snprintf(part, sizeof part, "'part': %zu\n'list': { 'a': c[1, 2], 'b': 'x%zu' }\n'<include>': 'harbol_cfg_shared.ini'\n'tail': %zu.5\n", i, i, i);
+				write_cfg_file(parts[i], part);
+				harbol_string_format(&root, false, "'<include>': '%s'\n", parts[i]);
+			}
+			harbol_string_add_cstr(&root, "'last': true\n");
+			write_cfg_file("harbol_cfg_shared.ini", "'shared': { 'deep': 'yes', 'n': 0x10 }\n");
+			write_cfg_file("harbol_cfg_root.ini", root.cstr);
+			harbol_string_clear(&root);
+			
+			struct HarbolMap *serial = harbol_cfg_parse_file("harbol_cfg_root.ini");
+			struct HarbolMap *inline_par = harbol_cfg_parse_file_parallel("harbol_cfg_root.ini", NULL);
+			struct HarbolThreadPool *pool = harbol_threadpool_new(4);
+			assert( pool != NULL );
+			struct HarbolMap *parallel = harbol_cfg_parse_file_parallel("harbol_cfg_root.ini", pool);
+			assert( serial != NULL && inline_par != NULL && parallel != NULL );
+			struct HarbolString serial_str = harbol_cfg_to_str(serial);
+			struct HarbolString inline_str = harbol_cfg_to_str(inline_par);
+			struct HarbolString par_str    = harbol_cfg_to_str(parallel);
+			assert( !strcmp(serial_str.cstr, par_str.cstr) && !strcmp(serial_str.cstr, inline_str.cstr) );
+			fprintf(debug_stream, "%s\n", par_str.cstr);
+			assert( harbol_map_has_key(parallel, "harbol_cfg_par5.ini", sizeof "harbol_cfg_par5.ini") );
+			harbol_string_clear(&inline_str);
+			harbol_string_clear(&par_str);
+			harbol_cfg_free(&inline_par);
+			harbol_cfg_free(&parallel);
+			
+			/// called from the pool's only worker, it can't wait for the whole pool.
+			struct HarbolThreadPool single = {0};
+			assert( harbol_threadpool_init(&single, 1) );
+			struct ParseJob job = { .pool = &single, .filename = "harbol_cfg_root.ini" };
+			struct HarbolTaskGroup group = {0};
+			assert( harbol_threadpool_submit_group(&single, &group, parse_job, &job) );
+			harbol_threadpool_wait_group(&single, &group);
+			assert( job.cfg != NULL );
+			par_str = harbol_cfg_to_str(job.cfg);
+			assert( !strcmp(serial_str.cstr, par_str.cstr) );
+			harbol_string_clear(&serial_str);
+			harbol_string_clear(&par_str);
+			harbol_cfg_free(&job.cfg);
+			harbol_cfg_free(&serial);
+			harbol_threadpool_clear(&single);
+			
+			/// an include cycle is left out instead of recursing forever, both parsers agree on where.
+			write_cfg_file("harbol_cfg_cyc_a.ini", "'a': 1\n'<include>': 'harbol_cfg_cyc_b.ini'\n");
+			write_cfg_file("harbol_cfg_cyc_b.ini", "'b': 2\n'<include>': 'harbol_cfg_cyc_a.ini'\n'<include>': 'harbol_cfg_missing.ini'\n");
+			serial   = harbol_cfg_parse_file("harbol_cfg_cyc_a.ini");
+			parallel = harbol_cfg_parse_file_parallel("harbol_cfg_cyc_a.ini", pool);
+			assert( serial != NULL && parallel != NULL );
+			serial_str = harbol_cfg_to_str(serial);
+			par_str    = harbol_cfg_to_str(parallel);
+			assert( !strcmp(serial_str.cstr, par_str.cstr) );
+			fprintf(debug_stream, "%s\n", par_str.cstr);
+			harbol_string_clear(&serial_str);
+			harbol_string_clear(&par_str);
+			harbol_cfg_free(&serial);
+			harbol_cfg_free(&parallel);
+			assert( harbol_cfg_parse_file_parallel("harbol_cfg_missing.ini", pool)==NULL );
+			
+			harbol_threadpool_free(&pool);
+			for( size_t i=0; i < part_count; i++ ) {
+				remove(parts[i]);
+			}
+			remove("harbol_cfg_shared.ini");
+			remove("harbol_cfg_root.ini");
+			remove("harbol_cfg_cyc_a.ini");
+			remove("harbol_cfg_cyc_b.ini");
+		}
+		
+		fputs("\ncfg :: test reloading cfg files in place\n", debug_stream);
+		{
+			time_t const stamp = time(NULL);
+			rewrite_cfg_file("harbol_cfg_reload.ini", "'name': 'app'\n'limits': { 'max': 10, 'min': 1 }\n'<include>': 'harbol_cfg_reload_inc.ini'\n'gone': true\n", stamp);
+			rewrite_cfg_file("harbol_cfg_reload_inc.ini", "'a': 1\n'b': { 'c': 'x' }\n", stamp);
+			bool res = false;
+			struct HarbolCfgFile file = harbol_cfg_file_make("harbol_cfg_reload.ini", &res);
+			assert( res && !harbol_cfg_file_changed(&file) );
+			struct HarbolMap const *const limits = harbol_cfg_get_section(file.cfg, "limits");
+			assert( limits != NULL );
+			struct ChangeLog log = { debug_stream, 0, 0, 0 };
+			assert( harbol_cfg_reload(&file, log_change, &log)==0 );
+			
+			/// only the include changed.
+			rewrite_cfg_file("harbol_cfg_reload_inc.ini", "'a': 2\n'b': { 'c': 'x', 'd': 3.5 }\n", stamp + 10);
+			assert( harbol_cfg_file_changed(&file) );
+			assert( harbol_cfg_reload(&file, log_change, &log)==2 && log.changed==1 && log.added==1 );
+			assert( *harbol_cfg_get_int(file.cfg, "harbol_cfg_reload_inc\\.ini.a")==2 );
+			assert( harbol_cfg_get_section(file.cfg, "limits")==limits );
+			
+			/// the root file drops a key, changes one and includes a new file.
+			rewrite_cfg_file("harbol_cfg_reload_new.ini", "'fresh': null\n", stamp);
+			rewrite_cfg_file("harbol_cfg_reload.ini", "'name': 'app'\n'limits': { 'max': 20, 'min': 1 }\n'<include>': 'harbol_cfg_reload_inc.ini'\n'<include>': 'harbol_cfg_reload_new.ini'\n", stamp + 10);
+			log = ( struct ChangeLog ){ debug_stream, 0, 0, 0 };
+			assert( harbol_cfg_reload(&file, log_change, &log)==3 && log.removed==1 && log.changed==1 && log.added==1 );
+			assert( harbol_cfg_get_section(file.cfg, "limits")==limits && *harbol_cfg_get_int(file.cfg, "limits.max")==20 );
+			
+			struct HarbolMap *reparsed = harbol_cfg_parse_file("harbol_cfg_reload.ini");
+			assert( reparsed != NULL );
+			struct HarbolString live_str  = harbol_cfg_to_str(file.cfg);
+			struct HarbolString fresh_str = harbol_cfg_to_str(reparsed);
+			assert( !strcmp(live_str.cstr, fresh_str.cstr) );
+			fprintf(debug_stream, "%s\n", live_str.cstr);
+			harbol_string_clear(&live_str);
+			harbol_string_clear(&fresh_str);
+			harbol_cfg_free(&reparsed);
+			
+			/// a half-saved edit is turned away whole and retried on the next reload.
+			rewrite_cfg_file("harbol_cfg_reload.ini", "'name': 'app'\n'limits': { 'max': 30,", stamp + 20);
+			rewrite_cfg_file("harbol_cfg_reload_inc.ini", "'a': 3\n'b': { 'c': 'x', 'd': 3.5 }\n", stamp + 20);
+			log = ( struct ChangeLog ){ debug_stream, 0, 0, 0 };
+			assert( harbol_cfg_reload(&file, log_change, &log)==SIZE_MAX );
+			assert( log.added==0 && log.removed==0 && log.changed==0 );
+			assert( *harbol_cfg_get_int(file.cfg, "limits.max")==20 && *harbol_cfg_get_int(file.cfg, "harbol_cfg_reload_inc\\.ini.a")==2 );
+			assert( harbol_cfg_get_section(file.cfg, "harbol_cfg_reload_new\\.ini") != NULL );
+			assert( harbol_cfg_file_changed(&file) );
+			rewrite_cfg_file("harbol_cfg_reload.ini", "'name': 'app'\n'limits': { 'max': 20, 'min': 1 }\n'<include>': 'harbol_cfg_reload_inc.ini'\n'<include>': 'harbol_cfg_reload_new.ini'\n", stamp + 30);
+			assert( harbol_cfg_reload(&file, log_change, &log)==1 && log.changed==1 );
+			assert( *harbol_cfg_get_int(file.cfg, "harbol_cfg_reload_inc\\.ini.a")==3 && !harbol_cfg_file_changed(&file) );
+			
+			/// an unreadable root file leaves the tree alone.
+			remove("harbol_cfg_reload.ini");
+			assert( harbol_cfg_reload(&file, NULL, NULL)==SIZE_MAX );
+			assert( *harbol_cfg_get_int(file.cfg, "limits.max")==20 );
+			harbol_cfg_file_clear(&file);
+			assert( file.cfg==NULL );
+			remove("harbol_cfg_reload_inc.ini");
+			remove("harbol_cfg_reload_new.ini");
+		}
+		
+		fputs("\ncfg :: test binding a cfg into a struct\n", debug_stream);
+		{
+			struct Settings {
+				intmax_t           width, height, missing;
+				floatmax_t         scale, gamma;
+				char const        *title;
+				bool               fullscreen;
+				union HarbolColor  clear;
+				struct HarbolVec4D spawn;
+				struct HarbolMap  *keys;
+				intmax_t           vsync;
+			} settings = {0};
+			intmax_t const def_missing = 7, def_vsync = 1;
+			floatmax_t const def_gamma = 2.2;
+			struct HarbolCfgField const schema[] = {
+				{ "window.width",      HarbolCfgType_Int,    offsetof(struct Settings, width),      NULL },
+				{ "window.height",     HarbolCfgType_Int,    offsetof(struct Settings, height),     NULL },
+				{ "window.missing",    HarbolCfgType_Int,    offsetof(struct Settings, missing),    &def_missing },
+				{ "window.scale",      HarbolCfgType_Float,  offsetof(struct Settings, scale),      NULL },
+				{ "window.gamma",      HarbolCfgType_Float,  offsetof(struct Settings, gamma),      &def_gamma },
+				{ "window.title\\.txt", HarbolCfgType_String, offsetof(struct Settings, title),      NULL },
+				{ "window.fullscreen", HarbolCfgType_Bool,   offsetof(struct Settings, fullscreen), NULL },
+				{ "render.clear",      HarbolCfgType_Color,  offsetof(struct Settings, clear),      NULL },
+				{ "render.spawn",      HarbolCfgType_Vec4D,  offsetof(struct Settings, spawn),      NULL },
+				{ "keys",              HarbolCfgType_Map,    offsetof(struct Settings, keys),       NULL },
+				{ "render.vsync",      HarbolCfgType_Int,    offsetof(struct Settings, vsync),      &def_vsync },
+			};
+			size_t const schema_len = sizeof schema / sizeof schema[0];
+			
+			char const *const good = "'window': {\n\t'width': 640, 'height': 480, 'scale': 2\n\t'title.txt': 'demo'\n\t'fullscreen': false\n}\n'render': { 'clear': c[1, 2, 3, 4], 'spawn': v[1.0, 2.0, 3.0, 4.0] }\n'keys': { 'jump': 'space' }\n'unused': { 'x': 1 }\n";
+			struct HarbolMap *cfg = harbol_cfg_parse_cstr(good);
+			assert( cfg != NULL );
+			assert( harbol_cfg_bind(cfg, schema, schema_len, &settings, NULL)==0 );
+			assert( settings.width==640 && settings.height==480 && settings.scale==2 && settings.gamma==def_gamma );
+			assert( !strcmp(settings.title, "demo") && !settings.fullscreen && settings.missing==7 && settings.vsync==1 );
+			assert( settings.clear.bytes.b==3 && settings.spawn.w==4.f );
+			assert( settings.keys==harbol_cfg_get_section(cfg, "keys") );
+			harbol_cfg_free(&cfg);
+			
+			/// every mismatch is reported, not just the first, and pointed at in the source.
+			write_cfg_file("harbol_cfg_bind.ini", "'window': {\n\t'width': 'wide', 'scale': 1.5\n\t'title.txt': 'demo'\n\t'fullscreen': 1\n}\n'render': { 'clear': c[1, 2, 3, 4], 'spawn': v[1.0, 2.0, 3.0, 4.0], 'vsync': true }\n'keys': { }\n");
+			cfg = harbol_cfg_parse_file("harbol_cfg_bind.ini");
+			assert( cfg != NULL );
+			bool res = false;
+			struct HarbolMsgSpan msgspan = harbol_msg_span_make("harbol_cfg_bind.ini", true, true, &res);
+			assert( res );
+			settings = ( struct Settings ){0};
+			size_t const errs = harbol_cfg_bind(cfg, schema, schema_len, &settings, &msgspan);
+			fprintf(debug_stream, "bind errors: %zu\n", errs);
+			/// 'width' is a string, 'height' is missing, 'fullscreen' is an int and 'vsync' a bool.
+			assert( errs==4 );
+			assert( settings.scale==1.5 && settings.vsync==def_vsync );
+			harbol_msg_span_clear(&msgspan);
+			harbol_cfg_free(&cfg);
+			remove("harbol_cfg_bind.ini");
+		}
+		
+		fputs("\ncfg :: test lazy parsing of sections\n", debug_stream);
+		{
+			write_cfg_file("harbol_cfg_lazy.ini",
+				"'name': 'lazy'\n"
+				"'window': { 'width': 800, 'height': 600, 'title': 'a \\'}\\' brace', 'inner': { 'x': 1 } }\n"
+				"'enums': { 'a': IOTA, 'b': IOTA }\n"
+				"'colors': { 'red': c[255, 0, 0, 255], 'first': iota, 'second': iota }\n"
+				"'after': ENUM\n"
+			);
+			struct HarbolCfgLazy lazy = harbol_cfg_lazy_make("harbol_cfg_lazy.ini", &( bool ){false});
+			assert( lazy.cfg != NULL );
+			/// 'enums' bumps the global counter so it's parsed right away.
+			assert( lazy.pending.len==2 );
+			assert( harbol_map_has_key(&lazy.pending, "window", sizeof "window") && harbol_map_has_key(&lazy.pending, "colors", sizeof "colors") );
+			assert( harbol_cfg_get_section(lazy.cfg, "window")->len==0 );
+			
+			intmax_t const *const width = harbol_cfg_get_int(harbol_cfg_lazy_touch(&lazy, "window.width"), "window.width");
+			assert( width != NULL && *width==800 );
+			assert( lazy.pending.len==1 );
+			struct HarbolMap const *const inner = harbol_cfg_lazy_get_section(&lazy, "window.inner");
+			assert( inner != NULL && inner->len==1 );
+			assert( harbol_cfg_lazy_get_section(&lazy, "missing.section")==NULL && lazy.pending.len==1 );
+			assert( harbol_cfg_lazy_load_all(&lazy) && lazy.pending.len==0 );
+			
+			struct HarbolMap *eager = harbol_cfg_parse_file("harbol_cfg_lazy.ini");
+			assert( eager != NULL );
+			struct HarbolString a = harbol_cfg_to_str(lazy.cfg), b = harbol_cfg_to_str(eager);
+			fprintf(debug_stream, "%s\n", a.cstr);
+			assert( !strcmp(a.cstr, b.cstr) );
+			harbol_string_clear(&a);
+			harbol_string_clear(&b);
+			harbol_cfg_free(&eager);
+			harbol_cfg_lazy_clear(&lazy);
+			remove("harbol_cfg_lazy.ini");
+			
+			/// math in a deferred section reads the global counters as a full parse would.
+			write_cfg_file("harbol_cfg_lazy_math.ini",
+				"'first': IOTA, 'second': IOTA\n"
+				"'<ENUM>flag': 1, '<ENUM>flag': 2\n"
+				"'calc': { 'iota': '<math IOTA + 100>', 'enum': '<math ENUM * 10>', 'local': '<math iota + enum>' }\n"
+				"'third': IOTA\n"
+			);
+			lazy = harbol_cfg_lazy_make("harbol_cfg_lazy_math.ini", &( bool ){false});
+			assert( lazy.cfg != NULL && harbol_map_has_key(&lazy.pending, "calc", sizeof "calc") );
+			assert( harbol_cfg_lazy_load_all(&lazy) );
+			eager = harbol_cfg_parse_file("harbol_cfg_lazy_math.ini");
+			assert( eager != NULL );
+			a = harbol_cfg_to_str(lazy.cfg), b = harbol_cfg_to_str(eager);
+			fprintf(debug_stream, "%s\n", a.cstr);
+			assert( !strcmp(a.cstr, b.cstr) );
+			assert( !strcmp(harbol_cfg_get_str(lazy.cfg, "calc.iota")->cstr, "102.000000") );
+			harbol_string_clear(&a);
+			harbol_string_clear(&b);
+			harbol_cfg_free(&eager);
+			harbol_cfg_lazy_clear(&lazy);
+			remove("harbol_cfg_lazy_math.ini");
+			
+			/// only the touched section of a big file is ever parsed.
+			struct HarbolString big = {0};
+			for( size_t sect=0; sect < 400; sect++ ) {
+				harbol_string_format(&big, false, "'section%zu': {\n", sect);
+				for( size_t key=0; key < 25; key++ ) {
+					harbol_string_format(&big, false, "\t'int%zu': %zu, 'str%zu': 'value %zu', 'flt%zu': %zu.5, 'vec%zu': v[%zu.25, -1.5, 0.75, 2]\n", key, key * sect, key, sect, key, key, key, sect);
+				}
+				harbol_string_add_cstr(&big, "}\n");
+			}
+			write_cfg_file("harbol_cfg_lazy_big.ini", big.cstr);
+			harbol_string_clear(&big);
+			
+			enum { ROUNDS = 10 };
+			double eager_secs = 0.0, lazy_secs = 0.0;
+			for( int r=0; r < ROUNDS; r++ ) {
+				clock_t const t0 = clock();
+				struct HarbolMap *full = harbol_cfg_parse_file("harbol_cfg_lazy_big.ini");
+				intmax_t const *const eager_val = harbol_cfg_get_int(full, "section250.int7");
+				clock_t const t1 = clock();
+				struct HarbolCfgLazy big_lazy = harbol_cfg_lazy_make("harbol_cfg_lazy_big.ini", &( bool ){false});
+				intmax_t const *const lazy_val = harbol_cfg_get_int(harbol_cfg_lazy_touch(&big_lazy, "section250.int7"), "section250.int7");
+				clock_t const t2 = clock();
+				assert( eager_val != NULL && lazy_val != NULL && *eager_val==*lazy_val && *lazy_val==1750 );
+				assert( big_lazy.pending.len==399 );
+				eager_secs += (t1 - t0) / ( double )(CLOCKS_PER_SEC);
+				lazy_secs  += (t2 - t1) / ( double )(CLOCKS_PER_SEC);
+				harbol_cfg_free(&full);
+				harbol_cfg_lazy_clear(&big_lazy);
+			}
+			printf("cfg 400 sections x%d: full parse %f secs | lazy parse + one lookup %f secs\n", ROUNDS, eager_secs, lazy_secs);
+			fprintf(debug_stream, "full parse: %f secs | lazy: %f secs\n", eager_secs, lazy_secs);
+			remove("harbol_cfg_lazy_big.ini");
+		}
+		
+		fputs("\ncfg :: test JSON import and export\n", debug_stream);
+		{
+			char const json[] =
+				"{\n"
+				"  \"name\": \"caf\\u00e9 \\\"q\\\" \\\\ \\ud83d\\ude00\",\n"
+				"  \"count\": -42, \"ratio\": 2.5e-1, \"big\": 123456789012345678901234567890,\n"
+				"  \"on\": true, \"off\": false, \"none\": null,\n"
+				"  \"tint\": [255, 128, 0, 255], \"pos\": [1.5, -2, 0.25, 4],\n"
+				"  \"list\": [1, \"two\", {\"three\": 3}, []], \"empty\": {},\n"
+				"  \"nested\": { \"deeper\": { \"key\": \"value\" } }\n"
+				"}\n";
+			struct HarbolMap *cfg_json = harbol_cfg_parse_json(json);
+			assert( cfg_json != NULL );
+			assert( !strcmp(harbol_cfg_get_str(cfg_json, "name")->cstr, "caf\xc3\xa9 \"q\" \\ \xf0\x9f\x98\x80") );
+			assert( *harbol_cfg_get_int(cfg_json, "count")==-42 );
+			assert( *harbol_cfg_get_float(cfg_json, "ratio")==0.25 );
+			assert( harbol_cfg_get_type(cfg_json, "big")==HarbolCfgType_Float );
+			assert( *harbol_cfg_get_bool(cfg_json, "on") && !*harbol_cfg_get_bool(cfg_json, "off") );
+			assert( harbol_cfg_get_type(cfg_json, "none")==HarbolCfgType_Null );
+			union HarbolColor const *const tint = harbol_cfg_get_color(cfg_json, "tint");
+			assert( tint != NULL && tint->bytes.r==255 && tint->bytes.g==128 && tint->bytes.b==0 && tint->bytes.a==255 );
+			struct HarbolVec4D const *const pos = harbol_cfg_get_vec4D(cfg_json, "pos");
+			assert( pos != NULL && pos->x==1.5f && pos->y==-2.f && pos->z==0.25f && pos->w==4.f );
+			assert( harbol_cfg_get_section(cfg_json, "list")->len==4 && *harbol_cfg_get_int(cfg_json, "list.0")==1 );
+			assert( *harbol_cfg_get_int(cfg_json, "list.2.three")==3 && harbol_cfg_get_section(cfg_json, "list.3")->len==0 );
+			assert( !strcmp(harbol_cfg_get_str(cfg_json, "nested.deeper.key")->cstr, "value") );
+			
+			/// exported JSON parses back to the same tree.
+			struct HarbolString out = harbol_cfg_to_json(cfg_json);
+			fprintf(debug_stream, "%s\n", out.cstr);
+			struct HarbolMap *reparsed = harbol_cfg_parse_json(out.cstr);
+			assert( reparsed != NULL );
+			struct HarbolString a = harbol_cfg_to_str(cfg_json), b = harbol_cfg_to_str(reparsed);
+			assert( !strcmp(a.cstr, b.cstr) );
+			harbol_string_clear(&a);
+			harbol_string_clear(&b);
+			harbol_string_clear(&out);
+			harbol_cfg_free(&reparsed);
+			harbol_cfg_free(&cfg_json);
+			
+			/// floats keep every digit they need, whatever their exponent.
+			struct HarbolMap *floats = harbol_cfg_parse_json("{\"tiny\": 1e-9, \"small\": -2.5e-300, \"huge\": 1.7976931348623157e308, \"precise\": 123456789.123456789, \"tenth\": 0.1, \"whole\": 3.0, \"axes\": [1e-9, 3.4e38, 0.1, 2.0]}");
+			assert( floats != NULL );
+			floatmax_t const tiny = *harbol_cfg_get_float(floats, "tiny"), small = *harbol_cfg_get_float(floats, "small");
+			floatmax_t const huge = *harbol_cfg_get_float(floats, "huge"), precise = *harbol_cfg_get_float(floats, "precise");
+			struct HarbolVec4D const axes = *harbol_cfg_get_vec4D(floats, "axes");
+			out = harbol_cfg_to_json(floats);
+			fprintf(debug_stream, "%s\n", out.cstr);
+			reparsed = harbol_cfg_parse_json(out.cstr);
+			assert( reparsed != NULL );
+			assert( *harbol_cfg_get_float(reparsed, "tiny")==tiny && *harbol_cfg_get_float(reparsed, "small")==small );
+			assert( *harbol_cfg_get_float(reparsed, "huge")==huge && *harbol_cfg_get_float(reparsed, "precise")==precise );
+			assert( *harbol_cfg_get_float(reparsed, "tenth")==*harbol_cfg_get_float(floats, "tenth") );
+			assert( harbol_cfg_get_type(reparsed, "whole")==HarbolCfgType_Float );
+			struct HarbolVec4D const *const axes_back = harbol_cfg_get_vec4D(reparsed, "axes");
+			assert( axes_back != NULL && !memcmp(axes_back, &axes, sizeof axes) );
+			b = harbol_cfg_to_json(reparsed);
+			assert( !strcmp(out.cstr, b.cstr) );
+			harbol_string_clear(&b);
+			harbol_string_clear(&out);
+			harbol_cfg_free(&reparsed);
+			harbol_cfg_set_float(floats, "huge", INFINITY, true);
+			out = harbol_cfg_to_json(floats);
+			assert( strstr(out.cstr, "\"huge\":null") != NULL );
+			harbol_string_clear(&out);
+			harbol_cfg_free(&floats);
+			
+			/// same tree as the cfg parser gives for the same values.
+			struct HarbolMap *from_cfg = harbol_cfg_parse_cstr("'a': 1, 'b': { 'c': 'two', 'd': c[1, 2, 3, 4], 'e': v[1.0, 2.0, 3.5, 4.0] }, 'f': null, 'g': -0.5e2, 'h': false");
+			struct HarbolMap *from_json = harbol_cfg_parse_json("{\"a\":1,\"b\":{\"c\":\"two\",\"d\":[1,2,3,4],\"e\":[1.0,2.0,3.5,4.0]},\"f\":null,\"g\":-0.5e2,\"h\":false}");
+			assert( from_cfg != NULL && from_json != NULL );
+			a = harbol_cfg_to_str(from_cfg), b = harbol_cfg_to_str(from_json);
+			assert( !strcmp(a.cstr, b.cstr) );
+			harbol_string_clear(&a);
+			harbol_string_clear(&b);
+			harbol_cfg_free(&from_cfg);
+			harbol_cfg_free(&from_json);
+			
+			/// malformed JSON gives no tree.
+			char const *const bad[] = {
+				"", "[1, 2]", "{\"a\": 1,}", "{\"a\" 1}", "{\"a\": tru}", "{\"a\": 01}", "{\"a\": 1} x",
+				"{\"a\": \"unterminated}", "{\"a\": \"bad \\q escape\"}", "{\"a\": \"raw\ttab\"}",
+				"{\"a\": 1, \"a\": 2}", "{\"a\": [1, 2}", "{\"a\": {\"b\": 1}", "{\"a\": \"\\ud800\"}",
+			};
+			for( size_t i=0; i < sizeof bad / sizeof bad[0]; i++ ) {
+				struct HarbolMap *const invalid = harbol_cfg_parse_json(bad[i]);
+				fprintf(debug_stream, "'%s' -> %s\n", bad[i], ( invalid==NULL )? "rejected" : "accepted");
+				assert( invalid==NULL );
+			}
+			
+			/// benchmark against the cfg lexer on the same values.
+			struct HarbolString big = {0};
+			for( size_t sect=0; sect < 400; sect++ ) {
+				harbol_string_format(&big, false, "'section%zu': {\n", sect);
+				for( size_t key=0; key < 25; key++ ) {
+					harbol_string_format(&big, false, "\t'int%zu': %zu, 'str%zu': 'value %zu', 'flt%zu': %zu.5, 'on%zu': true, 'vec%zu': v[%zu.25, -1.5, 0.75, 2], 'col%zu': c[%zu, 2, 3, 255]\n", key, key * sect, key, sect, key, key, key, key, sect, key, key);
+				}
+				harbol_string_add_cstr(&big, "}\n");
+			}
+			struct HarbolMap *tree = harbol_cfg_parse_cstr(big.cstr);
+			harbol_string_clear(&big);
+			assert( tree != NULL );
+			struct HarbolString cfg_text = harbol_cfg_to_str(tree), json_text = harbol_cfg_to_json(tree);
+			assert( harbol_cfg_build_json_file(tree, "harbol_cfg_json.json") );
+			
+			enum { ROUNDS = 5 };
+			double cfg_secs = 0.0, json_secs = 0.0;
+			for( int r=0; r < ROUNDS; r++ ) {
+				clock_t const t0 = clock();
+				struct HarbolMap *lexed = harbol_cfg_parse_cstr(cfg_text.cstr);
+				clock_t const t1 = clock();
+				struct HarbolMap *indexed = harbol_cfg_parse_json(json_text.cstr);
+				clock_t const t2 = clock();
+				assert( lexed != NULL && indexed != NULL );
+				cfg_secs  += (t1 - t0) / ( double )(CLOCKS_PER_SEC);
+				json_secs += (t2 - t1) / ( double )(CLOCKS_PER_SEC);
+				if( r==0 ) {
+					a = harbol_cfg_to_str(lexed), b = harbol_cfg_to_str(indexed);
+					assert( !strcmp(a.cstr, b.cstr) && !strcmp(a.cstr, cfg_text.cstr) );
+					harbol_string_clear(&a);
+					harbol_string_clear(&b);
+				}
+				harbol_cfg_free(&lexed);
+				harbol_cfg_free(&indexed);
+			}
+			printf("cfg 60k keys x%d: cfg parse %f secs (%zu bytes) | JSON parse %f secs (%zu bytes)\n", ROUNDS, cfg_secs, cfg_text.len, json_secs, json_text.len);
+			fprintf(debug_stream, "cfg parse: %f secs | JSON parse: %f secs\n", cfg_secs, json_secs);
+			
+			struct HarbolMap *from_file = harbol_cfg_parse_json_file("harbol_cfg_json.json");
+			assert( from_file != NULL );
+			a = harbol_cfg_to_str(from_file);
+			assert( !strcmp(a.cstr, cfg_text.cstr) );
+			harbol_string_clear(&a);
+			harbol_cfg_free(&from_file);
+			remove("harbol_cfg_json.json");
+			harbol_string_clear(&cfg_text);
+			harbol_string_clear(&json_text);
+			harbol_cfg_free(&tree);
+		}
+		
 		fputs("\ncfg :: test adding other cfg as a new section\n", debug_stream);
 		{
 			struct HarbolVariant var = harbol_variant_make(&cfg, sizeof cfg, HarbolCfgType_Map, &( bool ){0});
@@ -4,6 +4,43 @@
 #	define HARBOL_LIB
 #endif
 
+
+/// atomics used by the lock-free queues.
+#if defined(COMPILER_GCC) || defined(COMPILER_CLANG) || defined(COMPILER_INTEL)
+#	define HARBOL_LOAD_RELAXED(ptr)         __atomic_load_n((ptr), __ATOMIC_RELAXED)
+#	define HARBOL_LOAD_ACQUIRE(ptr)         __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#	define HARBOL_STORE_RELEASE(ptr, val)   __atomic_store_n((ptr), (val), __ATOMIC_RELEASE)
+#	define HARBOL_CAS_RELAXED(ptr, expected, desired) \
+		__atomic_compare_exchange_n((ptr), (expected), (desired), true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)
+#elif defined(COMPILER_MSVC)
+#	include <windows.h>
+static inline size_t _harbol_load_acquire(size_t const volatile *const ptr) {
+	size_t const val = *ptr;
+	MemoryBarrier();
+	return val;
+}
+static inline void _harbol_store_release(size_t volatile *const ptr, size_t const val) {
+	MemoryBarrier();
+	*ptr = val;
+}
+static inline bool _harbol_cas(size_t volatile *const ptr, size_t *const expected, size_t const desired) {
+#	ifdef HARBOL64
+	size_t const prev = ( size_t )(InterlockedCompareExchange64(( LONG64 volatile* )(ptr), ( LONG64 )(desired), ( LONG64 )(*expected)));
+#	else
+	size_t const prev = ( size_t )(InterlockedCompareExchange(( LONG volatile* )(ptr), ( LONG )(desired), ( LONG )(*expected)));
+#	endif
+	bool const res = prev==*expected;
+	*expected = prev;
+	return res;
+}
+#	define HARBOL_LOAD_RELAXED(ptr)         (*( size_t const volatile* )(ptr))
+#	define HARBOL_LOAD_ACQUIRE(ptr)         _harbol_load_acquire((ptr))
+#	define HARBOL_STORE_RELEASE(ptr, val)   _harbol_store_release((ptr), (val))
+#	define HARBOL_CAS_RELAXED(ptr, expected, desired)    _harbol_cas((ptr), (expected), (desired))
+#else
+#	error "harbol deque's lock-free queues need compiler atomics."
+#endif
+
 HARBOL_EXPORT struct HarbolDeque *harbol_deque_new(size_t const init_size) {
 	struct HarbolDeque *deque = calloc(1, sizeof *deque);
 	if( deque==NULL || !harbol_deque_init(deque, init_size) ) {
@@ -145,6 +182,7 @@ HARBOL_EXPORT size_t harbol_deque_prepend(struct HarbolDeque *const restrict deq
 	deque->datum[i] = dup_data(val, datasize);
 	if( deque->head==SIZE_MAX ) {
 		deque->head = deque->tail = i;
+		deque->nexts[i] = deque->prevs[i] = SIZE_MAX;
 	} else {
 		deque->nexts[i] = deque->head;
 		deque->prevs[i] = SIZE_MAX;
@@ -168,6 +206,7 @@ HARBOL_EXPORT size_t harbol_deque_append(struct HarbolDeque *const restrict dequ
 	deque->datum[i] = dup_data(val, datasize);
 	if( deque->tail==SIZE_MAX ) {
 		deque->head = deque->tail = i;
+		deque->nexts[i] = deque->prevs[i] = SIZE_MAX;
 	} else {
 		deque->prevs[i] = deque->tail;
 		deque->nexts[i] = SIZE_MAX;
@@ -229,3 +268,419 @@ HARBOL_EXPORT void *harbol_deque_get_front(struct HarbolDeque const *const deque
 HARBOL_EXPORT void *harbol_deque_get_back(struct HarbolDeque const *const deque) {
 	return( deque->tail==SIZE_MAX )? NULL : deque->datum[deque->tail];
 }
+
+
+static inline NO_NULL bool _harbol_deque_live(struct HarbolDeque const *const deque, size_t const node) {
+	return node < deque->cap && deque->datum[node] != NULL;
+}
+
+static NO_NULL void _harbol_deque_unlink(struct HarbolDeque *const deque, size_t const node) {
+	size_t const prev = deque->prevs[node], next = deque->nexts[node];
+	if( prev != SIZE_MAX ) {
+		deque->nexts[prev] = next;
+	} else {
+		deque->head = next;
+	}
+	if( next != SIZE_MAX ) {
+		deque->prevs[next] = prev;
+	} else {
+		deque->tail = prev;
+	}
+	deque->nexts[node] = deque->prevs[node] = SIZE_MAX;
+}
+
+/// links a detached 'node' between 'prev' and 'next', either may be SIZE_MAX for the ends.
+static NO_NULL void _harbol_deque_link(struct HarbolDeque *const deque, size_t const node, size_t const prev, size_t const next) {
+	deque->prevs[node] = prev;
+	deque->nexts[node] = next;
+	if( prev != SIZE_MAX ) {
+		deque->nexts[prev] = node;
+	} else {
+		deque->head = node;
+	}
+	if( next != SIZE_MAX ) {
+		deque->prevs[next] = node;
+	} else {
+		deque->tail = node;
+	}
+}
+
+static NO_NULL size_t _harbol_deque_new_node(struct HarbolDeque *const restrict deque, void const *const val, size_t const datasize) {
+	if( deque->len >= deque->cap && !_harbol_deque_resize(deque, deque->cap << 1) ) {
+		return SIZE_MAX;
+	}
+	size_t const i = _harbol_deque_alloc_node(deque);
+	if( i==SIZE_MAX ) {
+		return SIZE_MAX;
+	}
+	deque->datum[i] = dup_data(val, datasize);
+	if( deque->datum[i]==NULL ) {
+		_harbol_deque_free_node(deque, i);
+		return SIZE_MAX;
+	}
+	deque->len++;
+	return i;
+}
+
+HARBOL_EXPORT size_t harbol_deque_insert_after(struct HarbolDeque *const restrict deque, size_t const node, void const *const val, size_t const datasize) {
+	if( !_harbol_deque_live(deque, node) ) {
+		return SIZE_MAX;
+	}
+	size_t const i = _harbol_deque_new_node(deque, val, datasize);
+	if( i != SIZE_MAX ) {
+		_harbol_deque_link(deque, i, node, deque->nexts[node]);
+	}
+	return i;
+}
+
+HARBOL_EXPORT size_t harbol_deque_insert_before(struct HarbolDeque *const restrict deque, size_t const node, void const *const val, size_t const datasize) {
+	if( !_harbol_deque_live(deque, node) ) {
+		return SIZE_MAX;
+	}
+	size_t const i = _harbol_deque_new_node(deque, val, datasize);
+	if( i != SIZE_MAX ) {
+		_harbol_deque_link(deque, i, deque->prevs[node], node);
+	}
+	return i;
+}
+
+HARBOL_EXPORT bool harbol_deque_remove(struct HarbolDeque *const restrict deque, size_t const node, void *const restrict val, size_t const datasize) {
+	if( !_harbol_deque_live(deque, node) ) {
+		return false;
+	}
+	_harbol_deque_unlink(deque, node);
+	if( val != NULL ) {
+		memcpy(val, deque->datum[node], datasize);
+	}
+	free(deque->datum[node]); deque->datum[node] = NULL;
+	_harbol_deque_free_node(deque, node);
+	deque->len--;
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_deque_move_to_front(struct HarbolDeque *const deque, size_t const node) {
+	if( !_harbol_deque_live(deque, node) ) {
+		return false;
+	} else if( node==deque->head ) {
+		return true;
+	}
+	_harbol_deque_unlink(deque, node);
+	_harbol_deque_link(deque, node, SIZE_MAX, deque->head);
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_deque_move_to_back(struct HarbolDeque *const deque, size_t const node) {
+	if( !_harbol_deque_live(deque, node) ) {
+		return false;
+	} else if( node==deque->tail ) {
+		return true;
+	}
+	_harbol_deque_unlink(deque, node);
+	_harbol_deque_link(deque, node, deque->tail, SIZE_MAX);
+	return true;
+}
+
+
+/// Ring Deque.
+HARBOL_EXPORT struct HarbolRingDeque *harbol_ring_deque_new(size_t const datasize, size_t const init_size) {
+	struct HarbolRingDeque *ring = calloc(1, sizeof *ring);
+	if( ring==NULL || !harbol_ring_deque_init(ring, datasize, init_size) ) {
+		free(ring);
+		return NULL;
+	}
+	return ring;
+}
+
+HARBOL_EXPORT bool harbol_ring_deque_init(struct HarbolRingDeque *const ring, size_t const datasize, size_t const init_size) {
+	size_t const cap = (init_size <= 1)? 2 : bitwise_ceil(init_size - 1) + 1;
+	if( datasize==0 || cap==0 || cap > SIZE_MAX / datasize ) {
+		return false;
+	}
+	ring->table = calloc(cap, datasize);
+	if( ring->table==NULL ) {
+		return false;
+	}
+	ring->cap = cap;
+	ring->len = ring->head = 0;
+	return true;
+}
+
+HARBOL_EXPORT struct HarbolRingDeque harbol_ring_deque_make(size_t const datasize, size_t const init_size, bool *const res) {
+	struct HarbolRingDeque r = {0};
+	*res = harbol_ring_deque_init(&r, datasize, init_size);
+	return r;
+}
+
+HARBOL_EXPORT void harbol_ring_deque_clear(struct HarbolRingDeque *const ring) {
+	free(ring->table);
+	*ring = ( struct HarbolRingDeque ){0};
+}
+
+HARBOL_EXPORT void harbol_ring_deque_free(struct HarbolRingDeque **const ringref) {
+	if( *ringref==NULL ) {
+		return;
+	}
+	harbol_ring_deque_clear(*ringref);
+	free(*ringref); *ringref = NULL;
+}
+
+HARBOL_EXPORT void harbol_ring_deque_reset(struct HarbolRingDeque *const ring) {
+	ring->len = ring->head = 0;
+}
+
+HARBOL_EXPORT size_t harbol_ring_deque_count(struct HarbolRingDeque const *const ring) {
+	return ring->len;
+}
+HARBOL_EXPORT bool harbol_ring_deque_empty(struct HarbolRingDeque const *const ring) {
+	return( ring->table==NULL || ring->len==0 );
+}
+
+static NO_NULL bool _harbol_ring_deque_grow(struct HarbolRingDeque *const ring, size_t const datasize) {
+	if( ring->len < ring->cap && ring->table != NULL ) {
+		return true;
+	}
+	size_t const old_cap = ring->cap;
+	size_t const new_cap = (old_cap==0)? 2 : old_cap << 1;
+	if( new_cap <= old_cap || new_cap > SIZE_MAX / datasize ) {
+		return false;
+	}
+	uint8_t *const new_table = realloc(ring->table, new_cap * datasize);
+	if( new_table==NULL ) {
+		return false;
+	}
+	
+	/// unwrap: the run that wrapped past the old end moves right after it.
+	size_t const wrapped = (ring->head + ring->len > old_cap)? ring->head + ring->len - old_cap : 0;
+	memcpy(&new_table[old_cap * datasize], new_table, wrapped * datasize);
+	ring->table = new_table;
+	ring->cap   = new_cap;
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_ring_deque_prepend(struct HarbolRingDeque *const restrict ring, void const *const val, size_t const datasize) {
+	if( !_harbol_ring_deque_grow(ring, datasize) ) {
+		return false;
+	}
+	ring->head = (ring->head - 1) & (ring->cap - 1);
+	memcpy(&ring->table[ring->head * datasize], val, datasize);
+	ring->len++;
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_ring_deque_append(struct HarbolRingDeque *const restrict ring, void const *const val, size_t const datasize) {
+	if( !_harbol_ring_deque_grow(ring, datasize) ) {
+		return false;
+	}
+	size_t const i = (ring->head + ring->len) & (ring->cap - 1);
+	memcpy(&ring->table[i * datasize], val, datasize);
+	ring->len++;
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_ring_deque_pop_front(struct HarbolRingDeque *const restrict ring, void *const restrict val, size_t const datasize) {
+	if( ring->len==0 ) {
+		return false;
+	}
+	memcpy(val, &ring->table[ring->head * datasize], datasize);
+	ring->head = (ring->head + 1) & (ring->cap - 1);
+	ring->len--;
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_ring_deque_pop_back(struct HarbolRingDeque *const restrict ring, void *const restrict val, size_t const datasize) {
+	if( ring->len==0 ) {
+		return false;
+	}
+	ring->len--;
+	size_t const i = (ring->head + ring->len) & (ring->cap - 1);
+	memcpy(val, &ring->table[i * datasize], datasize);
+	return true;
+}
+
+HARBOL_EXPORT void *harbol_ring_deque_get(struct HarbolRingDeque const *const ring, size_t const index, size_t const datasize) {
+	return( index >= ring->len )? NULL : &ring->table[((ring->head + index) & (ring->cap - 1)) * datasize];
+}
+HARBOL_EXPORT void *harbol_ring_deque_get_front(struct HarbolRingDeque const *const ring, size_t const datasize) {
+	return harbol_ring_deque_get(ring, 0, datasize);
+}
+HARBOL_EXPORT void *harbol_ring_deque_get_back(struct HarbolRingDeque const *const ring, size_t const datasize) {
+	return( ring->len==0 )? NULL : harbol_ring_deque_get(ring, ring->len - 1, datasize);
+}
+
+
+/// SPSC Queue.
+static size_t _harbol_queue_cap(size_t const datasize, size_t const cap) {
+	size_t const rounded = (cap <= 1)? 2 : bitwise_ceil(cap - 1) + 1;
+	return( datasize==0 || rounded==0 || rounded > SIZE_MAX / datasize )? 0 : rounded;
+}
+
+HARBOL_EXPORT bool harbol_spsc_queue_init(struct HarbolSPSCQueue *const queue, size_t const datasize, size_t const cap) {
+	*queue = ( struct HarbolSPSCQueue ){0};
+	queue->cap = _harbol_queue_cap(datasize, cap);
+	if( queue->cap==0 ) {
+		return false;
+	}
+	queue->table = calloc(queue->cap, datasize);
+	return queue->table != NULL;
+}
+
+HARBOL_EXPORT void harbol_spsc_queue_clear(struct HarbolSPSCQueue *const queue) {
+	free(queue->table);
+	*queue = ( struct HarbolSPSCQueue ){0};
+}
+
+HARBOL_EXPORT size_t harbol_spsc_queue_count(struct HarbolSPSCQueue *const queue) {
+	return HARBOL_LOAD_ACQUIRE(&queue->tail) - HARBOL_LOAD_ACQUIRE(&queue->head);
+}
+
+/// copies 'count' elements between a linear buffer and the ring starting at 'pos', wrapping once.
+static NO_NULL void _harbol_ring_copy_in(uint8_t *const restrict table, size_t const cap, size_t const pos, uint8_t const *const restrict vals, size_t const count, size_t const datasize) {
+	size_t const start = pos & (cap - 1);
+	size_t const first = (cap - start < count)? cap - start : count;
+	memcpy(&table[start * datasize], vals, first * datasize);
+	memcpy(table, &vals[first * datasize], (count - first) * datasize);
+}
+static NO_NULL void _harbol_ring_copy_out(uint8_t const *const restrict table, size_t const cap, size_t const pos, uint8_t *const restrict vals, size_t const count, size_t const datasize) {
+	size_t const start = pos & (cap - 1);
+	size_t const first = (cap - start < count)? cap - start : count;
+	memcpy(vals, &table[start * datasize], first * datasize);
+	memcpy(&vals[first * datasize], table, (count - first) * datasize);
+}
+
+HARBOL_EXPORT size_t harbol_spsc_queue_append_n(struct HarbolSPSCQueue *const restrict queue, void const *const vals, size_t const count, size_t const datasize) {
+	size_t const tail = HARBOL_LOAD_RELAXED(&queue->tail);
+	size_t room = queue->cap - (tail - queue->cached_head);
+	if( room < count ) {
+		/// only touch the consumer's line when the cached view says we're short.
+		queue->cached_head = HARBOL_LOAD_ACQUIRE(&queue->head);
+		room = queue->cap - (tail - queue->cached_head);
+	}
+	size_t const amount = (room < count)? room : count;
+	if( amount==0 ) {
+		return 0;
+	}
+	_harbol_ring_copy_in(queue->table, queue->cap, tail, vals, amount, datasize);
+	HARBOL_STORE_RELEASE(&queue->tail, tail + amount);
+	return amount;
+}
+
+HARBOL_EXPORT size_t harbol_spsc_queue_pop_front_n(struct HarbolSPSCQueue *const restrict queue, void *const vals, size_t const count, size_t const datasize) {
+	size_t const head = HARBOL_LOAD_RELAXED(&queue->head);
+	size_t ready = queue->cached_tail - head;
+	if( ready < count ) {
+		queue->cached_tail = HARBOL_LOAD_ACQUIRE(&queue->tail);
+		ready = queue->cached_tail - head;
+	}
+	size_t const amount = (ready < count)? ready : count;
+	if( amount==0 ) {
+		return 0;
+	}
+	_harbol_ring_copy_out(queue->table, queue->cap, head, vals, amount, datasize);
+	HARBOL_STORE_RELEASE(&queue->head, head + amount);
+	return amount;
+}
+
+HARBOL_EXPORT bool harbol_spsc_queue_append(struct HarbolSPSCQueue *const restrict queue, void const *const val, size_t const datasize) {
+	return harbol_spsc_queue_append_n(queue, val, 1, datasize)==1;
+}
+
+HARBOL_EXPORT bool harbol_spsc_queue_pop_front(struct HarbolSPSCQueue *const restrict queue, void *const val, size_t const datasize) {
+	return harbol_spsc_queue_pop_front_n(queue, val, 1, datasize)==1;
+}
+
+
+/// MPMC Queue.
+HARBOL_EXPORT bool harbol_mpmc_queue_init(struct HarbolMPMCQueue *const queue, size_t const datasize, size_t const cap) {
+	*queue = ( struct HarbolMPMCQueue ){0};
+	queue->stride = harbol_align_size(sizeof(size_t) + datasize, sizeof(size_t));
+	queue->cap    = _harbol_queue_cap(queue->stride, cap);
+	if( queue->cap==0 ) {
+		return false;
+	}
+	queue->table = calloc(queue->cap, queue->stride);
+	if( queue->table==NULL ) {
+		return false;
+	}
+	for( size_t i=0; i < queue->cap; i++ ) {
+		memcpy(&queue->table[i * queue->stride], &i, sizeof i);
+	}
+	return true;
+}
+
+HARBOL_EXPORT void harbol_mpmc_queue_clear(struct HarbolMPMCQueue *const queue) {
+	free(queue->table);
+	*queue = ( struct HarbolMPMCQueue ){0};
+}
+
+static inline NO_NULL size_t *_harbol_mpmc_cell(struct HarbolMPMCQueue const *const queue, size_t const pos) {
+	return ( size_t* )(&queue->table[(pos & (queue->cap - 1)) * queue->stride]);
+}
+
+HARBOL_EXPORT bool harbol_mpmc_queue_append(struct HarbolMPMCQueue *const restrict queue, void const *const val, size_t const datasize) {
+	if( datasize > queue->stride - sizeof(size_t) ) {
+		return false;
+	}
+	size_t pos = HARBOL_LOAD_RELAXED(&queue->enqueue_pos);
+	size_t *cell = NULL;
+	for(;;) {
+		cell = _harbol_mpmc_cell(queue, pos);
+		size_t const seq = HARBOL_LOAD_ACQUIRE(cell);
+		intptr_t const diff = ( intptr_t )(seq) - ( intptr_t )(pos);
+		if( diff==0 ) {
+			if( HARBOL_CAS_RELAXED(&queue->enqueue_pos, &pos, pos + 1) ) {
+				break;
+			}
+		} else if( diff < 0 ) {
+			/// the cell a lap behind still holds unconsumed data.
+			return false;
+		} else {
+			pos = HARBOL_LOAD_RELAXED(&queue->enqueue_pos);
+		}
+	}
+	memcpy(&cell[1], val, datasize);
+	HARBOL_STORE_RELEASE(cell, pos + 1);
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_mpmc_queue_pop_front(struct HarbolMPMCQueue *const restrict queue, void *const val, size_t const datasize) {
+	if( datasize > queue->stride - sizeof(size_t) ) {
+		return false;
+	}
+	size_t pos = HARBOL_LOAD_RELAXED(&queue->dequeue_pos);
+	size_t *cell = NULL;
+	for(;;) {
+		cell = _harbol_mpmc_cell(queue, pos);
+		size_t const seq = HARBOL_LOAD_ACQUIRE(cell);
+		intptr_t const diff = ( intptr_t )(seq) - ( intptr_t )(pos + 1);
+		if( diff==0 ) {
+			if( HARBOL_CAS_RELAXED(&queue->dequeue_pos, &pos, pos + 1) ) {
+				break;
+			}
+		} else if( diff < 0 ) {
+			return false;
+		} else {
+			pos = HARBOL_LOAD_RELAXED(&queue->dequeue_pos);
+		}
+	}
+	memcpy(val, &cell[1], datasize);
+	HARBOL_STORE_RELEASE(cell, pos + queue->cap);
+	return true;
+}
+
+HARBOL_EXPORT size_t harbol_mpmc_queue_append_n(struct HarbolMPMCQueue *const restrict queue, void const *const vals, size_t const count, size_t const datasize) {
+	uint8_t const *const bytes = vals;
+	size_t n = 0;
+	while( n < count && harbol_mpmc_queue_append(queue, &bytes[n * datasize], datasize) ) {
+		n++;
+	}
+	return n;
+}
+
+HARBOL_EXPORT size_t harbol_mpmc_queue_pop_front_n(struct HarbolMPMCQueue *const restrict queue, void *const vals, size_t const count, size_t const datasize) {
+	uint8_t *const bytes = vals;
+	size_t n = 0;
+	while( n < count && harbol_mpmc_queue_pop_front(queue, &bytes[n * datasize], datasize) ) {
+		n++;
+	}
+	return n;
+}
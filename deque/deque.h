@@ -42,6 +42,95 @@ HARBOL_EXPORT NO_NULL bool harbol_deque_pop_back(struct HarbolDeque *deque, void
 HARBOL_EXPORT NO_NULL void *harbol_deque_get_front(struct HarbolDeque const *deque);
 HARBOL_EXPORT NO_NULL void *harbol_deque_get_back(struct HarbolDeque const *deque);
 HARBOL_EXPORT NO_NULL void *harbol_deque_get_data(struct HarbolDeque const *deque, size_t node);
+
+/// node handle ops, all O(1). inserts return the new node or SIZE_MAX.
+HARBOL_EXPORT NO_NULL size_t harbol_deque_insert_after(struct HarbolDeque *deque, size_t node, void const *val, size_t datasize);
+HARBOL_EXPORT NO_NULL size_t harbol_deque_insert_before(struct HarbolDeque *deque, size_t node, void const *val, size_t datasize);
+/// 'val' may be NULL to discard the removed value.
+HARBOL_EXPORT NEVER_NULL(1) bool harbol_deque_remove(struct HarbolDeque *deque, size_t node, void *val, size_t datasize);
+HARBOL_EXPORT NO_NULL bool harbol_deque_move_to_front(struct HarbolDeque *deque, size_t node);
+HARBOL_EXPORT NO_NULL bool harbol_deque_move_to_back(struct HarbolDeque *deque, size_t node);
+/********************************************************************/
+
+
+/// ring buffer deque, elements are stored inline and 'cap' is always a power of 2.
+struct HarbolRingDeque {
+	uint8_t *table;
+	size_t   cap, len, head;
+};
+
+HARBOL_EXPORT struct HarbolRingDeque *harbol_ring_deque_new(size_t datasize, size_t init_size);
+HARBOL_EXPORT NO_NULL bool harbol_ring_deque_init(struct HarbolRingDeque *ring, size_t datasize, size_t init_size);
+HARBOL_EXPORT NO_NULL struct HarbolRingDeque harbol_ring_deque_make(size_t datasize, size_t init_size, bool *res);
+
+HARBOL_EXPORT NO_NULL void harbol_ring_deque_clear(struct HarbolRingDeque *ring);
+HARBOL_EXPORT NO_NULL void harbol_ring_deque_free(struct HarbolRingDeque **ringref);
+HARBOL_EXPORT NO_NULL void harbol_ring_deque_reset(struct HarbolRingDeque *ring);
+
+HARBOL_EXPORT NO_NULL size_t harbol_ring_deque_count(struct HarbolRingDeque const *ring);
+HARBOL_EXPORT NO_NULL bool harbol_ring_deque_empty(struct HarbolRingDeque const *ring);
+
+HARBOL_EXPORT NO_NULL bool harbol_ring_deque_prepend(struct HarbolRingDeque *ring, void const *val, size_t datasize);
+HARBOL_EXPORT NO_NULL bool harbol_ring_deque_append(struct HarbolRingDeque *ring, void const *val, size_t datasize);
+
+HARBOL_EXPORT NO_NULL bool harbol_ring_deque_pop_front(struct HarbolRingDeque *ring, void *val, size_t datasize);
+HARBOL_EXPORT NO_NULL bool harbol_ring_deque_pop_back(struct HarbolRingDeque *ring, void *val, size_t datasize);
+
+HARBOL_EXPORT NO_NULL void *harbol_ring_deque_get_front(struct HarbolRingDeque const *ring, size_t datasize);
+HARBOL_EXPORT NO_NULL void *harbol_ring_deque_get_back(struct HarbolRingDeque const *ring, size_t datasize);
+/// 'index' counts from the front.
+HARBOL_EXPORT NO_NULL void *harbol_ring_deque_get(struct HarbolRingDeque const *ring, size_t index, size_t datasize);
+/********************************************************************/
+
+
+#ifndef HARBOL_CACHE_LINE_SIZE
+#	define HARBOL_CACHE_LINE_SIZE    64
+#endif
+
+/** bounded lock-free queues, capacity is fixed at init and rounded up to a power of 2.
+ * append fails when full and pop_front fails when empty; the '_n' variants move
+ * as many elements as possible and return how many they moved.
+ */
+
+/// single producer, single consumer.
+struct HarbolSPSCQueue {
+	uint8_t *table;
+	size_t   cap;
+	uint8_t  pad0[HARBOL_CACHE_LINE_SIZE - sizeof(uint8_t*) - sizeof(size_t)];
+	size_t   head, cached_tail; /// consumer side.
+	uint8_t  pad1[HARBOL_CACHE_LINE_SIZE - 2 * sizeof(size_t)];
+	size_t   tail, cached_head; /// producer side.
+	uint8_t  pad2[HARBOL_CACHE_LINE_SIZE - 2 * sizeof(size_t)];
+};
+
+HARBOL_EXPORT NO_NULL bool harbol_spsc_queue_init(struct HarbolSPSCQueue *queue, size_t datasize, size_t cap);
+HARBOL_EXPORT NO_NULL void harbol_spsc_queue_clear(struct HarbolSPSCQueue *queue);
+HARBOL_EXPORT NO_NULL size_t harbol_spsc_queue_count(struct HarbolSPSCQueue *queue);
+
+HARBOL_EXPORT NO_NULL bool harbol_spsc_queue_append(struct HarbolSPSCQueue *queue, void const *val, size_t datasize);
+HARBOL_EXPORT NO_NULL bool harbol_spsc_queue_pop_front(struct HarbolSPSCQueue *queue, void *val, size_t datasize);
+HARBOL_EXPORT NO_NULL size_t harbol_spsc_queue_append_n(struct HarbolSPSCQueue *queue, void const *vals, size_t count, size_t datasize);
+HARBOL_EXPORT NO_NULL size_t harbol_spsc_queue_pop_front_n(struct HarbolSPSCQueue *queue, void *vals, size_t count, size_t datasize);
+
+
+/// multi producer, multi consumer; each cell carries a sequence number.
+struct HarbolMPMCQueue {
+	uint8_t *table;
+	size_t   cap, stride;
+	uint8_t  pad0[HARBOL_CACHE_LINE_SIZE - sizeof(uint8_t*) - 2 * sizeof(size_t)];
+	size_t   enqueue_pos;
+	uint8_t  pad1[HARBOL_CACHE_LINE_SIZE - sizeof(size_t)];
+	size_t   dequeue_pos;
+	uint8_t  pad2[HARBOL_CACHE_LINE_SIZE - sizeof(size_t)];
+};
+
+HARBOL_EXPORT NO_NULL bool harbol_mpmc_queue_init(struct HarbolMPMCQueue *queue, size_t datasize, size_t cap);
+HARBOL_EXPORT NO_NULL void harbol_mpmc_queue_clear(struct HarbolMPMCQueue *queue);
+
+HARBOL_EXPORT NO_NULL bool harbol_mpmc_queue_append(struct HarbolMPMCQueue *queue, void const *val, size_t datasize);
+HARBOL_EXPORT NO_NULL bool harbol_mpmc_queue_pop_front(struct HarbolMPMCQueue *queue, void *val, size_t datasize);
+HARBOL_EXPORT NO_NULL size_t harbol_mpmc_queue_append_n(struct HarbolMPMCQueue *queue, void const *vals, size_t count, size_t datasize);
+HARBOL_EXPORT NO_NULL size_t harbol_mpmc_queue_pop_front_n(struct HarbolMPMCQueue *queue, void *vals, size_t count, size_t datasize);
 /********************************************************************/
 
 
@@ -1,9 +1,14 @@
+#define _POSIX_C_SOURCE 200809L
 #include <assert.h>
 #include <stdalign.h>
 #include <time.h>
+#include <pthread.h>
+#include <sched.h>
 #include "deque.h"
 
 void test_harbol_deque(FILE *debug_stream);
+void test_harbol_ring_deque(FILE *debug_stream);
+void test_harbol_queues(FILE *debug_stream);
 
 #ifdef HARBOL_USE_MEMPOOL
 struct HarbolMemPool *g_pool;
@@ -23,6 +28,8 @@ int main(void) {
 	g_pool = &m;
 #endif
 	test_harbol_deque(debug_stream);
+	test_harbol_ring_deque(debug_stream);
+	test_harbol_queues(debug_stream);
 	
 	fclose(debug_stream); debug_stream=NULL;
 #ifdef HARBOL_USE_MEMPOOL
@@ -99,6 +106,36 @@ void test_harbol_deque(FILE *const debug_stream) {
 		fprintf(debug_stream, "index: %zu - value: %" PRIi64 "\n", n, val->int64);
 	}
 	
+	fputs("\ndeque :: test node handle ops.\n", debug_stream);
+	{
+		struct HarbolDeque d = harbol_deque_make(2, &( bool ){false});
+		size_t const a = harbol_deque_append(&d, &( union Value ){1}, sizeof(union Value));
+		size_t const c = harbol_deque_append(&d, &( union Value ){3}, sizeof(union Value));
+		size_t const b = harbol_deque_insert_after(&d, a, &( union Value ){2}, sizeof(union Value));
+		size_t const z = harbol_deque_insert_before(&d, a, &( union Value ){0}, sizeof(union Value));
+		assert( b != SIZE_MAX && z != SIZE_MAX && harbol_deque_count(&d)==4 );
+		assert( harbol_deque_head(&d)==z && harbol_deque_next(&d, a)==b && harbol_deque_next(&d, b)==c );
+		
+		/// LRU style touch: 'c' becomes the front.
+		assert( harbol_deque_move_to_front(&d, c) && harbol_deque_head(&d)==c && harbol_deque_tail(&d)==b );
+		assert( harbol_deque_move_to_back(&d, z) && harbol_deque_tail(&d)==z );
+		
+		union Value v = {0};
+		assert( harbol_deque_remove(&d, a, &v, sizeof v) && v.int64==1 );
+		assert( !harbol_deque_remove(&d, a, NULL, sizeof v) );
+		assert( harbol_deque_remove(&d, c, NULL, sizeof v) && harbol_deque_head(&d)==b );
+		assert( harbol_deque_count(&d)==2 && harbol_deque_prev(&d, z)==b );
+		
+		/// freed nodes get recycled.
+		size_t const e = harbol_deque_insert_after(&d, b, &( union Value ){5}, sizeof(union Value));
+		assert( e==a || e==c );
+		for( size_t n=harbol_deque_head(&d); n != SIZE_MAX; n = harbol_deque_next(&d, n) ) {
+			union Value const *const val = harbol_deque_get_data(&d, n);
+			fprintf(debug_stream, "index: %zu - value: %" PRIi64 "\n", n, val->int64);
+		}
+		harbol_deque_clear(&d);
+	}
+	
 	/// free deque
 	harbol_deque_clear(&i);
 	fprintf(debug_stream, "i's item is null? '%s'\n", i.datum != NULL? "no" : "yes");
@@ -108,3 +145,269 @@ void test_harbol_deque(FILE *const debug_stream) {
 	harbol_deque_free(&p);
 	fprintf(debug_stream, "p is null? '%s'\n\n", p != NULL? "no" : "yes");
 }
+
+void test_harbol_ring_deque(FILE *const debug_stream) {
+	fputs("ring deque :: test allocation/initialization.\n", debug_stream);
+	struct HarbolRingDeque r = harbol_ring_deque_make(sizeof(union Value), 3, &( bool ){false});
+	assert( r.table != NULL && r.cap==4 );
+	
+	fputs("\nring deque :: test wrapping and growth.\n", debug_stream);
+	/// push the head backwards so the contents wrap before growing.
+	for( int64_t n=0; n < 3; n++ ) {
+		assert( harbol_ring_deque_append(&r, &( union Value ){.int64=n}, sizeof(union Value)) );
+	}
+	assert( harbol_ring_deque_prepend(&r, &( union Value ){.int64=-1}, sizeof(union Value)) );
+	assert( harbol_ring_deque_prepend(&r, &( union Value ){.int64=-2}, sizeof(union Value)) );
+	assert( r.cap==8 && harbol_ring_deque_count(&r)==5 );
+	for( size_t n=0; n < harbol_ring_deque_count(&r); n++ ) {
+		union Value const *const val = harbol_ring_deque_get(&r, n, sizeof(union Value));
+		assert( val->int64==( int64_t )(n) - 2 );
+		fprintf(debug_stream, "ring[%zu] == %" PRIi64 "\n", n, val->int64);
+	}
+	assert( (( union Value const* )(harbol_ring_deque_get_front(&r, sizeof(union Value))))->int64==-2 );
+	assert( (( union Value const* )(harbol_ring_deque_get_back(&r, sizeof(union Value))))->int64==2 );
+	
+	fputs("\nring deque :: test popping values.\n", debug_stream);
+	union Value v = {0};
+	assert( harbol_ring_deque_pop_front(&r, &v, sizeof v) && v.int64==-2 );
+	assert( harbol_ring_deque_pop_back(&r, &v, sizeof v) && v.int64==2 );
+	assert( harbol_ring_deque_count(&r)==3 );
+	harbol_ring_deque_reset(&r);
+	assert( harbol_ring_deque_empty(&r) && !harbol_ring_deque_pop_back(&r, &v, sizeof v) );
+	
+	/// steady-state queue traffic vs the linked deque.
+	enum { QUEUE_OPS = 1 << 20, QUEUE_DEPTH = 64 };
+	clock_t start = clock();
+	{
+		struct HarbolDeque d = harbol_deque_make(QUEUE_DEPTH, &( bool ){false});
+		for( int64_t n=0; n < QUEUE_OPS; n++ ) {
+			harbol_deque_append(&d, &( union Value ){.int64=n}, sizeof(union Value));
+			if( harbol_deque_count(&d) >= QUEUE_DEPTH ) {
+				harbol_deque_pop_front(&d, &v, sizeof v);
+			}
+		}
+		harbol_deque_clear(&d);
+	}
+	clock_t end = clock();
+	printf("linked deque queue time: %f\n", (end-start)/(double)CLOCKS_PER_SEC);
+	
+	start = clock();
+	for( int64_t n=0; n < QUEUE_OPS; n++ ) {
+		harbol_ring_deque_append(&r, &( union Value ){.int64=n}, sizeof(union Value));
+		if( harbol_ring_deque_count(&r) >= QUEUE_DEPTH ) {
+			harbol_ring_deque_pop_front(&r, &v, sizeof v);
+		}
+	}
+	end = clock();
+	printf("ring deque queue time: %f\n", (end-start)/(double)CLOCKS_PER_SEC);
+	assert( v.int64==QUEUE_OPS - QUEUE_DEPTH );
+	
+	harbol_ring_deque_clear(&r);
+	fprintf(debug_stream, "r's table is null? '%s'\n", r.table != NULL? "no" : "yes");
+	
+	struct HarbolRingDeque *p = harbol_ring_deque_new(sizeof(union Value), 0);
+	assert( p != NULL );
+	harbol_ring_deque_free(&p);
+	fprintf(debug_stream, "p is null? '%s'\n", p != NULL? "no" : "yes");
+}
+
+
+enum { BENCH_ITEMS = 1 << 18, BENCH_BATCH = 32 };
+
+static double wall_seconds(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+struct QueueBench {
+	struct HarbolSPSCQueue *spsc;
+	struct HarbolMPMCQueue *mpmc;
+	struct HarbolDeque     *locked;
+	pthread_mutex_t        *lock;
+	size_t                  items;
+	uint64_t                sum;
+};
+
+static void *spsc_producer(void *const arg) {
+	struct QueueBench *const b = arg;
+	uint64_t batch[BENCH_BATCH];
+	for( size_t n=0; n < b->items; ) {
+		size_t const amount = (b->items - n < BENCH_BATCH)? b->items - n : BENCH_BATCH;
+		for( size_t k=0; k < amount; k++ ) {
+			batch[k] = n + k;
+		}
+		size_t pushed = 0;
+		while( pushed < amount ) {
+			size_t const moved = harbol_spsc_queue_append_n(b->spsc, &batch[pushed], amount - pushed, sizeof batch[0]);
+			if( moved==0 ) {
+				sched_yield();
+			}
+			pushed += moved;
+		}
+		n += amount;
+	}
+	return NULL;
+}
+
+static void *spsc_consumer(void *const arg) {
+	struct QueueBench *const b = arg;
+	uint64_t batch[BENCH_BATCH];
+	for( size_t n=0; n < b->items; ) {
+		size_t const got = harbol_spsc_queue_pop_front_n(b->spsc, batch, BENCH_BATCH, sizeof batch[0]);
+		if( got==0 ) {
+			sched_yield();
+		}
+		for( size_t k=0; k < got; k++ ) {
+			b->sum += batch[k];
+		}
+		n += got;
+	}
+	return NULL;
+}
+
+static void *mpmc_producer(void *const arg) {
+	struct QueueBench *const b = arg;
+	for( uint64_t n=0; n < b->items; n++ ) {
+		while( !harbol_mpmc_queue_append(b->mpmc, &n, sizeof n) ) {
+			sched_yield();
+		}
+	}
+	return NULL;
+}
+
+static void *mpmc_consumer(void *const arg) {
+	struct QueueBench *const b = arg;
+	for( size_t n=0; n < b->items; n++ ) {
+		uint64_t v;
+		while( !harbol_mpmc_queue_pop_front(b->mpmc, &v, sizeof v) ) {
+			sched_yield();
+		}
+		b->sum += v;
+	}
+	return NULL;
+}
+
+static void *locked_producer(void *const arg) {
+	struct QueueBench *const b = arg;
+	for( uint64_t n=0; n < b->items; n++ ) {
+		pthread_mutex_lock(b->lock);
+		harbol_deque_append(b->locked, &n, sizeof n);
+		pthread_mutex_unlock(b->lock);
+	}
+	return NULL;
+}
+
+static void *locked_consumer(void *const arg) {
+	struct QueueBench *const b = arg;
+	for( size_t n=0; n < b->items; ) {
+		uint64_t v;
+		pthread_mutex_lock(b->lock);
+		bool const got = harbol_deque_pop_front(b->locked, &v, sizeof v);
+		pthread_mutex_unlock(b->lock);
+		if( got ) {
+			b->sum += v;
+			n++;
+		} else {
+			sched_yield();
+		}
+	}
+	return NULL;
+}
+
+/// half the threads produce and half consume, every producer pushes 0..items-1.
+static double run_bench(size_t const threads, void *(*const producer)(void*), void *(*const consumer)(void*), struct QueueBench const base) {
+	size_t const pairs = threads / 2;
+	size_t const items = BENCH_ITEMS / pairs;
+	pthread_t ids[16];
+	struct QueueBench benches[16];
+	double const start = wall_seconds();
+	for( size_t i=0; i < pairs * 2; i++ ) {
+		benches[i] = base;
+		benches[i].items = items;
+		benches[i].sum = 0;
+		assert( pthread_create(&ids[i], NULL, (i & 1)? consumer : producer, &benches[i])==0 );
+	}
+	uint64_t sum = 0;
+	for( size_t i=0; i < pairs * 2; i++ ) {
+		pthread_join(ids[i], NULL);
+		sum += benches[i].sum;
+	}
+	double const elapsed = wall_seconds() - start;
+	assert( sum==( uint64_t )(pairs) * (( uint64_t )(items) * (items - 1) / 2) );
+	return elapsed;
+}
+
+void test_harbol_queues(FILE *const debug_stream) {
+	fputs("\nqueues :: test spsc queue.\n", debug_stream);
+	struct HarbolSPSCQueue spsc;
+	assert( harbol_spsc_queue_init(&spsc, sizeof(uint64_t), 5) && spsc.cap==8 );
+	for( uint64_t n=0; n < 8; n++ ) {
+		assert( harbol_spsc_queue_append(&spsc, &n, sizeof n) );
+	}
+	assert( !harbol_spsc_queue_append(&spsc, &( uint64_t ){8}, sizeof(uint64_t)) );
+	uint64_t out[8] = {0};
+	assert( harbol_spsc_queue_pop_front_n(&spsc, out, 3, sizeof out[0])==3 && out[2]==2 );
+	/// wraps around the end of the table.
+	uint64_t const more[] = { 8, 9, 10, 11 };
+	assert( harbol_spsc_queue_append_n(&spsc, more, 4, sizeof more[0])==3 );
+	assert( harbol_spsc_queue_count(&spsc)==8 );
+	assert( harbol_spsc_queue_pop_front_n(&spsc, out, 8, sizeof out[0])==8 && out[0]==3 && out[7]==10 );
+	assert( !harbol_spsc_queue_pop_front(&spsc, out, sizeof out[0]) );
+	
+	fputs("\nqueues :: test mpmc queue.\n", debug_stream);
+	struct HarbolMPMCQueue mpmc;
+	assert( harbol_mpmc_queue_init(&mpmc, sizeof(uint64_t), 4) );
+	assert( harbol_mpmc_queue_append_n(&mpmc, more, 4, sizeof more[0])==4 );
+	assert( !harbol_mpmc_queue_append(&mpmc, &( uint64_t ){0}, sizeof(uint64_t)) );
+	assert( harbol_mpmc_queue_pop_front_n(&mpmc, out, 8, sizeof out[0])==4 && out[0]==8 && out[3]==11 );
+	assert( !harbol_mpmc_queue_pop_front(&mpmc, out, sizeof out[0]) );
+	for( uint64_t n=0; n < 4; n++ ) {
+		fprintf(debug_stream, "mpmc popped: %" PRIu64 "\n", out[n]);
+	}
+	harbol_mpmc_queue_clear(&mpmc);
+	harbol_spsc_queue_clear(&spsc);
+	
+	/// throughput: lock-free queues vs a mutex guarded HarbolDeque.
+	assert( harbol_spsc_queue_init(&spsc, sizeof(uint64_t), 1024) );
+	printf("spsc queue 2 threads: %f secs\n", run_bench(2, spsc_producer, spsc_consumer, ( struct QueueBench ){ .spsc = &spsc }));
+	harbol_spsc_queue_clear(&spsc);
+	
+	pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+	{
+		/// single thread, push/pop back to back.
+		assert( harbol_mpmc_queue_init(&mpmc, sizeof(uint64_t), 1024) );
+		struct HarbolDeque locked = harbol_deque_make(1024, &( bool ){false});
+		uint64_t v = 0;
+		double start = wall_seconds();
+		for( uint64_t n=0; n < BENCH_ITEMS; n++ ) {
+			harbol_mpmc_queue_append(&mpmc, &n, sizeof n);
+			harbol_mpmc_queue_pop_front(&mpmc, &v, sizeof v);
+		}
+		double const mpmc_time = wall_seconds() - start;
+		start = wall_seconds();
+		for( uint64_t n=0; n < BENCH_ITEMS; n++ ) {
+			pthread_mutex_lock(&lock);
+			harbol_deque_append(&locked, &n, sizeof n);
+			pthread_mutex_unlock(&lock);
+			pthread_mutex_lock(&lock);
+			harbol_deque_pop_front(&locked, &v, sizeof v);
+			pthread_mutex_unlock(&lock);
+		}
+		double const locked_time = wall_seconds() - start;
+		printf("%2d threads: mpmc queue %f secs | mutex deque %f secs\n", 1, mpmc_time, locked_time);
+		harbol_deque_clear(&locked);
+		harbol_mpmc_queue_clear(&mpmc);
+	}
+	for( size_t threads=2; threads <= 16; threads <<= 1 ) {
+		assert( harbol_mpmc_queue_init(&mpmc, sizeof(uint64_t), 1024) );
+		double const mpmc_time = run_bench(threads, mpmc_producer, mpmc_consumer, ( struct QueueBench ){ .mpmc = &mpmc });
+		harbol_mpmc_queue_clear(&mpmc);
+		
+		struct HarbolDeque locked = harbol_deque_make(1024, &( bool ){false});
+		double const locked_time = run_bench(threads, locked_producer, locked_consumer, ( struct QueueBench ){ .locked = &locked, .lock = &lock });
+		harbol_deque_clear(&locked);
+		printf("%2zu threads: mpmc queue %f secs | mutex deque %f secs\n", threads, mpmc_time, locked_time);
+	}
+	pthread_mutex_destroy(&lock);
+}
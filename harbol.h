@@ -75,6 +75,15 @@ extern "C" {
 /// Mersenne Twister
 #include "math/math_parser.h"
 
+/// Worker Thread Pool
+#include "threadpool/threadpool.h"
+
+/// Sorting, Searching & Parallel Array Algorithms
+#include "algo/algo.h"
+
+/// Bounded LRU/CLOCK/TinyLFU Cache
+#include "cache/cache.h"
+
 #ifdef __cplusplus
 }
 #endif
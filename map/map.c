@@ -20,7 +20,18 @@ HARBOL_EXPORT struct HarbolMap harbol_map_make(size_t const init_size, bool *con
 	return map;
 }
 
-HARBOL_EXPORT bool harbol_map_init(struct HarbolMap *const map, size_t const init_size) {
+/// capacity is kept a power of two so 'hash & mask' picks the home bucket.
+static inline size_t _harbol_map_round_cap(size_t const size) {
+	return( size <= 4 )? 4 : bitwise_ceil(size - 1) + 1;
+}
+
+/// the table grows before it passes 3/4 full so every probe run ends at an empty bucket.
+static inline NO_NULL bool _harbol_map_needs_grow(struct HarbolMap const *const map) {
+	return (map->len + 1) > (map->cap >> 2) * 3;
+}
+
+HARBOL_EXPORT bool harbol_map_init(struct HarbolMap *const map, size_t const size) {
+	size_t const init_size = _harbol_map_round_cap(size);
 	if( !harbol_multi_calloc(init_size, 6,
 						&map->keys,     sizeof *map->keys,
 						&map->keylens,  sizeof *map->keylens,
@@ -62,32 +73,39 @@ HARBOL_EXPORT void harbol_map_free(struct HarbolMap **const map_ref) {
 }
 
 
-HARBOL_EXPORT size_t harbol_map_get_entry_index(struct HarbolMap const *const map, void const *const key, size_t const keylen) {
-	uint8_t const *const restrict desired_key = key;
-	size_t const hash    = array_hash(desired_key, keylen, map->seed);
-	size_t const mask    = map->cap - 1;
-	size_t const bkt_idx = hash & mask;
-	size_t const val_idx = map->buckets[bkt_idx];
-	if( val_idx==SIZE_MAX ) {
+static size_t _harbol_map_probe(struct HarbolMap const *const map, uint8_t const *const restrict desired_key, size_t const keylen, size_t const hash) {
+	if( map->buckets==NULL ) {
 		return SIZE_MAX;
-	} else if( map->keys[val_idx][0]==desired_key[0] && map->keylens[val_idx]==keylen && !memcmp(map->keys[val_idx], desired_key, keylen) ) {
-		return val_idx;
 	}
-	
-	for( size_t i = bkt_idx+1; i != bkt_idx; (i = (i+1 >= mask)? ((i+1) & mask) : i+1) ) {
-		/// sometimes the `bkt_idx` is at the mask index. Account for that.
-		if( i > mask ) {
-			continue;
-		}
-		
+	size_t const mask = map->cap - 1;
+	for( size_t i = hash & mask;; i = (i + 1) & mask ) {
 		size_t const idx = map->buckets[i];
 		if( idx==SIZE_MAX ) {
-			continue;
-		} else if( map->keys[idx][0]==desired_key[0] && map->keylens[idx]==keylen && !memcmp(desired_key, map->keys[idx], keylen) ) {
+			return SIZE_MAX;
+		} else if( map->hashes[idx]==hash && map->keylens[idx]==keylen && !memcmp(desired_key, map->keys[idx], keylen) ) {
 			return idx;
 		}
 	}
-	return SIZE_MAX;
+}
+
+HARBOL_EXPORT size_t harbol_map_get_entry_index(struct HarbolMap const *const map, void const *const key, size_t const keylen) {
+	return _harbol_map_probe(map, key, keylen, array_hash(key, keylen, map->seed));
+}
+
+/// 'array_hash' folds each byte in as 'h = b + h * 65599' starting from the seed,
+/// so the seeded hash is the unseeded one plus 'seed * 65599^len'.
+HARBOL_EXPORT struct HarbolMapKeyHash harbol_map_key_hash(void const *const key, size_t const keylen) {
+	struct HarbolMapKeyHash keyhash = { 0, 1 };
+	uint8_t const *const restrict bytes = key;
+	for( size_t i=0; i < keylen; i++ ) {
+		keyhash.base   = ( size_t )(bytes[i]) + keyhash.base * 65599;
+		keyhash.scale *= 65599;
+	}
+	return keyhash;
+}
+
+HARBOL_EXPORT size_t harbol_map_get_entry_index_hashed(struct HarbolMap const *const map, void const *const key, size_t const keylen, struct HarbolMapKeyHash const keyhash) {
+	return _harbol_map_probe(map, key, keylen, keyhash.base + map->seed * keyhash.scale);
 }
 
 HARBOL_EXPORT bool harbol_map_has_key(struct HarbolMap const *const map, void const *const desired_key, size_t const keylen) {
@@ -102,17 +120,44 @@ static bool _harbol_map_insert_entry(struct HarbolMap *const map, size_t const n
 	size_t const mask    = map->cap - 1;
 	size_t       bkt_idx = map->hashes[n] & mask;
 	while( map->buckets[bkt_idx] != SIZE_MAX ) {
-		bkt_idx++;
-		if( bkt_idx >= mask ) {
-			bkt_idx &= mask;
-		}
+		bkt_idx = (bkt_idx + 1) & mask;
 	}
 	map->buckets[bkt_idx] = n;
 	return true;
 }
 
-HARBOL_EXPORT bool harbol_map_rehash(struct HarbolMap *const map, size_t const new_size) {
-	if( !harbol_multi_recalloc(new_size, map->cap, 6,
+/// finds the bucket that holds entry 'n'.
+static size_t _harbol_map_bucket_of(struct HarbolMap const *const map, size_t const n) {
+	size_t const mask = map->cap - 1;
+	for( size_t i = map->hashes[n] & mask;; i = (i + 1) & mask ) {
+		if( map->buckets[i]==n ) {
+			return i;
+		} else if( map->buckets[i]==SIZE_MAX ) {
+			return SIZE_MAX;
+		}
+	}
+}
+
+/// backward-shift deletion: later members of the probe run slide into the hole
+/// so a lookup can still stop at the first empty bucket.
+static void _harbol_map_unlink_bucket(struct HarbolMap *const map, size_t const bkt_idx) {
+	size_t const mask = map->cap - 1;
+	size_t       hole = bkt_idx;
+	for( size_t i = (bkt_idx + 1) & mask; map->buckets[i] != SIZE_MAX; i = (i + 1) & mask ) {
+		size_t const home = map->hashes[map->buckets[i]] & mask;
+		if( ((i - home) & mask) >= ((i - hole) & mask) ) {
+			map->buckets[hole] = map->buckets[i];
+			hole = i;
+		}
+	}
+	map->buckets[hole] = SIZE_MAX;
+}
+
+HARBOL_EXPORT bool harbol_map_rehash(struct HarbolMap *const map, size_t const size) {
+	size_t const new_size = _harbol_map_round_cap(size);
+	if( new_size <= map->len ) {
+		return false;
+	} else if( !harbol_multi_recalloc(new_size, map->cap, 6,
 						&map->keys,     sizeof *map->keys,
 						&map->keylens,  sizeof *map->keylens,
 						&map->datum,    sizeof *map->datum,
@@ -126,16 +171,14 @@ HARBOL_EXPORT bool harbol_map_rehash(struct HarbolMap *const map, size_t const n
 	for( size_t i=0; i < map->cap; i++ ) {
 		map->buckets[i] = SIZE_MAX;
 	}
-	
-	bool res = false;
 	for( size_t i=0; i < map->len; i++ ) {
-		res |= _harbol_map_insert_entry(map, i);
+		_harbol_map_insert_entry(map, i);
 	}
-	return res;
+	return true;
 }
 
 HARBOL_EXPORT bool harbol_map_insert(struct HarbolMap *const restrict map, void const *const key, size_t const keylen, void const *const val, size_t const datasize) {
-	if( harbol_map_has_key(map, key, keylen) || (map->len >= map->cap && !harbol_map_rehash(map, map->cap << 1)) ) {
+	if( harbol_map_has_key(map, key, keylen) || (_harbol_map_needs_grow(map) && !harbol_map_rehash(map, map->cap << 1)) ) {
 		return false;
 	}
 	
@@ -200,12 +243,8 @@ HARBOL_EXPORT void *harbol_map_idx_get(struct HarbolMap const *const map, size_t
 
 
 HARBOL_EXPORT bool harbol_map_key_set(struct HarbolMap *const restrict map, void const *const key, size_t const keylen, void const *const val, size_t const datasize) {
-	if( !harbol_map_has_key(map, key, keylen) ) {
-		return harbol_map_insert(map, key, keylen, val, datasize);
-	}
-	
 	size_t const entry = harbol_map_get_entry_index(map, key, keylen);
-	return harbol_map_idx_set(map, entry, val, datasize);
+	return( entry==SIZE_MAX )? harbol_map_insert(map, key, keylen, val, datasize) : harbol_map_idx_set(map, entry, val, datasize);
 }
 
 HARBOL_EXPORT bool harbol_map_idx_set(struct HarbolMap *const restrict map, size_t const index, void const *const val, size_t const datasize) {
@@ -218,7 +257,8 @@ HARBOL_EXPORT bool harbol_map_idx_set(struct HarbolMap *const restrict map, size
 		return false;
 	}
 	free(map->datum[index]);
-	map->datum[index] = data;
+	map->datum[index]    = data;
+	map->datalens[index] = datasize;
 	return true;
 }
 
@@ -232,18 +272,26 @@ HARBOL_EXPORT bool harbol_map_idx_rm(struct HarbolMap *const map, size_t const n
 		return false;
 	}
 	
-	size_t const mask    = map->cap - 1;
-	size_t const bkt_idx = map->hashes[n] & mask;
-	size_t const val_idx = map->buckets[bkt_idx];
-	if( val_idx==SIZE_MAX ) {
+	size_t const bkt_idx = _harbol_map_bucket_of(map, n);
+	if( bkt_idx==SIZE_MAX ) {
 		return false;
 	}
+	_harbol_map_unlink_bucket(map, bkt_idx);
 	
 	free(map->keys[n]);  map->keys[n]  = NULL;
 	free(map->datum[n]); map->datum[n] = NULL;
 	map->hashes[n] = map->keylens[n] = map->datalens[n] = 0;
-	map->buckets[bkt_idx] = SIZE_MAX;
 	
+	/// entries past 'n' slide down one slot to keep insertion order.
+	for( size_t i=0; i < map->cap; i++ ) {
+		if( map->buckets[i] != SIZE_MAX && map->buckets[i] > n ) {
+			map->buckets[i]--;
+		}
+	}
+	if( n + 1==map->len ) {
+		map->len--;
+		return true;
+	}
 	return multi_array_shift_up(&map->len, n, 1, 5,
 			map->keys,     sizeof *map->keys,
 			map->datum,    sizeof *map->datum,
@@ -251,4 +299,32 @@ HARBOL_EXPORT bool harbol_map_idx_rm(struct HarbolMap *const map, size_t const n
 			map->keylens,  sizeof *map->keylens,
 			map->datalens, sizeof *map->datalens
 	);
-}
\ No newline at end of file
+}
+
+HARBOL_EXPORT bool harbol_map_idx_swap_rm(struct HarbolMap *const map, size_t const n) {
+	if( n >= map->len ) {
+		return false;
+	}
+	
+	size_t const bkt_idx = _harbol_map_bucket_of(map, n);
+	if( bkt_idx==SIZE_MAX ) {
+		return false;
+	}
+	_harbol_map_unlink_bucket(map, bkt_idx);
+	free(map->keys[n]);
+	free(map->datum[n]);
+	
+	size_t const last = map->len - 1;
+	if( n != last ) {
+		map->buckets[_harbol_map_bucket_of(map, last)] = n;
+		map->keys[n]     = map->keys[last];
+		map->datum[n]    = map->datum[last];
+		map->hashes[n]   = map->hashes[last];
+		map->keylens[n]  = map->keylens[last];
+		map->datalens[n] = map->datalens[last];
+	}
+	map->keys[last]   = map->datum[last]    = NULL;
+	map->hashes[last] = map->keylens[last] = map->datalens[last] = 0;
+	map->len--;
+	return true;
+}
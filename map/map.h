@@ -15,6 +15,12 @@ struct HarbolMap {
 	size_t   *buckets, *hashes, *keylens, *datalens, cap, len, seed;
 };
 
+/// a key's hash with the map seed factored out.
+/// computed once, it can be used to look the key up in any map.
+struct HarbolMapKeyHash {
+	size_t base, scale;
+};
+
 
 HARBOL_EXPORT struct HarbolMap *harbol_map_new(size_t init_size);
 HARBOL_EXPORT NO_NULL struct HarbolMap harbol_map_make(size_t init_size, bool *res);
@@ -31,6 +37,9 @@ HARBOL_EXPORT NO_NULL bool harbol_map_insert(struct HarbolMap *map, void const *
 
 HARBOL_EXPORT NO_NULL size_t harbol_map_get_entry_index(struct HarbolMap const *map, void const *key, size_t keylen);
 
+HARBOL_EXPORT NO_NULL struct HarbolMapKeyHash harbol_map_key_hash(void const *key, size_t keylen);
+HARBOL_EXPORT NO_NULL size_t harbol_map_get_entry_index_hashed(struct HarbolMap const *map, void const *key, size_t keylen, struct HarbolMapKeyHash keyhash);
+
 HARBOL_EXPORT NO_NULL void *harbol_map_key_val(struct HarbolMap const *map, void const *val, size_t datasize, size_t *keylen);
 HARBOL_EXPORT NO_NULL size_t harbol_map_idx_val(struct HarbolMap const *map, void const *val, size_t datasize);
 
@@ -41,7 +50,10 @@ HARBOL_EXPORT NO_NULL bool harbol_map_key_set(struct HarbolMap *map, void const
 HARBOL_EXPORT NO_NULL bool harbol_map_idx_set(struct HarbolMap *map, size_t index, void const *val, size_t datasize);
 
 HARBOL_EXPORT NO_NULL bool harbol_map_key_rm(struct HarbolMap *map, void const *key, size_t keylen);
+/// keeps insertion order, O(n).
 HARBOL_EXPORT NO_NULL bool harbol_map_idx_rm(struct HarbolMap *map, size_t index);
+/// O(1), the last entry is moved into 'index'.
+HARBOL_EXPORT NO_NULL bool harbol_map_idx_swap_rm(struct HarbolMap *map, size_t index);
 /********************************************************************/
 
 #ifdef __cplusplus
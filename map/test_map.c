@@ -142,6 +142,56 @@ void test_harbol_map(FILE *const debug_stream) {
 	for( size_t n=0; n<p->len; n++ ) {
 		fprintf(debug_stream, "p: key '%s' - value == %" PRIi64 "\n", p->keys[n], (( union Value const* )p->datum[n])->int64);
 	}
+	/// removal must not strand entries further down a probe run.
+	fputs("\nmap :: test removal integrity.\n", debug_stream);
+	{
+		struct HarbolMap stress = harbol_map_make(4, &( bool ){false});
+		for( int64_t n=0; n < 2000; n++ ) {
+			assert( harbol_map_insert(&stress, &n, sizeof n, &n, sizeof n) );
+		}
+		for( int64_t n=0; n < 2000; n += 3 ) {
+			assert( harbol_map_key_rm(&stress, &n, sizeof n) );
+		}
+		for( size_t n=0; n < 300; n++ ) {
+			assert( harbol_map_idx_swap_rm(&stress, n * 2) );
+		}
+		for( int64_t n=0; n < 2000; n++ ) {
+			size_t const idx = harbol_map_get_entry_index(&stress, &n, sizeof n);
+			assert( idx==SIZE_MAX || *( int64_t const* )(stress.datum[idx])==n );
+		}
+		for( size_t n=0; n < stress.len; n++ ) {
+			assert( harbol_map_get_entry_index(&stress, stress.keys[n], stress.keylens[n])==n );
+		}
+		fprintf(debug_stream, "stress len: %zu | cap: %zu\n", stress.len, stress.cap);
+		harbol_map_clear(&stress);
+	}
+	
+	/// a precomputed key hash finds the same entry regardless of the map's seed.
+	fputs("\nmap :: test prehashed lookups.\n", debug_stream);
+	{
+		struct HarbolMap a = harbol_map_make(8, &( bool ){false});
+		struct HarbolMap b = harbol_map_make(8, &( bool ){false});
+		b.seed = a.seed * 31 + 7;
+		char const *const names[] = { "alpha", "beta", "gamma", "delta.epsilon", "" };
+		for( size_t n=0; n < 5; n++ ) {
+			size_t const len = strlen(names[n]) + 1;
+			assert( harbol_map_insert(&a, names[n], len, &n, sizeof n) );
+			assert( harbol_map_insert(&b, names[n], len, &n, sizeof n) );
+		}
+		for( size_t n=0; n < 5; n++ ) {
+			size_t const len = strlen(names[n]) + 1;
+			struct HarbolMapKeyHash const keyhash = harbol_map_key_hash(names[n], len);
+			assert( keyhash.base + a.seed * keyhash.scale==array_hash(( uint8_t const* )(names[n]), len, a.seed) );
+			assert( harbol_map_get_entry_index_hashed(&a, names[n], len, keyhash)==n );
+			assert( harbol_map_get_entry_index_hashed(&b, names[n], len, keyhash)==n );
+		}
+		struct HarbolMapKeyHash const missing = harbol_map_key_hash("zeta", sizeof "zeta");
+		assert( harbol_map_get_entry_index_hashed(&a, "zeta", sizeof "zeta", missing)==SIZE_MAX );
+		fprintf(debug_stream, "prehashed lookups matched over %zu keys\n", a.len);
+		harbol_map_clear(&a);
+		harbol_map_clear(&b);
+	}
+	
 	/// free data
 	fputs("\nmap :: test destruction.\n", debug_stream);
 	harbol_map_clear(&i);
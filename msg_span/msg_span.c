@@ -126,10 +126,6 @@ HARBOL_EXPORT bool harbol_msg_span_add_label(struct HarbolMsgSpan *const restric
 		.sym_color = sym_color,
 	};
 	
-	if( harbol_array_full(&msgspan->labels) && !harbol_array_grow(&msgspan->labels, sizeof label) ) {
-		return false;
-	}
-	
 	va_list ap; va_start(ap, msg);
 	if( msg_color != NULL ) {
 		harbol_string_add_cstr(&label.msg, msg_color);
@@ -148,10 +144,6 @@ HARBOL_EXPORT bool harbol_msg_span_add_label(struct HarbolMsgSpan *const restric
 
 HARBOL_EXPORT bool harbol_msg_span_add_note(struct HarbolMsgSpan *const restrict msgspan, char const msg_color[const restrict static 1], char const msg[const restrict static 1], ...) {
 	struct HarbolString note = {0};
-	if( harbol_array_full(&msgspan->notes) && !harbol_array_grow(&msgspan->notes, sizeof note) ) {
-		return false;
-	}
-	
 	va_list ap; va_start(ap, msg);
 	if( msg_color != NULL ) {
 		harbol_string_add_cstr(&note, msg_color);
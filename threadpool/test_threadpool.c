@@ -0,0 +1,118 @@
+#include <assert.h>
+#include <time.h>
+#include "threadpool.h"
+
+void test_harbol_threadpool(FILE *debug_stream);
+
+#ifdef HARBOL_USE_MEMPOOL
+struct HarbolMemPool *g_pool;
+#endif
+
+int main(void) {
+	FILE *debug_stream = fopen("harbol_threadpool_output.txt", "w");
+	if( debug_stream==NULL )
+		return -1;
+	
+#ifdef HARBOL_USE_MEMPOOL
+	struct HarbolMemPool m = harbol_mempool_create(1000000);
+	g_pool = &m;
+#endif
+	test_harbol_threadpool(debug_stream);
+	
+	fclose(debug_stream); debug_stream=NULL;
+#ifdef HARBOL_USE_MEMPOOL
+	harbol_mempool_clear(g_pool);
+#endif
+}
+
+struct SumTask {
+	uint64_t const *data;
+	size_t          len;
+	uint64_t        result;
+};
+
+static void sum_task(void *const arg) {
+	struct SumTask *const task = arg;
+	uint64_t sum = 0;
+	for( size_t i=0; i < task->len; i++ ) {
+		sum += task->data[i];
+	}
+	task->result = sum;
+}
+
+/// splits its sum into tasks on the pool it runs on and waits for just those.
+struct NestedTask {
+	struct HarbolThreadPool *pool;
+	struct SumTask           parts[4];
+	uint64_t                 result;
+};
+
+static void nested_task(void *const arg) {
+	struct NestedTask *const task = arg;
+	struct HarbolTaskGroup group = {0};
+	for( size_t i=0; i < 4; i++ ) {
+		assert( harbol_threadpool_submit_group(task->pool, &group, sum_task, &task->parts[i]) );
+	}
+	harbol_threadpool_wait_group(task->pool, &group);
+	task->result = 0;
+	for( size_t i=0; i < 4; i++ ) {
+		task->result += task->parts[i].result;
+	}
+}
+
+void test_harbol_threadpool(FILE *const debug_stream) {
+	fputs("threadpool :: test allocation/initialization.\n", debug_stream);
+	struct HarbolThreadPool *pool = harbol_threadpool_new(0);
+	assert( pool != NULL && harbol_threadpool_size(pool) > 0 );
+	fprintf(debug_stream, "cpu count: %zu | workers: %zu\n", harbol_cpu_count(), harbol_threadpool_size(pool));
+	
+	fputs("\nthreadpool :: test task submission.\n", debug_stream);
+	enum { DATA_LEN = 1 << 16, TASKS = 64 };
+	uint64_t *const data = calloc(DATA_LEN, sizeof *data);
+	assert( data != NULL );
+	uint64_t expected = 0;
+	for( size_t i=0; i < DATA_LEN; i++ ) {
+		data[i] = i;
+		expected += i;
+	}
+	
+	/// queue more tasks than the initial ring holds to exercise growth.
+	struct SumTask tasks[TASKS];
+	size_t const step = DATA_LEN / TASKS;
+	for( size_t i=0; i < TASKS; i++ ) {
+		tasks[i] = ( struct SumTask ){ .data = &data[i * step], .len = step };
+		assert( harbol_threadpool_submit(pool, sum_task, &tasks[i]) );
+	}
+	harbol_threadpool_wait(pool);
+	uint64_t total = 0;
+	for( size_t i=0; i < TASKS; i++ ) {
+		total += tasks[i].result;
+	}
+	assert( total==expected );
+	fprintf(debug_stream, "sum of %u values: %" PRIu64 "\n", DATA_LEN, total);
+	
+	fputs("\nthreadpool :: test single worker.\n", debug_stream);
+	struct HarbolThreadPool single = {0};
+	assert( harbol_threadpool_init(&single, 1) && harbol_threadpool_size(&single)==1 );
+	
+	/// the only worker waits on tasks queued behind it.
+	struct NestedTask nested = { .pool = &single };
+	for( size_t i=0; i < 4; i++ ) {
+		nested.parts[i] = ( struct SumTask ){ .data = &data[i * (DATA_LEN / 4)], .len = DATA_LEN / 4 };
+	}
+	struct HarbolTaskGroup outer = {0};
+	assert( harbol_threadpool_submit_group(&single, &outer, nested_task, &nested) );
+	harbol_threadpool_wait_group(&single, &outer);
+	assert( outer.pending==0 && nested.result==expected );
+	
+	struct SumTask whole = { .data = data, .len = DATA_LEN };
+	assert( harbol_threadpool_submit(&single, sum_task, &whole) );
+	/// clearing drains queued work before joining.
+	harbol_threadpool_clear(&single);
+	assert( whole.result==expected );
+	
+	free(data);
+	fputs("\nthreadpool :: test destruction.\n", debug_stream);
+	harbol_threadpool_free(&pool);
+	fprintf(debug_stream, "pool is null? '%s'\n", pool != NULL? "no" : "yes");
+}
@@ -0,0 +1,270 @@
+#include "threadpool.h"
+
+#ifdef OS_WINDOWS
+#	define HARBOL_LIB
+#	define HARBOL_LOCK(pool)              EnterCriticalSection(&(pool)->lock)
+#	define HARBOL_UNLOCK(pool)            LeaveCriticalSection(&(pool)->lock)
+#	define HARBOL_COND_WAIT(cond, pool)   SleepConditionVariableCS(&(cond), &(pool)->lock, INFINITE)
+#	define HARBOL_COND_SIGNAL(cond)       WakeConditionVariable(&(cond))
+#	define HARBOL_COND_BROADCAST(cond)    WakeAllConditionVariable(&(cond))
+#else
+#	include <unistd.h>
+#	define HARBOL_LOCK(pool)              pthread_mutex_lock(&(pool)->lock)
+#	define HARBOL_UNLOCK(pool)            pthread_mutex_unlock(&(pool)->lock)
+#	define HARBOL_COND_WAIT(cond, pool)   pthread_cond_wait(&(cond), &(pool)->lock)
+#	define HARBOL_COND_SIGNAL(cond)       pthread_cond_signal(&(cond))
+#	define HARBOL_COND_BROADCAST(cond)    pthread_cond_broadcast(&(cond))
+#endif
+
+
+HARBOL_EXPORT size_t harbol_cpu_count(void) {
+#ifdef OS_WINDOWS
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return( info.dwNumberOfProcessors > 0 )? ( size_t )(info.dwNumberOfProcessors) : 1;
+#elif defined(_SC_NPROCESSORS_ONLN)
+	long const n = sysconf(_SC_NPROCESSORS_ONLN);
+	return( n > 0 )? ( size_t )(n) : 1;
+#else
+	return 1;
+#endif
+}
+
+
+static NO_NULL bool _harbol_threadpool_pop(struct HarbolThreadPool *const pool, struct HarbolTask *const task) {
+	if( pool->count==0 ) {
+		return false;
+	}
+	*task = pool->tasks[pool->head];
+	pool->head = (pool->head + 1) % pool->cap;
+	pool->count--;
+	return true;
+}
+
+static NO_NULL bool _harbol_threadpool_push(struct HarbolThreadPool *const pool, struct HarbolTask const task) {
+	if( pool->count==pool->cap ) {
+		size_t const new_cap = (pool->cap==0)? 16 : pool->cap << 1;
+		struct HarbolTask *const new_tasks = calloc(new_cap, sizeof *new_tasks);
+		if( new_tasks==NULL ) {
+			return false;
+		}
+		/// unwrap the ring so the queue starts at zero again.
+		for( size_t i=0; i < pool->count; i++ ) {
+			new_tasks[i] = pool->tasks[(pool->head + i) % pool->cap];
+		}
+		free(pool->tasks);
+		pool->tasks = new_tasks;
+		pool->cap   = new_cap;
+		pool->head  = 0;
+	}
+	pool->tasks[(pool->head + pool->count) % pool->cap] = task;
+	pool->count++;
+	return true;
+}
+
+/// pulls the oldest queued task of 'group' out of the ring, the tasks behind it move up.
+static NO_NULL bool _harbol_threadpool_take(struct HarbolThreadPool *const pool, struct HarbolTaskGroup const *const group, struct HarbolTask *const task) {
+	for( size_t i=0; i < pool->count; i++ ) {
+		if( pool->tasks[(pool->head + i) % pool->cap].group != group ) {
+			continue;
+		}
+		*task = pool->tasks[(pool->head + i) % pool->cap];
+		for( size_t n=i + 1; n < pool->count; n++ ) {
+			pool->tasks[(pool->head + n - 1) % pool->cap] = pool->tasks[(pool->head + n) % pool->cap];
+		}
+		pool->count--;
+		return true;
+	}
+	return false;
+}
+
+/// runs a task taken off the queue, the lock is held on entry and on return.
+static NO_NULL void _harbol_threadpool_run(struct HarbolThreadPool *const pool, struct HarbolTask const task) {
+	pool->active++;
+	HARBOL_UNLOCK(pool);
+	
+	(*task.func)(task.arg);
+	
+	HARBOL_LOCK(pool);
+	pool->active--;
+	bool const group_done = task.group != NULL && --task.group->pending==0;
+	if( group_done || (pool->active==0 && pool->count==0) ) {
+		HARBOL_COND_BROADCAST(pool->idle_cond);
+	}
+}
+
+#ifdef OS_WINDOWS
+static DWORD WINAPI _harbol_threadpool_worker(LPVOID const param)
+#else
+static void *_harbol_threadpool_worker(void *const param)
+#endif
+{
+	struct HarbolThreadPool *const pool = param;
+	HARBOL_LOCK(pool);
+	for(;;) {
+		struct HarbolTask task;
+		while( !pool->stop && pool->count==0 ) {
+			HARBOL_COND_WAIT(pool->work_cond, pool);
+		}
+		/// drain whatever was queued before a stop.
+		if( !_harbol_threadpool_pop(pool, &task) ) {
+			break;
+		}
+		_harbol_threadpool_run(pool, task);
+	}
+	HARBOL_UNLOCK(pool);
+#ifdef OS_WINDOWS
+	return 0;
+#else
+	return NULL;
+#endif
+}
+
+
+HARBOL_EXPORT struct HarbolThreadPool *harbol_threadpool_new(size_t const nthreads) {
+	struct HarbolThreadPool *pool = calloc(1, sizeof *pool);
+	if( pool != NULL && !harbol_threadpool_init(pool, nthreads) ) {
+		free(pool); pool = NULL;
+	}
+	return pool;
+}
+
+HARBOL_EXPORT bool harbol_threadpool_init(struct HarbolThreadPool *const pool, size_t const nthreads) {
+	*pool = ( struct HarbolThreadPool ){0};
+	size_t const wanted = (nthreads==0)? harbol_cpu_count() : nthreads;
+	pool->threads = calloc(wanted, sizeof *pool->threads);
+	if( pool->threads==NULL ) {
+		return false;
+	}
+	
+#ifdef OS_WINDOWS
+	InitializeCriticalSection(&pool->lock);
+	InitializeConditionVariable(&pool->work_cond);
+	InitializeConditionVariable(&pool->idle_cond);
+	for( size_t i=0; i < wanted; i++ ) {
+		pool->threads[i] = CreateThread(NULL, 0, _harbol_threadpool_worker, pool, 0, NULL);
+		if( pool->threads[i]==NULL ) {
+			break;
+		}
+		pool->nthreads++;
+	}
+#else
+	if( pthread_mutex_init(&pool->lock, NULL) != 0 ) {
+		free(pool->threads); pool->threads = NULL;
+		return false;
+	} else if( pthread_cond_init(&pool->work_cond, NULL) != 0 ) {
+		pthread_mutex_destroy(&pool->lock);
+		free(pool->threads); pool->threads = NULL;
+		return false;
+	} else if( pthread_cond_init(&pool->idle_cond, NULL) != 0 ) {
+		pthread_cond_destroy(&pool->work_cond);
+		pthread_mutex_destroy(&pool->lock);
+		free(pool->threads); pool->threads = NULL;
+		return false;
+	}
+	for( size_t i=0; i < wanted; i++ ) {
+		if( pthread_create(&pool->threads[i], NULL, _harbol_threadpool_worker, pool) != 0 ) {
+			break;
+		}
+		pool->nthreads++;
+	}
+#endif
+	return true;
+}
+
+HARBOL_EXPORT void harbol_threadpool_clear(struct HarbolThreadPool *const pool) {
+	if( pool->threads==NULL ) {
+		return;
+	}
+	HARBOL_LOCK(pool);
+	pool->stop = true;
+	HARBOL_COND_BROADCAST(pool->work_cond);
+	HARBOL_UNLOCK(pool);
+	
+#ifdef OS_WINDOWS
+	for( size_t i=0; i < pool->nthreads; i++ ) {
+		WaitForSingleObject(pool->threads[i], INFINITE);
+		CloseHandle(pool->threads[i]);
+	}
+	DeleteCriticalSection(&pool->lock);
+#else
+	for( size_t i=0; i < pool->nthreads; i++ ) {
+		pthread_join(pool->threads[i], NULL);
+	}
+	pthread_cond_destroy(&pool->idle_cond);
+	pthread_cond_destroy(&pool->work_cond);
+	pthread_mutex_destroy(&pool->lock);
+#endif
+	free(pool->threads);
+	free(pool->tasks);
+	*pool = ( struct HarbolThreadPool ){0};
+}
+
+HARBOL_EXPORT void harbol_threadpool_free(struct HarbolThreadPool **const poolref) {
+	if( *poolref==NULL ) {
+		return;
+	}
+	harbol_threadpool_clear(*poolref);
+	free(*poolref); *poolref = NULL;
+}
+
+HARBOL_EXPORT size_t harbol_threadpool_size(struct HarbolThreadPool const *const pool) {
+	return pool->nthreads;
+}
+
+HARBOL_EXPORT bool harbol_threadpool_submit(struct HarbolThreadPool *const pool, HarbolTaskFunc *const func, void *const arg) {
+	if( pool->nthreads==0 ) {
+		(*func)(arg);
+		return true;
+	}
+	HARBOL_LOCK(pool);
+	bool const res = !pool->stop && _harbol_threadpool_push(pool, ( struct HarbolTask ){ func, arg, NULL });
+	if( res ) {
+		HARBOL_COND_SIGNAL(pool->work_cond);
+	}
+	HARBOL_UNLOCK(pool);
+	return res;
+}
+
+HARBOL_EXPORT void harbol_threadpool_wait(struct HarbolThreadPool *const pool) {
+	if( pool->nthreads==0 ) {
+		return;
+	}
+	HARBOL_LOCK(pool);
+	while( pool->count > 0 || pool->active > 0 ) {
+		HARBOL_COND_WAIT(pool->idle_cond, pool);
+	}
+	HARBOL_UNLOCK(pool);
+}
+
+HARBOL_EXPORT bool harbol_threadpool_submit_group(struct HarbolThreadPool *const pool, struct HarbolTaskGroup *const group, HarbolTaskFunc *const func, void *const arg) {
+	if( pool->nthreads==0 ) {
+		(*func)(arg);
+		return true;
+	}
+	HARBOL_LOCK(pool);
+	bool const res = !pool->stop && _harbol_threadpool_push(pool, ( struct HarbolTask ){ func, arg, group });
+	if( res ) {
+		group->pending++;
+		HARBOL_COND_SIGNAL(pool->work_cond);
+	}
+	HARBOL_UNLOCK(pool);
+	return res;
+}
+
+HARBOL_EXPORT void harbol_threadpool_wait_group(struct HarbolThreadPool *const pool, struct HarbolTaskGroup *const group) {
+	if( pool->nthreads==0 ) {
+		return;
+	}
+	HARBOL_LOCK(pool);
+	while( group->pending > 0 ) {
+		/// doing our own queued work keeps a caller that's itself a worker from starving its tasks.
+		struct HarbolTask task;
+		if( _harbol_threadpool_take(pool, group, &task) ) {
+			_harbol_threadpool_run(pool, task);
+		} else {
+			HARBOL_COND_WAIT(pool->idle_cond, pool);
+		}
+	}
+	HARBOL_UNLOCK(pool);
+}
@@ -0,0 +1,75 @@
+#ifndef HARBOL_THREADPOOL_INCLUDED
+#	define HARBOL_THREADPOOL_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "../harbol_common_defines.h"
+#include "../harbol_common_includes.h"
+
+#ifdef OS_WINDOWS
+#	include <windows.h>
+#else
+#	include <pthread.h>
+#endif
+
+
+typedef void HarbolTaskFunc(void *arg);
+
+/// tasks submitted together so they can be waited on apart from the rest of the pool's work.
+struct HarbolTaskGroup {
+	size_t pending;
+};
+
+struct HarbolTask {
+	HarbolTaskFunc         *func;
+	void                   *arg;
+	struct HarbolTaskGroup *group;
+};
+
+/// fixed set of workers pulling from one shared FIFO of tasks.
+/// a pool that ends up with no workers runs every submitted task inline.
+struct HarbolThreadPool {
+#ifdef OS_WINDOWS
+	HANDLE            *threads;
+	CRITICAL_SECTION   lock;
+	CONDITION_VARIABLE work_cond, idle_cond;
+#else
+	pthread_t         *threads;
+	pthread_mutex_t    lock;
+	pthread_cond_t     work_cond, idle_cond;
+#endif
+	struct HarbolTask *tasks; /// ring buffer.
+	size_t             cap, head, count;
+	size_t             nthreads, active;
+	bool               stop;
+};
+
+
+HARBOL_EXPORT size_t harbol_cpu_count(void);
+
+HARBOL_EXPORT struct HarbolThreadPool *harbol_threadpool_new(size_t nthreads);
+HARBOL_EXPORT NO_NULL bool harbol_threadpool_init(struct HarbolThreadPool *pool, size_t nthreads);
+HARBOL_EXPORT NO_NULL void harbol_threadpool_clear(struct HarbolThreadPool *pool);
+HARBOL_EXPORT NO_NULL void harbol_threadpool_free(struct HarbolThreadPool **poolref);
+
+HARBOL_EXPORT NO_NULL size_t harbol_threadpool_size(struct HarbolThreadPool const *pool);
+HARBOL_EXPORT NEVER_NULL(1, 2) bool harbol_threadpool_submit(struct HarbolThreadPool *pool, HarbolTaskFunc *func, void *arg);
+
+/// blocks until every queued and running task has finished.
+HARBOL_EXPORT NO_NULL void harbol_threadpool_wait(struct HarbolThreadPool *pool);
+
+/// like 'submit', the task is counted in 'group' until it finishes.
+HARBOL_EXPORT NEVER_NULL(1, 2, 3) bool harbol_threadpool_submit_group(struct HarbolThreadPool *pool, struct HarbolTaskGroup *group, HarbolTaskFunc *func, void *arg);
+/// blocks until every task in 'group' has finished, running the group's still queued tasks itself.
+/// unlike 'wait', it can be called from a task running on the same pool.
+HARBOL_EXPORT NO_NULL void harbol_threadpool_wait_group(struct HarbolThreadPool *pool, struct HarbolTaskGroup *group);
+/********************************************************************/
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /** HARBOL_THREADPOOL_INCLUDED */
@@ -1,3 +1,4 @@
+#define _POSIX_C_SOURCE 200809L
 #include <assert.h>
 #include <stdalign.h>
 #include <time.h>
@@ -5,6 +6,9 @@
 #include "tree.h"
 
 void test_harbol_tree(FILE *debug_stream);
+void test_harbol_flat_tree(FILE *debug_stream);
+void test_harbol_tree_traversal(FILE *debug_stream);
+void test_harbol_tree_kid_index(FILE *debug_stream);
 
 #ifdef HARBOL_USE_MEMPOOL
 struct HarbolMemPool *g_pool;
@@ -127,4 +131,348 @@ void test_harbol_tree(FILE *const debug_stream) {
 	fprintf(debug_stream, "p's children vector is null? '%s'\n", p->kids.table != NULL? "no" : "yes");
 	harbol_tree_free(&p);
 	fprintf(debug_stream, "p is null? '%s'\n", p != NULL? "no" : "yes");
+	
+	test_harbol_flat_tree(debug_stream);
+	test_harbol_tree_traversal(debug_stream);
+	test_harbol_tree_kid_index(debug_stream);
+}
+
+static int64_t sum_tree(struct HarbolTree const *const tree) {
+	int64_t sum = (( union Value const* )tree->data)->int64;
+	for( size_t i=0; i < tree->kids.len; i++ ) {
+		sum += sum_tree(harbol_tree_get_node_by_index(tree, i));
+	}
+	return sum;
+}
+
+static bool same_tree(struct HarbolTree const *const a, struct HarbolTree const *const b) {
+	if( a->len != b->len || memcmp(a->data, b->data, a->len) || a->kids.len != b->kids.len ) {
+		return false;
+	}
+	for( size_t i=0; i < a->kids.len; i++ ) {
+		if( !same_tree(harbol_tree_get_node_by_index(a, i), harbol_tree_get_node_by_index(b, i)) ) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void test_harbol_flat_tree(FILE *const debug_stream) {
+	fputs("\nflat tree :: test building.\n", debug_stream);
+	size_t const u_val_size = sizeof(union Value);
+	/**
+	 *        0
+	 *      / | \
+	 *     1  4  5
+	 *    / \    \
+	 *   2   3    6
+	 */
+	struct HarbolFlatTree f = harbol_flat_tree_make(u_val_size, 2, &( bool ){false});
+	assert( harbol_flat_tree_append(&f, SIZE_MAX, &( union Value ){.int64=0})==0 );
+	assert( harbol_flat_tree_append(&f, 0, &( union Value ){.int64=1})==1 );
+	assert( harbol_flat_tree_append(&f, 1, &( union Value ){.int64=2})==2 );
+	assert( harbol_flat_tree_append(&f, 1, &( union Value ){.int64=3})==3 );
+	assert( harbol_flat_tree_append(&f, 0, &( union Value ){.int64=4})==4 );
+	/// node 1 is no longer on the rightmost path.
+	assert( harbol_flat_tree_append(&f, 1, &( union Value ){.int64=9})==SIZE_MAX );
+	assert( harbol_flat_tree_append(&f, 0, &( union Value ){.int64=5})==5 );
+	assert( harbol_flat_tree_append(&f, 5, &( union Value ){.int64=6})==6 );
+	assert( harbol_flat_tree_subtree_len(&f, 0)==7 && harbol_flat_tree_subtree_len(&f, 1)==3 );
+	assert( harbol_flat_tree_skip(&f, 1)==4 && harbol_flat_tree_skip(&f, 5)==SIZE_MAX );
+	assert( harbol_flat_tree_next_sib(&f, 1)==4 && harbol_flat_tree_first_kid(&f, 5)==6 );
+	
+	fputs("\nflat tree :: test iterators.\n", debug_stream);
+	size_t const expected_post[] = { 2, 3, 1, 4, 6, 5, 0 };
+	size_t n = 0;
+	for( size_t i = harbol_flat_tree_postorder_first(&f); i != SIZE_MAX; i = harbol_flat_tree_postorder_next(&f, i) ) {
+		fprintf(debug_stream, "postorder: %" PRIi64 "\n", (( union Value const* )harbol_flat_tree_get(&f, i))->int64);
+		assert( i==expected_post[n++] );
+	}
+	assert( n==7 );
+	size_t const expected_bfs[] = { 0, 1, 4, 5, 2, 3, 6 };
+	size_t order[7];
+	assert( harbol_flat_tree_level_order(&f, order)==7 );
+	assert( !memcmp(order, expected_bfs, sizeof order) );
+	
+	fputs("\nflat tree :: test conversion.\n", debug_stream);
+	struct HarbolTree *t = harbol_flat_tree_to_tree(&f);
+	assert( t != NULL && t->kids.len==3 );
+	assert( sum_tree(t)==21 );
+	struct HarbolFlatTree g = harbol_flat_tree_make(u_val_size, 0, &( bool ){false});
+	assert( harbol_flat_tree_from_tree(&g, t) );
+	assert( g.len==f.len && !memcmp(g.datum, f.datum, f.len * u_val_size) && !memcmp(g.ends, f.ends, f.len * sizeof *f.ends) );
+	harbol_tree_free(&t);
+	harbol_flat_tree_clear(&g);
+	harbol_flat_tree_clear(&f);
+	
+	/// a chain-shaped tree still builds in linear time.
+	fputs("\nflat tree :: test deep chain.\n", debug_stream);
+	enum { CHAIN_LEN = 200000 };
+	struct HarbolFlatTree chain = harbol_flat_tree_make(u_val_size, 16, &( bool ){false});
+	for( size_t i=0; i < CHAIN_LEN; i++ ) {
+		assert( harbol_flat_tree_append(&chain, ( i==0 )? SIZE_MAX : i - 1, &( union Value ){.int64=( int64_t )(i)})==i );
+	}
+	assert( harbol_flat_tree_subtree_len(&chain, 0)==CHAIN_LEN && harbol_flat_tree_subtree_len(&chain, CHAIN_LEN/2)==CHAIN_LEN/2 );
+	assert( harbol_flat_tree_skip(&chain, 1)==SIZE_MAX );
+	/// a second kid of the root closes the whole chain below it.
+	assert( harbol_flat_tree_append(&chain, 0, &( union Value ){.int64=-1})==CHAIN_LEN );
+	assert( harbol_flat_tree_subtree_len(&chain, 0)==CHAIN_LEN + 1 && harbol_flat_tree_subtree_len(&chain, 1)==CHAIN_LEN - 1 );
+	assert( harbol_flat_tree_skip(&chain, 1)==CHAIN_LEN && harbol_flat_tree_skip(&chain, CHAIN_LEN - 1)==CHAIN_LEN );
+	assert( harbol_flat_tree_next_sib(&chain, 1)==CHAIN_LEN );
+	harbol_flat_tree_clear(&chain);
+	
+	/// benchmark a wide, bushy tree: pointer chasing vs. a sequential pass.
+	fputs("\nflat tree :: benchmark traversal.\n", debug_stream);
+	enum { BENCH_NODES = 200000, BENCH_FANOUT = 8 };
+	struct HarbolFlatTree *big = harbol_flat_tree_new(u_val_size, BENCH_NODES);
+	assert( big != NULL );
+	/// kids of node 'i' are appended in BFS order, then re-laid out via a HarbolTree round-trip.
+	struct HarbolTree **nodes = calloc(BENCH_NODES, sizeof *nodes);
+	nodes[0] = harbol_tree_new(&( union Value ){.int64=0}, u_val_size);
+	for( size_t i=1; i < BENCH_NODES; i++ ) {
+		nodes[i] = harbol_tree_new(&( union Value ){.int64=( int64_t )(i)}, u_val_size);
+		harbol_tree_insert_node(nodes[(i - 1) / BENCH_FANOUT], &nodes[i]);
+	}
+	struct HarbolTree *root = nodes[0];
+	free(nodes);
+	assert( harbol_flat_tree_from_tree(big, root) );
+	
+	int64_t const expected = ( int64_t )(BENCH_NODES) * (BENCH_NODES - 1) / 2;
+	clock_t start = clock();
+	int64_t tree_sum = 0;
+	for( int r=0; r < 20; r++ ) {
+		tree_sum += sum_tree(root);
+	}
+	double const tree_secs = (clock() - start) / ( double )(CLOCKS_PER_SEC);
+	
+	start = clock();
+	int64_t flat_sum = 0;
+	for( int r=0; r < 20; r++ ) {
+		for( size_t i=0; i < big->len; i++ ) {
+			flat_sum += (( union Value const* )harbol_flat_tree_get(big, i))->int64;
+		}
+	}
+	double const flat_secs = (clock() - start) / ( double )(CLOCKS_PER_SEC);
+	assert( tree_sum==expected * 20 && flat_sum==expected * 20 );
+	
+	start = clock();
+	int64_t post_sum = 0;
+	for( int r=0; r < 20; r++ ) {
+		for( size_t i = harbol_flat_tree_postorder_first(big); i != SIZE_MAX; i = harbol_flat_tree_postorder_next(big, i) ) {
+			post_sum += (( union Value const* )harbol_flat_tree_get(big, i))->int64;
+		}
+	}
+	double const post_secs = (clock() - start) / ( double )(CLOCKS_PER_SEC);
+	assert( post_sum==expected * 20 );
+	printf("harbol tree :: 20 x %d-node sums - HarbolTree: %f secs | flat preorder: %f secs | flat postorder: %f secs\n", BENCH_NODES, tree_secs, flat_secs, post_secs);
+	fprintf(debug_stream, "HarbolTree: %f | flat preorder: %f | flat postorder: %f\n", tree_secs, flat_secs, post_secs);
+	
+	struct HarbolTree *back = harbol_flat_tree_to_tree(big);
+	assert( back != NULL && same_tree(back, root) );
+	harbol_tree_free(&back);
+	harbol_tree_free(&root);
+	harbol_flat_tree_free(&big);
+	assert( big==NULL );
+}
+
+struct VisitLog {
+	int64_t vals[16];
+	size_t  depths[16], len, stop_at;
+};
+
+static bool log_visit(struct HarbolTree const *const node, size_t const depth, void *const userdata) {
+	struct VisitLog *const log = userdata;
+	log->depths[log->len] = depth;
+	log->vals[log->len++] = (( union Value const* )node->data)->int64;
+	return log->len != log->stop_at;
+}
+
+static double wall_seconds(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+struct TreeStats {
+	int64_t  sum, max;
+	uint64_t mix;
+	size_t  count;
+};
+
+static void stats_fold(void *const acc, struct HarbolTree const *const node, void *const userdata) {
+	(void)(userdata);
+	struct TreeStats *const stats = acc;
+	int64_t const val = (( union Value const* )node->data)->int64;
+	/// a little extra work per node so the parallel split has something to win.
+	uint64_t mix = ( uint64_t )(val);
+	for( int i=0; i < 32; i++ ) {
+		mix = mix * 6364136223846793005ULL + 1442695040888963407ULL;
+	}
+	stats->mix ^= mix;
+	stats->sum += val;
+	stats->max  = (val > stats->max)? val : stats->max;
+	stats->count++;
+}
+
+static void stats_combine(void *const acc, void const *const other, void *const userdata) {
+	(void)(userdata);
+	struct TreeStats *const a = acc;
+	struct TreeStats const *const b = other;
+	a->sum   += b->sum;
+	a->mix   ^= b->mix;
+	a->max    = (b->max > a->max)? b->max : a->max;
+	a->count += b->count;
+}
+
+void test_harbol_tree_traversal(FILE *const debug_stream) {
+	fputs("\ntree :: test visitors.\n", debug_stream);
+	size_t const u_val_size = sizeof(union Value);
+	/// same shape as the flat tree test.
+	struct HarbolTree *root = harbol_tree_new(&( union Value ){.int64=0}, u_val_size);
+	harbol_tree_insert_val(root, &( union Value ){.int64=1}, u_val_size);
+	harbol_tree_insert_val(root, &( union Value ){.int64=4}, u_val_size);
+	harbol_tree_insert_val(root, &( union Value ){.int64=5}, u_val_size);
+	harbol_tree_insert_val(harbol_tree_get_node_by_index(root, 0), &( union Value ){.int64=2}, u_val_size);
+	harbol_tree_insert_val(harbol_tree_get_node_by_index(root, 0), &( union Value ){.int64=3}, u_val_size);
+	harbol_tree_insert_val(harbol_tree_get_node_by_index(root, 2), &( union Value ){.int64=6}, u_val_size);
+	
+	struct VisitLog log = {0};
+	assert( harbol_tree_visit_preorder(root, log_visit, &log) && log.len==7 );
+	assert( !memcmp(log.vals, (int64_t[]){ 0, 1, 2, 3, 4, 5, 6 }, 7 * sizeof(int64_t)) );
+	assert( !memcmp(log.depths, (size_t[]){ 0, 1, 2, 2, 1, 1, 2 }, 7 * sizeof(size_t)) );
+	
+	log = ( struct VisitLog ){0};
+	assert( harbol_tree_visit_postorder(root, log_visit, &log) && log.len==7 );
+	assert( !memcmp(log.vals, (int64_t[]){ 2, 3, 1, 4, 6, 5, 0 }, 7 * sizeof(int64_t)) );
+	
+	log = ( struct VisitLog ){0};
+	assert( harbol_tree_visit_level_order(root, log_visit, &log) && log.len==7 );
+	assert( !memcmp(log.vals, (int64_t[]){ 0, 1, 4, 5, 2, 3, 6 }, 7 * sizeof(int64_t)) );
+	
+	/// stopping early.
+	log = ( struct VisitLog ){ .stop_at = 3 };
+	assert( !harbol_tree_visit_preorder(root, log_visit, &log) && log.len==3 );
+	for( size_t i=0; i < log.len; i++ ) {
+		fprintf(debug_stream, "visited %" PRIi64 " at depth %zu\n", log.vals[i], log.depths[i]);
+	}
+	
+	struct TreeStats small = {0};
+	assert( harbol_tree_reduce(root, NULL, &small, sizeof small, stats_fold, stats_combine, NULL) );
+	assert( small.sum==21 && small.max==6 && small.count==7 );
+	harbol_tree_free(&root);
+	
+	fputs("\ntree :: test parallel reduce.\n", debug_stream);
+	enum { BENCH_NODES = 400000, BENCH_FANOUT = 6 };
+	struct HarbolTree **nodes = calloc(BENCH_NODES, sizeof *nodes);
+	nodes[0] = harbol_tree_new(&( union Value ){.int64=0}, u_val_size);
+	for( size_t i=1; i < BENCH_NODES; i++ ) {
+		nodes[i] = harbol_tree_new(&( union Value ){.int64=( int64_t )(i)}, u_val_size);
+		harbol_tree_insert_node(nodes[(i - 1) / BENCH_FANOUT], &nodes[i]);
+	}
+	root = nodes[0];
+	free(nodes);
+	
+	clock_t start = clock();
+	struct TreeStats seq = {0};
+	assert( harbol_tree_reduce(root, NULL, &seq, sizeof seq, stats_fold, stats_combine, NULL) );
+	double const seq_secs = (clock() - start) / ( double )(CLOCKS_PER_SEC);
+	assert( seq.count==BENCH_NODES && seq.max==BENCH_NODES - 1 );
+	assert( seq.sum==( int64_t )(BENCH_NODES) * (BENCH_NODES - 1) / 2 );
+	
+	struct HarbolThreadPool *pool = harbol_threadpool_new(4);
+	assert( pool != NULL );
+	double const t0 = wall_seconds();
+	struct TreeStats par = {0};
+	assert( harbol_tree_reduce(root, pool, &par, sizeof par, stats_fold, stats_combine, NULL) );
+	double const par_secs = wall_seconds() - t0;
+	assert( par.sum==seq.sum && par.max==seq.max && par.count==seq.count && par.mix==seq.mix );
+	printf("harbol tree :: reduce over %d nodes - sequential: %f secs | 4 workers (wall): %f secs\n", BENCH_NODES, seq_secs, par_secs);
+	fprintf(debug_stream, "sequential: %f | parallel: %f\n", seq_secs, par_secs);
+	
+	harbol_threadpool_free(&pool);
+	harbol_tree_free(&root);
+}
+
+void test_harbol_tree_kid_index(FILE *const debug_stream) {
+	fputs("\ntree :: test kid index.\n", debug_stream);
+	size_t const u_val_size = sizeof(union Value);
+	struct HarbolTree *small = harbol_tree_new(&( union Value ){.int64=0}, u_val_size);
+	for( int64_t i=0; i < HARBOL_TREE_INDEX_THRESHOLD - 1; i++ ) {
+		harbol_tree_insert_val(small, &( union Value ){.int64=i}, u_val_size);
+	}
+	assert( small->kid_index==NULL );
+	harbol_tree_insert_val(small, &( union Value ){.int64=7}, u_val_size);
+	assert( small->kid_index != NULL );
+	
+	/// duplicates: the first kid holding a value wins, and removal passes the entry on.
+	struct HarbolTree *const first_seven = harbol_tree_get_node_by_index(small, 7);
+	assert( harbol_tree_get_node_by_val(small, &( union Value ){.int64=7}, u_val_size)==first_seven );
+	assert( harbol_tree_rm_val(small, &( union Value ){.int64=7}, u_val_size) );
+	struct HarbolTree *const last_seven = harbol_tree_get_node_by_index(small, small->kids.len - 1);
+	assert( harbol_tree_get_node_by_val(small, &( union Value ){.int64=7}, u_val_size)==last_seven );
+	assert( harbol_tree_rm_val(small, &( union Value ){.int64=7}, u_val_size) );
+	assert( harbol_tree_get_node_by_val(small, &( union Value ){.int64=7}, u_val_size)==NULL );
+	assert( harbol_tree_rm_index(small, 0) && harbol_tree_get_node_by_val(small, &( union Value ){.int64=0}, u_val_size)==NULL );
+	assert( harbol_tree_get_node_by_val(small, &( union Value ){.int64=8}, u_val_size)==harbol_tree_get_node_by_index(small, 6) );
+	
+	/// after editing a kid in place the index has to be rebuilt.
+	harbol_tree_set(harbol_tree_get_node_by_index(small, 0), &( union Value ){.int64=-1}, u_val_size);
+	assert( harbol_tree_index_kids(small) );
+	assert( harbol_tree_get_node_by_val(small, &( union Value ){.int64=-1}, u_val_size)==harbol_tree_get_node_by_index(small, 0) );
+	harbol_tree_free(&small);
+	
+	/// values only match when their sizes do, with or without an index.
+	struct HarbolTree *sized = harbol_tree_new("root", sizeof "root");
+	for( size_t round=0; round < 2; round++ ) {
+		harbol_tree_insert_val(sized, "abcd", 4);
+		assert( (sized->kid_index != NULL)==(round > 0) );
+		struct HarbolTree *const abcd = harbol_tree_get_node_by_val(sized, "abcd", 4);
+		assert( abcd != NULL && abcd->len==4 );
+		assert( harbol_tree_get_node_by_val(sized, "ab", 2)==NULL );
+		assert( harbol_tree_get_node_by_val(sized, "abcdef", 6)==NULL );
+		assert( !harbol_tree_rm_val(sized, "ab", 2) );
+		assert( harbol_tree_rm_val(sized, "abcd", 4) && harbol_tree_get_node_by_val(sized, "abcd", 4)==NULL );
+		/// grow past the threshold for the indexed round.
+		for( int64_t i=0; round==0 && i < HARBOL_TREE_INDEX_THRESHOLD; i++ ) {
+			harbol_tree_insert_val(sized, &( union Value ){.int64=i}, u_val_size);
+		}
+	}
+	harbol_tree_free(&sized);
+	
+	/// wide, directory-like node.
+	enum { WIDE_KIDS = 20000 };
+	struct HarbolTree *wide = harbol_tree_new(&( union Value ){.int64=0}, u_val_size);
+	struct HarbolTree *scan = harbol_tree_new(&( union Value ){.int64=0}, u_val_size);
+	for( int64_t i=0; i < WIDE_KIDS; i++ ) {
+		harbol_tree_insert_val(wide, &( union Value ){.int64=i}, u_val_size);
+		harbol_tree_insert_val(scan, &( union Value ){.int64=i}, u_val_size);
+	}
+	harbol_map_free(&scan->kid_index);
+	
+	clock_t start = clock();
+	for( int64_t i=0; i < WIDE_KIDS; i++ ) {
+		struct HarbolTree const *const kid = harbol_tree_get_node_by_val(wide, &( union Value ){.int64=i}, u_val_size);
+		assert( kid != NULL && (( union Value const* )kid->data)->int64==i );
+	}
+	double const index_secs = (clock() - start) / ( double )(CLOCKS_PER_SEC);
+	start = clock();
+	for( int64_t i=0; i < WIDE_KIDS; i++ ) {
+		assert( harbol_tree_get_node_by_val(scan, &( union Value ){.int64=i}, u_val_size) != NULL );
+	}
+	double const scan_secs = (clock() - start) / ( double )(CLOCKS_PER_SEC);
+	
+	start = clock();
+	for( int64_t i=0; i < WIDE_KIDS; i += 2 ) {
+		assert( harbol_tree_rm_val(wide, &( union Value ){.int64=i}, u_val_size) );
+	}
+	double const rm_secs = (clock() - start) / ( double )(CLOCKS_PER_SEC);
+	assert( wide->kids.len==WIDE_KIDS / 2 );
+	for( int64_t i=0; i < WIDE_KIDS; i++ ) {
+		struct HarbolTree const *const kid = harbol_tree_get_node_by_val(wide, &( union Value ){.int64=i}, u_val_size);
+		assert( (i & 1)? kid != NULL : kid==NULL );
+	}
+	printf("harbol tree :: %d by-value lookups on a %d-kid node - indexed: %f secs | scanning: %f secs | %d indexed removals: %f secs\n", WIDE_KIDS, WIDE_KIDS, index_secs, scan_secs, WIDE_KIDS / 2, rm_secs);
+	fprintf(debug_stream, "indexed: %f | scanning: %f | removals: %f\n", index_secs, scan_secs, rm_secs);
+	harbol_tree_free(&wide);
+	harbol_tree_free(&scan);
 }
@@ -13,6 +13,7 @@ HARBOL_EXPORT struct HarbolTree *harbol_tree_new(void const *const val, size_t c
 }
 
 HARBOL_EXPORT bool harbol_tree_init(struct HarbolTree *const restrict tree, void const *const val, size_t const datasize) {
+	tree->kid_index = NULL;
 	tree->data = dup_data(val, datasize);
 	if( tree->data==NULL ) {
 		return false;
@@ -36,6 +37,7 @@ HARBOL_EXPORT void harbol_tree_clear(struct HarbolTree *const tree) {
 		harbol_tree_free(&conv.t[i]);
 	}
 	harbol_array_clear(&tree->kids);
+	harbol_map_free(&tree->kid_index);
 }
 
 HARBOL_EXPORT void harbol_tree_free(struct HarbolTree **const tree_ref) {
@@ -70,16 +72,96 @@ HARBOL_EXPORT bool harbol_tree_set(struct HarbolTree *const restrict tree, void
 	return true;
 }
 
+
+static inline struct HarbolTree *_harbol_tree_kid_at(struct HarbolTree const *const tree, size_t const index) {
+	return (( struct HarbolTree *const* )(tree->kids.table))[index];
+}
+
+static NO_NULL bool _harbol_tree_index_add(struct HarbolTree *const tree, struct HarbolTree *const kid) {
+	struct HarbolTreeKidEntry *const entry = harbol_map_key_get(tree->kid_index, kid->data, kid->len);
+	if( entry != NULL ) {
+		entry->count++;
+		return true;
+	}
+	return harbol_map_insert(tree->kid_index, kid->data, kid->len, &( struct HarbolTreeKidEntry ){ kid, 1 }, sizeof(struct HarbolTreeKidEntry));
+}
+
+/// must run while 'kid' is still in 'kids'.
+static NO_NULL void _harbol_tree_index_drop(struct HarbolTree *const tree, struct HarbolTree const *const kid) {
+	if( tree->kid_index==NULL ) {
+		return;
+	}
+	size_t const n = harbol_map_get_entry_index(tree->kid_index, kid->data, kid->len);
+	if( n==SIZE_MAX ) {
+		return;
+	}
+	struct HarbolTreeKidEntry *const entry = harbol_map_idx_get(tree->kid_index, n);
+	if( entry->count <= 1 ) {
+		/// index order doesn't matter, so take the O(1) removal.
+		harbol_map_idx_swap_rm(tree->kid_index, n);
+		return;
+	}
+	entry->count--;
+	if( entry->kid==kid ) {
+		/// duplicate values: hand the entry to the next kid holding the same value.
+		for( size_t i=0; i < tree->kids.len; i++ ) {
+			struct HarbolTree *const other = _harbol_tree_kid_at(tree, i);
+			if( other != kid && other->len==kid->len && !memcmp(other->data, kid->data, kid->len) ) {
+				entry->kid = other;
+				break;
+			}
+		}
+	}
+}
+
+/// called after a kid was appended.
+static NO_NULL void _harbol_tree_index_insert(struct HarbolTree *const tree, struct HarbolTree *const kid) {
+	if( tree->kid_index != NULL ) {
+		if( !_harbol_tree_index_add(tree, kid) ) {
+			/// a stale index is worse than none; lookups fall back to scanning.
+			harbol_map_free(&tree->kid_index);
+		}
+	} else if( tree->kids.len >= HARBOL_TREE_INDEX_THRESHOLD ) {
+		harbol_tree_index_kids(tree);
+	}
+}
+
+HARBOL_EXPORT bool harbol_tree_index_kids(struct HarbolTree *const tree) {
+	harbol_map_free(&tree->kid_index);
+	tree->kid_index = harbol_map_new(tree->kids.len + (tree->kids.len >> 1));
+	if( tree->kid_index==NULL ) {
+		return false;
+	}
+	for( size_t i=0; i < tree->kids.len; i++ ) {
+		if( !_harbol_tree_index_add(tree, _harbol_tree_kid_at(tree, i)) ) {
+			harbol_map_free(&tree->kid_index);
+			return false;
+		}
+	}
+	return true;
+}
+
 HARBOL_EXPORT bool harbol_tree_insert_val(struct HarbolTree *const restrict tree, void const *const val, size_t const datasize) {
-	if( datasize==0 || (harbol_array_full(&tree->kids) && !harbol_array_grow(&tree->kids, sizeof tree)) ) {
+	if( datasize==0 ) {
 		return false;
 	}
 	struct HarbolTree *node = harbol_tree_new(val, datasize);
-	return( node==NULL || node->data==NULL )? false : harbol_array_insert(&tree->kids, &node, sizeof node);
+	if( node==NULL || node->data==NULL ) {
+		return false;
+	} else if( !harbol_array_insert(&tree->kids, &node, sizeof node) ) {
+		harbol_tree_free(&node);
+		return false;
+	}
+	_harbol_tree_index_insert(tree, node);
+	return true;
 }
 
 HARBOL_EXPORT bool harbol_tree_insert_node(struct HarbolTree *const tree, struct HarbolTree **const child_ref) {
-	return( (*child_ref)->data==NULL || (harbol_array_full(&tree->kids) && !harbol_array_grow(&tree->kids, sizeof tree)) )? false : harbol_array_insert(&tree->kids, child_ref, sizeof *child_ref);
+	if( (*child_ref)->data==NULL || !harbol_array_insert(&tree->kids, child_ref, sizeof *child_ref) ) {
+		return false;
+	}
+	_harbol_tree_index_insert(tree, *child_ref);
+	return true;
 }
 
 HARBOL_EXPORT bool harbol_tree_rm_node(struct HarbolTree *const tree, struct HarbolTree **const child_ref) {
@@ -87,6 +169,7 @@ HARBOL_EXPORT bool harbol_tree_rm_node(struct HarbolTree *const tree, struct Har
 	if( i==SIZE_MAX ) {
 		return false;
 	}
+	_harbol_tree_index_drop(tree, *child_ref);
 	harbol_tree_free(child_ref);
 	return harbol_array_del_by_index(&tree->kids, i, sizeof tree);
 }
@@ -96,22 +179,41 @@ HARBOL_EXPORT bool harbol_tree_rm_index(struct HarbolTree *const tree, size_t co
 	if( child_ref==NULL || *child_ref==NULL ) {
 		return false;
 	}
+	_harbol_tree_index_drop(tree, *child_ref);
 	harbol_tree_free(child_ref);
 	return harbol_array_del_by_index(&tree->kids, index, sizeof *child_ref);
 }
 
-HARBOL_EXPORT bool harbol_tree_rm_val(struct HarbolTree *const restrict tree, void const *const val, size_t const datasize) {
-	if( datasize==0 ) {
-		return false;
+/// with an index, the value lookup is a hash probe and the kid's slot is found by pointer compare.
+static NO_NULL size_t _harbol_tree_kid_by_val(struct HarbolTree const *const tree, void const *const val, size_t const datasize) {
+	if( tree->kid_index != NULL ) {
+		struct HarbolTreeKidEntry const *const entry = harbol_map_key_get(tree->kid_index, val, datasize);
+		if( entry==NULL ) {
+			return SIZE_MAX;
+		}
+		struct HarbolTree *const *const kids = ( struct HarbolTree *const* )(tree->kids.table);
+		for( size_t i=0; i < tree->kids.len; i++ ) {
+			if( kids[i]==entry->kid ) {
+				return i;
+			}
+		}
+		return SIZE_MAX;
 	}
 	for( size_t i=0; i < tree->kids.len; i++ ) {
-		struct HarbolTree **const child_ref = harbol_array_get(&tree->kids, i, sizeof *child_ref);
-		if( !memcmp((*child_ref)->data, val, (*child_ref)->len) ) {
-			harbol_tree_free(child_ref);
-			return harbol_array_del_by_index(&tree->kids, i, sizeof *child_ref);
+		struct HarbolTree const *const child = _harbol_tree_kid_at(tree, i);
+		if( child->len==datasize && !memcmp(child->data, val, datasize) ) {
+			return i;
 		}
 	}
-	return false;
+	return SIZE_MAX;
+}
+
+HARBOL_EXPORT bool harbol_tree_rm_val(struct HarbolTree *const restrict tree, void const *const val, size_t const datasize) {
+	if( datasize==0 ) {
+		return false;
+	}
+	size_t const i = _harbol_tree_kid_by_val(tree, val, datasize);
+	return( i==SIZE_MAX )? false : harbol_tree_rm_index(tree, i);
 }
 
 HARBOL_EXPORT struct HarbolTree *harbol_tree_get_node_by_index(struct HarbolTree const *const tree, size_t const index) {
@@ -122,12 +224,430 @@ HARBOL_EXPORT struct HarbolTree *harbol_tree_get_node_by_index(struct HarbolTree
 HARBOL_EXPORT struct HarbolTree *harbol_tree_get_node_by_val(struct HarbolTree const *const tree, void const *const val, size_t const datasize) {
 	if( datasize==0 ) {
 		return NULL;
+	} else if( tree->kid_index != NULL ) {
+		struct HarbolTreeKidEntry const *const entry = harbol_map_key_get(tree->kid_index, val, datasize);
+		return( entry==NULL )? NULL : entry->kid;
 	}
-	for( size_t i=0; i < tree->kids.len; i++ ) {
-		struct HarbolTree **const child_ref = harbol_array_get(&tree->kids, i, sizeof *child_ref);
-		if( !memcmp((*child_ref)->data, val, (*child_ref)->len) ) {
-			return *child_ref;
+	size_t const i = _harbol_tree_kid_by_val(tree, val, datasize);
+	return( i==SIZE_MAX )? NULL : _harbol_tree_kid_at(tree, i);
+}
+
+
+/// traversal frame: the node, its depth and the next kid to descend into.
+struct HarbolTreeFrame {
+	struct HarbolTree const *node;
+	size_t                   depth, kid;
+};
+
+struct HarbolTreeStack {
+	struct HarbolTreeFrame *frames;
+	size_t                  len, cap;
+};
+
+static NO_NULL bool _harbol_tree_stack_push(struct HarbolTreeStack *const stack, struct HarbolTree const *const node, size_t const depth) {
+	if( stack->len >= stack->cap ) {
+		size_t const new_cap = (stack->cap==0)? 64 : stack->cap << 1;
+		struct HarbolTreeFrame *const frames = harbol_recalloc(stack->frames, new_cap, sizeof *frames, stack->cap);
+		if( frames==NULL ) {
+			return false;
+		}
+		stack->frames = frames;
+		stack->cap    = new_cap;
+	}
+	stack->frames[stack->len++] = ( struct HarbolTreeFrame ){ node, depth, 0 };
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_tree_visit_preorder(struct HarbolTree const *const tree, HarbolTreeVisitFunc *const visitor, void *const userdata) {
+	struct HarbolTreeStack stack = {0};
+	bool res = _harbol_tree_stack_push(&stack, tree, 0);
+	while( res && stack.len > 0 ) {
+		struct HarbolTreeFrame const frame = stack.frames[--stack.len];
+		if( !(*visitor)(frame.node, frame.depth, userdata) ) {
+			res = false;
+			break;
+		}
+		/// push kids in reverse so the first kid is visited first.
+		for( size_t i=frame.node->kids.len; i-- > 0; ) {
+			if( !_harbol_tree_stack_push(&stack, _harbol_tree_kid_at(frame.node, i), frame.depth + 1) ) {
+				res = false;
+				break;
+			}
+		}
+	}
+	free(stack.frames);
+	return res;
+}
+
+HARBOL_EXPORT bool harbol_tree_visit_postorder(struct HarbolTree const *const tree, HarbolTreeVisitFunc *const visitor, void *const userdata) {
+	struct HarbolTreeStack stack = {0};
+	bool res = _harbol_tree_stack_push(&stack, tree, 0);
+	while( res && stack.len > 0 ) {
+		struct HarbolTreeFrame *const top = &stack.frames[stack.len - 1];
+		if( top->kid < top->node->kids.len ) {
+			struct HarbolTree const *const kid = _harbol_tree_kid_at(top->node, top->kid++);
+			res = _harbol_tree_stack_push(&stack, kid, top->depth + 1);
+		} else {
+			stack.len--;
+			res = (*visitor)(top->node, top->depth, userdata);
+		}
+	}
+	free(stack.frames);
+	return res;
+}
+
+HARBOL_EXPORT bool harbol_tree_visit_level_order(struct HarbolTree const *const tree, HarbolTreeVisitFunc *const visitor, void *const userdata) {
+	/// the frame buffer is used as a queue; consumed frames are never reused.
+	struct HarbolTreeStack queue = {0};
+	bool res = _harbol_tree_stack_push(&queue, tree, 0);
+	for( size_t head=0; res && head < queue.len; head++ ) {
+		struct HarbolTreeFrame const frame = queue.frames[head];
+		if( !(*visitor)(frame.node, frame.depth, userdata) ) {
+			res = false;
+			break;
+		}
+		for( size_t i=0; i < frame.node->kids.len; i++ ) {
+			if( !_harbol_tree_stack_push(&queue, _harbol_tree_kid_at(frame.node, i), frame.depth + 1) ) {
+				res = false;
+				break;
+			}
+		}
+	}
+	free(queue.frames);
+	return res;
+}
+
+
+struct HarbolTreeReduceTask {
+	struct HarbolTree const *subtree;
+	HarbolTreeFoldFunc      *fold;
+	void                    *acc, *userdata;
+	bool                     res;
+};
+
+struct HarbolTreeFoldCtx {
+	HarbolTreeFoldFunc *fold;
+	void               *acc, *userdata;
+};
+
+static bool _harbol_tree_fold_visit(struct HarbolTree const *const node, size_t const depth, void *const userdata) {
+	(void)(depth);
+	struct HarbolTreeFoldCtx const *const ctx = userdata;
+	(*ctx->fold)(ctx->acc, node, ctx->userdata);
+	return true;
+}
+
+static void _harbol_tree_reduce_task(void *const arg) {
+	struct HarbolTreeReduceTask *const task = arg;
+	struct HarbolTreeFoldCtx ctx = { task->fold, task->acc, task->userdata };
+	task->res = harbol_tree_visit_preorder(task->subtree, _harbol_tree_fold_visit, &ctx);
+}
+
+/// subtrees handed out per worker, so idle workers can pick up slack from uneven subtrees.
+enum { HARBOL_TREE_TASKS_PER_THREAD = 8 };
+
+HARBOL_EXPORT bool harbol_tree_reduce(struct HarbolTree const *const tree, struct HarbolThreadPool *const pool, void *const acc, size_t const accsize, HarbolTreeFoldFunc *const fold, HarbolTreeCombineFunc *const combine, void *const userdata) {
+	size_t const threads = (pool==NULL)? 0 : harbol_threadpool_size(pool);
+	if( threads < 2 || accsize==0 ) {
+		struct HarbolTreeFoldCtx ctx = { fold, acc, userdata };
+		return harbol_tree_visit_preorder(tree, _harbol_tree_fold_visit, &ctx);
+	}
+	
+	/// every task starts from a copy of the identity.
+	uint8_t *const identity = dup_data(acc, accsize);
+	if( identity==NULL ) {
+		return false;
+	}
+	
+	/// expand breadth-first until there are enough subtrees to keep every worker busy.
+	/// expanded nodes are folded here; the remaining frontier becomes the tasks.
+	size_t const target = threads * HARBOL_TREE_TASKS_PER_THREAD;
+	struct HarbolTreeStack frontier = {0};
+	bool res = _harbol_tree_stack_push(&frontier, tree, 0);
+	size_t head = 0;
+	while( res && head < frontier.len && frontier.len - head < target ) {
+		struct HarbolTree const *const node = frontier.frames[head++].node;
+		(*fold)(acc, node, userdata);
+		for( size_t i=0; res && i < node->kids.len; i++ ) {
+			res = _harbol_tree_stack_push(&frontier, _harbol_tree_kid_at(node, i), 0);
+		}
+	}
+	
+	size_t const ntasks = frontier.len - head;
+	struct HarbolTreeReduceTask *tasks = NULL;
+	uint8_t *accs = NULL;
+	if( res && ntasks > 0 ) {
+		tasks = calloc(ntasks, sizeof *tasks);
+		accs  = calloc(ntasks, accsize);
+		res   = tasks != NULL && accs != NULL;
+	}
+	if( res && ntasks > 0 ) {
+		for( size_t i=0; i < ntasks; i++ ) {
+			memcpy(&accs[i * accsize], identity, accsize);
+			tasks[i] = ( struct HarbolTreeReduceTask ){ frontier.frames[head + i].node, fold, &accs[i * accsize], userdata, false };
+		}
+		
+		/// the pool's shared queue lets idle workers take the next subtree as soon as they finish one.
+		size_t submitted = 0;
+		while( submitted < ntasks && harbol_threadpool_submit(pool, _harbol_tree_reduce_task, &tasks[submitted]) ) {
+			submitted++;
+		}
+		/// anything the pool refused is folded here.
+		for( size_t i=submitted; i < ntasks; i++ ) {
+			_harbol_tree_reduce_task(&tasks[i]);
+		}
+		harbol_threadpool_wait(pool);
+		for( size_t i=0; i < ntasks; i++ ) {
+			res &= tasks[i].res;
+			(*combine)(acc, &accs[i * accsize], userdata);
+		}
+	}
+	free(identity);
+	free(tasks);
+	free(accs);
+	free(frontier.frames);
+	return res;
+}
+
+
+HARBOL_EXPORT struct HarbolFlatTree *harbol_flat_tree_new(size_t const datasize, size_t const init_size) {
+	struct HarbolFlatTree *ftree = calloc(1, sizeof *ftree);
+	if( ftree==NULL || !harbol_flat_tree_init(ftree, datasize, init_size) ) {
+		free(ftree); ftree = NULL;
+	}
+	return ftree;
+}
+
+HARBOL_EXPORT bool harbol_flat_tree_init(struct HarbolFlatTree *const ftree, size_t const datasize, size_t const init_size) {
+	if( datasize==0 ) {
+		return false;
+	}
+	*ftree = ( struct HarbolFlatTree ){0};
+	ftree->datasize = datasize;
+	return harbol_flat_tree_reserve(ftree, ( init_size > 0 )? init_size : 4);
+}
+
+HARBOL_EXPORT struct HarbolFlatTree harbol_flat_tree_make(size_t const datasize, size_t const init_size, bool *const res) {
+	struct HarbolFlatTree ftree = {0};
+	*res = harbol_flat_tree_init(&ftree, datasize, init_size);
+	return ftree;
+}
+
+HARBOL_EXPORT void harbol_flat_tree_clear(struct HarbolFlatTree *const ftree) {
+	harbol_multi_cleanup(5, &ftree->datum, &ftree->first_kids, &ftree->next_sibs, &ftree->parents, &ftree->ends);
+	ftree->len = ftree->cap = 0;
+}
+
+HARBOL_EXPORT void harbol_flat_tree_free(struct HarbolFlatTree **const ftree_ref) {
+	if( *ftree_ref==NULL ) {
+		return;
+	}
+	harbol_flat_tree_clear(*ftree_ref);
+	free(*ftree_ref); *ftree_ref = NULL;
+}
+
+HARBOL_EXPORT size_t harbol_flat_tree_len(struct HarbolFlatTree const *const ftree) {
+	return ftree->len;
+}
+
+HARBOL_EXPORT bool harbol_flat_tree_reserve(struct HarbolFlatTree *const ftree, size_t const new_cap) {
+	if( new_cap <= ftree->cap ) {
+		return true;
+	} else if( !harbol_multi_recalloc(new_cap, ftree->cap, 5,
+						&ftree->datum,      ftree->datasize,
+						&ftree->first_kids, sizeof *ftree->first_kids,
+						&ftree->next_sibs,  sizeof *ftree->next_sibs,
+						&ftree->parents,    sizeof *ftree->parents,
+						&ftree->ends,       sizeof *ftree->ends) ) {
+		return false;
+	}
+	ftree->cap = new_cap;
+	return true;
+}
+
+HARBOL_EXPORT size_t harbol_flat_tree_append(struct HarbolFlatTree *const restrict ftree, size_t const parent, void const *const val) {
+	size_t prev_sib = SIZE_MAX;
+	if( ftree->len==0 ) {
+		if( parent != SIZE_MAX ) {
+			return SIZE_MAX;
+		}
+	} else if( parent >= ftree->len ) {
+		return SIZE_MAX;
+	} else {
+		/// climb from the last node; the node met just below 'parent' is its current last child.
+		for( size_t n = ftree->len - 1; n != parent; n = ftree->parents[n] ) {
+			if( ftree->parents[n]==SIZE_MAX ) {
+				return SIZE_MAX;
+			}
+			prev_sib = n;
+		}
+	}
+	
+	if( ftree->len >= ftree->cap && !harbol_flat_tree_reserve(ftree, ftree->cap << 1) ) {
+		return SIZE_MAX;
+	}
+	/// the nodes climbed past can't get any more kids, so their subtrees end here.
+	/// each node is closed once, which keeps building a tree linear however deep it is.
+	if( ftree->len > 0 ) {
+		for( size_t n = ftree->len - 1; n != parent; n = ftree->parents[n] ) {
+			ftree->ends[n] = ftree->len;
+		}
+	}
+	size_t const node = ftree->len++;
+	memcpy(&ftree->datum[node * ftree->datasize], val, ftree->datasize);
+	ftree->first_kids[node] = ftree->next_sibs[node] = SIZE_MAX;
+	ftree->parents[node]    = parent;
+	ftree->ends[node]       = SIZE_MAX;
+	if( parent != SIZE_MAX ) {
+		if( prev_sib==SIZE_MAX ) {
+			ftree->first_kids[parent] = node;
+		} else {
+			ftree->next_sibs[prev_sib] = node;
+		}
+	}
+	return node;
+}
+
+HARBOL_EXPORT void *harbol_flat_tree_get(struct HarbolFlatTree const *const ftree, size_t const node) {
+	return( node >= ftree->len )? NULL : &ftree->datum[node * ftree->datasize];
+}
+
+HARBOL_EXPORT size_t harbol_flat_tree_parent(struct HarbolFlatTree const *const ftree, size_t const node) {
+	return( node >= ftree->len )? SIZE_MAX : ftree->parents[node];
+}
+
+HARBOL_EXPORT size_t harbol_flat_tree_first_kid(struct HarbolFlatTree const *const ftree, size_t const node) {
+	return( node >= ftree->len )? SIZE_MAX : ftree->first_kids[node];
+}
+
+HARBOL_EXPORT size_t harbol_flat_tree_next_sib(struct HarbolFlatTree const *const ftree, size_t const node) {
+	return( node >= ftree->len )? SIZE_MAX : ftree->next_sibs[node];
+}
+
+HARBOL_EXPORT size_t harbol_flat_tree_subtree_len(struct HarbolFlatTree const *const ftree, size_t const node) {
+	return( node >= ftree->len )? 0 : (( ftree->ends[node] < ftree->len )? ftree->ends[node] : ftree->len) - node;
+}
+
+HARBOL_EXPORT size_t harbol_flat_tree_preorder_next(struct HarbolFlatTree const *const ftree, size_t const node) {
+	return( node + 1 >= ftree->len )? SIZE_MAX : node + 1;
+}
+
+HARBOL_EXPORT size_t harbol_flat_tree_skip(struct HarbolFlatTree const *const ftree, size_t const node) {
+	return( node >= ftree->len || ftree->ends[node] >= ftree->len )? SIZE_MAX : ftree->ends[node];
+}
+
+static inline size_t _harbol_flat_tree_leftmost_leaf(struct HarbolFlatTree const *const ftree, size_t node) {
+	while( ftree->first_kids[node] != SIZE_MAX ) {
+		node = ftree->first_kids[node];
+	}
+	return node;
+}
+
+HARBOL_EXPORT size_t harbol_flat_tree_postorder_first(struct HarbolFlatTree const *const ftree) {
+	return( ftree->len==0 )? SIZE_MAX : _harbol_flat_tree_leftmost_leaf(ftree, 0);
+}
+
+HARBOL_EXPORT size_t harbol_flat_tree_postorder_next(struct HarbolFlatTree const *const ftree, size_t const node) {
+	if( node >= ftree->len ) {
+		return SIZE_MAX;
+	} else if( ftree->next_sibs[node] != SIZE_MAX ) {
+		return _harbol_flat_tree_leftmost_leaf(ftree, ftree->next_sibs[node]);
+	}
+	return ftree->parents[node];
+}
+
+HARBOL_EXPORT size_t harbol_flat_tree_level_order(struct HarbolFlatTree const *const ftree, size_t order[const static 1]) {
+	if( ftree->len==0 ) {
+		return 0;
+	}
+	/// the output doubles as the queue.
+	size_t tail = 0;
+	order[tail++] = 0;
+	for( size_t head=0; head < tail; head++ ) {
+		for( size_t kid = ftree->first_kids[order[head]]; kid != SIZE_MAX; kid = ftree->next_sibs[kid] ) {
+			order[tail++] = kid;
+		}
+	}
+	return tail;
+}
+
+/// preorder walk with an explicit stack so deep trees can't overflow the call stack.
+struct HarbolFlatTreeFrame {
+	struct HarbolTree const *node;
+	size_t                   parent;
+};
+
+HARBOL_EXPORT bool harbol_flat_tree_from_tree(struct HarbolFlatTree *const ftree, struct HarbolTree const *const tree) {
+	size_t stack_cap = 64, stack_len = 0;
+	struct HarbolFlatTreeFrame *stack = calloc(stack_cap, sizeof *stack);
+	if( stack==NULL ) {
+		return false;
+	}
+	
+	ftree->len = 0;
+	stack[stack_len++] = ( struct HarbolFlatTreeFrame ){ tree, SIZE_MAX };
+	bool res = true;
+	while( stack_len > 0 ) {
+		struct HarbolFlatTreeFrame const frame = stack[--stack_len];
+		if( frame.node->len != ftree->datasize ) {
+			res = false;
+			break;
+		}
+		size_t const node = harbol_flat_tree_append(ftree, frame.parent, frame.node->data);
+		if( node==SIZE_MAX ) {
+			res = false;
+			break;
+		}
+		
+		size_t const kids = frame.node->kids.len;
+		if( stack_len + kids > stack_cap ) {
+			size_t const new_cap = bitwise_ceil(stack_len + kids) + 1;
+			struct HarbolFlatTreeFrame *const new_stack = harbol_recalloc(stack, new_cap, sizeof *stack, stack_cap);
+			if( new_stack==NULL ) {
+				res = false;
+				break;
+			}
+			stack = new_stack; stack_cap = new_cap;
+		}
+		/// push kids in reverse so the first kid is visited first.
+		struct HarbolTree const *const *const kid_table = ( struct HarbolTree const *const* )(frame.node->kids.table);
+		for( size_t i=kids; i-- > 0; ) {
+			stack[stack_len++] = ( struct HarbolFlatTreeFrame ){ kid_table[i], node };
+		}
+	}
+	free(stack);
+	return res;
+}
+
+HARBOL_EXPORT struct HarbolTree *harbol_flat_tree_to_tree(struct HarbolFlatTree const *const ftree) {
+	if( ftree->len==0 ) {
+		return NULL;
+	}
+	struct HarbolTree **const nodes = calloc(ftree->len, sizeof *nodes);
+	if( nodes==NULL ) {
+		return NULL;
+	}
+	
+	struct HarbolTree *root = NULL;
+	for( size_t i=0; i < ftree->len; i++ ) {
+		nodes[i] = harbol_tree_new(&ftree->datum[i * ftree->datasize], ftree->datasize);
+		if( nodes[i]==NULL ) {
+			break;
+		}
+		/// preorder visits each parent's kids in order, so appending keeps sibling order.
+		size_t const parent = ftree->parents[i];
+		if( parent==SIZE_MAX ) {
+			root = nodes[i];
+		} else if( !harbol_tree_insert_node(nodes[parent], &nodes[i]) ) {
+			harbol_tree_free(&nodes[i]);
+			break;
+		}
+		if( i + 1==ftree->len ) {
+			free(nodes);
+			return root;
 		}
 	}
+	harbol_tree_free(&root);
+	free(nodes);
 	return NULL;
 }
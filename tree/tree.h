@@ -6,11 +6,24 @@ extern "C" {
 #endif
 
 #include "../array/array.h"
+#include "../map/map.h"
+#include "../threadpool/threadpool.h"
+
+/// nodes with this many kids get a value -> kid index for by-value lookup and removal.
+#ifndef HARBOL_TREE_INDEX_THRESHOLD
+#	define HARBOL_TREE_INDEX_THRESHOLD    64
+#endif
 
 struct HarbolTree {
-	struct HarbolArray kids; /// []*HarbolTree
+	struct HarbolArray kids;      /// []*HarbolTree
 	size_t             len;
 	uint8_t           *data;
+	struct HarbolMap  *kid_index; /// map[kid value]struct HarbolTreeKidEntry, NULL until needed.
+};
+
+struct HarbolTreeKidEntry {
+	struct HarbolTree *kid;   /// first kid holding the value.
+	size_t             count; /// how many kids hold it.
 };
 
 HARBOL_EXPORT NO_NULL struct HarbolTree *harbol_tree_new(void const *val, size_t datasize);
@@ -32,6 +45,80 @@ HARBOL_EXPORT NO_NULL bool harbol_tree_rm_val(struct HarbolTree *tree, void cons
 
 HARBOL_EXPORT NO_NULL struct HarbolTree *harbol_tree_get_node_by_index(struct HarbolTree const *tree, size_t index);
 HARBOL_EXPORT NO_NULL struct HarbolTree *harbol_tree_get_node_by_val(struct HarbolTree const *tree, void const *val, size_t datasize);
+
+/// (re)builds the kid index regardless of the threshold.
+/// the index keys on kid values as they were inserted,
+/// so call this after changing a kid's value or editing 'kids' directly.
+HARBOL_EXPORT NO_NULL bool harbol_tree_index_kids(struct HarbolTree *tree);
+
+
+/// return false to stop the traversal early.
+typedef bool HarbolTreeVisitFunc(struct HarbolTree const *node, size_t depth, void *userdata);
+
+/// traversals use an explicit stack/queue, so tree depth isn't bound by the call stack.
+/// each returns true if every node was visited.
+HARBOL_EXPORT NEVER_NULL(1, 2) bool harbol_tree_visit_preorder(struct HarbolTree const *tree, HarbolTreeVisitFunc *visitor, void *userdata);
+HARBOL_EXPORT NEVER_NULL(1, 2) bool harbol_tree_visit_postorder(struct HarbolTree const *tree, HarbolTreeVisitFunc *visitor, void *userdata);
+HARBOL_EXPORT NEVER_NULL(1, 2) bool harbol_tree_visit_level_order(struct HarbolTree const *tree, HarbolTreeVisitFunc *visitor, void *userdata);
+
+/// folds one node into an accumulator.
+typedef void HarbolTreeFoldFunc(void *acc, struct HarbolTree const *node, void *userdata);
+/// merges the partial accumulator 'other' into 'acc'.
+typedef void HarbolTreeCombineFunc(void *acc, void const *other, void *userdata);
+
+/// 'acc' holds the identity value on entry and the result on return.
+/// the tree is split into a frontier of subtrees that the pool's workers fold independently,
+/// so 'combine' must be associative and commutative.
+/// runs sequentially if 'pool' is NULL or has fewer than two workers.
+HARBOL_EXPORT NEVER_NULL(1, 3, 5, 6) bool harbol_tree_reduce(struct HarbolTree const *tree, struct HarbolThreadPool *pool, void *acc, size_t accsize, HarbolTreeFoldFunc *fold, HarbolTreeCombineFunc *combine, void *userdata);
+/********************************************************************/
+
+
+/// flattened tree: nodes live in preorder in one pool, linked by index.
+/// node 0 is the root and a node's subtree spans [node, ends[node]).
+/// nodes on the path from the root to the last node can still get kids, their 'ends' is SIZE_MAX as their subtrees run to 'len'.
+/// values are stored inline, 'datasize' bytes each.
+struct HarbolFlatTree {
+	uint8_t *datum;
+	size_t  *first_kids, *next_sibs, *parents, *ends;
+	size_t   datasize, len, cap;
+};
+
+HARBOL_EXPORT struct HarbolFlatTree *harbol_flat_tree_new(size_t datasize, size_t init_size);
+HARBOL_EXPORT NO_NULL bool harbol_flat_tree_init(struct HarbolFlatTree *ftree, size_t datasize, size_t init_size);
+HARBOL_EXPORT NO_NULL struct HarbolFlatTree harbol_flat_tree_make(size_t datasize, size_t init_size, bool *res);
+
+HARBOL_EXPORT NO_NULL void harbol_flat_tree_clear(struct HarbolFlatTree *ftree);
+HARBOL_EXPORT NO_NULL void harbol_flat_tree_free(struct HarbolFlatTree **ftree_ref);
+
+HARBOL_EXPORT NO_NULL size_t harbol_flat_tree_len(struct HarbolFlatTree const *ftree);
+HARBOL_EXPORT NO_NULL bool harbol_flat_tree_reserve(struct HarbolFlatTree *ftree, size_t new_cap);
+
+/// appends 'val' as the last child of 'parent' (SIZE_MAX for the root).
+/// 'parent' must lie on the path from the root to the last node so preorder holds.
+/// returns the new node's index or SIZE_MAX.
+HARBOL_EXPORT NO_NULL size_t harbol_flat_tree_append(struct HarbolFlatTree *ftree, size_t parent, void const *val);
+
+HARBOL_EXPORT NO_NULL void *harbol_flat_tree_get(struct HarbolFlatTree const *ftree, size_t node);
+HARBOL_EXPORT NO_NULL size_t harbol_flat_tree_parent(struct HarbolFlatTree const *ftree, size_t node);
+HARBOL_EXPORT NO_NULL size_t harbol_flat_tree_first_kid(struct HarbolFlatTree const *ftree, size_t node);
+HARBOL_EXPORT NO_NULL size_t harbol_flat_tree_next_sib(struct HarbolFlatTree const *ftree, size_t node);
+HARBOL_EXPORT NO_NULL size_t harbol_flat_tree_subtree_len(struct HarbolFlatTree const *ftree, size_t node);
+
+/// preorder is plain index order; 'skip' jumps past a node's subtree.
+HARBOL_EXPORT NO_NULL size_t harbol_flat_tree_preorder_next(struct HarbolFlatTree const *ftree, size_t node);
+HARBOL_EXPORT NO_NULL size_t harbol_flat_tree_skip(struct HarbolFlatTree const *ftree, size_t node);
+
+HARBOL_EXPORT NO_NULL size_t harbol_flat_tree_postorder_first(struct HarbolFlatTree const *ftree);
+HARBOL_EXPORT NO_NULL size_t harbol_flat_tree_postorder_next(struct HarbolFlatTree const *ftree, size_t node);
+
+/// writes the breadth-first node order into 'order', which must hold 'len' indices.
+/// returns the number of nodes written.
+HARBOL_EXPORT NO_NULL size_t harbol_flat_tree_level_order(struct HarbolFlatTree const *ftree, size_t order[]);
+
+/// every node of 'tree' must hold exactly 'ftree->datasize' bytes.
+HARBOL_EXPORT NO_NULL bool harbol_flat_tree_from_tree(struct HarbolFlatTree *ftree, struct HarbolTree const *tree);
+HARBOL_EXPORT NO_NULL struct HarbolTree *harbol_flat_tree_to_tree(struct HarbolFlatTree const *ftree);
 /********************************************************************/
 
 
@@ -1,9 +1,11 @@
 #include <assert.h>
+#include <stddef.h>
 #include <stdalign.h>
 #include <time.h>
 #include "tuple.h"
 
 void test_harbol_tuple(FILE *debug_stream);
+void test_harbol_tuple_table(FILE *debug_stream);
 
 #ifdef HARBOL_USE_MEMPOOL
 struct HarbolMemPool *g_pool;
@@ -23,6 +25,7 @@ int main(void) {
 	g_pool = &m;
 #endif
 	test_harbol_tuple(debug_stream);
+	test_harbol_tuple_table(debug_stream);
 	
 	fclose(debug_stream); debug_stream=NULL;
 #ifdef HARBOL_USE_MEMPOOL
@@ -115,4 +118,113 @@ void test_harbol_tuple(FILE *const debug_stream) {
 	fprintf(debug_stream, "p's item is null? '%s'\n", p->datum != NULL? "no" : "yes");
 	harbol_tuple_free(&p);
 	fprintf(debug_stream, "p is null? '%s'\n\n", p != NULL? "no" : "yes");
-}
\ No newline at end of file
+}
+
+struct Particle {
+	int64_t id;
+	float   x;
+	char    tag;
+};
+
+void test_harbol_tuple_table(FILE *const debug_stream) {
+	fputs("tuple :: test shared layouts.\n", debug_stream);
+	size_t const shapes[][4] = {
+		{ sizeof(char), sizeof(int), sizeof(short), 0 },
+		{ sizeof(int64_t), sizeof(char), sizeof(int), sizeof(short) },
+		{ sizeof(char), sizeof(char), sizeof(char), sizeof(char) },
+	};
+	size_t const shape_lens[] = { 3, 4, 4 };
+	for( size_t s=0; s < 3; s++ ) {
+		for( int packed=0; packed < 2; packed++ ) {
+			struct HarbolTupleLayout layout = harbol_tuple_layout_make(shape_lens[s], shapes[s], packed, &( bool ){false});
+			struct HarbolTuple old = harbol_tuple_create(shape_lens[s], shapes[s], packed, &( bool ){false});
+			struct HarbolTuple stamped;
+			assert( harbol_tuple_init_layout(&stamped, &layout) );
+			assert( layout.len==old.len && stamped.len==old.len );
+			for( size_t i=0; i < shape_lens[s]; i++ ) {
+				assert( ( uint8_t* )(harbol_tuple_get(&old, i)) - old.datum==( ptrdiff_t )(layout.offsets[i]) );
+				assert( ( uint8_t* )(harbol_tuple_get(&stamped, i)) - stamped.datum==( ptrdiff_t )(layout.offsets[i]) );
+				assert( harbol_tuple_field_size(&stamped, i)==shapes[s][i] );
+			}
+			fprintf(debug_stream, "shape %zu%s: size '%zu', fields '%zu'\n", s, packed? " (packed)" : "", layout.len, harbol_tuple_fields(&stamped));
+			harbol_tuple_clear(&old);
+			harbol_tuple_clear(&stamped);
+			harbol_tuple_layout_clear(&layout);
+		}
+	}
+	
+	size_t const psizes[] = { sizeof(int64_t), sizeof(float), sizeof(char) };
+	struct HarbolTupleLayout *playout = harbol_tuple_layout_new(3, psizes, false);
+	assert( playout != NULL && playout->len==sizeof(struct Particle) );
+	assert( playout->offsets[1]==offsetof(struct Particle, x) && playout->offsets[2]==offsetof(struct Particle, tag) );
+	
+	struct HarbolTuple t;
+	assert( harbol_tuple_init_layout(&t, playout) );
+	harbol_tuple_set(&t, 0, &( int64_t ){42});
+	harbol_tuple_set(&t, 1, &( float ){1.5f});
+	harbol_tuple_set(&t, 2, &( char ){'p'});
+	assert( harbol_tuple_get(&t, 3)==NULL );
+	struct Particle pt;
+	assert( harbol_tuple_to_struct(&t, &pt) && pt.id==42 && pt.x==1.5f && pt.tag=='p' );
+	*( float* )(harbol_tuple_layout_field(playout, &pt, 1)) = 2.5f;
+	assert( pt.x==2.5f );
+	
+	fputs("\ntuple :: test tuple tables.\n", debug_stream);
+	struct HarbolTupleTable table = harbol_tuple_table_make(playout, 0, &( bool ){false});
+	assert( harbol_tuple_table_append_tuple(&table, &t)==0 );
+	assert( harbol_tuple_table_append_row(&table, &pt)==1 );
+	assert( harbol_tuple_table_append_row(&table, NULL)==2 );
+	assert( *( char const* )(harbol_tuple_table_get(&table, 2, 2))==0 );
+	assert( harbol_tuple_table_set(&table, 2, 0, &( int64_t ){7}) );
+	assert( harbol_tuple_table_get(&table, 3, 0)==NULL && harbol_tuple_table_get(&table, 0, 3)==NULL );
+	assert( harbol_tuple_table_rm_row(&table, 0) && harbol_tuple_table_len(&table)==2 );
+	struct Particle back = {0};
+	assert( harbol_tuple_table_get_row(&table, 0, &back) && back.id==42 && back.x==2.5f && back.tag=='p' );
+	assert( (( int64_t const* )(harbol_tuple_table_column(&table, 0)))[1]==7 );
+	harbol_tuple_clear(&t);
+	harbol_tuple_table_clear(&table);
+	
+	/// column scan vs. reading the same field out of row-major tuples.
+	enum { ROWS = 1 << 20 };
+	struct HarbolTupleTable *big = harbol_tuple_table_new(playout, ROWS);
+	struct HarbolTuple *rows = calloc(ROWS, sizeof *rows);
+	assert( big != NULL && rows != NULL );
+	for( size_t i=0; i < ROWS; i++ ) {
+		struct Particle const p = { ( int64_t )(i), ( float )(i & 1023), ( char )(i) };
+		assert( harbol_tuple_table_append_row(big, &p)==i );
+		harbol_tuple_init_layout(&rows[i], playout);
+		memcpy(rows[i].datum, &p, sizeof p);
+	}
+	
+	clock_t start = clock();
+	double aos_sum = 0.0;
+	for( int r=0; r < 10; r++ ) {
+		for( size_t i=0; i < ROWS; i++ ) {
+			aos_sum += *( float const* )(harbol_tuple_get(&rows[i], 1));
+		}
+	}
+	double const aos_secs = (clock() - start) / ( double )(CLOCKS_PER_SEC);
+	
+	start = clock();
+	double soa_sum = 0.0;
+	for( int r=0; r < 10; r++ ) {
+		float const *const xs = harbol_tuple_table_column(big, 1);
+		double partial = 0.0;
+		for( size_t i=0; i < ROWS; i++ ) {
+			partial += xs[i];
+		}
+		soa_sum += partial;
+	}
+	double const soa_secs = (clock() - start) / ( double )(CLOCKS_PER_SEC);
+	assert( aos_sum==soa_sum );
+	printf("harbol tuple :: 10 x %d-row field sum - tuples: %f secs | table column: %f secs\n", ROWS, aos_secs, soa_secs);
+	fprintf(debug_stream, "tuples: %f | table column: %f\n", aos_secs, soa_secs);
+	
+	for( size_t i=0; i < ROWS; i++ ) {
+		harbol_tuple_clear(&rows[i]);
+	}
+	free(rows);
+	harbol_tuple_table_free(&big);
+	harbol_tuple_layout_free(&playout);
+	assert( playout==NULL );
+}
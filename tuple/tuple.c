@@ -18,60 +18,76 @@ HARBOL_EXPORT struct HarbolTuple *harbol_tuple_new(size_t const len, size_t cons
 	return tuple;
 }
 
-HARBOL_EXPORT bool harbol_tuple_init(struct HarbolTuple *const tuple, size_t const len, size_t const sizes[const static 1], bool const packed) {
+/// computes each field's offset plus the tuple's total size.
+/// unpacked fields are aligned to the next field's size (capped at pointer size),
+/// and the total to the largest member's.
+static size_t _harbol_tuple_layout(size_t const len, size_t const sizes[const static 1], bool const packed, size_t offsets[const static 1]) {
 	size_t const ptr_size = sizeof(intptr_t);
-	size_t largest_memb = 0;
-	
-	/// first we find the largest member of the tuple:
+	size_t largest_memb = 0, offset = 0, prev_size = 0;
 	for( size_t i=0; i < len; i++ ) {
 		if( largest_memb < sizes[i] ) {
 			largest_memb = sizes[i];
 		}
-	}
-	
-	/// next, compute padding and alignment. we do this by having a next and previous size.
-	size_t
-		total_size=0,
-		prev_size=0
-	;
-	for( size_t i=0; i < len; i++ ) {
-		total_size += sizes[i];
+		offsets[i] = offset;
+		offset += sizes[i];
 		if( packed || len==1 ) {
 			continue;
 		}
 		size_t const offalign = (i+1 < len)? sizes[i+1] : prev_size;
-		total_size = harbol_align_size(total_size, offalign >= ptr_size? ptr_size : offalign);
+		offset = harbol_align_size(offset, offalign >= ptr_size? ptr_size : offalign);
 		prev_size = sizes[i];
 	}
+	return packed? offset : harbol_align_size(offset, largest_memb >= ptr_size? ptr_size : largest_memb);
+}
+
+HARBOL_EXPORT bool harbol_tuple_init(struct HarbolTuple *const tuple, size_t const len, size_t const sizes[const static 1], bool const packed) {
+	tuple->layout = NULL;
+	size_t *const offsets = calloc(len + (len==0), sizeof *offsets);
+	if( offsets==NULL ) {
+		return false;
+	}
+	size_t const total_size = _harbol_tuple_layout(len, sizes, packed, offsets);
 	
-	/// now do a final size alignment with the largest member.
-	size_t const aligned_total = harbol_align_size(total_size, largest_memb >= ptr_size? ptr_size : largest_memb);
-	tuple->datum = calloc(packed? total_size : aligned_total, sizeof *tuple->datum);
+	tuple->datum = calloc(total_size + (total_size==0), sizeof *tuple->datum);
 	if( tuple->datum==NULL ) {
+		free(offsets);
 		return false;
 	}
 	
-	tuple->len = packed? total_size : aligned_total;
-	tuple->fields = harbol_array_make(sizeof(uint32_t), tuple->len, &( bool ){false});
-	uint32_t offset = 0;
+	tuple->len = total_size;
+	tuple->packed = packed;
+	tuple->fields = harbol_array_make(sizeof(uint32_t), len, &( bool ){false});
+	uint32_t *const fields = ( uint32_t* )(tuple->fields.table);
+	if( fields==NULL ) {
+		free(tuple->datum); tuple->datum = NULL;
+		free(offsets);
+		return false;
+	}
+	tuple->fields.len = len;
 	for( size_t i=0; i < len; i++ ) {
-		uint32_t const size_pack = (( uint32_t )(sizes[i]) << 16) | offset;
-		harbol_array_insert(&tuple->fields, &size_pack, sizeof size_pack);
-		offset += sizes[i];
-		if( packed || len==1 ) {
-			continue;
-		}
-		size_t const offalign = (i+1<len)? sizes[i+1] : prev_size;
-		offset = harbol_align_size(offset, offalign >= ptr_size? ptr_size : offalign);
-		prev_size = sizes[i];
+		fields[i] = (( uint32_t )(sizes[i]) << 16) | ( uint32_t )(offsets[i]);
+	}
+	free(offsets);
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_tuple_init_layout(struct HarbolTuple *const tuple, struct HarbolTupleLayout const *const layout) {
+	*tuple = ( struct HarbolTuple ){0};
+	tuple->datum = calloc(layout->len + (layout->len==0), sizeof *tuple->datum);
+	if( tuple->datum==NULL ) {
+		return false;
 	}
+	tuple->layout = layout;
+	tuple->len    = layout->len;
+	tuple->packed = layout->packed;
 	return true;
 }
 
 HARBOL_EXPORT void harbol_tuple_clear(struct HarbolTuple *const tuple) {
 	harbol_array_clear(&tuple->fields);
 	free(tuple->datum); tuple->datum = NULL;
-	tuple->len = 0;
+	tuple->len    = 0;
+	tuple->layout = NULL;
 }
 
 HARBOL_EXPORT void harbol_tuple_free(struct HarbolTuple **tupleref) {
@@ -87,12 +103,14 @@ HARBOL_EXPORT size_t harbol_tuple_len(struct HarbolTuple const *const tuple) {
 }
 
 HARBOL_EXPORT size_t harbol_tuple_fields(struct HarbolTuple const *const tuple) {
-	return tuple->fields.len;
+	return( tuple->layout != NULL )? tuple->layout->fields : tuple->fields.len;
 }
 
 HARBOL_EXPORT void *harbol_tuple_get(struct HarbolTuple const *const tuple, size_t const index) {
 	if( tuple->datum==NULL || tuple->len==0 ) {
 		return NULL;
+	} else if( tuple->layout != NULL ) {
+		return( index >= tuple->layout->fields )? NULL : tuple->datum + tuple->layout->offsets[index];
 	}
 	
 	uint32_t const *const field_data = harbol_array_get(&tuple->fields, index, sizeof *field_data);
@@ -105,17 +123,14 @@ HARBOL_EXPORT void *harbol_tuple_set(struct HarbolTuple const *const tuple, size
 	}
 	
 	void *const restrict field = harbol_tuple_get(tuple, index);
-	if( field==NULL ) {
-		return NULL;
-	}
-	
-	uint32_t const *const field_data = harbol_array_get(&tuple->fields, index, sizeof *field_data);
-	return memcpy(field, val, *field_data >> 16);
+	return( field==NULL )? NULL : memcpy(field, val, harbol_tuple_field_size(tuple, index));
 }
 
 HARBOL_EXPORT size_t harbol_tuple_field_size(struct HarbolTuple const *const tuple, size_t const index) {
 	if( tuple->datum==NULL || tuple->len==0 ) {
 		return 0;
+	} else if( tuple->layout != NULL ) {
+		return( index >= tuple->layout->fields )? 0 : tuple->layout->sizes[index];
 	}
 	uint32_t const *const field_data = harbol_array_get(&tuple->fields, index, sizeof *field_data);
 	return( field_data==NULL )? 0 : *field_data >> 16;
@@ -132,3 +147,187 @@ HARBOL_EXPORT bool harbol_tuple_to_struct(struct HarbolTuple const *const tuple,
 	memcpy(struc, tuple->datum, tuple->len);
 	return true;
 }
+
+
+HARBOL_EXPORT struct HarbolTupleLayout *harbol_tuple_layout_new(size_t const len, size_t const sizes[const static 1], bool const packed) {
+	struct HarbolTupleLayout *layout = calloc(1, sizeof *layout);
+	if( layout==NULL || !harbol_tuple_layout_init(layout, len, sizes, packed) ) {
+		free(layout); layout = NULL;
+	}
+	return layout;
+}
+
+HARBOL_EXPORT struct HarbolTupleLayout harbol_tuple_layout_make(size_t const len, size_t const sizes[const static 1], bool const packed, bool *const restrict res) {
+	struct HarbolTupleLayout layout = {0};
+	*res = harbol_tuple_layout_init(&layout, len, sizes, packed);
+	return layout;
+}
+
+HARBOL_EXPORT bool harbol_tuple_layout_init(struct HarbolTupleLayout *const layout, size_t const len, size_t const sizes[const static 1], bool const packed) {
+	*layout = ( struct HarbolTupleLayout ){0};
+	if( len==0 || !harbol_multi_calloc(len, 2, &layout->offsets, sizeof *layout->offsets, &layout->sizes, sizeof *layout->sizes) ) {
+		return false;
+	}
+	memcpy(layout->sizes, sizes, len * sizeof *sizes);
+	layout->len    = _harbol_tuple_layout(len, sizes, packed, layout->offsets);
+	layout->fields = len;
+	layout->packed = packed;
+	return true;
+}
+
+HARBOL_EXPORT void harbol_tuple_layout_clear(struct HarbolTupleLayout *const layout) {
+	harbol_multi_cleanup(2, &layout->offsets, &layout->sizes);
+	layout->fields = layout->len = 0;
+}
+
+HARBOL_EXPORT void harbol_tuple_layout_free(struct HarbolTupleLayout **const layoutref) {
+	if( *layoutref==NULL ) {
+		return;
+	}
+	harbol_tuple_layout_clear(*layoutref);
+	free(*layoutref); *layoutref = NULL;
+}
+
+
+HARBOL_EXPORT struct HarbolTupleTable *harbol_tuple_table_new(struct HarbolTupleLayout const *const layout, size_t const init_rows) {
+	struct HarbolTupleTable *table = calloc(1, sizeof *table);
+	if( table==NULL || !harbol_tuple_table_init(table, layout, init_rows) ) {
+		free(table); table = NULL;
+	}
+	return table;
+}
+
+HARBOL_EXPORT struct HarbolTupleTable harbol_tuple_table_make(struct HarbolTupleLayout const *const layout, size_t const init_rows, bool *const restrict res) {
+	struct HarbolTupleTable table = {0};
+	*res = harbol_tuple_table_init(&table, layout, init_rows);
+	return table;
+}
+
+HARBOL_EXPORT bool harbol_tuple_table_init(struct HarbolTupleTable *const table, struct HarbolTupleLayout const *const layout, size_t const init_rows) {
+	*table = ( struct HarbolTupleTable ){0};
+	table->columns = calloc(layout->fields, sizeof *table->columns);
+	if( table->columns==NULL ) {
+		return false;
+	}
+	table->layout = layout;
+	if( !harbol_tuple_table_reserve(table, (init_rows==0)? ARRAY_DEFAULT_SIZE : init_rows) ) {
+		harbol_tuple_table_clear(table);
+		return false;
+	}
+	return true;
+}
+
+HARBOL_EXPORT void harbol_tuple_table_clear(struct HarbolTupleTable *const table) {
+	if( table->columns != NULL ) {
+		for( size_t i=0; i < table->layout->fields; i++ ) {
+			free(table->columns[i]);
+		}
+		free(table->columns); table->columns = NULL;
+	}
+	table->len = table->cap = 0;
+}
+
+HARBOL_EXPORT void harbol_tuple_table_free(struct HarbolTupleTable **const tableref) {
+	if( *tableref==NULL ) {
+		return;
+	}
+	harbol_tuple_table_clear(*tableref);
+	free(*tableref); *tableref = NULL;
+}
+
+HARBOL_EXPORT size_t harbol_tuple_table_len(struct HarbolTupleTable const *const table) {
+	return table->len;
+}
+
+HARBOL_EXPORT bool harbol_tuple_table_reserve(struct HarbolTupleTable *const table, size_t const rows) {
+	if( rows <= table->cap ) {
+		return true;
+	}
+	/// columns grow one at a time; a failure part way leaves the grown ones
+	/// with extra room, which is harmless since 'cap' is unchanged.
+	for( size_t i=0; i < table->layout->fields; i++ ) {
+		uint8_t *const column = harbol_recalloc(table->columns[i], rows, table->layout->sizes[i], table->cap);
+		if( column==NULL ) {
+			return false;
+		}
+		table->columns[i] = column;
+	}
+	table->cap = rows;
+	return true;
+}
+
+HARBOL_EXPORT size_t harbol_tuple_table_append_row(struct HarbolTupleTable *const restrict table, void const *const row) {
+	if( table->len >= table->cap && !harbol_tuple_table_reserve(table, (table->cap < ARRAY_DEFAULT_SIZE)? ARRAY_DEFAULT_SIZE : table->cap << 1) ) {
+		return SIZE_MAX;
+	}
+	size_t const r = table->len++;
+	if( row != NULL ) {
+		harbol_tuple_table_set_row(table, r, row);
+	} else {
+		for( size_t i=0; i < table->layout->fields; i++ ) {
+			memset(&table->columns[i][r * table->layout->sizes[i]], 0, table->layout->sizes[i]);
+		}
+	}
+	return r;
+}
+
+HARBOL_EXPORT size_t harbol_tuple_table_append_tuple(struct HarbolTupleTable *const restrict table, struct HarbolTuple const *const tuple) {
+	if( tuple->layout != table->layout ) {
+		return SIZE_MAX;
+	}
+	return harbol_tuple_table_append_row(table, tuple->datum);
+}
+
+HARBOL_EXPORT bool harbol_tuple_table_rm_row(struct HarbolTupleTable *const table, size_t const row) {
+	if( row >= table->len ) {
+		return false;
+	}
+	size_t const tail = table->len - row - 1;
+	for( size_t i=0; i < table->layout->fields; i++ ) {
+		size_t const size = table->layout->sizes[i];
+		memmove(&table->columns[i][row * size], &table->columns[i][(row + 1) * size], tail * size);
+	}
+	table->len--;
+	return true;
+}
+
+HARBOL_EXPORT void *harbol_tuple_table_column(struct HarbolTupleTable const *const table, size_t const field) {
+	return( field >= table->layout->fields )? NULL : table->columns[field];
+}
+
+HARBOL_EXPORT void *harbol_tuple_table_get(struct HarbolTupleTable const *const table, size_t const row, size_t const field) {
+	return( row >= table->len || field >= table->layout->fields )? NULL : &table->columns[field][row * table->layout->sizes[field]];
+}
+
+HARBOL_EXPORT bool harbol_tuple_table_set(struct HarbolTupleTable *const restrict table, size_t const row, size_t const field, void const *const val) {
+	void *const restrict cell = harbol_tuple_table_get(table, row, field);
+	if( cell==NULL ) {
+		return false;
+	}
+	memcpy(cell, val, table->layout->sizes[field]);
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_tuple_table_get_row(struct HarbolTupleTable const *const table, size_t const row, void *const restrict row_out) {
+	if( row >= table->len ) {
+		return false;
+	}
+	uint8_t *const out = row_out;
+	for( size_t i=0; i < table->layout->fields; i++ ) {
+		size_t const size = table->layout->sizes[i];
+		memcpy(&out[table->layout->offsets[i]], &table->columns[i][row * size], size);
+	}
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_tuple_table_set_row(struct HarbolTupleTable *const table, size_t const row, void const *const restrict row_in) {
+	if( row >= table->len ) {
+		return false;
+	}
+	uint8_t const *const in = row_in;
+	for( size_t i=0; i < table->layout->fields; i++ ) {
+		size_t const size = table->layout->sizes[i];
+		memcpy(&table->columns[i][row * size], &in[table->layout->offsets[i]], size);
+	}
+	return true;
+}
@@ -8,17 +8,35 @@ extern "C" {
 #include "../array/array.h"
 
 
+/// field offsets computed once and shared by any number of tuples or tables.
+/// 'len' is the size of one row laid out in the struct-like order.
+struct HarbolTupleLayout {
+	size_t *offsets, *sizes;
+	size_t  fields, len;
+	bool    packed : 1;
+};
+
 struct HarbolTuple {
-	struct HarbolArray fields;
-	uint8_t           *datum;
-	size_t             len;
-	bool               packed : 1;
+	struct HarbolArray              fields;
+	uint8_t                        *datum;
+	struct HarbolTupleLayout const *layout; /// if set, 'fields' is unused and the layout is borrowed.
+	size_t                          len;
+	bool                            packed : 1;
+};
+
+/// struct-of-arrays rows sharing one layout: each field is a contiguous column.
+struct HarbolTupleTable {
+	struct HarbolTupleLayout const *layout; /// borrowed, must outlive the table.
+	uint8_t                       **columns;
+	size_t                          len, cap;
 };
 
 
 HARBOL_EXPORT NO_NULL struct HarbolTuple *harbol_tuple_new(size_t len, size_t const sizes[], bool packed);
 HARBOL_EXPORT NO_NULL struct HarbolTuple harbol_tuple_create(size_t len, size_t const sizes[], bool packed, bool *res);
 HARBOL_EXPORT NO_NULL bool harbol_tuple_init(struct HarbolTuple *tuple, size_t len, size_t const sizes[], bool packed);
+/// only allocates the tuple's data; the layout is shared.
+HARBOL_EXPORT NO_NULL bool harbol_tuple_init_layout(struct HarbolTuple *tuple, struct HarbolTupleLayout const *layout);
 
 HARBOL_EXPORT NO_NULL void harbol_tuple_clear(struct HarbolTuple *tuple);
 HARBOL_EXPORT NO_NULL void harbol_tuple_free(struct HarbolTuple **tupleref);
@@ -35,6 +53,48 @@ HARBOL_EXPORT NO_NULL bool harbol_tuple_to_struct(struct HarbolTuple const *tupl
 /********************************************************************/
 
 
+HARBOL_EXPORT NO_NULL struct HarbolTupleLayout *harbol_tuple_layout_new(size_t len, size_t const sizes[], bool packed);
+HARBOL_EXPORT NO_NULL struct HarbolTupleLayout harbol_tuple_layout_make(size_t len, size_t const sizes[], bool packed, bool *res);
+HARBOL_EXPORT NO_NULL bool harbol_tuple_layout_init(struct HarbolTupleLayout *layout, size_t len, size_t const sizes[], bool packed);
+
+HARBOL_EXPORT NO_NULL void harbol_tuple_layout_clear(struct HarbolTupleLayout *layout);
+HARBOL_EXPORT NO_NULL void harbol_tuple_layout_free(struct HarbolTupleLayout **layoutref);
+
+/// field access on any buffer laid out by 'layout', e.g. one row of a plain array.
+static inline NO_NULL void *harbol_tuple_layout_field(struct HarbolTupleLayout const *const layout, void *const row, size_t const index) {
+	return ( uint8_t* )(row) + layout->offsets[index];
+}
+/********************************************************************/
+
+
+HARBOL_EXPORT NO_NULL struct HarbolTupleTable *harbol_tuple_table_new(struct HarbolTupleLayout const *layout, size_t init_rows);
+HARBOL_EXPORT NO_NULL struct HarbolTupleTable harbol_tuple_table_make(struct HarbolTupleLayout const *layout, size_t init_rows, bool *res);
+HARBOL_EXPORT NO_NULL bool harbol_tuple_table_init(struct HarbolTupleTable *table, struct HarbolTupleLayout const *layout, size_t init_rows);
+
+HARBOL_EXPORT NO_NULL void harbol_tuple_table_clear(struct HarbolTupleTable *table);
+HARBOL_EXPORT NO_NULL void harbol_tuple_table_free(struct HarbolTupleTable **tableref);
+
+HARBOL_EXPORT NO_NULL size_t harbol_tuple_table_len(struct HarbolTupleTable const *table);
+HARBOL_EXPORT NO_NULL bool harbol_tuple_table_reserve(struct HarbolTupleTable *table, size_t rows);
+
+/// 'row' is laid out like the layout's struct form, NULL appends a zeroed row.
+/// returns the row index or SIZE_MAX.
+HARBOL_EXPORT NEVER_NULL(1) size_t harbol_tuple_table_append_row(struct HarbolTupleTable *table, void const *row);
+/// 'tuple' must have been made from the table's layout.
+HARBOL_EXPORT NO_NULL size_t harbol_tuple_table_append_tuple(struct HarbolTupleTable *table, struct HarbolTuple const *tuple);
+HARBOL_EXPORT NO_NULL bool harbol_tuple_table_rm_row(struct HarbolTupleTable *table, size_t row);
+
+/// contiguous 'len' values of the field's size.
+HARBOL_EXPORT NO_NULL void *harbol_tuple_table_column(struct HarbolTupleTable const *table, size_t field);
+HARBOL_EXPORT NO_NULL void *harbol_tuple_table_get(struct HarbolTupleTable const *table, size_t row, size_t field);
+HARBOL_EXPORT NO_NULL bool harbol_tuple_table_set(struct HarbolTupleTable *table, size_t row, size_t field, void const *val);
+
+/// gather/scatter one row to/from its struct form.
+HARBOL_EXPORT NO_NULL bool harbol_tuple_table_get_row(struct HarbolTupleTable const *table, size_t row, void *row_out);
+HARBOL_EXPORT NO_NULL bool harbol_tuple_table_set_row(struct HarbolTupleTable *table, size_t row, void const *row_in);
+/********************************************************************/
+
+
 #ifdef __cplusplus
 }
 #endif
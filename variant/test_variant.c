@@ -44,8 +44,8 @@ void test_harbol_variant(FILE *const debug_stream) {
 	assert( p );
 	
 	fputs("\nvariant :: test retrieval.\n", debug_stream);
-	fprintf(debug_stream, "i data == '%i'\n", *(( const int* )i.data));
-	fprintf(debug_stream, "p data == '%i'\n", *(( const int* )p->data));
+	fprintf(debug_stream, "i data == '%i'\n", *(( const int* )harbol_variant_data(&i)));
+	fprintf(debug_stream, "p data == '%i'\n", *(( const int* )harbol_variant_data(p)));
 	
 	fprintf(debug_stream, "i tag == '%i'\n", i.tag);
 	fprintf(debug_stream, "p tag == '%i'\n", p->tag);
@@ -53,23 +53,63 @@ void test_harbol_variant(FILE *const debug_stream) {
 	fputs("\nvariant :: test setting.\n", debug_stream);
 	harbol_variant_set(&i, &( int ){100}, sizeof(int));
 	harbol_variant_set(p, &( int ){421}, sizeof(int));
-	fprintf(debug_stream, "i data == '%i'\n", *(( const int* )i.data));
-	fprintf(debug_stream, "p data == '%i'\n", *(( const int* )p->data));
+	fprintf(debug_stream, "i data == '%i'\n", *(( const int* )harbol_variant_data(&i)));
+	fprintf(debug_stream, "p data == '%i'\n", *(( const int* )harbol_variant_data(p)));
 	
 	harbol_variant_set(&i, &( float32_t ){1.f}, sizeof(float32_t));
 	i.tag = TYPE_FLOAT32;
 	harbol_variant_set(p, &( float64_t ){3.4}, sizeof(float64_t));
 	p->tag = TYPE_FLOAT64;
-	fprintf(debug_stream, "i data == '%" PRIf32 "'\n", *(( const float32_t* )i.data));
-	fprintf(debug_stream, "p data == '%" PRIf64 "'\n", *(( const float64_t* )p->data));
+	fprintf(debug_stream, "i data == '%" PRIf32 "'\n", *(( const float32_t* )harbol_variant_data(&i)));
+	fprintf(debug_stream, "p data == '%" PRIf64 "'\n", *(( const float64_t* )harbol_variant_data(p)));
 	
 	/// free data
 	fputs("\nvariant :: test destruction.\n", debug_stream);
 	harbol_variant_clear(&i);
-	fprintf(debug_stream, "i's data are null? '%s'\n", i.data != NULL? "no" : "yes");
+	fprintf(debug_stream, "i's data are null? '%s'\n", harbol_variant_data(&i) != NULL? "no" : "yes");
 	
 	harbol_variant_clear(p);
-	fprintf(debug_stream, "p's data are null? '%s'\n", p->data != NULL? "no" : "yes");
+	fprintf(debug_stream, "p's data are null? '%s'\n", harbol_variant_data(p) != NULL? "no" : "yes");
 	harbol_variant_free(&p);
 	fprintf(debug_stream, "p is null? '%s'\n", p != NULL? "no" : "yes");
+	
+	/// small values stay inline, larger ones go to the heap.
+	fputs("\nvariant :: test inline storage.\n", debug_stream);
+	assert( sizeof(struct HarbolVariant) <= 2 * HARBOL_VARIANT_INLINE_SIZE );
+	struct HarbolVariant small = harbol_variant_make(&( floatmax_t ){2.5L}, sizeof(floatmax_t), TYPE_FLOAT64, &( bool ){false});
+	assert( harbol_variant_is_inline(&small) && *( floatmax_t const* )(harbol_variant_data(&small))==2.5L );
+	/// copies of an inline variant carry their own value.
+	struct HarbolVariant copy = small;
+	*( floatmax_t* )(harbol_variant_data(&copy)) = 5.0L;
+	assert( *( floatmax_t const* )(harbol_variant_data(&small))==2.5L );
+	
+	char const text[] = "a value larger than sixteen bytes";
+	assert( harbol_variant_set(&small, text, sizeof text) && !harbol_variant_is_inline(&small) );
+	assert( !strcmp(harbol_variant_data(&small), text) );
+	/// shrinking back inline from the variant's own data.
+	assert( harbol_variant_set(&small, harbol_variant_data(&small), 8) && harbol_variant_is_inline(&small) );
+	assert( !memcmp(harbol_variant_data(&small), text, 8) );
+	fprintf(debug_stream, "small's size: '%zu', inline? '%s'\n", harbol_variant_size(&small), harbol_variant_is_inline(&small)? "yes" : "no");
+	harbol_variant_clear(&small);
+	assert( harbol_variant_data(&small)==NULL );
+	
+	enum { BENCH_VARS = 1 << 20 };
+	struct HarbolVariant *vars = calloc(BENCH_VARS, sizeof *vars);
+	assert( vars != NULL );
+	clock_t start = clock();
+	for( size_t n=0; n < BENCH_VARS; n++ ) {
+		vars[n] = harbol_variant_make(&( intmax_t ){( intmax_t )(n)}, sizeof(intmax_t), TYPE_INT, &( bool ){false});
+	}
+	intmax_t sum = 0;
+	for( size_t n=0; n < BENCH_VARS; n++ ) {
+		sum += *( intmax_t const* )(harbol_variant_data(&vars[n]));
+	}
+	for( size_t n=0; n < BENCH_VARS; n++ ) {
+		harbol_variant_clear(&vars[n]);
+	}
+	double const secs = (clock() - start) / ( double )(CLOCKS_PER_SEC);
+	assert( sum==( intmax_t )(BENCH_VARS) * (BENCH_VARS - 1) / 2 );
+	printf("harbol variant :: make/read/clear %d int variants: %f secs\n", BENCH_VARS, secs);
+	fprintf(debug_stream, "%d int variants: %f secs\n", BENCH_VARS, secs);
+	free(vars);
 }
@@ -19,9 +19,16 @@ HARBOL_EXPORT struct HarbolVariant harbol_variant_make(void const *const val, si
 }
 
 HARBOL_EXPORT bool harbol_variant_init(struct HarbolVariant *const restrict variant, void const *const val, size_t const datasize, int32_t const type_flags) {
-	variant->data = dup_data(val, datasize);
-	if( variant->data==NULL ) {
+	if( datasize==0 ) {
 		return false;
+	} else if( datasize <= HARBOL_VARIANT_INLINE_SIZE ) {
+		memset(&variant->data, 0, sizeof variant->data);
+		memcpy(variant->data.bytes, val, datasize);
+	} else {
+		variant->data.ptr = dup_data(val, datasize);
+		if( variant->data.ptr==NULL ) {
+			return false;
+		}
 	}
 	variant->size = datasize;
 	variant->tag = type_flags;
@@ -29,7 +36,10 @@ HARBOL_EXPORT bool harbol_variant_init(struct HarbolVariant *const restrict vari
 }
 
 HARBOL_EXPORT void harbol_variant_clear(struct HarbolVariant *const variant) {
-	free(variant->data); variant->data=NULL;
+	if( !harbol_variant_is_inline(variant) ) {
+		free(variant->data.ptr);
+	}
+	memset(&variant->data, 0, sizeof variant->data);
 	variant->size = 0;
 	variant->tag = 0;
 }
@@ -42,8 +52,15 @@ HARBOL_EXPORT void harbol_variant_free(struct HarbolVariant **const variantref)
 	free(*variantref); *variantref = NULL;
 }
 
+HARBOL_EXPORT bool harbol_variant_is_inline(struct HarbolVariant const *const variant) {
+	return variant->size <= HARBOL_VARIANT_INLINE_SIZE;
+}
+
 HARBOL_EXPORT void *harbol_variant_data(struct HarbolVariant const *const variant) {
-	return variant->data;
+	if( variant->size==0 ) {
+		return NULL;
+	}
+	return( harbol_variant_is_inline(variant) )? ( void* )(variant->data.bytes) : variant->data.ptr;
 }
 
 HARBOL_EXPORT size_t harbol_variant_size(struct HarbolVariant const *const variant) {
@@ -55,14 +72,25 @@ HARBOL_EXPORT int32_t harbol_variant_tag(struct HarbolVariant const *const varia
 }
 
 HARBOL_EXPORT bool harbol_variant_set(struct HarbolVariant *const restrict variant, void const *const val, size_t const datasize) {
-	uint8_t *const cpy = dup_data(val, datasize);
-	if( cpy==NULL ) {
+	if( datasize==0 ) {
 		return false;
+	} else if( datasize <= HARBOL_VARIANT_INLINE_SIZE ) {
+		/// 'val' may point into the variant itself, so copy it out first.
+		uint8_t bytes[HARBOL_VARIANT_INLINE_SIZE] = {0};
+		memcpy(bytes, val, datasize);
+		if( !harbol_variant_is_inline(variant) ) {
+			free(variant->data.ptr);
+		}
+		memcpy(variant->data.bytes, bytes, sizeof bytes);
+	} else {
+		uint8_t *const cpy = dup_data(val, datasize);
+		if( cpy==NULL ) {
+			return false;
+		} else if( !harbol_variant_is_inline(variant) ) {
+			free(variant->data.ptr);
+		}
+		variant->data.ptr = cpy;
 	}
-	if( variant->data != NULL ) {
-		free(variant->data); variant->data = NULL;
-	}
-	variant->data = cpy;
 	variant->size = datasize;
 	return true;
 }
@@ -9,9 +9,20 @@ extern "C" {
 #include "../harbol_common_includes.h"
 
 
+enum { HARBOL_VARIANT_INLINE_SIZE = 16 };
+
+/// values up to 'HARBOL_VARIANT_INLINE_SIZE' bytes are stored inline, larger ones on the heap.
+/// inline data moves with the struct, so always go through 'harbol_variant_data'.
+/// the fields after 'data' fit in 16 bytes so the struct stays 32 bytes even when floatmax_t is 16-byte aligned.
 struct HarbolVariant {
-	uint8_t *data;
-	size_t   size, align_or_len;
+	union {
+		uint8_t   *ptr;
+		uint8_t    bytes[HARBOL_VARIANT_INLINE_SIZE];
+		floatmax_t align_f; /// keeps inline floats/ints suitably aligned.
+		intmax_t   align_i;
+	}        data;
+	size_t   size;
+	uint32_t align_or_len;
 	int32_t  tag;
 };
 
@@ -23,7 +34,9 @@ HARBOL_EXPORT NO_NULL struct HarbolVariant *harbol_variant_new(void const *val,
 HARBOL_EXPORT NO_NULL void harbol_variant_clear(struct HarbolVariant *variant);
 HARBOL_EXPORT NO_NULL void harbol_variant_free(struct HarbolVariant **variantref);
 
+/// NULL for an empty variant.
 HARBOL_EXPORT NO_NULL void *harbol_variant_data(struct HarbolVariant const *variant);
+HARBOL_EXPORT NO_NULL bool harbol_variant_is_inline(struct HarbolVariant const *variant);
 HARBOL_EXPORT NO_NULL size_t harbol_variant_size(struct HarbolVariant const *variant);
 HARBOL_EXPORT NO_NULL int32_t harbol_variant_tag(struct HarbolVariant const *variant);
 